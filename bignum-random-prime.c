@@ -41,6 +41,7 @@
 
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 #if RANDOM_PRIME_VERBOSE
 #include <stdio.h>
@@ -318,11 +319,65 @@ miller_rabin_pocklington(mpz_t n, mpz_t nm1, mpz_t nm1dq, mpz_t a)
      n < 2^#n <= 2^{3 #q} = 8 2^{3 (#q-1)} < 8 q^3
 */
 
+/* Candidates are sieved in windows of SIEVE_SIZE consecutive values
+   of r, using all odd primes below SIEVE_LIMIT. */
+#define SIEVE_SIZE 2048
+#define SIEVE_LIMIT 0x4000
+/* Number of odd primes below SIEVE_LIMIT. */
+#define SIEVE_NPRIMES 1899
+
+/* Stores the odd primes below SIEVE_LIMIT, extending the primes
+   table using trial division. */
+static void
+sieve_primes_init (uint16_t *sp)
+{
+  unsigned x, i, n;
+
+  for (i = 0; i < NPRIMES; i++)
+    sp[i] = primes[i];
+
+  for (n = NPRIMES, x = primes[NPRIMES-1] + 2; x < SIEVE_LIMIT; x += 2)
+    {
+      for (i = 0; prime_square[i] <= x; i++)
+	if (x % primes[i] == 0)
+	  goto composite;
+      sp[n++] = x;
+    composite:
+      ;
+    }
+  assert (n == SIEVE_NPRIMES);
+}
+
+/* Returns a^{-1} (mod m), for 0 < a < m with gcd (a, m) = 1. */
+static unsigned
+inverse_mod (unsigned a, unsigned m)
+{
+  int u0 = 0, u1 = 1;
+  unsigned r0 = m, r1 = a;
+
+  while (r1 > 0)
+    {
+      unsigned q = r0 / r1;
+      unsigned t = r0 - q * r1;
+      int u = u0 - (int) q * u1;
+      r0 = r1; r1 = t;
+      u0 = u1; u1 = u;
+    }
+  assert (r0 == 1);
+  return u0 < 0 ? u0 + m : u0;
+}
+
 /* Generate a prime number p of size bits with 2 p0q dividing (p-1).
    p0 must be of size >= ceil(bits/3). The extra factor q can be
    omitted (then p0 and p0q should be equal). If top_bits_set is one,
    the topmost two bits are set to one, suitable for RSA primes. Also
-   returns r = (p-1)/p0q. */
+   returns r = (p-1)/p0q.
+
+   Candidates are examined for consecutive values of r, starting at a
+   random point, and candidates with small factors are sieved out
+   before applying the more expensive tests. Like any incremental
+   search, this makes primes following a long gap slightly more likely
+   to be selected. */
 void
 _nettle_generate_pocklington_prime (mpz_t p, mpz_t r,
 				    unsigned bits, int top_bits_set, 
@@ -331,10 +386,16 @@ _nettle_generate_pocklington_prime (mpz_t p, mpz_t r,
 				    const mpz_t q,
 				    const mpz_t p0q)
 {
-  mpz_t r_min, r_range, pm1, a, e;
+  mpz_t r_min, r_range, r0, pm1, a, e;
   int need_square_test;
   unsigned p0_bits;
   mpz_t x, y, p04;
+  uint16_t sieve_primes[SIEVE_NPRIMES];
+  /* For each sieving prime l, (2 p0q)^{-1} (mod l), or zero if l
+     divides p0q, and then l can't divide any candidate. */
+  uint16_t sieve_inverse[SIEVE_NPRIMES];
+  uint32_t sieve[SIEVE_SIZE / 32];
+  unsigned nprimes, i;
 
   p0_bits = mpz_sizeinbase (p0, 2);
 
@@ -345,6 +406,7 @@ _nettle_generate_pocklington_prime (mpz_t p, mpz_t r,
 
   mpz_init (r_min);
   mpz_init (r_range);
+  mpz_init (r0);
   mpz_init (pm1);
   mpz_init (a);
 
@@ -379,69 +441,112 @@ _nettle_generate_pocklington_prime (mpz_t p, mpz_t r,
       mpz_add_ui (r_min, r_range, 1);
     }
 
+  sieve_primes_init (sieve_primes);
+  nprimes = SIEVE_NPRIMES;
+  /* Only sieve using primes smaller than the candidates. */
+  if (bits <= 15)
+    while (nprimes > 0 && sieve_primes[nprimes-1] >= (1U << (bits-1)))
+      nprimes--;
+
+  for (i = 0; i < nprimes; i++)
+    {
+      unsigned l = sieve_primes[i];
+      unsigned d = (2 * mpz_fdiv_ui (p0q, l)) % l;
+      sieve_inverse[i] = d ? inverse_mod (d, l) : 0;
+    }
+
   for (;;)
     {
-      uint8_t buf[1];
+      unsigned long window, k;
+
+      /* Examine r = r_0 + k for 0 <= k < window, with random r_0, and
+	 the window cut off at the end of the range. */
+      nettle_mpz_random (r0, ctx, random, r_range);
+      mpz_sub (pm1, r_range, r0);
+      window = mpz_cmp_ui (pm1, SIEVE_SIZE) < 0
+	? mpz_get_ui (pm1) : SIEVE_SIZE;
+      mpz_add (r0, r0, r_min);
+
+      /* Candidate k is p_0 + 2 k p0q, where p_0 = 2 r_0 p0q + 1. It
+	 is divisible by l iff k = -p_0 (2 p0q)^{-1} (mod l). */
+      mpz_mul_2exp (pm1, r0, 1);
+      mpz_mul (pm1, pm1, p0q);
+
+      memset (sieve, 0, sizeof (sieve));
+      for (i = 0; i < nprimes; i++)
+	{
+	  unsigned long l = sieve_primes[i];
+	  unsigned long j;
 
-      nettle_mpz_random (r, ctx, random, r_range);
-      mpz_add (r, r, r_min);
+	  if (!sieve_inverse[i])
+	    continue;
 
-      /* Set p = 2*r*p0q + 1 */
-      mpz_mul_2exp(r, r, 1);
-      mpz_mul (pm1, r, p0q);
-      mpz_add_ui (p, pm1, 1);
+	  j = (mpz_fdiv_ui (pm1, l) + 1) % l;
+	  for (j = (l - j) * sieve_inverse[i] % l; j < window; j += l)
+	    sieve[j / 32] |= (uint32_t) 1 << (j % 32);
+	}
 
-      assert(mpz_sizeinbase(p, 2) == bits);
+      for (k = 0; k < window; k++)
+	{
+	  uint8_t buf[1];
 
-      /* Should use GMP trial division interface when that
-	 materializes, we don't need any testing beyond trial
-	 division. */
-      if (!mpz_probab_prime_p (p, 1))
-	continue;
+	  if (sieve[k / 32] & ((uint32_t) 1 << (k % 32)))
+	    continue;
 
-      random(ctx, sizeof(buf), buf);
-	  
-      mpz_set_ui (a, buf[0] + 2);
+	  /* Set p = 2*r*p0q + 1, with r = r_0 + k */
+	  mpz_add_ui (r, r0, k);
+	  mpz_mul_2exp (r, r, 1);
+	  mpz_mul (pm1, r, p0q);
+	  mpz_add_ui (p, pm1, 1);
 
-      if (q)
-	{
-	  mpz_mul (e, r, q);
-	  if (!miller_rabin_pocklington(p, pm1, e, a))
-	    continue;
+	  assert(mpz_sizeinbase(p, 2) == bits);
+
+	  random(ctx, sizeof(buf), buf);
 
-	  if (need_square_test)
+	  mpz_set_ui (a, buf[0] + 2);
+
+	  if (q)
 	    {
-	      /* Our e corresponds to 2r in the theorem */
-	      mpz_tdiv_qr (x, y, e, p04);
-	      goto square_test;
+	      mpz_mul (e, r, q);
+	      if (!miller_rabin_pocklington(p, pm1, e, a))
+		continue;
+
+	      if (need_square_test)
+		{
+		  /* Our e corresponds to 2r in the theorem */
+		  mpz_tdiv_qr (x, y, e, p04);
+		  goto square_test;
+		}
 	    }
-	}
-      else
-	{
-	  if (!miller_rabin_pocklington(p, pm1, r, a))
-	    continue;
-	  if (need_square_test)
+	  else
 	    {
-	      mpz_tdiv_qr (x, y, r, p04);
-	    square_test:
-	      /* We have r' = 2r, x = floor (r/2q) = floor(r'/2q),
-		 and y' = r' - x 4q = 2 (r - x 2q) = 2y.
-
-		 Then y^2 - 4x is a square iff y'^2 - 16 x is a
-		 square. */
-		 
-	      mpz_mul (y, y, y);
-	      mpz_submul_ui (y, x, 16);
-	      if (mpz_perfect_square_p (y))
+	      if (!miller_rabin_pocklington(p, pm1, r, a))
 		continue;
+	      if (need_square_test)
+		{
+		  mpz_tdiv_qr (x, y, r, p04);
+		square_test:
+		  /* We have r' = 2r, x = floor (r/2q) = floor(r'/2q),
+		     and y' = r' - x 4q = 2 (r - x 2q) = 2y.
+
+		     Then y^2 - 4x is a square iff y'^2 - 16 x is a
+		     square. */
+
+		  mpz_mul (y, y, y);
+		  mpz_submul_ui (y, x, 16);
+		  if (mpz_perfect_square_p (y))
+		    continue;
+		}
 	    }
-	}
 
-      /* If we passed all the tests, we have found a prime. */
-      break;
+	  /* If we passed all the tests, we have found a prime. */
+	  goto found;
+	}
     }
+ found:
   mpz_clear (r_min);
   mpz_clear (r_range);
+  mpz_clear (r0);
   mpz_clear (pm1);
   mpz_clear (a);
 
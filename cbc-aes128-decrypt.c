@@ -0,0 +1,53 @@
+/* cbc-aes128-decrypt.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "cbc.h"
+
+/* For fat builds */
+#if HAVE_NATIVE_cbc_aes128_decrypt
+void
+_nettle_cbc_aes128_decrypt_c(const struct aes128_ctx *ctx, uint8_t *iv,
+			     size_t length, uint8_t *dst,
+			     const uint8_t *src);
+# define nettle_cbc_aes128_decrypt _nettle_cbc_aes128_decrypt_c
+#endif
+
+void
+cbc_aes128_decrypt(const struct aes128_ctx *ctx, uint8_t *iv,
+		   size_t length, uint8_t *dst, const uint8_t *src)
+{
+  cbc_decrypt(ctx, (nettle_cipher_func *) aes128_decrypt,
+	      AES_BLOCK_SIZE, iv, length, dst, src);
+}
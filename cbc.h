@@ -47,6 +47,9 @@ extern "C" {
 #define cbc_aes128_encrypt nettle_cbc_aes128_encrypt
 #define cbc_aes192_encrypt nettle_cbc_aes192_encrypt
 #define cbc_aes256_encrypt nettle_cbc_aes256_encrypt
+#define cbc_aes128_decrypt nettle_cbc_aes128_decrypt
+#define cbc_aes192_decrypt nettle_cbc_aes192_decrypt
+#define cbc_aes256_decrypt nettle_cbc_aes256_decrypt
 
 void
 cbc_encrypt(const void *ctx, nettle_cipher_func *f,
@@ -95,6 +98,18 @@ void
 cbc_aes256_encrypt(const struct aes256_ctx *ctx, uint8_t *iv,
 		   size_t length, uint8_t *dst, const uint8_t *src);
 
+void
+cbc_aes128_decrypt(const struct aes128_ctx *ctx, uint8_t *iv,
+		   size_t length, uint8_t *dst, const uint8_t *src);
+
+void
+cbc_aes192_decrypt(const struct aes192_ctx *ctx, uint8_t *iv,
+		   size_t length, uint8_t *dst, const uint8_t *src);
+
+void
+cbc_aes256_decrypt(const struct aes256_ctx *ctx, uint8_t *iv,
+		   size_t length, uint8_t *dst, const uint8_t *src);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,6 +4,7 @@
 
    Copyright (C) 2014 Exegin Technologies Limited
    Copyright (C) 2014 Owen Kirby
+   Copyright (C) 2026 agent
 
    This file is part of GNU Nettle.
 
@@ -40,6 +41,44 @@
 
 #include "aes.h"
 #include "ccm.h"
+#include "ccm-internal.h"
+#include "memops.h"
+
+static void
+ccm_aes128_encrypt_blocks (struct ccm_ctx *ctx, const struct aes128_ctx *cipher,
+			   size_t length, uint8_t *dst, const uint8_t *src)
+{
+#if HAVE_NATIVE_ccm_aes128_encrypt_n
+  size_t n = length / CCM_BLOCK_SIZE;
+  if (n > 0)
+    {
+      size_t done;
+      _ccm_pad (ctx, cipher, (nettle_cipher_func *) aes128_encrypt);
+      done = CCM_BLOCK_SIZE * _ccm_aes128_encrypt_n (ctx, cipher, n, dst, src);
+      length -= done; dst += done; src += done;
+    }
+#endif
+  ccm_encrypt (ctx, cipher, (nettle_cipher_func *) aes128_encrypt,
+	       length, dst, src);
+}
+
+static void
+ccm_aes128_decrypt_blocks (struct ccm_ctx *ctx, const struct aes128_ctx *cipher,
+			   size_t length, uint8_t *dst, const uint8_t *src)
+{
+#if HAVE_NATIVE_ccm_aes128_decrypt_n
+  size_t n = length / CCM_BLOCK_SIZE;
+  if (n > 0)
+    {
+      size_t done;
+      _ccm_pad (ctx, cipher, (nettle_cipher_func *) aes128_encrypt);
+      done = CCM_BLOCK_SIZE * _ccm_aes128_decrypt_n (ctx, cipher, n, dst, src);
+      length -= done; dst += done; src += done;
+    }
+#endif
+  ccm_decrypt (ctx, cipher, (nettle_cipher_func *) aes128_encrypt,
+	       length, dst, src);
+}
 
 void
 ccm_aes128_set_key(struct ccm_aes128_ctx *ctx, const uint8_t *key)
@@ -68,16 +107,14 @@ void
 ccm_aes128_encrypt(struct ccm_aes128_ctx *ctx,
 		   size_t length, uint8_t *dst, const uint8_t *src)
 {
-  ccm_encrypt(&ctx->ccm, &ctx->cipher, (nettle_cipher_func *) aes128_encrypt,
-	      length, dst, src);
+  ccm_aes128_encrypt_blocks (&ctx->ccm, &ctx->cipher, length, dst, src);
 }
 
 void
 ccm_aes128_decrypt(struct ccm_aes128_ctx *ctx,
 		   size_t length, uint8_t *dst, const uint8_t *src)
 {
-  ccm_decrypt(&ctx->ccm, &ctx->cipher, (nettle_cipher_func *) aes128_encrypt,
-	      length, dst, src);
+  ccm_aes128_decrypt_blocks (&ctx->ccm, &ctx->cipher, length, dst, src);
 }
 
 void
@@ -87,25 +124,37 @@ ccm_aes128_digest(struct ccm_aes128_ctx *ctx, uint8_t *digest)
 }
 
 void
-ccm_aes128_encrypt_message(const struct aes128_ctx *ctx,
+ccm_aes128_encrypt_message(const struct aes128_ctx *cipher,
 			   size_t nlength, const uint8_t *nonce,
 			   size_t alength, const uint8_t *adata,
 			   size_t tlength,
 			   size_t clength, uint8_t *dst, const uint8_t *src)
 {
-  ccm_encrypt_message(ctx, (nettle_cipher_func *) aes128_encrypt,
-		      nlength, nonce, alength, adata,
-		      tlength, clength, dst, src);
+  struct ccm_ctx ctx;
+  uint8_t *tag = dst + (clength-tlength);
+  assert(clength >= tlength);
+  ccm_set_nonce(&ctx, cipher, (nettle_cipher_func *) aes128_encrypt,
+		nlength, nonce, alength, clength-tlength, tlength);
+  ccm_update(&ctx, cipher, (nettle_cipher_func *) aes128_encrypt,
+	     alength, adata);
+  ccm_aes128_encrypt_blocks (&ctx, cipher, clength-tlength, dst, src);
+  ccm_digest(&ctx, cipher, (nettle_cipher_func *) aes128_encrypt, tag);
 }
 
 int
-ccm_aes128_decrypt_message(const struct aes128_ctx *ctx,
+ccm_aes128_decrypt_message(const struct aes128_ctx *cipher,
 			   size_t nlength, const uint8_t *nonce,
 			   size_t alength, const uint8_t *adata,
 			   size_t tlength,
 			   size_t mlength, uint8_t *dst, const uint8_t *src)
 {
-  return ccm_decrypt_message(ctx, (nettle_cipher_func *) aes128_encrypt,
-			     nlength, nonce, alength, adata,
-			     tlength, mlength, dst, src);
+  struct ccm_ctx ctx;
+  uint8_t tag[CCM_BLOCK_SIZE];
+  ccm_set_nonce(&ctx, cipher, (nettle_cipher_func *) aes128_encrypt,
+		nlength, nonce, alength, mlength, tlength);
+  ccm_update(&ctx, cipher, (nettle_cipher_func *) aes128_encrypt,
+	     alength, adata);
+  ccm_aes128_decrypt_blocks (&ctx, cipher, mlength, dst, src);
+  ccm_digest(&ctx, cipher, (nettle_cipher_func *) aes128_encrypt, tag);
+  return memeql_sec(tag, src + mlength, tlength);
 }
@@ -0,0 +1,63 @@
+/* ccm-internal.h
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_CCM_INTERNAL_H_INCLUDED
+#define NETTLE_CCM_INTERNAL_H_INCLUDED
+
+#include "ccm.h"
+
+/* Name mangling */
+#define _ccm_pad _nettle_ccm_pad
+#define _ccm_aes128_encrypt_n _nettle_ccm_aes128_encrypt_n
+#define _ccm_aes128_decrypt_n _nettle_ccm_aes128_decrypt_n
+
+/* Completes any partial CBC-MAC block. */
+void
+_ccm_pad(struct ccm_ctx *ctx, const void *cipher, nettle_cipher_func *f);
+
+/* Process n complete message blocks, computing the CBC-MAC and the
+   CTR encryption in a single pass, and updating tag and ctr of
+   ctx. Any partial CBC-MAC block must have been completed by
+   _ccm_pad. Returns the number of blocks processed, which is either
+   n or, if not supported by the cpu, zero. */
+#if HAVE_NATIVE_ccm_aes128_encrypt_n
+size_t
+_ccm_aes128_encrypt_n (struct ccm_ctx *ctx, const struct aes128_ctx *cipher,
+		       size_t n, uint8_t *dst, const uint8_t *src);
+#endif
+
+#if HAVE_NATIVE_ccm_aes128_decrypt_n
+size_t
+_ccm_aes128_decrypt_n (struct ccm_ctx *ctx, const struct aes128_ctx *cipher,
+		       size_t n, uint8_t *dst, const uint8_t *src);
+#endif
+
+#endif /* NETTLE_CCM_INTERNAL_H_INCLUDED */
@@ -5,6 +5,7 @@
 
    Copyright (C) 2014 Exegin Technologies Limited
    Copyright (C) 2014 Owen Kirby
+   Copyright (C) 2026 agent
 
    This file is part of GNU Nettle.
 
@@ -44,6 +45,8 @@
 #include "ccm.h"
 #include "ctr.h"
 
+#include "ccm-internal.h"
+#include "block-internal.h"
 #include "memops.h"
 #include "nettle-internal.h"
 #include "macros.h"
@@ -78,7 +81,7 @@
  * and iterate the cipher one more time.
  *
  * The end of adata is detected implicitly by the first call to the encrypt()
- * and decrypt() functions, and will call ccm_pad() to insert the padding if
+ * and decrypt() functions, and will call _ccm_pad() to insert the padding if
  * necessary. Because of the underlying CTR encryption, the encrypt() and
  * decrypt() functions must be called with a multiple of the block size and
  * therefore blength should be zero on all but the first call.
@@ -87,8 +90,8 @@
  * to the digest() function, which will pad if the final CTR encryption was not
  * a multiple of the block size.
  */
-static void
-ccm_pad(struct ccm_ctx *ctx, const void *cipher, nettle_cipher_func *f)
+void
+_ccm_pad(struct ccm_ctx *ctx, const void *cipher, nettle_cipher_func *f)
 {
     if (ctx->blength) f(cipher, CCM_BLOCK_SIZE, ctx->tag.b, ctx->tag.b);
     ctx->blength = 0;
@@ -204,7 +207,27 @@ void
 ccm_encrypt(struct ccm_ctx *ctx, const void *cipher, nettle_cipher_func *f,
 	    size_t length, uint8_t *dst, const uint8_t *src)
 {
-  ccm_pad(ctx, cipher, f);
+  union nettle_block16 block[2];
+  union nettle_block16 m;
+
+  _ccm_pad(ctx, cipher, f);
+
+  /* The CBC-MAC is strictly serial, but each of its blocks can be
+     encrypted together with the independent CTR block for the same
+     data, letting the cipher process both in parallel. */
+  for (; length >= CCM_BLOCK_SIZE;
+       length -= CCM_BLOCK_SIZE, src += CCM_BLOCK_SIZE, dst += CCM_BLOCK_SIZE)
+    {
+      memcpy (m.b, src, CCM_BLOCK_SIZE);
+      block16_xor3 (&block[0], &ctx->tag, &m);
+      block[1] = ctx->ctr;
+      INCREMENT (CCM_BLOCK_SIZE, ctx->ctr.b);
+      f(cipher, 2*CCM_BLOCK_SIZE, block[0].b, block[0].b);
+      ctx->tag = block[0];
+      block16_xor (&m, &block[1]);
+      memcpy (dst, m.b, CCM_BLOCK_SIZE);
+    }
+
   ccm_update(ctx, cipher, f, length, src);
   ctr_crypt(cipher, f, CCM_BLOCK_SIZE, ctx->ctr.b, length, dst, src);
 }
@@ -218,8 +241,40 @@ void
 ccm_decrypt(struct ccm_ctx *ctx, const void *cipher, nettle_cipher_func *f,
 	    size_t length, uint8_t *dst, const uint8_t *src)
 {
+  _ccm_pad(ctx, cipher, f);
+
+  if (length >= CCM_BLOCK_SIZE)
+    {
+      /* Like for encryption, but the CBC-MAC needs the plaintext, so
+	 each block is authenticated together with the CTR
+	 decryption of the next block. */
+      union nettle_block16 block[2];
+      union nettle_block16 m;
+
+      f(cipher, CCM_BLOCK_SIZE, block[1].b, ctx->ctr.b);
+      INCREMENT (CCM_BLOCK_SIZE, ctx->ctr.b);
+      memcpy (m.b, src, CCM_BLOCK_SIZE);
+      block16_xor (&m, &block[1]);
+      memcpy (dst, m.b, CCM_BLOCK_SIZE);
+
+      for (length -= CCM_BLOCK_SIZE, src += CCM_BLOCK_SIZE, dst += CCM_BLOCK_SIZE;
+	   length >= CCM_BLOCK_SIZE;
+	   length -= CCM_BLOCK_SIZE, src += CCM_BLOCK_SIZE, dst += CCM_BLOCK_SIZE)
+	{
+	  block16_xor3 (&block[0], &ctx->tag, &m);
+	  block[1] = ctx->ctr;
+	  INCREMENT (CCM_BLOCK_SIZE, ctx->ctr.b);
+	  f(cipher, 2*CCM_BLOCK_SIZE, block[0].b, block[0].b);
+	  ctx->tag = block[0];
+	  memcpy (m.b, src, CCM_BLOCK_SIZE);
+	  block16_xor (&m, &block[1]);
+	  memcpy (dst, m.b, CCM_BLOCK_SIZE);
+	}
+      block16_xor (&ctx->tag, &m);
+      f(cipher, CCM_BLOCK_SIZE, ctx->tag.b, ctx->tag.b);
+    }
+
   ctr_crypt(cipher, f, CCM_BLOCK_SIZE, ctx->ctr.b, length, dst, src);
-  ccm_pad(ctx, cipher, f);
   ccm_update(ctx, cipher, f, length, dst);
 }
 
@@ -229,7 +284,7 @@ ccm_digest(struct ccm_ctx *ctx, const void *cipher, nettle_cipher_func *f,
 {
   int i = CCM_BLOCK_SIZE - CCM_FLAG_GET_L(ctx->ctr.b[CCM_OFFSET_FLAGS]);
   while (i < CCM_BLOCK_SIZE)  ctx->ctr.b[i++] = 0;
-  ccm_pad(ctx, cipher, f);
+  _ccm_pad(ctx, cipher, f);
   assert (ctx->tag_length <= CCM_BLOCK_SIZE);
   ctr_crypt(cipher, f, CCM_BLOCK_SIZE, ctx->ctr.b, ctx->tag_length, digest, ctx->tag.b);
 }
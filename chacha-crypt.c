@@ -54,17 +54,54 @@
 
 #define CHACHA_ROUNDS 20
 
-#if HAVE_NATIVE_chacha_4core
+#if HAVE_NATIVE_chacha_16core
+#define _nettle_chacha_crypt_16core chacha_crypt
+#define _nettle_chacha_crypt32_16core chacha_crypt32
+#elif HAVE_NATIVE_chacha_4core
 #define _nettle_chacha_crypt_4core chacha_crypt
 #define _nettle_chacha_crypt32_4core chacha_crypt32
 #elif HAVE_NATIVE_chacha_3core
 #define _nettle_chacha_crypt_3core chacha_crypt
 #define _nettle_chacha_crypt32_3core chacha_crypt32
-#elif !(HAVE_NATIVE_fat_chacha_4core || HAVE_NATIVE_fat_chacha_3core)
+#elif !(HAVE_NATIVE_fat_chacha_4core || HAVE_NATIVE_fat_chacha_3core \
+	|| HAVE_NATIVE_fat_chacha_16core)
 #define _nettle_chacha_crypt_1core chacha_crypt
 #define _nettle_chacha_crypt32_1core chacha_crypt32
 #endif
 
+#if HAVE_NATIVE_chacha_16core || HAVE_NATIVE_fat_chacha_16core
+void
+_nettle_chacha_crypt_16core(struct chacha_ctx *ctx,
+			    size_t length,
+			    uint8_t *dst,
+			    const uint8_t *src)
+{
+  uint32_t x[16*_CHACHA_STATE_LENGTH];
+
+  while (length > 8*CHACHA_BLOCK_SIZE)
+    {
+      _nettle_chacha_16core (x, ctx->state, CHACHA_ROUNDS);
+      if (length <= 16*CHACHA_BLOCK_SIZE)
+	{
+	  uint32_t incr = (length + CHACHA_BLOCK_SIZE - 1) / CHACHA_BLOCK_SIZE;
+	  ctx->state[12] += incr;
+	  ctx->state[13] += (ctx->state[12] < incr);
+	  memxor3 (dst, src, x, length);
+	  return;
+	}
+      ctx->state[12] += 16;
+      ctx->state[13] += (ctx->state[12] < 16);
+      memxor3 (dst, src, x, 16*CHACHA_BLOCK_SIZE);
+
+      length -= 16*CHACHA_BLOCK_SIZE;
+      dst += 16*CHACHA_BLOCK_SIZE;
+      src += 16*CHACHA_BLOCK_SIZE;
+    }
+  /* Up to 8 blocks left, not worth the 16-way function. */
+  _nettle_chacha_crypt_4core (ctx, length, dst, src);
+}
+#endif
+
 #if HAVE_NATIVE_chacha_4core || HAVE_NATIVE_fat_chacha_4core
 void
 _nettle_chacha_crypt_4core(struct chacha_ctx *ctx,
@@ -188,6 +225,35 @@ _nettle_chacha_crypt_1core(struct chacha_ctx *ctx,
 }
 #endif
 
+#if HAVE_NATIVE_chacha_16core || HAVE_NATIVE_fat_chacha_16core
+void
+_nettle_chacha_crypt32_16core(struct chacha_ctx *ctx,
+			      size_t length,
+			      uint8_t *dst,
+			      const uint8_t *src)
+{
+  uint32_t x[16*_CHACHA_STATE_LENGTH];
+
+  while (length > 8*CHACHA_BLOCK_SIZE)
+    {
+      _nettle_chacha_16core32 (x, ctx->state, CHACHA_ROUNDS);
+      if (length <= 16*CHACHA_BLOCK_SIZE)
+	{
+	  ctx->state[12] += (length + CHACHA_BLOCK_SIZE - 1) / CHACHA_BLOCK_SIZE;
+	  memxor3 (dst, src, x, length);
+	  return;
+	}
+      ctx->state[12] += 16;
+      memxor3 (dst, src, x, 16*CHACHA_BLOCK_SIZE);
+
+      length -= 16*CHACHA_BLOCK_SIZE;
+      dst += 16*CHACHA_BLOCK_SIZE;
+      src += 16*CHACHA_BLOCK_SIZE;
+    }
+  _nettle_chacha_crypt32_4core (ctx, length, dst, src);
+}
+#endif
+
 #if HAVE_NATIVE_chacha_4core || HAVE_NATIVE_fat_chacha_4core
 void
 _nettle_chacha_crypt32_4core(struct chacha_ctx *ctx,
@@ -61,6 +61,12 @@ _nettle_chacha_4core(uint32_t *dst, const uint32_t *src, unsigned rounds);
 void
 _nettle_chacha_4core32(uint32_t *dst, const uint32_t *src, unsigned rounds);
 
+void
+_nettle_chacha_16core(uint32_t *dst, const uint32_t *src, unsigned rounds);
+
+void
+_nettle_chacha_16core32(uint32_t *dst, const uint32_t *src, unsigned rounds);
+
 void
 _nettle_chacha_crypt_1core(struct chacha_ctx *ctx,
 			   size_t length,
@@ -79,6 +85,12 @@ _nettle_chacha_crypt_4core(struct chacha_ctx *ctx,
 			   uint8_t *dst,
 			   const uint8_t *src);
 
+void
+_nettle_chacha_crypt_16core(struct chacha_ctx *ctx,
+			    size_t length,
+			    uint8_t *dst,
+			    const uint8_t *src);
+
 void
 _nettle_chacha_crypt32_1core(struct chacha_ctx *ctx,
 			     size_t length,
@@ -97,4 +109,10 @@ _nettle_chacha_crypt32_4core(struct chacha_ctx *ctx,
 			     uint8_t *dst,
 			     const uint8_t *src);
 
+void
+_nettle_chacha_crypt32_16core(struct chacha_ctx *ctx,
+			      size_t length,
+			      uint8_t *dst,
+			      const uint8_t *src);
+
 #endif /* NETTLE_CHACHA_INTERNAL_H_INCLUDED */
@@ -41,6 +41,7 @@ extern "C" {
 /* Name mangling */
 #define curve25519_mul_g nettle_curve25519_mul_g
 #define curve25519_mul nettle_curve25519_mul
+#define curve25519_mul_batch nettle_curve25519_mul_batch
 
 #define CURVE25519_SIZE 32
 
@@ -53,6 +54,14 @@ curve25519_mul_g (uint8_t *q, const uint8_t *n);
 void
 curve25519_mul (uint8_t *q, const uint8_t *n, const uint8_t *p);
 
+/* Computes count independent products, like curve25519_mul, using a
+   single inversion. Input i is the scalar n + i*CURVE25519_SIZE
+   and the point p + i*CURVE25519_SIZE, and output i is written
+   to q + i*CURVE25519_SIZE. */
+void
+curve25519_mul_batch (size_t count, uint8_t *q,
+		      const uint8_t *n, const uint8_t *p);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,68 @@
+/* curve448-mul-batch.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "curve448.h"
+
+#include "ecc.h"
+#include "ecc-internal.h"
+
+void
+curve448_mul_batch (size_t count, uint8_t *q,
+		  const uint8_t *n, const uint8_t *p)
+{
+  const struct ecc_modulo *m = &_nettle_curve448.p;
+  mp_size_t itch;
+  mp_limb_t *x;
+  size_t i;
+
+  if (count == 0)
+    return;
+
+  itch = count*m->size + ECC_MUL_M_BATCH_ITCH (m->size, count);
+  x = gmp_alloc_limbs (itch);
+
+  for (i = 0; i < count; i++)
+    mpn_set_base256_le (x + i*m->size, m->size,
+			p + i*CURVE448_SIZE, CURVE448_SIZE);
+
+  ecc_mul_m_batch (m, 39081, 2, 446, count, x, n, x, x + count*m->size);
+
+  for (i = 0; i < count; i++)
+    mpn_get_base256_le (q + i*CURVE448_SIZE, CURVE448_SIZE,
+			x + i*m->size, m->size);
+
+  gmp_free_limbs (x, itch);
+}
@@ -42,6 +42,7 @@ extern "C" {
 /* Name mangling */
 #define curve448_mul_g nettle_curve448_mul_g
 #define curve448_mul nettle_curve448_mul
+#define curve448_mul_batch nettle_curve448_mul_batch
 
 #define CURVE448_SIZE 56
 
@@ -51,6 +52,14 @@ curve448_mul_g (uint8_t *q, const uint8_t *n);
 void
 curve448_mul (uint8_t *q, const uint8_t *n, const uint8_t *p);
 
+/* Computes count independent products, like curve448_mul, using a
+   single inversion. Input i is the scalar n + i*CURVE448_SIZE
+   and the point p + i*CURVE448_SIZE, and output i is written
+   to q + i*CURVE448_SIZE. */
+void
+curve448_mul_batch (size_t count, uint8_t *q,
+		    const uint8_t *n, const uint8_t *p);
+
 #ifdef __cplusplus
 }
 #endif
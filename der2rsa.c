@@ -66,11 +66,13 @@ rsa_public_key_from_der_iterator(struct rsa_public_key *pub,
 	  && rsa_public_key_prepare(pub));
 }
 
-int
-rsa_private_key_from_der_iterator(struct rsa_public_key *pub,
-				  struct rsa_private_key *priv,
-				  unsigned limit,
-				  struct asn1_der_iterator *i)
+/* Reads the fields shared by two-prime and multi-prime keys. */
+static int
+private_key_from_der_fields(struct rsa_public_key *pub,
+			    struct rsa_private_key *priv,
+			    unsigned limit,
+			    struct asn1_der_iterator *i,
+			    uint32_t *version)
 {
   /* RSAPrivateKey ::= SEQUENCE {
          version           Version,
@@ -86,24 +88,31 @@ rsa_private_key_from_der_iterator(struct rsa_public_key *pub,
     }
   */
 
+  return (i->type == ASN1_SEQUENCE
+	  && asn1_der_decode_constructed_last(i) == ASN1_ITERATOR_PRIMITIVE
+	  && i->type == ASN1_INTEGER
+	  && asn1_der_get_uint32(i, version)
+	  && *version <= 1
+	  && GET(i, pub->n, limit)
+	  && GET(i, pub->e, limit)
+	  && rsa_public_key_prepare(pub)
+	  && GET(i, priv->d, limit)
+	  && GET(i, priv->p, limit)
+	  && GET(i, priv->q, limit)
+	  && GET(i, priv->a, limit)
+	  && GET(i, priv->b, limit)
+	  && GET(i, priv->c, limit));
+}
+
+int
+rsa_private_key_from_der_iterator(struct rsa_public_key *pub,
+				  struct rsa_private_key *priv,
+				  unsigned limit,
+				  struct asn1_der_iterator *i)
+{
   uint32_t version;
   
-  if (i->type != ASN1_SEQUENCE)
-    return 0;
-
-  if (asn1_der_decode_constructed_last(i) == ASN1_ITERATOR_PRIMITIVE
-      && i->type == ASN1_INTEGER
-      && asn1_der_get_uint32(i, &version)
-      && version <= 1
-      && GET(i, pub->n, limit)
-      && GET(i, pub->e, limit)
-      && rsa_public_key_prepare(pub)
-      && GET(i, priv->d, limit)
-      && GET(i, priv->p, limit)
-      && GET(i, priv->q, limit)
-      && GET(i, priv->a, limit)
-      && GET(i, priv->b, limit)
-      && GET(i, priv->c, limit)
+  if (private_key_from_der_fields(pub, priv, limit, i, &version)
       && rsa_private_key_prepare(priv))
     {
       if (version == 1)
@@ -120,6 +129,70 @@ rsa_private_key_from_der_iterator(struct rsa_public_key *pub,
   return 0;
 }
 
+int
+rsa_multi_private_key_from_der_iterator(struct rsa_public_key *pub,
+					struct rsa_multi_private_key *priv,
+					unsigned limit,
+					struct asn1_der_iterator *i)
+{
+  /* OtherPrimeInfos ::= SEQUENCE SIZE(1..MAX) OF OtherPrimeInfo
+
+     OtherPrimeInfo ::= SEQUENCE {
+         prime             INTEGER,  -- r_i
+	 exponent          INTEGER,  -- d mod (r_i - 1)
+	 coefficient       INTEGER   -- (inverse of p q r_3 ... r_{i-1}) mod r_i
+    }
+  */
+  uint32_t version;
+
+  if (!private_key_from_der_fields(pub, &priv->key, limit, i, &version))
+    return 0;
+
+  priv->nprimes = 2;
+  if (version == 1)
+    {
+      enum asn1_iterator_result res;
+
+      if (!(asn1_der_iterator_next(i) == ASN1_ITERATOR_CONSTRUCTED
+	    && i->type == ASN1_SEQUENCE))
+	return 0;
+
+      for (res = asn1_der_decode_constructed_last(i);
+	   res != ASN1_ITERATOR_END;
+	   res = asn1_der_iterator_next(i))
+	{
+	  struct asn1_der_iterator info;
+	  unsigned j = priv->nprimes - 2;
+
+	  if (res != ASN1_ITERATOR_CONSTRUCTED
+	      || i->type != ASN1_SEQUENCE
+	      || priv->nprimes == RSA_MAX_PRIMES)
+	    return 0;
+
+	  if (!(asn1_der_decode_constructed(i, &info) == ASN1_ITERATOR_PRIMITIVE
+		&& info.type == ASN1_INTEGER
+		&& asn1_der_get_bignum(&info, priv->r[j], limit)
+		&& mpz_sgn(priv->r[j]) > 0
+		&& GET(&info, priv->d[j], limit)
+		&& GET(&info, priv->t[j], limit)
+		&& asn1_der_iterator_next(&info) == ASN1_ITERATOR_END))
+	    return 0;
+
+	  priv->nprimes++;
+	}
+      /* The sequence must not be empty. */
+      if (priv->nprimes == 2)
+	return 0;
+    }
+  else
+    /* Nothing more may follow in the outer sequence. */
+    if (asn1_der_iterator_next(i) != ASN1_ITERATOR_END)
+      return 0;
+
+  return (rsa_multi_private_key_prepare(priv)
+	  && priv->key.size == pub->size);
+}
+
 int
 rsa_keypair_from_der(struct rsa_public_key *pub,
 		     struct rsa_private_key *priv,
@@ -139,3 +212,20 @@ rsa_keypair_from_der(struct rsa_public_key *pub,
   else
     return rsa_public_key_from_der_iterator(pub, limit, &i);    
 }
+
+int
+rsa_multi_keypair_from_der(struct rsa_public_key *pub,
+			   struct rsa_multi_private_key *priv,
+			   unsigned limit,
+			   size_t length, const uint8_t *data)
+{
+  struct asn1_der_iterator i;
+  enum asn1_iterator_result res;
+
+  res = asn1_der_iterator_first(&i, length, data);
+
+  if (res != ASN1_ITERATOR_CONSTRUCTED)
+    return 0;
+
+  return rsa_multi_private_key_from_der_iterator(pub, priv, limit, &i);
+}
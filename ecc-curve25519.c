@@ -70,6 +70,24 @@ ecc_curve25519_modp(const struct ecc_modulo *m UNUSED, mp_limb_t *rp, mp_limb_t
 }
 #endif /* HAVE_NATIVE_ecc_curve25519_modp */
 
+#if HAVE_NATIVE_ecc_curve25519_mul
+#define ecc_curve25519_mul _nettle_ecc_curve25519_mul
+void
+ecc_curve25519_mul (const struct ecc_modulo *m, mp_limb_t *rp,
+		   const mp_limb_t *ap, const mp_limb_t *bp, mp_limb_t *tp);
+#else
+#define ecc_curve25519_mul NULL
+#endif
+
+#if HAVE_NATIVE_ecc_curve25519_sqr
+#define ecc_curve25519_sqr _nettle_ecc_curve25519_sqr
+void
+ecc_curve25519_sqr (const struct ecc_modulo *m, mp_limb_t *rp,
+		   const mp_limb_t *ap, mp_limb_t *tp);
+#else
+#define ecc_curve25519_sqr NULL
+#endif
+
 #define QHIGH_BITS (GMP_NUMB_BITS * ECC_LIMB_SIZE - 252)
 
 #if QHIGH_BITS == 0
@@ -275,13 +293,15 @@ const struct ecc_curve _nettle_curve25519 =
     ecc_curve25519_inv,
     NULL,
     ecc_curve25519_sqrt_ratio,
+    ecc_curve25519_mul,
+    ecc_curve25519_sqr,
   },
   {
     253,
     ECC_LIMB_SIZE,
     ECC_BMODQ_SIZE,
     0,
-    ECC_MOD_INV_ITCH (ECC_LIMB_SIZE),
+    ECC_MOD_INV_SAFEGCD_ITCH (ECC_LIMB_SIZE),
     0,
     0,
 
@@ -294,7 +314,9 @@ const struct ecc_curve _nettle_curve25519 =
 
     ecc_curve25519_modq,
     ecc_curve25519_modq,
-    ecc_mod_inv,
+    ecc_mod_inv_safegcd,
+    NULL,
+    NULL,
     NULL,
     NULL,
   },
@@ -97,6 +97,24 @@ ecc_curve448_modp(const struct ecc_modulo *m, mp_limb_t *rp, mp_limb_t *xp)
 #define ecc_curve448_modp ecc_mod
 #endif
 
+#if HAVE_NATIVE_ecc_curve448_mul
+#define ecc_curve448_mul _nettle_ecc_curve448_mul
+void
+ecc_curve448_mul (const struct ecc_modulo *m, mp_limb_t *rp,
+		 const mp_limb_t *ap, const mp_limb_t *bp, mp_limb_t *tp);
+#else
+#define ecc_curve448_mul NULL
+#endif
+
+#if HAVE_NATIVE_ecc_curve448_sqr
+#define ecc_curve448_sqr _nettle_ecc_curve448_sqr
+void
+ecc_curve448_sqr (const struct ecc_modulo *m, mp_limb_t *rp,
+		 const mp_limb_t *ap, mp_limb_t *tp);
+#else
+#define ecc_curve448_sqr NULL
+#endif
+
 /* Computes a^{(p-3)/4} = a^{2^446-2^222-1} mod m. Needs 4 * n scratch
    space. */
 static void
@@ -142,18 +160,6 @@ ecc_mod_pow_446m224m1 (const struct ecc_modulo *p,
 #undef tp
 }
 
-#define ECC_CURVE448_INV_ITCH (4*ECC_LIMB_SIZE)
-
-static void ecc_curve448_inv (const struct ecc_modulo *p,
-			 mp_limb_t *rp, const mp_limb_t *ap,
-			 mp_limb_t *tp)
-{
-  ecc_mod_pow_446m224m1 (p, rp, ap, tp);/* a^{2^446-2^222-1} */
-  ecc_mod_sqr (p, rp, rp, tp);		/* a^{2^447-2^223-2} */
-  ecc_mod_sqr (p, rp, rp, tp);		/* a^{2^448-2^224-4} */
-  ecc_mod_mul (p, rp, ap, rp, tp);	/* a^{2^448-2^224-3} */
-}
-
 /* To guarantee that inputs to ecc_mod_zero_p are in the required range. */
 #if ECC_LIMB_SIZE * GMP_NUMB_BITS != 448
 #error Unsupported limb size
@@ -213,7 +219,7 @@ const struct ecc_curve _nettle_curve448 =
     ECC_LIMB_SIZE,
     ECC_BMODP_SIZE,
     0,
-    ECC_CURVE448_INV_ITCH,
+    ECC_MOD_INV_SAFEGCD_ITCH (ECC_LIMB_SIZE),
     0,
     ECC_CURVE448_SQRT_RATIO_ITCH,
 
@@ -226,16 +232,18 @@ const struct ecc_curve _nettle_curve448 =
 
     ecc_curve448_modp,
     ecc_curve448_modp,
-    ecc_curve448_inv,
+    ecc_mod_inv_safegcd,
     NULL,
     ecc_curve448_sqrt_ratio,
+    ecc_curve448_mul,
+    ecc_curve448_sqr,
   },
   {
     446,
     ECC_LIMB_SIZE,
     ECC_BMODQ_SIZE,
     0,
-    ECC_MOD_INV_ITCH (ECC_LIMB_SIZE),
+    ECC_MOD_INV_SAFEGCD_ITCH (ECC_LIMB_SIZE),
     0,
     0,
 
@@ -248,7 +256,9 @@ const struct ecc_curve _nettle_curve448 =
 
     ecc_mod,
     ecc_mod,
-    ecc_mod_inv,
+    ecc_mod_inv_safegcd,
+    NULL,
+    NULL,
     NULL,
     NULL,
   },
@@ -262,7 +272,7 @@ const struct ecc_curve _nettle_curve448 =
   ECC_DUP_EH_ITCH (ECC_LIMB_SIZE),
   ECC_MUL_A_EH_ITCH (ECC_LIMB_SIZE),
   ECC_MUL_G_EH_ITCH (ECC_LIMB_SIZE),
-  ECC_EH_TO_A_ITCH (ECC_LIMB_SIZE, ECC_CURVE448_INV_ITCH),
+  ECC_EH_TO_A_ITCH (ECC_LIMB_SIZE, ECC_MOD_INV_SAFEGCD_ITCH (ECC_LIMB_SIZE)),
 
   ecc_add_eh,
   ecc_add_ehh,
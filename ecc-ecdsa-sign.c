@@ -99,3 +99,33 @@ ecc_ecdsa_sign (const struct ecc_curve *ecc,
 #undef kinv
 #undef tp
 }
+
+mp_size_t
+ecc_ecdsa_sign_random_itch (const struct ecc_curve *ecc)
+{
+  return ecc->p.size + ECC_ECDSA_SIGN_ITCH (ecc->p.size);
+}
+
+/* Like ecc_ecdsa_sign, but generates the nonce, retrying until both r
+   and s are non-zero. */
+void
+ecc_ecdsa_sign_random (const struct ecc_curve *ecc,
+		       const mp_limb_t *zp,
+		       void *random_ctx, nettle_random_func *random,
+		       size_t length, const uint8_t *digest,
+		       mp_limb_t *rp, mp_limb_t *sp,
+		       mp_limb_t *scratch)
+{
+#define kp scratch
+#define scratch_out (scratch + ecc->p.size)
+  /* Timing reveals the number of rounds through this loop, but the
+     timing is still independent of the secret k finally used. */
+  do
+    {
+      ecc_mod_random (&ecc->q, kp, random_ctx, random, scratch_out);
+      ecc_ecdsa_sign (ecc, zp, kp, length, digest, rp, sp, scratch_out);
+    }
+  while (mpn_zero_p (rp, ecc->p.size) || mpn_zero_p (sp, ecc->p.size));
+#undef kp
+#undef scratch_out
+}
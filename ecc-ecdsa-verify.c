@@ -51,14 +51,92 @@ ecdsa_in_range (const struct ecc_curve *ecc, const mp_limb_t *xp)
     && mpn_cmp (xp, ecc->q.m, ecc->p.size) < 0;
 }
 
+/* Checks if the x coordinate of the jacobian point P, reduced modulo
+   q, equals r, i.e., if X = r' Z^2 (mod p) for r' = r or r' = r + q,
+   avoiding the inversion needed for conversion to affine
+   coordinates. Needs 6*size limbs of scratch space. */
+int
+ecc_ecdsa_check_x (const struct ecc_curve *ecc,
+		   const mp_limb_t *P, const mp_limb_t *rp,
+		   mp_limb_t *scratch)
+{
+  mp_size_t size = ecc->p.size;
+#define xp scratch
+#define zz (scratch + size)
+#define tp (scratch + 2*size)
+#define scratch_out (scratch + 4*size)
+
+  /* Multiplication by one undoes the redc representation. */
+  mpn_zero (tp, size);
+  tp[0] = 1;
+  ecc_mod_mul_canonical (&ecc->p, xp, P, tp, scratch_out);
+
+  /* Z = 0 means the infinity point, which never matches. Reject it
+     explicitly, since X = r Z^2 would otherwise hold for any r. */
+  ecc_mod_sqr_canonical (&ecc->p, zz, P + 2*size, scratch_out);
+  if (mpn_zero_p (zz, size))
+    return 0;
+
+  ecc_mod_mul_canonical (&ecc->p, tp, zz, rp, scratch_out);
+  if (mpn_cmp (tp, xp, size) == 0)
+    return 1;
+
+  /* Also r + q is a candidate, if less than p. */
+  if (mpn_add_n (tp, rp, ecc->q.m, size)
+      || mpn_cmp (tp, ecc->p.m, size) >= 0)
+    return 0;
+
+  ecc_mod_mul_canonical (&ecc->p, tp, zz, tp, scratch_out);
+  return mpn_cmp (tp, xp, size) == 0;
+#undef xp
+#undef zz
+#undef tp
+#undef scratch_out
+}
+
+/* Verification with s^{-1} already computed. */
+static int
+ecdsa_verify_sinv (const struct ecc_curve *ecc,
+		   const mp_limb_t *pp,
+		   size_t length, const uint8_t *digest,
+		   const mp_limb_t *rp, const mp_limb_t *sinv,
+		   mp_limb_t *scratch)
+{
+#define P scratch
+#define u1 (scratch + 3*ecc->p.size)
+#define u2 (scratch + 4*ecc->p.size)
+#define hp (scratch + 5*ecc->p.size)
+#define scratch_out (scratch + 5*ecc->p.size)
+
+  /* u1 = h / s */
+  _nettle_dsa_hash (hp, ecc->q.bit_size, length, digest);
+  ecc_mod_mul_canonical (&ecc->q, u1, hp, sinv, u1);
+
+  /* u2 = r / s */
+  ecc_mod_mul_canonical (&ecc->q, u2, rp, sinv, u2);
+
+  /* R = u1 G + u2 Y. u1 = 0 can happen only if h = 0 or h = q, which
+     is extremely unlikely, but handled. If R is the infinity point,
+     the signature is invalid. */
+  if (!ecc_nonsec_mul_ga (ecc, P, u1, u2, pp, scratch_out))
+    return 0;
+
+  return ecc_ecdsa_check_x (ecc, P, rp, scratch_out);
+#undef P
+#undef u1
+#undef u2
+#undef hp
+#undef scratch_out
+}
+
 mp_size_t
 ecc_ecdsa_verify_itch (const struct ecc_curve *ecc)
 {
-  /* Largest storage need is for the ecc_mul_a call. */
-  return 5*ecc->p.size + ECC_MUL_A_ITCH (ecc->p.size);
+  /* Largest storage need is for the ecc_nonsec_mul_ga call. */
+  assert (ecc->q.invert_itch <= ECC_NONSEC_MUL_GA_ITCH (ecc->p.size));
+  return 6*ecc->p.size + ECC_NONSEC_MUL_GA_ITCH (ecc->p.size);
 }
 
-/* FIXME: Use faster primitives, not requiring side-channel silence. */
 int
 ecc_ecdsa_verify (const struct ecc_curve *ecc,
 		  const mp_limb_t *pp, /* Public key */
@@ -82,55 +160,160 @@ ecc_ecdsa_verify (const struct ecc_curve *ecc,
      6. Signature is valid if R_x = r (mod q).
   */
 
-#define P2 scratch
-#define u1 (scratch + 3*ecc->p.size)
-#define u2 (scratch + 4*ecc->p.size)
-
-#define P1 (scratch + 4*ecc->p.size)
-#define sinv (scratch)
-#define hp (scratch + ecc->p.size)
+#define sinv scratch
+#define scratch_out (scratch + ecc->p.size)
 
   if (! (ecdsa_in_range (ecc, rp)
 	 && ecdsa_in_range (ecc, sp)))
     return 0;
 
-  /* FIXME: Micro optimizations: Either simultaneous multiplication.
-     Or convert to projective coordinates (can be done without
-     division, I think), and write an ecc_add_ppp. */
+  ecc->q.invert (&ecc->q, sinv, sp, scratch_out);
 
-  /* Compute sinv */
-  ecc->q.invert (&ecc->q, sinv, sp, sinv + ecc->p.size);
+  return ecdsa_verify_sinv (ecc, pp, length, digest, rp, sinv, scratch_out);
+#undef sinv
+#undef scratch_out
+}
 
-  /* u1 = h / s, P1 = u1 * G */
+mp_size_t
+ecc_ecdsa_table_size (const struct ecc_curve *ecc)
+{
+  return ECC_NONSEC_TABLE_SIZE (ecc->p.size);
+}
+
+mp_size_t
+ecc_ecdsa_table_init_itch (const struct ecc_curve *ecc)
+{
+  return ECC_NONSEC_TABLE_INIT_ITCH (ecc);
+}
+
+void
+ecc_ecdsa_table_init (const struct ecc_curve *ecc,
+		      mp_limb_t *tp, const mp_limb_t *pp,
+		      mp_limb_t *scratch)
+{
+  ecc_nonsec_table_init (ecc, tp, pp, scratch);
+}
+
+mp_size_t
+ecc_ecdsa_verify_table_itch (const struct ecc_curve *ecc)
+{
+  assert (ecc->q.invert_itch <= ECC_NONSEC_MUL_GT_ITCH (ecc->p.size));
+  return 6*ecc->p.size + ECC_NONSEC_MUL_GT_ITCH (ecc->p.size);
+}
+
+int
+ecc_ecdsa_verify_table (const struct ecc_curve *ecc,
+			const mp_limb_t *tp, /* Public key table */
+			size_t length, const uint8_t *digest,
+			const mp_limb_t *rp, const mp_limb_t *sp,
+			mp_limb_t *scratch)
+{
+  /* Same procedure as ecc_ecdsa_verify, but with R = u1 G + u2 Y
+     computed using the precomputed table. */
+#define sinv scratch
+#define P (scratch + ecc->p.size)
+#define u1 (scratch + 4*ecc->p.size)
+#define u2 (scratch + 5*ecc->p.size)
+#define hp (scratch + 6*ecc->p.size)
+#define scratch_out (scratch + 6*ecc->p.size)
+
+  if (! (ecdsa_in_range (ecc, rp)
+	 && ecdsa_in_range (ecc, sp)))
+    return 0;
+
+  ecc->q.invert (&ecc->q, sinv, sp, scratch_out);
+
+  /* u1 = h / s */
   _nettle_dsa_hash (hp, ecc->q.bit_size, length, digest);
   ecc_mod_mul_canonical (&ecc->q, u1, hp, sinv, u1);
 
-  /* u2 = r / s, P2 = u2 * Y */
+  /* u2 = r / s */
   ecc_mod_mul_canonical (&ecc->q, u2, rp, sinv, u2);
 
-   /* Total storage: 5*ecc->p.size + ECC_MUL_A_ITCH */
-  ecc_mul_a (ecc, P2, u2, pp, u2 + ecc->p.size);
+  if (!ecc_nonsec_mul_gt (ecc, P, u1, u2, tp, scratch_out))
+    return 0;
+
+  return ecc_ecdsa_check_x (ecc, P, rp, scratch_out);
+#undef sinv
+#undef P
+#undef u1
+#undef u2
+#undef hp
+#undef scratch_out
+}
 
-  /* u = 0 can happen only if h = 0 or h = q, which is extremely
-     unlikely. */
-  if (!mpn_zero_p (u1, ecc->p.size))
-    {
-      /* Total storage: 7*ecc->p.size + ECC_MUL_G_ITCH */
-      ecc_mul_g (ecc, P1, u1, P1 + 3*ecc->p.size);
+mp_size_t
+ecc_ecdsa_verify_batch_itch (const struct ecc_curve *ecc, size_t n)
+{
+  return (n+1)*ecc->p.size + ecc_ecdsa_verify_itch (ecc);
+}
 
-      /* Total storage: 6*ecc->p.size + ECC_ADD_JJJ_ITCH */
-      if (!ecc_nonsec_add_jjj (ecc, P2, P2, P1, P1 + 3*ecc->p.size))
-	/* Infinity point, not a valid signature. */
-	return 0;
+int
+ecc_ecdsa_verify_batch (const struct ecc_curve *ecc,
+			size_t n, const mp_limb_t *pp,
+			const size_t *length, const uint8_t * const *digest,
+			const mp_limb_t *rp, const mp_limb_t *sp,
+			int *valid, mp_limb_t *scratch)
+{
+  /* All the inversions s_i^{-1} are computed using a single
+     inversion (Montgomery's trick): With prefix products c_i = s_0
+     ... s_i, we get s_i^{-1} = c_{i-1} c_i^{-1}, and c_{i-1}^{-1} =
+     s_i c_i^{-1}. */
+  mp_size_t size = ecc->p.size;
+  size_t i;
+  int res;
+
+#define cp scratch
+#define inv (scratch + n*size)
+#define sinv (scratch + (n+1)*size)
+#define tp (scratch + (n+2)*size)
+#define scratch_out (scratch + (n+2)*size)
+
+  if (n == 0)
+    return 1;
+
+  /* Signatures with r or s out of range are excluded from the
+     products, by reusing the previous one. */
+  mpn_zero (inv, size);
+  inv[0] = 1;
+  for (i = 0; i < n; i++)
+    {
+      if (ecdsa_in_range (ecc, rp + i*size)
+	  && ecdsa_in_range (ecc, sp + i*size))
+	ecc_mod_mul_canonical (&ecc->q, inv, inv, sp + i*size, tp);
+      mpn_copyi (cp + i*size, inv, size);
     }
-  /* x coordinate only, modulo q */
-  ecc_j_to_a (ecc, 2, P1, P2, P1 + 3*ecc->p.size);
+  ecc->q.invert (&ecc->q, inv, cp + (n-1)*size, scratch_out);
 
-  return (mpn_cmp (rp, P1, ecc->p.size) == 0);
-#undef P2
-#undef P1
+  for (i = n, res = 1; i-- > 0; )
+    {
+      int ok;
+      if (!ecdsa_in_range (ecc, rp + i*size)
+	  || !ecdsa_in_range (ecc, sp + i*size))
+	ok = 0;
+      else
+	{
+	  if (i > 0)
+	    {
+	      ecc_mod_mul_canonical (&ecc->q, sinv, inv, cp + (i-1)*size, tp);
+	      ecc_mod_mul_canonical (&ecc->q, inv, inv, sp + i*size, tp);
+	    }
+	  else
+	    mpn_copyi (sinv, inv, size);
+
+	  ok = ecdsa_verify_sinv (ecc, pp + 2*i*size, length[i], digest[i],
+				  rp + i*size, sinv, scratch_out);
+	}
+      res &= ok;
+      if (valid)
+	valid[i] = ok;
+      else if (!ok)
+	break;
+    }
+  return res;
+#undef cp
+#undef inv
 #undef sinv
-#undef u2
-#undef hp
-#undef u1
+#undef tp
+#undef scratch_out
 }
@@ -38,6 +38,27 @@
 #include "ecc.h"
 #include "ecc-internal.h"
 
+/* Completes the conversion, with 1/z already stored at scratch. Needs
+   3*size scratch. */
+static void
+eh_to_a_iz (const struct ecc_curve *ecc,
+	    mp_limb_t *r, const mp_limb_t *p,
+	    mp_limb_t *scratch)
+{
+#define izp scratch
+#define tp (scratch + ecc->p.size)
+
+#define xp p
+#define yp (p + ecc->p.size)
+
+  ecc_mod_mul_canonical (&ecc->p, r, xp, izp, tp);
+  ecc_mod_mul_canonical (&ecc->p, r + ecc->p.size, yp, izp, tp);
+#undef izp
+#undef tp
+#undef xp
+#undef yp
+}
+
 /* Convert from homogeneous coordinates on the Edwards curve to affine
    coordinates. */
 void
@@ -46,18 +67,33 @@ ecc_eh_to_a (const struct ecc_curve *ecc,
 	     mp_limb_t *r, const mp_limb_t *p,
 	     mp_limb_t *scratch)
 {
-#define izp scratch
-#define tp (scratch + ecc->p.size)
-
-#define xp p
-#define yp (p + ecc->p.size)
-#define zp (p + 2*ecc->p.size)
-
   assert(op == 0);
 
   /* Needs size + scratch for the invert call. */
-  ecc->p.invert (&ecc->p, izp, zp, tp);
+  ecc->p.invert (&ecc->p, scratch, p + 2*ecc->p.size, scratch + ecc->p.size);
+  eh_to_a_iz (ecc, r, p, scratch);
+}
 
-  ecc_mod_mul_canonical (&ecc->p, r, xp, izp, tp);
-  ecc_mod_mul_canonical (&ecc->p, r + ecc->p.size, yp, izp, tp);
+void
+ecc_eh_to_a_batch (const struct ecc_curve *ecc,
+		   int op, size_t n,
+		   mp_limb_t *r, const mp_limb_t *p,
+		   mp_limb_t *scratch)
+{
+  mp_size_t size = ecc->p.size;
+  size_t i;
+
+#define izp scratch
+#define scratch_out (scratch + n*size)
+
+  assert(op == 0);
+
+  ecc_mod_inv_batch (&ecc->p, n, izp, p + 2*size, 3*size, scratch_out);
+  for (i = 0; i < n; i++)
+    {
+      mpn_copyi (scratch_out, izp + i*size, size);
+      eh_to_a_iz (ecc, r + 2*i*size, p + 3*i*size, scratch_out);
+    }
+#undef izp
+#undef scratch_out
 }
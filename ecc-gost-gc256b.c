@@ -80,6 +80,8 @@ const struct ecc_curve _nettle_gost_gc256b =
     ecc_mod_inv,
     NULL,
     NULL,
+    NULL,
+    NULL,
   },
   {
     256,
@@ -102,6 +104,8 @@ const struct ecc_curve _nettle_gost_gc256b =
     ecc_mod_inv,
     NULL,
     NULL,
+    NULL,
+    NULL,
   },
 
   USE_REDC,
@@ -53,11 +53,11 @@ ecdsa_in_range (const struct ecc_curve *ecc, const mp_limb_t *xp)
 mp_size_t
 ecc_gostdsa_verify_itch (const struct ecc_curve *ecc)
 {
-  /* Largest storage need is for the ecc_mul_a call. */
-  return 5*ecc->p.size + ECC_MUL_A_ITCH (ecc->p.size);
+  /* Largest storage need is for the ecc_nonsec_mul_ga call. */
+  assert (ecc->q.invert_itch <= ECC_NONSEC_MUL_GA_ITCH (ecc->p.size));
+  return 5*ecc->p.size + ECC_NONSEC_MUL_GA_ITCH (ecc->p.size);
 }
 
-/* FIXME: Use faster primitives, not requiring side-channel silence. */
 int
 ecc_gostdsa_verify (const struct ecc_curve *ecc,
 		  const mp_limb_t *pp, /* Public key */
@@ -76,7 +76,7 @@ ecc_gostdsa_verify (const struct ecc_curve *ecc,
 
      4. z2  <-- -r * v (mod q)
 
-     5. R = u1 G + u2 Y
+     5. R = z1 G + z2 Y
 
      6. Signature is valid if R_x = r (mod q).
   */
@@ -86,9 +86,8 @@ ecc_gostdsa_verify (const struct ecc_curve *ecc,
 #define z1 (scratch + 3*ecc->p.size)
 #define z2 (scratch + 4*ecc->p.size)
 
-#define P1 (scratch + 4*ecc->p.size)
-#define P2 (scratch)
-
+#define P (scratch)
+#define scratch_out (scratch + 5*ecc->p.size)
 
   if (! (ecdsa_in_range (ecc, rp)
 	 && ecdsa_in_range (ecc, sp)))
@@ -102,29 +101,24 @@ ecc_gostdsa_verify (const struct ecc_curve *ecc,
   /* Compute v */
   ecc->q.invert (&ecc->q, vp, hp, vp + ecc->p.size);
 
-  /* z1 = s / h, P1 = z1 * G */
+  /* z1 = s / h */
   ecc_mod_mul_canonical (&ecc->q, z1, sp, vp, z1);
 
-  /* z2 = - r / h, P2 = z2 * Y */
+  /* z2 = - r / h */
   mpn_sub_n (hp, ecc->q.m, rp, ecc->p.size);
   ecc_mod_mul_canonical (&ecc->q, z2, hp, vp, z2);
 
-   /* Total storage: 5*ecc->p.size + ECC_MUL_A_ITCH */
-  ecc_mul_a (ecc, P2, z2, pp, z2 + ecc->p.size);
-
-  /* Total storage: 7*ecc->p.size + ECC_MUL_G_ITCH */
-  ecc_mul_g (ecc, P1, z1, P1 + 3*ecc->p.size);
-
-  /* Total storage: 6*ecc->p.size + ECC_ADD_JJJ_ITCH */
-  if (!ecc_nonsec_add_jjj (ecc, P1, P1, P2, P1 + 3*ecc->p.size))
+  /* Public scalars only, so use the variable time wNAF
+     multiplication. */
+  if (!ecc_nonsec_mul_ga (ecc, P, z1, z2, pp, scratch_out))
     return 0;
 
   /* x coordinate only, modulo q */
-  ecc_j_to_a (ecc, 2, P2, P1, P1 + 3*ecc->p.size);
+  ecc_j_to_a (ecc, 2, P, P, scratch_out);
 
-  return (mpn_cmp (rp, P2, ecc->p.size) == 0);
-#undef P2
-#undef P1
+  return (mpn_cmp (rp, P, ecc->p.size) == 0);
+#undef P
+#undef scratch_out
 #undef z2
 #undef z1
 #undef hp
@@ -58,13 +58,24 @@
 #define ecc_mod_random _nettle_ecc_mod_random
 #define ecc_mod _nettle_ecc_mod
 #define ecc_mod_inv _nettle_ecc_mod_inv
+#define ecc_mod_inv_safegcd _nettle_ecc_mod_inv_safegcd
+#define ecc_mod_inv_batch _nettle_ecc_mod_inv_batch
 #define ecc_a_to_j _nettle_ecc_a_to_j
 #define ecc_j_to_a _nettle_ecc_j_to_a
 #define ecc_eh_to_a _nettle_ecc_eh_to_a
+#define ecc_j_to_a_batch _nettle_ecc_j_to_a_batch
+#define ecc_eh_to_a_batch _nettle_ecc_eh_to_a_batch
 #define ecc_dup_jj _nettle_ecc_dup_jj
 #define ecc_add_jja _nettle_ecc_add_jja
 #define ecc_add_jjj _nettle_ecc_add_jjj
 #define ecc_nonsec_add_jjj _nettle_ecc_nonsec_add_jjj
+#define ecc_nonsec_add_jja _nettle_ecc_nonsec_add_jja
+#define ecc_nonsec_mul_ga _nettle_ecc_nonsec_mul_ga
+#define ecc_nonsec_mul_ga_eh _nettle_ecc_nonsec_mul_ga_eh
+#define ecc_nonsec_table_init _nettle_ecc_nonsec_table_init
+#define ecc_nonsec_mul_gt _nettle_ecc_nonsec_mul_gt
+#define ecc_ecdsa_check_x _nettle_ecc_ecdsa_check_x
+#define ecc_wnaf _nettle_ecc_wnaf
 #define ecc_dup_eh _nettle_ecc_dup_eh
 #define ecc_add_eh _nettle_ecc_add_eh
 #define ecc_add_ehh _nettle_ecc_add_ehh
@@ -76,6 +87,7 @@
 #define ecc_mul_g_eh _nettle_ecc_mul_g_eh
 #define ecc_mul_a_eh _nettle_ecc_mul_a_eh
 #define ecc_mul_m _nettle_ecc_mul_m
+#define ecc_mul_m_batch _nettle_ecc_mul_m_batch
 #define cnd_copy _nettle_cnd_copy
 #define sec_add_1 _nettle_sec_add_1
 #define sec_sub_1 _nettle_sec_sub_1
@@ -118,6 +130,18 @@ extern const struct ecc_curve _nettle_gost_gc512a;
 #define ECC_MUL_A_WBITS 4
 /* And for ecc_mul_a_eh */
 #define ECC_MUL_A_EH_WBITS 4
+/* Window size for the variable time wNAF multiplication,
+   ecc_nonsec_mul_ga. Tables hold 2^{ECC_NONSEC_WBITS - 2} odd
+   multiples per point. */
+#define ECC_NONSEC_WBITS 5
+/* Parameters for the precomputed tables of ecc_nonsec_mul_gt. Each
+   scalar is split into ECC_NONSEC_TABLE_PARTS parts, sharing the
+   doublings, and each part uses a table of 2^{ECC_NONSEC_TABLE_WBITS
+   - 2} odd multiples, for both the generator and the other point. */
+#define ECC_NONSEC_TABLE_WBITS 6
+#define ECC_NONSEC_TABLE_PARTS 4
+#define ECC_NONSEC_TABLE_POINTS \
+  (2*ECC_NONSEC_TABLE_PARTS << (ECC_NONSEC_TABLE_WBITS - 2))
 
 struct ecc_modulo;
 
@@ -128,6 +152,14 @@ struct ecc_modulo;
    allowed. */
 typedef void ecc_mod_func (const struct ecc_modulo *m, mp_limb_t *rp, mp_limb_t *xp);
 
+/* Fused multiplication and reduction, with the same requirements on
+   input and output areas as ecc_mod_mul and ecc_mod_sqr below. */
+typedef void ecc_mod_mul_func (const struct ecc_modulo *m, mp_limb_t *rp,
+			       const mp_limb_t *ap, const mp_limb_t *bp,
+			       mp_limb_t *tp);
+typedef void ecc_mod_sqr_func (const struct ecc_modulo *m, mp_limb_t *rp,
+			       const mp_limb_t *ap, mp_limb_t *tp);
+
 typedef void ecc_mod_inv_func (const struct ecc_modulo *m,
 			       mp_limb_t *vp, const mp_limb_t *ap,
 			       mp_limb_t *scratch);
@@ -200,6 +232,10 @@ struct ecc_modulo
   ecc_mod_inv_func *invert;
   ecc_mod_sqrt_func *sqrt;
   ecc_mod_sqrt_ratio_func *sqrt_ratio;
+  /* Optional, used by ecc_mod_mul and ecc_mod_sqr in place of
+     mpn_mul_n or mpn_sqr followed by reduce, when non-NULL. */
+  ecc_mod_mul_func *mul;
+  ecc_mod_sqr_func *sqr;
 };
 
 /* Represents an elliptic curve of the form
@@ -257,6 +293,20 @@ ecc_mod_func ecc_pm1_redc;
 
 ecc_mod_inv_func ecc_mod_inv;
 
+/* Constant time inversion using the Bernstein-Yang divstep
+   iteration. Output is canonical, and zero if a == 0 (mod m). */
+ecc_mod_inv_func ecc_mod_inv_safegcd;
+
+/* Inverts the n elements at ap, ap + stride, ..., ap + (n-1) stride,
+   writing the canonical inverses at rp, rp + size, ..., using a
+   single call to m->invert. Inputs must be less than 2m. Like
+   m->invert, zero inputs give zero outputs. The output must not
+   overlap the input. Needs 2*size + m->invert_itch scratch. */
+void
+ecc_mod_inv_batch (const struct ecc_modulo *m, size_t n,
+		   mp_limb_t *rp, const mp_limb_t *ap, mp_size_t stride,
+		   mp_limb_t *scratch);
+
 /* Side channel silent. Requires that x < 2m, so checks if x == 0 or x == p */
 int
 ecc_mod_zero_p (const struct ecc_modulo *m, const mp_limb_t *xp);
@@ -359,6 +409,21 @@ ecc_eh_to_a (const struct ecc_curve *ecc,
 	     mp_limb_t *r, const mp_limb_t *p,
 	     mp_limb_t *scratch);
 
+/* Like ecc_j_to_a and ecc_eh_to_a, but converts the n points at p, p
+   + 3*size, ..., writing the outputs at r, r + 2*size, ..., sharing a
+   single inversion. Needs n*size + ecc->h_to_a_itch + size
+   scratch. */
+void
+ecc_j_to_a_batch (const struct ecc_curve *ecc,
+		  int op, size_t n,
+		  mp_limb_t *r, const mp_limb_t *p,
+		  mp_limb_t *scratch);
+void
+ecc_eh_to_a_batch (const struct ecc_curve *ecc,
+		   int op, size_t n,
+		   mp_limb_t *r, const mp_limb_t *p,
+		   mp_limb_t *scratch);
+
 /* Group operations */
 
 /* Point doubling, with jacobian input and output. Corner cases:
@@ -394,6 +459,72 @@ ecc_nonsec_add_jjj (const struct ecc_curve *ecc,
 		    mp_limb_t *r, const mp_limb_t *p, const mp_limb_t *q,
 		    mp_limb_t *scratch);
 
+/* Like ecc_nonsec_add_jjj, but with q in affine coordinates, using
+   the internal representation. */
+int
+ecc_nonsec_add_jja (const struct ecc_curve *ecc,
+		    mp_limb_t *r, const mp_limb_t *p, const mp_limb_t *q,
+		    mp_limb_t *scratch);
+
+/* Recodes the number N, of size limbs, into width-w non-adjacent
+   form: digits are zero or odd, with absolute value less than
+   2^{w-1}, and each non-zero digit is followed by at least w-1 zero
+   digits. Writes size * GMP_NUMB_BITS + 1 digits at dp, least
+   significant first, and returns the number of digits up to and
+   including the most significant non-zero one. Not side-channel
+   silent. */
+unsigned
+ecc_wnaf (signed char *dp, unsigned w,
+	  const mp_limb_t *np, mp_size_t size);
+
+/* Computes R = N1 G + N2 P, using interleaved wNAF multiplication
+   with shared doublings. P must be a non-zero point in affine
+   coordinates, and the output is in jacobian coordinates. Returns 1
+   on success, 0 if the result is the point at infinity. Not
+   side-channel silent, so must be used only with public scalars, as
+   in signature verification. */
+int
+ecc_nonsec_mul_ga (const struct ecc_curve *ecc, mp_limb_t *r,
+		   const mp_limb_t *n1p, const mp_limb_t *n2p,
+		   const mp_limb_t *p, mp_limb_t *scratch);
+
+/* Edwards curve variant of ecc_nonsec_mul_ga, using the curve's
+   complete addition and doubling functions. The scalars are of size
+   ecc->q.size, P is in affine coordinates, and the output is in
+   homogeneous coordinates. Not side-channel silent. */
+void
+ecc_nonsec_mul_ga_eh (const struct ecc_curve *ecc, mp_limb_t *r,
+		      const mp_limb_t *n1p, const mp_limb_t *n2p,
+		      const mp_limb_t *p, mp_limb_t *scratch);
+
+/* Computes the table used by ecc_nonsec_mul_gt, for the generator
+   and the affine point P. The table, of size
+   ECC_NONSEC_TABLE_SIZE, holds the points in affine coordinates.
+   Works for both Weierstrass and Edwards curves. */
+void
+ecc_nonsec_table_init (const struct ecc_curve *ecc, mp_limb_t *T,
+		       const mp_limb_t *p, mp_limb_t *scratch);
+
+/* Computes R = N1 G + N2 P, with the table T precomputed by
+   ecc_nonsec_table_init. The scalars are of size ecc->q.size, and
+   must be less than 2^{q.bit_size}. The output is in jacobian or
+   homogeneous coordinates. Returns 1 on success, 0 if the result is
+   the point at infinity (never for Edwards curves). Not side-channel
+   silent. */
+int
+ecc_nonsec_mul_gt (const struct ecc_curve *ecc, mp_limb_t *r,
+		   const mp_limb_t *n1p, const mp_limb_t *n2p,
+		   const mp_limb_t *T, mp_limb_t *scratch);
+
+/* Checks if the x coordinate of the jacobian point P, reduced modulo
+   q, equals r, as the final step of ECDSA verification. Returns 0 if
+   P is the point at infinity, Z = 0. Needs 6*size limbs of scratch
+   space. */
+int
+ecc_ecdsa_check_x (const struct ecc_curve *ecc,
+		   const mp_limb_t *P, const mp_limb_t *rp,
+		   mp_limb_t *scratch);
+
 /* Point doubling on a twisted Edwards curve, with homogeneous
    cooordinates. */
 void
@@ -460,6 +591,16 @@ ecc_mul_m (const struct ecc_modulo *m,
 	   mp_limb_t *qx, const uint8_t *n, const mp_limb_t *px,
 	   mp_limb_t *scratch);
 
+/* Like ecc_mul_m, for count inputs px + i*size and scalars n +
+   i*(1 + bit_high/8), with a single inversion for all the outputs
+   qx + i*size. */
+void
+ecc_mul_m_batch (const struct ecc_modulo *m,
+		 mp_limb_t a24,
+		 unsigned bit_low, unsigned bit_high, size_t count,
+		 mp_limb_t *qx, const uint8_t *n, const mp_limb_t *px,
+		 mp_limb_t *scratch);
+
 /* The cnd argument must be 1 or 0. */
 void
 cnd_copy (int cnd, mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n);
@@ -480,6 +621,7 @@ curve448_eh_to_x (mp_limb_t *xp, const mp_limb_t *p,
 
 /* Current scratch needs: */
 #define ECC_MOD_INV_ITCH(size) (3*(size))
+#define ECC_MOD_INV_SAFEGCD_ITCH(size) (5*(size) + 5)
 #define ECC_J_TO_A_ITCH(size, inv) ((size)+(inv))
 #define ECC_EH_TO_A_ITCH(size, inv) ((size)+(inv))
 #define ECC_DUP_JJ_ITCH(size) (4*(size))
@@ -505,7 +647,22 @@ curve448_eh_to_x (mp_limb_t *xp, const mp_limb_t *p,
 #define ECC_MUL_A_EH_ITCH(size) \
   (((3 << ECC_MUL_A_EH_WBITS) + 7) * (size))
 #endif
-#define ECC_MUL_M_ITCH(size) (8*(size))
+/* Includes two digit arrays for ecc_wnaf, each using 8*size + 1
+   limbs. */
+#define ECC_NONSEC_MUL_GA_ITCH(size) \
+  (((6 << (ECC_NONSEC_WBITS - 2)) + 24) * (size) + 2)
+#define ECC_NONSEC_MUL_GA_EH_ITCH(size) \
+  (((6 << (ECC_NONSEC_WBITS - 2)) + 23) * (size) + 2)
+#define ECC_NONSEC_ADD_JJA_ITCH(size) (7*(size))
+#define ECC_NONSEC_TABLE_SIZE(size) (2*ECC_NONSEC_TABLE_POINTS*(size))
+#define ECC_NONSEC_TABLE_INIT_ITCH(ecc) \
+  ((4*ECC_NONSEC_TABLE_POINTS + 1) * (ecc)->p.size + (ecc)->h_to_a_itch)
+#define ECC_NONSEC_MUL_GT_ITCH(size) (25*(size) + 2)
+/* Also large enough for inversion using z3 and the following
+   limbs. */
+#define ECC_MUL_M_ITCH(size) (3*(size) + ECC_MOD_INV_SAFEGCD_ITCH (size))
+#define ECC_MUL_M_BATCH_ITCH(size, count) \
+  (3*(count)*(size) + ECC_MUL_M_ITCH (size))
 #define ECC_ECDSA_SIGN_ITCH(size) (11*(size))
 #define ECC_GOSTDSA_SIGN_ITCH(size) (11*(size))
 #define ECC_MOD_RANDOM_ITCH(size) (size)
@@ -38,18 +38,19 @@
 #include "ecc.h"
 #include "ecc-internal.h"
 
-void
-ecc_j_to_a (const struct ecc_curve *ecc,
-	    int op,
-	    mp_limb_t *r, const mp_limb_t *p,
-	    mp_limb_t *scratch)
+/* Completes the conversion, with 1/z already stored at scratch. Needs
+   4*size scratch. */
+static void
+j_to_a_iz (const struct ecc_curve *ecc,
+	   int op,
+	   mp_limb_t *r, const mp_limb_t *p,
+	   mp_limb_t *scratch)
 {
 #define izp   scratch
 #define iz2p (scratch + ecc->p.size)
 #define iz3p (scratch + 2*ecc->p.size)
 #define tp    scratch
 
-  ecc->p.invert (&ecc->p, izp, p+2*ecc->p.size, izp + ecc->p.size);
   ecc_mod_sqr (&ecc->p, iz2p, izp, iz2p);
 
   if (ecc->use_redc)
@@ -84,3 +85,35 @@ ecc_j_to_a (const struct ecc_curve *ecc,
 #undef iz3p
 #undef tp
 }
+
+void
+ecc_j_to_a (const struct ecc_curve *ecc,
+	    int op,
+	    mp_limb_t *r, const mp_limb_t *p,
+	    mp_limb_t *scratch)
+{
+  ecc->p.invert (&ecc->p, scratch, p+2*ecc->p.size, scratch + ecc->p.size);
+  j_to_a_iz (ecc, op, r, p, scratch);
+}
+
+void
+ecc_j_to_a_batch (const struct ecc_curve *ecc,
+		  int op, size_t n,
+		  mp_limb_t *r, const mp_limb_t *p,
+		  mp_limb_t *scratch)
+{
+  mp_size_t size = ecc->p.size;
+  size_t i;
+
+#define izp scratch
+#define scratch_out (scratch + n*size)
+
+  ecc_mod_inv_batch (&ecc->p, n, izp, p + 2*size, 3*size, scratch_out);
+  for (i = 0; i < n; i++)
+    {
+      mpn_copyi (scratch_out, izp + i*size, size);
+      j_to_a_iz (ecc, op, r + 2*i*size, p + 3*i*size, scratch_out);
+    }
+#undef izp
+#undef scratch_out
+}
@@ -152,16 +152,26 @@ void
 ecc_mod_mul (const struct ecc_modulo *m, mp_limb_t *rp,
 	     const mp_limb_t *ap, const mp_limb_t *bp, mp_limb_t *tp)
 {
-  mpn_mul_n (tp, ap, bp, m->size);
-  m->reduce (m, rp, tp);
+  if (m->mul)
+    m->mul (m, rp, ap, bp, tp);
+  else
+    {
+      mpn_mul_n (tp, ap, bp, m->size);
+      m->reduce (m, rp, tp);
+    }
 }
 
 void
 ecc_mod_sqr (const struct ecc_modulo *m, mp_limb_t *rp,
 	     const mp_limb_t *ap, mp_limb_t *tp)
 {
-  mpn_sqr (tp, ap, m->size);
-  m->reduce (m, rp, tp);
+  if (m->sqr)
+    m->sqr (m, rp, ap, tp);
+  else
+    {
+      mpn_sqr (tp, ap, m->size);
+      m->reduce (m, rp, tp);
+    }
 }
 
 void
@@ -169,8 +179,13 @@ ecc_mod_mul_canonical (const struct ecc_modulo *m, mp_limb_t *rp,
 		       const mp_limb_t *ap, const mp_limb_t *bp, mp_limb_t *tp)
 {
   mp_limb_t cy;
-  mpn_mul_n (tp, ap, bp, m->size);
-  m->reduce (m, tp + m->size, tp);
+  if (m->mul)
+    m->mul (m, tp + m->size, ap, bp, tp);
+  else
+    {
+      mpn_mul_n (tp, ap, bp, m->size);
+      m->reduce (m, tp + m->size, tp);
+    }
 
   cy = mpn_sub_n (rp, tp + m->size, m->m, m->size);
   cnd_copy (cy, rp, tp + m->size, m->size);
@@ -181,8 +196,13 @@ ecc_mod_sqr_canonical (const struct ecc_modulo *m, mp_limb_t *rp,
 		       const mp_limb_t *ap, mp_limb_t *tp)
 {
   mp_limb_t cy;
-  mpn_sqr (tp, ap, m->size);
-  m->reduce (m, tp + m->size, tp);
+  if (m->sqr)
+    m->sqr (m, tp + m->size, ap, tp);
+  else
+    {
+      mpn_sqr (tp, ap, m->size);
+      m->reduce (m, tp + m->size, tp);
+    }
 
   cy = mpn_sub_n (rp, tp + m->size, m->m, m->size);
   cnd_copy (cy, rp, tp + m->size, m->size);
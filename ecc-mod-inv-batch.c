@@ -0,0 +1,103 @@
+/* ecc-mod-inv-batch.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include "ecc-internal.h"
+
+/* Replaces a zero input by 1, so that it doesn't spoil the product
+   of all inputs. Returns one if the input was zero. */
+static int
+nonzero_input (const struct ecc_modulo *m,
+	       mp_limb_t *tp, const mp_limb_t *ap)
+{
+  int is_zero = ecc_mod_zero_p (m, ap);
+  mpn_copyi (tp, ap, m->size);
+  tp[0] |= is_zero;
+  return is_zero;
+}
+
+void
+ecc_mod_inv_batch (const struct ecc_modulo *m, size_t n,
+		   mp_limb_t *rp, const mp_limb_t *ap, mp_size_t stride,
+		   mp_limb_t *scratch)
+{
+  /* Uses Montgomery's trick: With prefix products c_i = a_0 ... a_i,
+     stored at rp, we get a_i^{-1} = c_{i-1} c_i^{-1}, and
+     c_{i-1}^{-1} = a_i c_i^{-1}. */
+  mp_size_t size = m->size;
+  size_t i, j;
+
+#define inv scratch
+#define ai (scratch + size)
+#define tp (scratch + 2*size)
+
+  assert (n > 0);
+  assert (m->invert_itch >= 2*size);
+
+  nonzero_input (m, rp, ap);
+  for (i = 1; i < n; i++)
+    {
+      nonzero_input (m, ai, ap + i*stride);
+      ecc_mod_mul (m, rp + i*size, rp + (i-1)*size, ai, tp);
+    }
+
+  m->invert (m, inv, rp + (n-1)*size, tp);
+
+  for (i = n; i-- > 0; )
+    {
+      mp_limb_t mask = - (mp_limb_t) (1 - nonzero_input (m, ai, ap + i*stride));
+      if (i > 0)
+	{
+	  ecc_mod_mul_canonical (m, rp + i*size, inv, rp + (i-1)*size, tp);
+	  ecc_mod_mul (m, inv, inv, ai, tp);
+	}
+      else
+	{
+	  /* Output from m->invert or ecc_mod_mul is reduced only below
+	     2m. */
+	  mp_limb_t cy = mpn_sub_n (rp, inv, m->m, size);
+	  cnd_copy (cy, rp, inv, size);
+	}
+
+      /* Zero inputs get zero output, like for m->invert. */
+      for (j = 0; j < size; j++)
+	rp[i*size + j] &= mask;
+    }
+#undef inv
+#undef ai
+#undef tp
+}
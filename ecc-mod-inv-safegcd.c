@@ -0,0 +1,234 @@
+/* ecc-mod-inv-safegcd.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ecc-internal.h"
+
+/* Constant time inversion using the divstep iteration of Bernstein
+   and Yang, "Fast constant-time gcd computation and modular
+   inversion", https://eprint.iacr.org/2019/266.
+
+   The iteration is applied to f = m, g = a, and it is split into
+   batches of DIVSTEP_BATCH steps. Each batch depends only on the low
+   limbs of f and g, and produces a transition matrix, with entries of
+   at most DIVSTEP_BATCH bits, which is then applied to the full
+   numbers. The same matrix is applied to d and e, with f = d a and g
+   = e a (mod m). Signed numbers are represented in two's complement,
+   using size + 1 limbs. */
+
+#define DIVSTEP_BATCH (GMP_NUMB_BITS - 2)
+#define HIGH_BIT(x) ((x) >> (GMP_NUMB_BITS - 1))
+
+/* Applies DIVSTEP_BATCH divsteps to the low limbs f and g. Returns the
+   new delta, and the transition matrix (u, v, q, r), scaled by
+   2^DIVSTEP_BATCH, in t. */
+static mp_limb_t
+divsteps (mp_limb_t delta, mp_limb_t f, mp_limb_t g, mp_limb_t *t)
+{
+  mp_limb_t u = 1, v = 0, q = 0, r = 1;
+  unsigned i;
+
+  for (i = 0; i < DIVSTEP_BATCH; i++)
+    {
+      /* If delta > 0 and g odd,
+
+	   (delta, f, g) <-- (1 - delta, g, (g - f)/2)
+
+	 otherwise,
+
+	   (delta, f, g) <-- (1 + delta, f, (g + (g mod 2) f) / 2)
+
+	 The first case is done as a conditional (f, g) <-- (g, -f),
+	 delta <-- -delta, followed by the second case. */
+      mp_limb_t odd = -(g & 1);
+      mp_limb_t swap = odd & -HIGH_BIT (-delta);
+      mp_limb_t x;
+
+      x = (f ^ g) & swap; f ^= x; g ^= x;
+      g = (g ^ swap) - swap;
+      x = (u ^ q) & swap; u ^= x; q ^= x;
+      q = (q ^ swap) - swap;
+      x = (v ^ r) & swap; v ^= x; r ^= x;
+      r = (r ^ swap) - swap;
+      delta = (delta ^ swap) - swap;
+
+      g += f & odd; q += u & odd; r += v & odd;
+      g >>= 1; u <<= 1; v <<= 1;
+      delta++;
+    }
+  t[0] = u; t[1] = v; t[2] = q; t[3] = r;
+  return delta;
+}
+
+static void
+cnd_neg (mp_limb_t cnd, mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n)
+{
+  mp_limb_t cy = (cnd != 0);
+  mp_limb_t mask = -cy;
+  mp_size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      mp_limb_t r = (ap[i] ^ mask) + cy;
+      cy = r < cy;
+      rp[i] = r;
+    }
+}
+
+/* Computes r = s a + t b (mod B^n), with signed s and t. The output
+   may overlap b, but not a. The input a is temporarily negated, if t
+   is negative, and then restored. */
+static void
+lincomb (mp_limb_t *rp, mp_size_t n,
+	 mp_limb_t *ap, mp_limb_t s, const mp_limb_t *bp, mp_limb_t t)
+{
+  mp_limb_t s_sign = -HIGH_BIT (s);
+  mp_limb_t t_sign = -HIGH_BIT (t);
+
+  mpn_mul_1 (rp, bp, n, (t ^ t_sign) - t_sign);
+  cnd_neg (t_sign, rp, rp, n);
+  cnd_neg (s_sign, ap, ap, n);
+  mpn_addmul_1 (rp, ap, n, (s ^ s_sign) - s_sign);
+  cnd_neg (s_sign, ap, ap, n);
+}
+
+/* Arithmetic right shift by DIVSTEP_BATCH bits. */
+static void
+shift_batch (mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n)
+{
+  mp_limb_t sign = -HIGH_BIT (ap[n-1]);
+  mpn_rshift (rp, ap, n, DIVSTEP_BATCH);
+  rp[n-1] |= sign << (GMP_NUMB_BITS - DIVSTEP_BATCH);
+}
+
+/* Computes (s a + t b) / 2^DIVSTEP_BATCH (mod m), where mi = -1/m mod
+   B, for a, b in the range 0 <= a, b < m. The output is in the same
+   range. */
+static void
+update_de (const struct ecc_modulo *m, mp_limb_t mi,
+	   mp_limb_t *rp, mp_limb_t *ap, mp_limb_t s,
+	   const mp_limb_t *bp, mp_limb_t t)
+{
+  mp_size_t n = m->size;
+  mp_limb_t md, cy;
+  unsigned i;
+
+  lincomb (rp, n + 1, ap, s, bp, t);
+  /* Add a multiple of m to make the low bits zero. */
+  md = (rp[0] * mi) & (((mp_limb_t) 1 << DIVSTEP_BATCH) - 1);
+  rp[n] += mpn_addmul_1 (rp, m->m, n, md);
+  shift_batch (rp, rp, n + 1);
+
+  /* The result is in the range -2m < r < 2m, reduce to 0 <= r < m. */
+  for (i = 0; i < 2; i++)
+    {
+      mp_limb_t neg = HIGH_BIT (rp[n]);
+      rp[n] += mpn_cnd_add_n (neg, rp, rp, m->m, n);
+    }
+  cy = mpn_sub_n (rp, rp, m->m, n);
+  cy = (rp[n] - cy) >> (GMP_NUMB_BITS - 1);
+  mpn_cnd_add_n (cy, rp, rp, m->m, n);
+  rp[n] = 0;
+}
+
+/* Compute a^{-1} mod m, with running time depending only on the size.
+   Returns zero if a == 0 (mod m). m must be odd. Input and output
+   may overlap. */
+void
+ecc_mod_inv_safegcd (const struct ecc_modulo *m,
+		     mp_limb_t *vp, const mp_limb_t *in_ap,
+		     mp_limb_t *scratch)
+{
+  mp_size_t n = m->size;
+  mp_limb_t mi, delta, is_unit, f_sign;
+  mp_limb_t t[4];
+  unsigned bits, steps, i;
+
+#define fp scratch
+#define gp (scratch + (n+1))
+#define dp (scratch + 2*(n+1))
+#define ep (scratch + 3*(n+1))
+#define t0 (scratch + 4*(n+1))
+
+  /* Newton iteration for 1/m mod B, starting with 5 correct bits. */
+  for (mi = (3*m->m[0]) ^ 2, i = 0; i < 4; i++)
+    mi *= 2 - m->m[0] * mi;
+  mi = -mi;
+
+  mpn_copyi (fp, m->m, n);
+  fp[n] = 0;
+  mpn_copyi (gp, in_ap, n);
+  gp[n] = 0;
+  mpn_zero (dp, n+1);
+  mpn_zero (ep, n+1);
+  ep[0] = 1;
+
+  /* Number of divsteps sufficient for any inputs of size bits, from
+     Theorem 11.2 of the paper. */
+  bits = n * GMP_NUMB_BITS;
+  steps = (49 * bits + (bits < 46 ? 80 : 57)) / 17;
+
+  for (delta = 1, i = 0; i < steps; i += DIVSTEP_BATCH)
+    {
+      delta = divsteps (delta, fp[0], gp[0], t);
+
+      lincomb (t0, n+1, fp, t[0], gp, t[1]);
+      lincomb (gp, n+1, fp, t[2], gp, t[3]);
+      shift_batch (fp, t0, n+1);
+      shift_batch (gp, gp, n+1);
+
+      update_de (m, mi, t0, dp, t[0], ep, t[1]);
+      update_de (m, mi, ep, dp, t[2], ep, t[3]);
+      mpn_copyi (dp, t0, n+1);
+    }
+
+  /* Now g = 0 and f = ±gcd(a, m), and if f = ±1, the inverse is ±d. */
+  f_sign = HIGH_BIT (fp[n]);
+  cnd_neg (f_sign, fp, fp, n+1);
+  for (is_unit = fp[0] ^ 1, i = 1; i <= n; i++)
+    is_unit |= fp[i];
+  is_unit = HIGH_BIT (is_unit | -is_unit) ^ 1;
+
+  mpn_sub_n (t0, m->m, dp, n);
+  cnd_copy (f_sign, dp, t0, n);
+  for (i = 0; i < n; i++)
+    vp[i] = dp[i] & -is_unit;
+
+#undef fp
+#undef gp
+#undef dp
+#undef ep
+#undef t0
+}
@@ -40,12 +40,14 @@
 #include "ecc.h"
 #include "ecc-internal.h"
 
-void
-ecc_mul_m (const struct ecc_modulo *m,
-	   mp_limb_t a24,
-	   unsigned bit_low, unsigned bit_high,
-	   mp_limb_t *qx, const uint8_t *n, const mp_limb_t *px,
-	   mp_limb_t *scratch)
+/* Runs the Montgomery ladder, leaving the projective coordinates x2,
+   z2 of the result at scratch. Needs 8*size scratch. */
+static void
+mul_m_ladder (const struct ecc_modulo *m,
+	      mp_limb_t a24,
+	      unsigned bit_low, unsigned bit_high,
+	      const uint8_t *n, const mp_limb_t *px,
+	      mp_limb_t *scratch)
 {
   unsigned i;
   mp_limb_t swap;
@@ -160,7 +162,53 @@ ecc_mul_m (const struct ecc_modulo *m,
       ecc_mod_addmul_1 (m, AA, E, a24);
       ecc_mod_mul (m, z2, E, AA, tp);
     }
-  assert (m->invert_itch <= 7 * m->size);
-  m->invert (m, x3, z2, z3 + m->size);
+}
+
+void
+ecc_mul_m (const struct ecc_modulo *m,
+	   mp_limb_t a24,
+	   unsigned bit_low, unsigned bit_high,
+	   mp_limb_t *qx, const uint8_t *n, const mp_limb_t *px,
+	   mp_limb_t *scratch)
+{
+  mul_m_ladder (m, a24, bit_low, bit_high, n, px, scratch);
+
+  assert (m->invert_itch <= ECC_MUL_M_ITCH (m->size) - 3*m->size);
+  m->invert (m, x3, z2, z3);
   ecc_mod_mul_canonical (m, qx, x2, x3, z3);
 }
+
+void
+ecc_mul_m_batch (const struct ecc_modulo *m,
+		 mp_limb_t a24,
+		 unsigned bit_low, unsigned bit_high, size_t count,
+		 mp_limb_t *qx, const uint8_t *n, const mp_limb_t *px,
+		 mp_limb_t *scratch)
+{
+  mp_size_t size = m->size;
+  size_t n_size = 1 + bit_high / 8;
+  size_t i;
+
+  /* Projective results (x_i, z_i) at xz + 2*i*size, and inverses of
+     all z_i at iz + i*size. */
+#define xz scratch
+#define iz (scratch + 2*count*size)
+#define scratch_out (scratch + 3*count*size)
+
+  for (i = 0; i < count; i++)
+    {
+      mul_m_ladder (m, a24, bit_low, bit_high,
+		    n + i*n_size, px + i*size, scratch_out);
+      mpn_copyi (xz + 2*i*size, scratch_out, 2*size);
+    }
+
+  assert (2*size + m->invert_itch <= ECC_MUL_M_ITCH (size));
+  ecc_mod_inv_batch (m, count, iz, xz + size, 2*size, scratch_out);
+
+  for (i = 0; i < count; i++)
+    ecc_mod_mul_canonical (m, qx + i*size, xz + 2*i*size, iz + i*size,
+			   scratch_out);
+#undef xz
+#undef iz
+#undef scratch_out
+}
@@ -0,0 +1,139 @@
+/* ecc-nonsec-add-jja.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ecc.h"
+#include "ecc-internal.h"
+
+/* Similar to ecc_add_jja, but checks if x coordinates are equal (H =
+   0), and if so, performs doubling if also y coordinates are equal,
+   or returns 0 (failure) indicating that the result is the infinity
+   point. The affine point q must use the internal representation,
+   as for the ecc_mul_g tables. */
+int
+ecc_nonsec_add_jja (const struct ecc_curve *ecc,
+		    mp_limb_t *r, const mp_limb_t *p, const mp_limb_t *q,
+		    mp_limb_t *scratch)
+{
+#define x1  p
+#define y1 (p + ecc->p.size)
+#define z1 (p + 2*ecc->p.size)
+#define x2  q
+#define y2 (q + ecc->p.size)
+
+#define x3  r
+#define y3 (r + ecc->p.size)
+#define z3 (r + 2*ecc->p.size)
+
+  /* Same formulas as ecc_add_jja, but with W computed before Z_3,
+     so that the special cases are detected before the output is
+     written. */
+#define zz  scratch
+#define h  (scratch + ecc->p.size)
+#define w (scratch + 2*ecc->p.size)
+#define hh zz
+#define i zz
+#define v zz
+#define j h
+#define tp (scratch + 3*ecc->p.size)
+
+  /* The coordinates of p are correct only mod p, and may be larger
+     than 2p. Like U1 = X1 Z2^2 and S1 = Y1 Z2^3 in ecc_nonsec_add_jjj,
+     with Z2 = 1, multiply them by one to get values < 2p, stored at
+     x3 and y3. This is fine also when r == p, since all return paths
+     below write the complete output. */
+  ecc_mod_mul (&ecc->p, x3, x1, ecc->unit, tp);
+  ecc_mod_mul (&ecc->p, y3, y1, ecc->unit, tp);
+#undef x1
+#undef y1
+#define u1 x3
+#define s1 y3
+
+  ecc_mod_sqr (&ecc->p, zz, z1, tp);	/* zz */
+  ecc_mod_mul (&ecc->p, h, x2, zz, tp);	/* zz, h */
+  ecc_mod_sub (&ecc->p, h, h, u1);
+  ecc_mod_mul (&ecc->p, w, zz, z1, tp);	/* zz, h, w */
+  ecc_mod_mul (&ecc->p, w, y2, w, tp);
+  ecc_mod_sub (&ecc->p, w, w, s1);
+
+  /* Note that use of ecc_mod_zero_p depends on 0 <= h,w < 2p. */
+  if (ecc_mod_zero_p (&ecc->p, h))
+    {
+      /* X1 == X2 */
+      if (ecc_mod_zero_p (&ecc->p, w))
+	{
+	  /* Y1 == Y2. Do point duplication of q, which is
+	     unclobbered. */
+	  mpn_copyi (scratch, q, 2*ecc->p.size);
+	  mpn_copyi (scratch + 2*ecc->p.size, ecc->unit, ecc->p.size);
+	  ecc_dup_jj (ecc, r, scratch, scratch + 3*ecc->p.size);
+	  return 1;
+	}
+      /* We must have Y1 == -Y2, and then the result is the infinity
+	 point, */
+      mpn_zero (r, 3*ecc->p.size);
+      return 0;
+    }
+
+  /* z_3 */
+  ecc_mod_add (&ecc->p, z3, z1, h);
+  ecc_mod_sqr (&ecc->p, z3, z3, tp);
+  ecc_mod_sub (&ecc->p, z3, z3, zz);	/* h, w */
+  /* hh */
+  ecc_mod_sqr (&ecc->p, hh, h, tp);	/* h, w, hh */
+  ecc_mod_sub (&ecc->p, z3, z3, hh);
+
+  ecc_mod_add (&ecc->p, w, w, w);
+
+  /* i replaces hh */
+  ecc_mod_mul_1 (&ecc->p, i, hh, 4);	/* h, w, i */
+  /* j replaces h */
+  ecc_mod_mul (&ecc->p, j, i, h, tp);	/* w, i, j */
+
+  /* v replaces i */
+  ecc_mod_mul (&ecc->p, v, u1, i, tp);
+
+  /* x_3 */
+  ecc_mod_sqr (&ecc->p, x3, w, tp);
+  ecc_mod_sub (&ecc->p, x3, x3, j);
+  ecc_mod_submul_1 (&ecc->p, x3, v, 2);
+
+  /* y_3 */
+  ecc_mod_mul (&ecc->p, j, s1, j, tp);
+  ecc_mod_sub (&ecc->p, y3, v, x3);
+  ecc_mod_mul (&ecc->p, y3, y3, w, tp);
+  ecc_mod_submul_1 (&ecc->p, y3, j, 2);
+
+  return 1;
+}
@@ -0,0 +1,136 @@
+/* ecc-nonsec-mul-ga-eh.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ecc.h"
+#include "ecc-internal.h"
+
+#define TABLE_SIZE (1U << (ECC_NONSEC_WBITS - 2))
+
+/* Fills in the table of odd multiples, T[i] = (2i+1) T[0], in
+   homogeneous coordinates. */
+static void
+table_init (const struct ecc_curve *ecc, mp_limb_t *T, mp_limb_t *scratch)
+{
+  mp_size_t size = ecc->p.size;
+  unsigned i;
+
+#define dp scratch
+#define scratch_out (scratch + 3*size)
+
+  ecc->dup (ecc, dp, T, scratch_out);
+  for (i = 1; i < TABLE_SIZE; i++)
+    ecc->add_hhh (ecc, T + 3*size*i, T + 3*size*(i-1), dp, scratch_out);
+#undef dp
+#undef scratch_out
+}
+
+/* Adds digit * P to R, using the table of odd multiples. The
+   addition formulas are complete, so the only special case is the
+   initial neutral point, represented only by the is_zero flag. */
+static int
+add_digit (const struct ecc_curve *ecc, mp_limb_t *r, int is_zero,
+	   int digit, const mp_limb_t *T, mp_limb_t *scratch)
+{
+  mp_size_t size = ecc->p.size;
+  const mp_limb_t *tp;
+
+  if (!digit)
+    return is_zero;
+
+  if (digit > 0)
+    tp = T + 3*size*(digit >> 1);
+  else
+    {
+      /* Negation is (x, y) -> (-x, y). */
+      const mp_limb_t *sp = T + 3*size*(-digit >> 1);
+      ecc_mod_sub (&ecc->p, scratch, ecc->p.m, sp);
+      mpn_copyi (scratch + size, sp + size, 2*size);
+      tp = scratch;
+    }
+  if (is_zero)
+    mpn_copyi (r, tp, 3*size);
+  else
+    ecc->add_hhh (ecc, r, r, tp, scratch + 3*size);
+  return 0;
+}
+
+void
+ecc_nonsec_mul_ga_eh (const struct ecc_curve *ecc, mp_limb_t *r,
+		      const mp_limb_t *n1p, const mp_limb_t *n2p,
+		      const mp_limb_t *p, mp_limb_t *scratch)
+{
+  mp_size_t size = ecc->p.size;
+  unsigned l1, l2, i;
+  int is_zero;
+
+#define TG scratch
+#define TP (scratch + 3*size*TABLE_SIZE)
+#define d1 ((signed char *) (scratch + 6*size*TABLE_SIZE))
+#define d2 ((signed char *) (scratch + (6*TABLE_SIZE + 8)*size + 1))
+#define scratch_out (scratch + (6*TABLE_SIZE + 16)*size + 2)
+
+  /* The generator is the second entry of the Pippenger table, already
+     in internal representation. */
+  mpn_copyi (TG, ecc->pippenger_table + 2*size, 2*size);
+  mpn_copyi (TG + 2*size, ecc->unit, size);
+  table_init (ecc, TG, scratch_out);
+
+  mpn_copyi (TP, p, 2*size);
+  mpn_copyi (TP + 2*size, ecc->unit, size);
+  table_init (ecc, TP, scratch_out);
+
+  l1 = ecc_wnaf (d1, ECC_NONSEC_WBITS, n1p, ecc->q.size);
+  l2 = ecc_wnaf (d2, ECC_NONSEC_WBITS, n2p, ecc->q.size);
+
+  for (i = l1 > l2 ? l1 : l2, is_zero = 1; i-- > 0; )
+    {
+      if (!is_zero)
+	ecc->dup (ecc, r, r, scratch_out);
+      is_zero = add_digit (ecc, r, is_zero, d1[i], TG, scratch_out);
+      is_zero = add_digit (ecc, r, is_zero, d2[i], TP, scratch_out);
+    }
+  if (is_zero)
+    {
+      /* Both scalars zero, return the neutral point (0, 1). */
+      mpn_zero (r, 3*size);
+      mpn_copyi (r + size, ecc->unit, size);
+      mpn_copyi (r + 2*size, ecc->unit, size);
+    }
+#undef TG
+#undef TP
+#undef d1
+#undef d2
+#undef scratch_out
+}
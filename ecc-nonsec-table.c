@@ -0,0 +1,205 @@
+/* ecc-nonsec-table.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ecc.h"
+#include "ecc-internal.h"
+
+#include <assert.h>
+
+#define TABLE_SIZE (1U << (ECC_NONSEC_TABLE_WBITS - 2))
+#define PARTS ECC_NONSEC_TABLE_PARTS
+
+/* Number of wNAF digits handled by each part of the table. */
+#define PART_BITS(ecc) (((ecc)->q.bit_size + PARTS) / PARTS)
+
+/* Fills in the jacobian or homogeneous coordinates of the odd
+   multiples for the PARTS points 2^{jm} T[0], where m = PART_BITS. On
+   input, T[0] holds the first point. */
+static void
+table_fill (const struct ecc_curve *ecc, mp_limb_t *T, mp_limb_t *scratch)
+{
+  mp_size_t size = ecc->p.size;
+  unsigned m = PART_BITS (ecc);
+  unsigned i, j;
+
+#define dp scratch
+#define scratch_out (scratch + 3*size)
+
+  for (j = 0; j < PARTS; j++, T += 3*size*TABLE_SIZE)
+    {
+      if (j > 0)
+	{
+	  mpn_copyi (T, T - 3*size*TABLE_SIZE, 3*size);
+	  for (i = 0; i < m; i++)
+	    ecc->dup (ecc, T, T, scratch_out);
+	}
+      ecc->dup (ecc, dp, T, scratch_out);
+      /* Can't hit any special cases, since T[0] has large order. */
+      for (i = 1; i < TABLE_SIZE; i++)
+	ecc->add_hhh (ecc, T + 3*size*i, T + 3*size*(i-1), dp,
+		      scratch_out);
+    }
+#undef dp
+#undef scratch_out
+}
+
+void
+ecc_nonsec_table_init (const struct ecc_curve *ecc, mp_limb_t *T,
+		       const mp_limb_t *p, mp_limb_t *scratch)
+{
+  mp_size_t size = ecc->p.size;
+  unsigned i;
+
+#define H scratch
+#define scratch_out (scratch + 3*size*ECC_NONSEC_TABLE_POINTS)
+
+  mpn_copyi (H, ecc->pippenger_table + 2*size, 2*size);
+  mpn_copyi (H + 2*size, ecc->unit, size);
+  table_fill (ecc, H, scratch_out);
+
+  ecc_a_to_j (ecc, H + 3*size*PARTS*TABLE_SIZE, p);
+  table_fill (ecc, H + 3*size*PARTS*TABLE_SIZE, scratch_out);
+
+  if (ecc->h_to_a == ecc_eh_to_a)
+    ecc_eh_to_a_batch (ecc, 0, ECC_NONSEC_TABLE_POINTS, T, H, scratch_out);
+  else
+    ecc_j_to_a_batch (ecc, 0, ECC_NONSEC_TABLE_POINTS, T, H, scratch_out);
+
+  /* The conversion produces canonical coordinates, convert back to
+     the internal representation. */
+  if (ecc->use_redc)
+    for (i = 0; i < ECC_NONSEC_TABLE_POINTS; i++)
+      {
+	ecc_a_to_j (ecc, H, T + 2*size*i);
+	mpn_copyi (T + 2*size*i, H, 2*size);
+      }
+#undef H
+#undef scratch_out
+}
+
+/* Adds digit * P to R, using a table of odd multiples in affine
+   coordinates. Returns 1 if the result is the point at infinity,
+   otherwise 0. */
+static int
+add_digit (const struct ecc_curve *ecc, mp_limb_t *r, int is_zero,
+	   int digit, const mp_limb_t *T, mp_limb_t *scratch)
+{
+  mp_size_t size = ecc->p.size;
+  const mp_limb_t *tp;
+
+  if (!digit)
+    return is_zero;
+
+  if (digit > 0)
+    tp = T + 2*size*(digit >> 1);
+  else
+    {
+      /* Negation is (x, -y) on Weierstrass curves, and (-x, y) on
+	 Edwards curves. */
+      const mp_limb_t *sp = T + 2*size*(-digit >> 1);
+      int i = (ecc->h_to_a != ecc_eh_to_a);
+      mpn_copyi (scratch + (1-i)*size, sp + (1-i)*size, size);
+      ecc_mod_sub (&ecc->p, scratch + i*size, ecc->p.m, sp + i*size);
+      tp = scratch;
+    }
+  if (is_zero)
+    {
+      mpn_copyi (r, tp, 2*size);
+      mpn_copyi (r + 2*size, ecc->unit, size);
+      return 0;
+    }
+  if (ecc->h_to_a == ecc_eh_to_a)
+    {
+      /* Complete formulas, no special cases. */
+      ecc->add_hh (ecc, r, r, tp, scratch + 2*size);
+      return 0;
+    }
+  return !ecc_nonsec_add_jja (ecc, r, r, tp, scratch + 2*size);
+}
+
+static int
+get_digit (const signed char *dp, unsigned length, unsigned i)
+{
+  return i < length ? dp[i] : 0;
+}
+
+int
+ecc_nonsec_mul_gt (const struct ecc_curve *ecc, mp_limb_t *r,
+		   const mp_limb_t *n1p, const mp_limb_t *n2p,
+		   const mp_limb_t *T, mp_limb_t *scratch)
+{
+  mp_size_t size = ecc->p.size;
+  unsigned m = PART_BITS (ecc);
+  unsigned l1, l2, i, j;
+  int is_zero;
+
+#define TG T
+#define TP (T + 2*size*PARTS*TABLE_SIZE)
+#define d1 ((signed char *) scratch)
+#define d2 ((signed char *) (scratch + 8*size + 1))
+#define scratch_out (scratch + 16*size + 2)
+
+  l1 = ecc_wnaf (d1, ECC_NONSEC_TABLE_WBITS, n1p, ecc->q.size);
+  l2 = ecc_wnaf (d2, ECC_NONSEC_TABLE_WBITS, n2p, ecc->q.size);
+  assert (l1 <= PARTS * m);
+  assert (l2 <= PARTS * m);
+
+  for (i = m, is_zero = 1; i-- > 0; )
+    {
+      if (!is_zero)
+	ecc->dup (ecc, r, r, scratch_out);
+      for (j = 0; j < PARTS; j++)
+	{
+	  is_zero = add_digit (ecc, r, is_zero, get_digit (d1, l1, j*m + i),
+			       TG + 2*size*TABLE_SIZE*j, scratch_out);
+	  is_zero = add_digit (ecc, r, is_zero, get_digit (d2, l2, j*m + i),
+			       TP + 2*size*TABLE_SIZE*j, scratch_out);
+	}
+    }
+  if (is_zero && ecc->h_to_a == ecc_eh_to_a)
+    {
+      /* Both scalars zero, return the neutral point (0, 1). */
+      mpn_zero (r, size);
+      mpn_copyi (r + size, ecc->unit, size);
+      mpn_copyi (r + 2*size, ecc->unit, size);
+      return 1;
+    }
+  return !is_zero;
+#undef TG
+#undef TP
+#undef d1
+#undef d2
+#undef scratch_out
+}
@@ -0,0 +1,138 @@
+/* ecc-point-mul-batch.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include "ecc.h"
+#include "ecc-internal.h"
+
+/* Converts the count points at hp + 3*i*size to affine coordinates,
+   and stores them in r[i], using a single inversion. */
+static void
+h_to_a_batch (const struct ecc_curve *ecc, size_t count,
+	      struct ecc_point * const *r, const mp_limb_t *hp,
+	      mp_limb_t *scratch)
+{
+  mp_size_t size = ecc->p.size;
+  size_t i;
+
+#define ap scratch
+#define scratch_out (scratch + 2*count*size)
+
+  if (ecc->h_to_a == ecc_eh_to_a)
+    ecc_eh_to_a_batch (ecc, 0, count, ap, hp, scratch_out);
+  else
+    ecc_j_to_a_batch (ecc, 0, count, ap, hp, scratch_out);
+
+  for (i = 0; i < count; i++)
+    mpn_copyi (r[i]->p, ap + 2*i*size, 2*size);
+#undef ap
+#undef scratch_out
+}
+
+static mp_size_t
+h_to_a_batch_itch (const struct ecc_curve *ecc, size_t count)
+{
+  return 3*count*ecc->p.size + ecc->p.size + ecc->h_to_a_itch;
+}
+
+void
+ecc_point_mul_batch (size_t count, struct ecc_point * const *r,
+		     const struct ecc_scalar * const *n,
+		     const struct ecc_point * const *p)
+{
+  const struct ecc_curve *ecc;
+  mp_size_t size;
+  mp_size_t itch;
+  mp_limb_t *scratch;
+  size_t i;
+
+  if (count == 0)
+    return;
+
+  ecc = r[0]->ecc;
+  size = ecc->p.size;
+  itch = h_to_a_batch_itch (ecc, count);
+  if (itch < ecc->mul_itch)
+    itch = ecc->mul_itch;
+  itch += 3*count*size;
+  scratch = gmp_alloc_limbs (itch);
+
+  for (i = 0; i < count; i++)
+    {
+      assert (r[i]->ecc == ecc);
+      assert (n[i]->ecc == ecc);
+      assert (p[i]->ecc == ecc);
+
+      ecc->mul (ecc, scratch + 3*i*size, n[i]->p, p[i]->p,
+		scratch + 3*count*size);
+    }
+  h_to_a_batch (ecc, count, r, scratch, scratch + 3*count*size);
+  gmp_free_limbs (scratch, itch);
+}
+
+void
+ecc_point_mul_g_batch (size_t count, struct ecc_point * const *r,
+		       const struct ecc_scalar * const *n)
+{
+  const struct ecc_curve *ecc;
+  mp_size_t size;
+  mp_size_t itch;
+  mp_limb_t *scratch;
+  size_t i;
+
+  if (count == 0)
+    return;
+
+  ecc = r[0]->ecc;
+  size = ecc->p.size;
+  itch = h_to_a_batch_itch (ecc, count);
+  if (itch < ecc->mul_g_itch)
+    itch = ecc->mul_g_itch;
+  itch += 3*count*size;
+  scratch = gmp_alloc_limbs (itch);
+
+  for (i = 0; i < count; i++)
+    {
+      assert (r[i]->ecc == ecc);
+      assert (n[i]->ecc == ecc);
+
+      ecc->mul_g (ecc, scratch + 3*i*size, n[i]->p,
+		  scratch + 3*count*size);
+    }
+  h_to_a_batch (ecc, count, r, scratch, scratch + 3*count*size);
+  gmp_free_limbs (scratch, itch);
+}
@@ -257,6 +257,8 @@ const struct ecc_curve _nettle_secp_192r1 =
     ecc_secp192r1_inv,
     ecc_secp192r1_sqrt,
     NULL,
+    NULL,
+    NULL,
   },
   {
     192,
@@ -279,6 +281,8 @@ const struct ecc_curve _nettle_secp_192r1 =
     ecc_mod_inv,
     NULL,
     NULL,
+    NULL,
+    NULL,
   },
   
   USE_REDC,
@@ -232,6 +232,8 @@ const struct ecc_curve _nettle_secp_224r1 =
     ecc_secp224r1_inv,
     ecc_secp224r1_sqrt,
     NULL,
+    NULL,
+    NULL,
   },
   {
     224,
@@ -254,6 +256,8 @@ const struct ecc_curve _nettle_secp_224r1 =
     ecc_mod_inv,
     NULL,
     NULL,
+    NULL,
+    NULL,
   },
   
   USE_REDC,
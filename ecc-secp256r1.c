@@ -352,13 +352,15 @@ const struct ecc_curve _nettle_secp_256r1 =
     ecc_secp256r1_inv,
     ecc_secp256r1_sqrt,
     NULL,
+    NULL,
+    NULL,
   },
   {
     256,
     ECC_LIMB_SIZE,
     ECC_BMODQ_SIZE,
     0,
-    ECC_MOD_INV_ITCH (ECC_LIMB_SIZE),
+    ECC_MOD_INV_SAFEGCD_ITCH (ECC_LIMB_SIZE),
     0,
     0,
 
@@ -371,7 +373,9 @@ const struct ecc_curve _nettle_secp_256r1 =
 
     ecc_secp256r1_modq,
     ecc_secp256r1_modq,
-    ecc_mod_inv,
+    ecc_mod_inv_safegcd,
+    NULL,
+    NULL,
     NULL,
     NULL,
   },
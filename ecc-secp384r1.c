@@ -210,45 +210,6 @@ ecc_mod_pow_288m32m1 (const struct ecc_modulo *m,
 #undef tp
 }
 
-#define ECC_SECP384R1_INV_ITCH (6*ECC_LIMB_SIZE)
-
-static void
-ecc_secp384r1_inv (const struct ecc_modulo *p,
-		   mp_limb_t *rp, const mp_limb_t *ap,
-		   mp_limb_t *scratch)
-{
-  /*
-    Addition chain for
-
-    p - 2 = 2^{384} - 2^{128} - 2^{96} + 2^{32} - 3
-
-    Start with
-
-      a^{2^{288} - 2^{32} - 1}
-
-    and then use
-
-      2^{382} - 2^{126} - 2^{94} + 2^{30} - 1
-         = 2^{94} (2^{288} - 2^{32} - 1) + 2^{30} - 1
-
-      2^{384} - 2^{128} - 2^{96} + 2^{32} - 3
-         = 2^2 (2^{382} - 2^{126} - 2^{94} + 2^{30} - 1) + 1
-
-    This addition chain needs 96 additional squarings and 2
-    multiplies, for a total of 383 squarings and 14 multiplies.
-  */
-
-#define a30m1 scratch
-#define tp (scratch + ECC_LIMB_SIZE)
-
-  ecc_mod_pow_288m32m1 (p, rp, a30m1, ap, tp);
-  ecc_mod_pow_2k_mul (p, rp, rp, 94, a30m1, tp); /* a^{2^{382} - 2^{126} - 2^{94} + 2^{30} - 1 */
-  ecc_mod_pow_2k_mul (p, rp, rp, 2, ap, tp);
-
-#undef a30m1
-#undef tp
-}
-
 /* To guarantee that inputs to ecc_mod_zero_p are in the required range. */
 #if ECC_LIMB_SIZE * GMP_NUMB_BITS != 384
 #error Unsupported limb size
@@ -307,7 +268,7 @@ const struct ecc_curve _nettle_secp_384r1 =
     ECC_LIMB_SIZE,    
     ECC_BMODP_SIZE,
     ECC_REDC_SIZE,
-    ECC_SECP384R1_INV_ITCH,
+    ECC_MOD_INV_SAFEGCD_ITCH (ECC_LIMB_SIZE),
     ECC_SECP384R1_SQRT_ITCH,
     0,
 
@@ -320,16 +281,18 @@ const struct ecc_curve _nettle_secp_384r1 =
 
     ecc_secp384r1_modp,
     ecc_secp384r1_modp,
-    ecc_secp384r1_inv,
+    ecc_mod_inv_safegcd,
     ecc_secp384r1_sqrt,
     NULL,
+    NULL,
+    NULL,
   },
   {
     384,
     ECC_LIMB_SIZE,    
     ECC_BMODQ_SIZE,
     0,
-    ECC_MOD_INV_ITCH (ECC_LIMB_SIZE),
+    ECC_MOD_INV_SAFEGCD_ITCH (ECC_LIMB_SIZE),
     0,
     0,
 
@@ -342,7 +305,9 @@ const struct ecc_curve _nettle_secp_384r1 =
 
     ecc_mod,
     ecc_mod,
-    ecc_mod_inv,
+    ecc_mod_inv_safegcd,
+    NULL,
+    NULL,
     NULL,
     NULL,
   },
@@ -356,7 +321,7 @@ const struct ecc_curve _nettle_secp_384r1 =
   ECC_DUP_JJ_ITCH (ECC_LIMB_SIZE),
   ECC_MUL_A_ITCH (ECC_LIMB_SIZE),
   ECC_MUL_G_ITCH (ECC_LIMB_SIZE),
-  ECC_J_TO_A_ITCH(ECC_LIMB_SIZE, ECC_SECP384R1_INV_ITCH),
+  ECC_J_TO_A_ITCH(ECC_LIMB_SIZE, ECC_MOD_INV_SAFEGCD_ITCH (ECC_LIMB_SIZE)),
 
   ecc_add_jja,
   ecc_add_jjj,
@@ -178,6 +178,8 @@ const struct ecc_curve _nettle_secp_521r1 =
     ecc_secp521r1_inv,
     ecc_secp521r1_sqrt,
     NULL,
+    NULL,
+    NULL,
   },
   {
     521,
@@ -200,6 +202,8 @@ const struct ecc_curve _nettle_secp_521r1 =
     ecc_mod_inv,
     NULL,
     NULL,
+    NULL,
+    NULL,
   },
   
   USE_REDC,
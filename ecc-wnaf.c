@@ -0,0 +1,93 @@
+/* ecc-wnaf.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "ecc-internal.h"
+
+/* Extracts w bits starting at bit_index, reading zeros beyond the
+   end. */
+static unsigned
+get_bits (const mp_limb_t *np, mp_size_t size,
+	  mp_bitcnt_t bit_index, unsigned w)
+{
+  mp_size_t limb_index = bit_index / GMP_NUMB_BITS;
+  unsigned shift = bit_index % GMP_NUMB_BITS;
+  mp_limb_t bits;
+
+  if (limb_index >= size)
+    return 0;
+
+  bits = np[limb_index] >> shift;
+  if (shift + w > GMP_NUMB_BITS && limb_index + 1 < size)
+    bits |= np[limb_index + 1] << (GMP_NUMB_BITS - shift);
+
+  return bits & ((1U << w) - 1);
+}
+
+unsigned
+ecc_wnaf (signed char *dp, unsigned w,
+	  const mp_limb_t *np, mp_size_t size)
+{
+  unsigned half = 1U << (w - 1);
+  unsigned bits = size * GMP_NUMB_BITS;
+  unsigned carry;
+  unsigned i, length;
+
+  assert (w >= 2 && w <= 7);
+  memset (dp, 0, bits + 1);
+
+  /* Process the number from the least significant end, with carry
+     representing an addition of 2^i. A non-zero digit is produced
+     whenever the current bit, with carry, is one, and it is chosen so
+     that the next w - 1 bits become zero. */
+  for (i = carry = length = 0; i < bits || carry; )
+    {
+      unsigned v = get_bits (np, size, i, w) + carry;
+      if (!(v & 1))
+	{
+	  /* Current bit equals carry, and the carry is unchanged. */
+	  i++;
+	  continue;
+	}
+      carry = v > half;
+      dp[i] = carry ? (int) v - (int) (2*half) : (int) v;
+      length = i + 1;
+      i += w;
+    }
+  assert (length <= bits + 1);
+  return length;
+}
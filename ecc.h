@@ -48,6 +48,8 @@ extern "C" {
 #define ecc_point_get nettle_ecc_point_get
 #define ecc_point_mul nettle_ecc_point_mul
 #define ecc_point_mul_g nettle_ecc_point_mul_g
+#define ecc_point_mul_batch nettle_ecc_point_mul_batch
+#define ecc_point_mul_g_batch nettle_ecc_point_mul_g_batch
 #define ecc_scalar_init nettle_ecc_scalar_init
 #define ecc_scalar_clear nettle_ecc_scalar_clear
 #define ecc_scalar_set nettle_ecc_scalar_set
@@ -116,6 +118,19 @@ ecc_point_mul (struct ecc_point *r, const struct ecc_scalar *n,
 void
 ecc_point_mul_g (struct ecc_point *r, const struct ecc_scalar *n);
 
+/* Computes r[i] = n[i] p[i] and r[i] = n[i] g, respectively, for i =
+   0, ..., count - 1, with all points and scalars using the same
+   curve. The conversion of all results to affine coordinates shares a
+   single inversion. */
+void
+ecc_point_mul_batch (size_t count, struct ecc_point * const *r,
+		     const struct ecc_scalar * const *n,
+		     const struct ecc_point * const *p);
+
+void
+ecc_point_mul_g_batch (size_t count, struct ecc_point * const *r,
+		       const struct ecc_scalar * const *n);
+
 
 /* Low-level interface */
   
@@ -50,22 +50,15 @@ ecdsa_sign (const struct ecc_scalar *key,
 	    struct dsa_signature *signature)
 {
   /* At most 936 bytes. */
-  TMP_DECL(k, mp_limb_t, ECC_MAX_SIZE + ECC_ECDSA_SIGN_ITCH (ECC_MAX_SIZE));
+  TMP_DECL(scratch, mp_limb_t, ECC_MAX_SIZE + ECC_ECDSA_SIGN_ITCH (ECC_MAX_SIZE));
   mp_limb_t size = key->ecc->p.size;
   mp_limb_t *rp = mpz_limbs_write (signature->r, size);
   mp_limb_t *sp = mpz_limbs_write (signature->s, size);
 
-  TMP_ALLOC (k, size + ECC_ECDSA_SIGN_ITCH (size));
-
-  /* Timing reveals the number of rounds through this loop, but the
-     timing is still independent of the secret k finally used. */
-  do
-    {
-      ecc_mod_random (&key->ecc->q, k, random_ctx, random, k + size);
-      ecc_ecdsa_sign (key->ecc, key->p, k, digest_length, digest,
-		   rp, sp, k + size);
-      mpz_limbs_finish (signature->r, size);
-      mpz_limbs_finish (signature->s, size);
-    }
-  while (mpz_sgn (signature->r) == 0 || mpz_sgn (signature->s) == 0);
+  TMP_ALLOC (scratch, ecc_ecdsa_sign_random_itch (key->ecc));
+
+  ecc_ecdsa_sign_random (key->ecc, key->p, random_ctx, random,
+			 digest_length, digest, rp, sp, scratch);
+  mpz_limbs_finish (signature->r, size);
+  mpz_limbs_finish (signature->s, size);
 }
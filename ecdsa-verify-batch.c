@@ -0,0 +1,115 @@
+/* ecdsa-verify-batch.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include "ecdsa.h"
+
+#include "gmp-glue.h"
+
+/* Process at most this many signatures per call to
+   ecc_ecdsa_verify_batch, to bound storage. */
+#define ECDSA_BATCH_SIZE 64
+
+int
+ecdsa_verify_batch (size_t n, const struct ecc_point * const *pub,
+		    const size_t *length, const uint8_t * const *digest,
+		    const struct dsa_signature * const *signature,
+		    int *valid)
+{
+  const struct ecc_curve *ecc;
+  mp_size_t size;
+  size_t max_chunk, done;
+  mp_size_t itch;
+  mp_limb_t *scratch;
+  int res;
+
+  if (n == 0)
+    return 1;
+
+  ecc = pub[0]->ecc;
+  size = ecc_size (ecc);
+  max_chunk = n < ECDSA_BATCH_SIZE ? n : ECDSA_BATCH_SIZE;
+  itch = 4*max_chunk*size + ecc_ecdsa_verify_batch_itch (ecc, max_chunk);
+
+  scratch = gmp_alloc_limbs (itch);
+
+#define pp scratch
+#define rp (scratch + 2*max_chunk*size)
+#define sp (scratch + 3*max_chunk*size)
+#define scratch_out (scratch + 4*max_chunk*size)
+
+  for (done = 0, res = 1; done < n; done += max_chunk)
+    {
+      size_t chunk = n - done < max_chunk ? n - done : max_chunk;
+      size_t i;
+
+      for (i = 0; i < chunk; i++)
+	{
+	  const struct dsa_signature *s = signature[done + i];
+	  assert (pub[done + i]->ecc == ecc);
+	  mpn_copyi (pp + 2*i*size, pub[done + i]->p, 2*size);
+
+	  /* Values out of range are replaced by zero, which is
+	     rejected by ecc_ecdsa_verify_batch. */
+	  if (mpz_sgn (s->r) <= 0 || mpz_size (s->r) > size
+	      || mpz_sgn (s->s) <= 0 || mpz_size (s->s) > size)
+	    {
+	      mpn_zero (rp + i*size, size);
+	      mpn_zero (sp + i*size, size);
+	    }
+	  else
+	    {
+	      mpz_limbs_copy (rp + i*size, s->r, size);
+	      mpz_limbs_copy (sp + i*size, s->s, size);
+	    }
+	}
+      if (!ecc_ecdsa_verify_batch (ecc, chunk, pp, length + done,
+				   digest + done, rp, sp,
+				   valid ? valid + done : NULL, scratch_out))
+	{
+	  res = 0;
+	  if (!valid)
+	    break;
+	}
+    }
+  gmp_free_limbs (scratch, itch);
+
+  return res;
+#undef pp
+#undef rp
+#undef sp
+#undef scratch_out
+}
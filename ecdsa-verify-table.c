@@ -0,0 +1,94 @@
+/* ecdsa-verify-table.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ecdsa.h"
+
+#include "gmp-glue.h"
+
+void
+ecdsa_public_table_init (struct ecdsa_public_table *table,
+			 const struct ecc_point *pub)
+{
+  const struct ecc_curve *ecc = pub->ecc;
+  mp_size_t itch = ecc_ecdsa_table_init_itch (ecc);
+  mp_limb_t *scratch = gmp_alloc_limbs (itch);
+
+  table->ecc = ecc;
+  table->p = gmp_alloc_limbs (ecc_ecdsa_table_size (ecc));
+  ecc_ecdsa_table_init (ecc, table->p, pub->p, scratch);
+
+  gmp_free_limbs (scratch, itch);
+}
+
+void
+ecdsa_public_table_clear (struct ecdsa_public_table *table)
+{
+  gmp_free_limbs (table->p, ecc_ecdsa_table_size (table->ecc));
+}
+
+int
+ecdsa_verify_table (const struct ecdsa_public_table *table,
+		    size_t length, const uint8_t *digest,
+		    const struct dsa_signature *signature)
+{
+  const struct ecc_curve *ecc = table->ecc;
+  mp_size_t size = ecc_size (ecc);
+  mp_size_t itch = 2*size + ecc_ecdsa_verify_table_itch (ecc);
+  mp_limb_t *scratch;
+  int res;
+
+#define rp scratch
+#define sp (scratch + size)
+#define scratch_out (scratch + 2*size)
+
+  if (mpz_sgn (signature->r) <= 0 || mpz_size (signature->r) > size
+      || mpz_sgn (signature->s) <= 0 || mpz_size (signature->s) > size)
+    return 0;
+
+  scratch = gmp_alloc_limbs (itch);
+
+  mpz_limbs_copy (rp, signature->r, size);
+  mpz_limbs_copy (sp, signature->s, size);
+
+  res = ecc_ecdsa_verify_table (ecc, table->p, length, digest,
+				rp, sp, scratch_out);
+
+  gmp_free_limbs (scratch, itch);
+
+  return res;
+#undef rp
+#undef sp
+#undef scratch_out
+}
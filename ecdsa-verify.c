@@ -49,9 +49,8 @@ ecdsa_verify (const struct ecc_point *pub,
 {
   mp_limb_t size = ecc_size (pub->ecc);
   mp_size_t itch = 2*size + ecc_ecdsa_verify_itch (pub->ecc);
-  /* For ECC_MUL_A_WBITS == 0, at most 1512 bytes. With
-     ECC_MUL_A_WBITS == 4, currently needs 67 * ecc->size, at most
-     4824 bytes. Don't use stack allocation for this. */
+  /* With ECC_NONSEC_WBITS == 5, currently needs 80 * ecc->size + 2,
+     at most 5776 bytes. Don't use stack allocation for this. */
   mp_limb_t *scratch;
   int res;
 
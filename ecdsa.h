@@ -44,11 +44,24 @@ extern "C" {
 /* Name mangling */
 #define ecdsa_sign nettle_ecdsa_sign
 #define ecdsa_verify nettle_ecdsa_verify
+#define ecdsa_verify_batch nettle_ecdsa_verify_batch
+#define ecdsa_public_table_init nettle_ecdsa_public_table_init
+#define ecdsa_public_table_clear nettle_ecdsa_public_table_clear
+#define ecdsa_verify_table nettle_ecdsa_verify_table
 #define ecdsa_generate_keypair nettle_ecdsa_generate_keypair
 #define ecc_ecdsa_sign nettle_ecc_ecdsa_sign
 #define ecc_ecdsa_sign_itch nettle_ecc_ecdsa_sign_itch
+#define ecc_ecdsa_sign_random nettle_ecc_ecdsa_sign_random
+#define ecc_ecdsa_sign_random_itch nettle_ecc_ecdsa_sign_random_itch
 #define ecc_ecdsa_verify nettle_ecc_ecdsa_verify
 #define ecc_ecdsa_verify_itch nettle_ecc_ecdsa_verify_itch
+#define ecc_ecdsa_verify_batch nettle_ecc_ecdsa_verify_batch
+#define ecc_ecdsa_verify_batch_itch nettle_ecc_ecdsa_verify_batch_itch
+#define ecc_ecdsa_table_size nettle_ecc_ecdsa_table_size
+#define ecc_ecdsa_table_init nettle_ecc_ecdsa_table_init
+#define ecc_ecdsa_table_init_itch nettle_ecc_ecdsa_table_init_itch
+#define ecc_ecdsa_verify_table nettle_ecc_ecdsa_verify_table
+#define ecc_ecdsa_verify_table_itch nettle_ecc_ecdsa_verify_table_itch
 
 /* High level ECDSA functions.
  *
@@ -66,6 +79,35 @@ ecdsa_verify (const struct ecc_point *pub,
 	      size_t length, const uint8_t *digest,
 	      const struct dsa_signature *signature);
 
+/* Verifies n signatures, all public keys must be on the same
+   curve. Returns 1 if all are valid. If valid is non-NULL, it is
+   filled in with the result for each signature. */
+int
+ecdsa_verify_batch (size_t n, const struct ecc_point * const *pub,
+		    const size_t *length, const uint8_t * const *digest,
+		    const struct dsa_signature * const *signature,
+		    int *valid);
+
+/* Precomputed tables for a public key, making verification faster
+   when many signatures are verified using the same key. */
+struct ecdsa_public_table
+{
+  const struct ecc_curve *ecc;
+  mp_limb_t *p;
+};
+
+void
+ecdsa_public_table_init (struct ecdsa_public_table *table,
+			 const struct ecc_point *pub);
+
+void
+ecdsa_public_table_clear (struct ecdsa_public_table *table);
+
+int
+ecdsa_verify_table (const struct ecdsa_public_table *table,
+		    size_t length, const uint8_t *digest,
+		    const struct dsa_signature *signature);
+
 void
 ecdsa_generate_keypair (struct ecc_point *pub,
 			struct ecc_scalar *key,
@@ -85,6 +127,18 @@ ecc_ecdsa_sign (const struct ecc_curve *ecc,
 		mp_limb_t *rp, mp_limb_t *sp,
 		mp_limb_t *scratch);
 
+mp_size_t
+ecc_ecdsa_sign_random_itch (const struct ecc_curve *ecc);
+
+/* Generates the nonce, and never returns a zero r or s. */
+void
+ecc_ecdsa_sign_random (const struct ecc_curve *ecc,
+		       const mp_limb_t *zp,
+		       void *random_ctx, nettle_random_func *random,
+		       size_t length, const uint8_t *digest,
+		       mp_limb_t *rp, mp_limb_t *sp,
+		       mp_limb_t *scratch);
+
 mp_size_t
 ecc_ecdsa_verify_itch (const struct ecc_curve *ecc);
 
@@ -95,6 +149,39 @@ ecc_ecdsa_verify (const struct ecc_curve *ecc,
 		  const mp_limb_t *rp, const mp_limb_t *sp,
 		  mp_limb_t *scratch);
 
+mp_size_t
+ecc_ecdsa_verify_batch_itch (const struct ecc_curve *ecc, size_t n);
+
+/* Public keys, r and s of signature i are at pp + 2*i*size, rp +
+   i*size and sp + i*size, respectively. */
+int
+ecc_ecdsa_verify_batch (const struct ecc_curve *ecc,
+			size_t n, const mp_limb_t *pp,
+			const size_t *length, const uint8_t * const *digest,
+			const mp_limb_t *rp, const mp_limb_t *sp,
+			int *valid, mp_limb_t *scratch);
+
+/* Size, in limbs, of the table for a public key. */
+mp_size_t
+ecc_ecdsa_table_size (const struct ecc_curve *ecc);
+
+mp_size_t
+ecc_ecdsa_table_init_itch (const struct ecc_curve *ecc);
+
+void
+ecc_ecdsa_table_init (const struct ecc_curve *ecc,
+		      mp_limb_t *tp, const mp_limb_t *pp,
+		      mp_limb_t *scratch);
+
+mp_size_t
+ecc_ecdsa_verify_table_itch (const struct ecc_curve *ecc);
+
+int
+ecc_ecdsa_verify_table (const struct ecc_curve *ecc,
+			const mp_limb_t *tp, /* Public key table */
+			size_t length, const uint8_t *digest,
+			const mp_limb_t *rp, const mp_limb_t *sp,
+			mp_limb_t *scratch);
 
 #ifdef __cplusplus
 }
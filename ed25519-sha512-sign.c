@@ -39,15 +39,21 @@
 #include "ecc-internal.h"
 #include "sha2.h"
 
+mp_size_t
+ecc_ed25519_sha512_sign_itch (void)
+{
+  const struct ecc_curve *ecc = &_nettle_curve25519;
+  return ecc->q.size + _eddsa_sign_itch (ecc);
+}
+
 void
-ed25519_sha512_sign (const uint8_t *pub,
-		     const uint8_t *priv,
-		     size_t length, const uint8_t *msg,
-		     uint8_t *signature)
+ecc_ed25519_sha512_sign (const uint8_t *pub,
+			 const uint8_t *priv,
+			 size_t length, const uint8_t *msg,
+			 uint8_t *signature,
+			 mp_limb_t *scratch)
 {
   const struct ecc_curve *ecc = &_nettle_curve25519;
-  mp_size_t itch = ecc->q.size + _eddsa_sign_itch (ecc);
-  mp_limb_t *scratch = gmp_alloc_limbs (itch);
 #define k2 scratch
 #define scratch_out (scratch + ecc->q.size)
   struct sha512_ctx ctx;
@@ -59,9 +65,20 @@ ed25519_sha512_sign (const uint8_t *pub,
   _eddsa_sign (ecc, &_nettle_ed25519_sha512, &ctx,
 	       pub, digest + ED25519_KEY_SIZE, k2,
 	       length, msg, signature, scratch_out);
-
-  gmp_free_limbs (scratch, itch);
-#undef k1
 #undef k2
 #undef scratch_out
 }
+
+void
+ed25519_sha512_sign (const uint8_t *pub,
+		     const uint8_t *priv,
+		     size_t length, const uint8_t *msg,
+		     uint8_t *signature)
+{
+  mp_size_t itch = ecc_ed25519_sha512_sign_itch ();
+  mp_limb_t *scratch = gmp_alloc_limbs (itch);
+
+  ecc_ed25519_sha512_sign (pub, priv, length, msg, signature, scratch);
+
+  gmp_free_limbs (scratch, itch);
+}
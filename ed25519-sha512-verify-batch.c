@@ -0,0 +1,56 @@
+/* ed25519-sha512-verify-batch.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "eddsa.h"
+#include "eddsa-internal.h"
+
+#include "ecc-internal.h"
+#include "sha2.h"
+
+int
+ed25519_sha512_verify_batch (size_t n, const uint8_t * const *pub,
+			     const size_t *length,
+			     const uint8_t * const *msg,
+			     const uint8_t * const *signature,
+			     void *random_ctx, nettle_random_func *random,
+			     int *valid)
+{
+  struct sha512_ctx ctx;
+
+  sha512_init (&ctx);
+  return _eddsa_verify_batch (&_nettle_curve25519, &_nettle_ed25519_sha512,
+			      &ctx, n, pub, length, msg, signature,
+			      random_ctx, random, valid);
+}
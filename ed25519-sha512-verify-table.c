@@ -0,0 +1,98 @@
+/* ed25519-sha512-verify-table.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <string.h>
+
+#include "eddsa.h"
+
+#include "ecc-internal.h"
+#include "eddsa-internal.h"
+#include "sha2.h"
+
+int
+ed25519_sha512_public_table_init (struct ed25519_public_table *table,
+				  const uint8_t *pub)
+{
+  const struct ecc_curve *ecc = &_nettle_curve25519;
+  mp_size_t itch = 3*ecc->p.size + _eddsa_table_init_itch (ecc);
+  mp_limb_t *scratch = gmp_alloc_limbs (itch);
+  int res;
+#define A scratch
+#define scratch_out (scratch + 3*ecc->p.size)
+
+  table->p = NULL;
+  res = _eddsa_decompress (ecc, A, pub, scratch_out);
+  if (res)
+    {
+      memcpy (table->pub, pub, ED25519_KEY_SIZE);
+      table->p = gmp_alloc_limbs (ECC_NONSEC_TABLE_SIZE (ecc->p.size));
+      _eddsa_table_init (ecc, table->p, A, scratch_out);
+    }
+  gmp_free_limbs (scratch, itch);
+  return res;
+#undef A
+#undef scratch_out
+}
+
+void
+ed25519_sha512_public_table_clear (struct ed25519_public_table *table)
+{
+  const struct ecc_curve *ecc = &_nettle_curve25519;
+  if (table->p)
+    gmp_free_limbs (table->p, ECC_NONSEC_TABLE_SIZE (ecc->p.size));
+}
+
+int
+ed25519_sha512_verify_table (const struct ed25519_public_table *table,
+			     size_t length, const uint8_t *msg,
+			     const uint8_t *signature)
+{
+  const struct ecc_curve *ecc = &_nettle_curve25519;
+  mp_size_t itch = _eddsa_verify_table_itch (ecc);
+  mp_limb_t *scratch;
+  struct sha512_ctx ctx;
+  int res;
+
+  if (!table->p)
+    return 0;
+
+  scratch = gmp_alloc_limbs (itch);
+  sha512_init (&ctx);
+  res = _eddsa_verify_table (ecc, &_nettle_ed25519_sha512,
+			     table->pub, table->p, &ctx,
+			     length, msg, signature, scratch);
+  gmp_free_limbs (scratch, itch);
+  return res;
+}
@@ -41,14 +41,20 @@
 #include "ecc-internal.h"
 #include "sha2.h"
 
+mp_size_t
+ecc_ed25519_sha512_verify_itch (void)
+{
+  const struct ecc_curve *ecc = &_nettle_curve25519;
+  return 3*ecc->p.size + _eddsa_verify_itch (ecc);
+}
+
 int
-ed25519_sha512_verify (const uint8_t *pub,
-		       size_t length, const uint8_t *msg,
-		       const uint8_t *signature)
+ecc_ed25519_sha512_verify (const uint8_t *pub,
+			   size_t length, const uint8_t *msg,
+			   const uint8_t *signature,
+			   mp_limb_t *scratch)
 {
   const struct ecc_curve *ecc = &_nettle_curve25519;
-  mp_size_t itch = 3*ecc->p.size + _eddsa_verify_itch (ecc);
-  mp_limb_t *scratch = gmp_alloc_limbs (itch);
   struct sha512_ctx ctx;
   int res;
 #define A scratch
@@ -61,8 +67,22 @@ ed25519_sha512_verify (const uint8_t *pub,
 			   pub, A, &ctx,
 			   length, msg, signature,
 			   scratch_out));
-  gmp_free_limbs (scratch, itch);
   return res;
 #undef A
 #undef scratch_out
 }
+
+int
+ed25519_sha512_verify (const uint8_t *pub,
+		       size_t length, const uint8_t *msg,
+		       const uint8_t *signature)
+{
+  mp_size_t itch = ecc_ed25519_sha512_verify_itch ();
+  mp_limb_t *scratch = gmp_alloc_limbs (itch);
+  int res;
+
+  res = ecc_ed25519_sha512_verify (pub, length, msg, signature, scratch);
+
+  gmp_free_limbs (scratch, itch);
+  return res;
+}
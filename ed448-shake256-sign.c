@@ -40,16 +40,22 @@
 #include "eddsa-internal.h"
 #include "sha3.h"
 
+mp_size_t
+ecc_ed448_shake256_sign_itch (void)
+{
+  const struct ecc_curve *ecc = &_nettle_curve448;
+  return ecc->q.size + _eddsa_sign_itch (ecc);
+}
+
 void
-ed448_shake256_sign (const uint8_t *pub,
-		     const uint8_t *priv,
-		     size_t length, const uint8_t *msg,
-		     uint8_t *signature)
+ecc_ed448_shake256_sign (const uint8_t *pub,
+			 const uint8_t *priv,
+			 size_t length, const uint8_t *msg,
+			 uint8_t *signature,
+			 mp_limb_t *scratch)
 {
   const struct ecc_curve *ecc = &_nettle_curve448;
   const struct ecc_eddsa *eddsa = &_nettle_ed448_shake256;
-  mp_size_t itch = ecc->q.size + _eddsa_sign_itch (ecc);
-  mp_limb_t *scratch = gmp_alloc_limbs (itch);
 #define k2 scratch
 #define scratch_out (scratch + ecc->q.size)
   struct sha3_ctx ctx;
@@ -61,9 +67,20 @@ ed448_shake256_sign (const uint8_t *pub,
   _eddsa_sign (ecc, eddsa, &ctx,
 	       pub, digest + ED448_KEY_SIZE, k2,
 	       length, msg, signature, scratch_out);
-
-  gmp_free_limbs (scratch, itch);
-#undef k1
 #undef k2
 #undef scratch_out
 }
+
+void
+ed448_shake256_sign (const uint8_t *pub,
+		     const uint8_t *priv,
+		     size_t length, const uint8_t *msg,
+		     uint8_t *signature)
+{
+  mp_size_t itch = ecc_ed448_shake256_sign_itch ();
+  mp_limb_t *scratch = gmp_alloc_limbs (itch);
+
+  ecc_ed448_shake256_sign (pub, priv, length, msg, signature, scratch);
+
+  gmp_free_limbs (scratch, itch);
+}
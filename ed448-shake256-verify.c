@@ -42,14 +42,20 @@
 #include "eddsa-internal.h"
 #include "sha3.h"
 
+mp_size_t
+ecc_ed448_shake256_verify_itch (void)
+{
+  const struct ecc_curve *ecc = &_nettle_curve448;
+  return 3*ecc->p.size + _eddsa_verify_itch (ecc);
+}
+
 int
-ed448_shake256_verify (const uint8_t *pub,
-		       size_t length, const uint8_t *msg,
-		       const uint8_t *signature)
+ecc_ed448_shake256_verify (const uint8_t *pub,
+			   size_t length, const uint8_t *msg,
+			   const uint8_t *signature,
+			   mp_limb_t *scratch)
 {
   const struct ecc_curve *ecc = &_nettle_curve448;
-  mp_size_t itch = 3*ecc->p.size + _eddsa_verify_itch (ecc);
-  mp_limb_t *scratch = gmp_alloc_limbs (itch);
   struct sha3_ctx ctx;
   int res;
 #define A scratch
@@ -64,8 +70,22 @@ ed448_shake256_verify (const uint8_t *pub,
 			   &ctx,
 			   length, msg, signature,
 			   scratch_out));
-  gmp_free_limbs (scratch, itch);
   return res;
 #undef A
 #undef scratch_out
 }
+
+int
+ed448_shake256_verify (const uint8_t *pub,
+		       size_t length, const uint8_t *msg,
+		       const uint8_t *signature)
+{
+  mp_size_t itch = ecc_ed448_shake256_verify_itch ();
+  mp_limb_t *scratch = gmp_alloc_limbs (itch);
+  int res;
+
+  res = ecc_ed448_shake256_verify (pub, length, msg, signature, scratch);
+
+  gmp_free_limbs (scratch, itch);
+  return res;
+}
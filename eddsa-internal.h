@@ -40,11 +40,17 @@
 #define _eddsa_decompress _nettle_eddsa_decompress
 #define _eddsa_decompress_itch _nettle_eddsa_decompress_itch
 #define _eddsa_hash _nettle_eddsa_hash
+#define _eddsa_equal_h _nettle_eddsa_equal_h
 #define _eddsa_expand_key _nettle_eddsa_expand_key
 #define _eddsa_sign _nettle_eddsa_sign
 #define _eddsa_sign_itch _nettle_eddsa_sign_itch
 #define _eddsa_verify _nettle_eddsa_verify
 #define _eddsa_verify_itch _nettle_eddsa_verify_itch
+#define _eddsa_table_init _nettle_eddsa_table_init
+#define _eddsa_table_init_itch _nettle_eddsa_table_init_itch
+#define _eddsa_verify_table _nettle_eddsa_verify_table
+#define _eddsa_verify_table_itch _nettle_eddsa_verify_table_itch
+#define _eddsa_verify_batch _nettle_eddsa_verify_batch
 #define _eddsa_public_key_itch _nettle_eddsa_public_key_itch
 #define _eddsa_public_key _nettle_eddsa_public_key
 
@@ -86,6 +92,14 @@ void
 _eddsa_hash (const struct ecc_modulo *m,
 	     mp_limb_t *rp, size_t digest_size, const uint8_t *digest);
 
+/* Checks if x1/z1 == x2/z2 (mod p). Assumes z1 and z2 are
+   non-zero. Needs 2*p->size limbs of scratch space. */
+int
+_eddsa_equal_h (const struct ecc_modulo *p,
+		const mp_limb_t *x1, const mp_limb_t *z1,
+		const mp_limb_t *x2, const mp_limb_t *z2,
+		mp_limb_t *scratch);
+
 mp_size_t
 _eddsa_sign_itch (const struct ecc_curve *ecc);
 
@@ -115,6 +129,43 @@ _eddsa_verify (const struct ecc_curve *ecc,
 	       const uint8_t *signature,
 	       mp_limb_t *scratch);
 
+/* Computes the table for the public key A, of size
+   ECC_NONSEC_TABLE_SIZE, for use with _eddsa_verify_table. */
+mp_size_t
+_eddsa_table_init_itch (const struct ecc_curve *ecc);
+
+void
+_eddsa_table_init (const struct ecc_curve *ecc,
+		   mp_limb_t *T, const mp_limb_t *A,
+		   mp_limb_t *scratch);
+
+mp_size_t
+_eddsa_verify_table_itch (const struct ecc_curve *ecc);
+
+int
+_eddsa_verify_table (const struct ecc_curve *ecc,
+		     const struct ecc_eddsa *eddsa,
+		     const uint8_t *pub,
+		     const mp_limb_t *T,
+		     void *ctx,
+		     size_t length,
+		     const uint8_t *msg,
+		     const uint8_t *signature,
+		     mp_limb_t *scratch);
+
+/* Verifies n signatures, with a random linear combination of the
+   verification equations. Returns 1 if all are valid. If valid is
+   non-NULL, it is filled in with the result for each signature. */
+int
+_eddsa_verify_batch (const struct ecc_curve *ecc,
+		     const struct ecc_eddsa *eddsa,
+		     void *ctx,
+		     size_t n, const uint8_t * const *pub,
+		     const size_t *length, const uint8_t * const *msg,
+		     const uint8_t * const *signature,
+		     void *random_ctx, nettle_random_func *random,
+		     int *valid);
+
 void
 _eddsa_expand_key (const struct ecc_curve *ecc,
 		   const struct ecc_eddsa *eddsa,
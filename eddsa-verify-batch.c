@@ -0,0 +1,477 @@
+/* eddsa-verify-batch.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "eddsa.h"
+#include "eddsa-internal.h"
+
+#include "ecc.h"
+#include "ecc-internal.h"
+#include "gmp-glue.h"
+
+/* The batch check is a random linear combination of the verification
+   equations. With random 128-bit z_i, it computes
+
+     M = sum_i (z_i h_i) A_i + sum_i z_i R_i
+     T = (sum_i z_i s_i) G
+
+   and checks that c M = c T, where c is the cofactor. M is computed
+   using Pippenger's bucket method, T using the precomputed tables for
+   G. Since all inputs are public, none of this needs to be side
+   channel silent.
+
+   Inputs are processed in chunks of at most EDDSA_BATCH_SIZE
+   signatures, to bound the size of the temporary storage. */
+#define EDDSA_BATCH_SIZE 128
+
+/* Largest window size for the bucket method, 2^(c-1) buckets. */
+#define EDDSA_BATCH_MAX_C 8
+
+/* Each signature is represented by a record of EDDSA_BATCH_RECORD
+   elements of ecc->p.size limbs each: A and R are stored as (x, y, -x,
+   y), so that both A and -A are available in affine coordinates,
+   followed by h and s. */
+#define EDDSA_BATCH_RECORD 10
+
+struct eddsa_batch
+{
+  const struct ecc_curve *ecc;
+  const struct ecc_eddsa *eddsa;
+  void *ctx;
+  void *random_ctx;
+  nettle_random_func *random;
+
+  /* Records for the signatures of the current chunk, and their
+     indices in the caller's arrays. */
+  mp_limb_t *records;
+  size_t *index;
+
+  /* Two scalars per signature, z_i h_i and z_i. */
+  mp_limb_t *scalars;
+  signed char *digits;
+
+  mp_limb_t *buckets;
+  unsigned char *used;
+  mp_limb_t *scratch;
+};
+
+#define RECORD(b, i) ((b)->records + EDDSA_BATCH_RECORD * (i) * (b)->ecc->p.size)
+
+static mp_size_t
+batch_scratch_itch (const struct ecc_curve *ecc)
+{
+  /* Largest of all point operations, and the temporaries used by
+     batch_prepare and batch_check. */
+  mp_size_t itch = _eddsa_decompress_itch (ecc);
+  if (itch < ecc->mul_g_itch)
+    itch = ecc->mul_g_itch;
+  if (itch < ecc->add_hh_itch)
+    itch = ecc->add_hh_itch;
+  if (itch < ecc->add_hhh_itch)
+    itch = ecc->add_hhh_itch;
+  if (itch < ecc->dup_itch)
+    itch = ecc->dup_itch;
+  /* Room for the hash digest and its reduction. */
+  if (itch < 5*ecc->p.size + 2)
+    itch = 5*ecc->p.size + 2;
+
+  return 14*ecc->p.size + itch;
+}
+
+/* Decodes a signature into record i, and computes h. Returns 0 if the
+   public key or R can't be decoded, or if s is out of range. */
+static int
+batch_prepare (struct eddsa_batch *b, size_t i,
+	       const uint8_t *pub, size_t length, const uint8_t *msg,
+	       const uint8_t *signature)
+{
+  const struct ecc_curve *ecc = b->ecc;
+  mp_size_t size = ecc->p.size;
+  mp_limb_t *rp = RECORD (b, i);
+  size_t nbytes;
+
+#define A rp
+#define R (rp + 4*size)
+#define hp (rp + 8*size)
+#define sp (rp + 9*size)
+#define tp b->scratch
+#define hash ((uint8_t *) (b->scratch + 2*size + 1))
+
+  nbytes = 1 + ecc->p.bit_size / 8;
+
+  if (!_eddsa_decompress (ecc, A, pub, b->scratch)
+      || !_eddsa_decompress (ecc, R, signature, b->scratch))
+    return 0;
+
+  mpn_set_base256_le (sp, size, signature + nbytes, nbytes);
+  if (mpn_cmp (sp, ecc->q.m, size) >= 0)
+    return 0;
+
+  b->eddsa->dom (b->ctx);
+  b->eddsa->update (b->ctx, nbytes, signature);
+  b->eddsa->update (b->ctx, nbytes, pub);
+  b->eddsa->update (b->ctx, length, msg);
+  b->eddsa->digest (b->ctx, hash);
+  _eddsa_hash (&ecc->q, tp, 2*nbytes, hash);
+  mpn_copyi (hp, tp, size);
+
+  /* Negated points. Decompression gives canonical x, so x <= p. */
+  mpn_sub_n (A + 2*size, ecc->p.m, A, size);
+  mpn_copyi (A + 3*size, A + size, size);
+  mpn_sub_n (R + 2*size, ecc->p.m, R, size);
+  mpn_copyi (R + 3*size, R + size, size);
+
+  return 1;
+#undef A
+#undef R
+#undef hp
+#undef sp
+#undef tp
+#undef hash
+}
+
+/* Selects window size for the bucket method, to minimize the
+   approximate number of point additions, which is the number of
+   windows times the sum of the number of points and twice the number
+   of buckets. */
+static unsigned
+batch_window_size (size_t npoints, unsigned bits)
+{
+  unsigned c, best_c;
+  size_t cost, best_cost;
+
+  for (c = best_c = 2, best_cost = (size_t) -1; c <= EDDSA_BATCH_MAX_C; c++)
+    {
+      cost = (bits / c + 1) * (npoints + ((size_t) 1 << c));
+      if (cost < best_cost)
+	{
+	  best_c = c;
+	  best_cost = cost;
+	}
+    }
+  return best_c;
+}
+
+/* Recodes a scalar into signed digits in the range -2^{c-1} < d <=
+   2^{c-1}, least significant first. */
+static void
+batch_recode (signed char *dp, unsigned windows, unsigned c,
+	      const mp_limb_t *np, mp_size_t size)
+{
+  unsigned half = 1U << (c - 1);
+  unsigned carry;
+  unsigned i;
+
+  for (i = carry = 0; i < windows; i++)
+    {
+      mp_bitcnt_t bit_index = (mp_bitcnt_t) i * c;
+      mp_size_t limb_index = bit_index / GMP_NUMB_BITS;
+      unsigned shift = bit_index % GMP_NUMB_BITS;
+      unsigned bits;
+
+      if (limb_index < size)
+	{
+	  mp_limb_t w = np[limb_index] >> shift;
+	  if (shift + c > GMP_NUMB_BITS && limb_index + 1 < size)
+	    w |= np[limb_index + 1] << (GMP_NUMB_BITS - shift);
+	  bits = w & ((2*half) - 1);
+	}
+      else
+	bits = 0;
+
+      bits += carry;
+      carry = bits > half;
+      dp[i] = carry ? (int) bits - (int) (2*half) : (int) bits;
+    }
+  assert (carry == 0);
+}
+
+/* Computes r = sum_i u_i A_i + z_i R_i, for the k records starting at
+   first. Output in homogeneous coordinates. */
+static void
+batch_msm (struct eddsa_batch *b, size_t first, size_t k, mp_limb_t *r)
+{
+  const struct ecc_curve *ecc = b->ecc;
+  mp_size_t size = ecc->p.size;
+  unsigned bits = ecc->q.bit_size;
+  unsigned c = batch_window_size (2*k, bits);
+  unsigned windows = bits / c + 1;
+  size_t nbuckets = (size_t) 1 << (c - 1);
+  size_t npoints = 2*k;
+  size_t j;
+  unsigned w;
+
+  /* The first 8*size limbs of scratch are used by batch_check. */
+  mp_limb_t *sum = b->scratch + 8*size;
+  mp_limb_t *total = b->scratch + 11*size;
+  mp_limb_t *scratch_out = b->scratch + 14*size;
+
+  for (j = 0; j < npoints; j++)
+    batch_recode (b->digits + j * windows, windows, c,
+		  b->scalars + j * size, size);
+
+  /* x = 0, y = 1, z = 1 */
+  mpn_zero (r, 3*size);
+  mpn_copyi (r + size, ecc->unit, size);
+  mpn_copyi (r + 2*size, ecc->unit, size);
+
+  for (w = windows; w-- > 0; )
+    {
+      int have_sum, have_total;
+      size_t i;
+
+      if (w < windows - 1)
+	for (i = 0; i < c; i++)
+	  ecc->dup (ecc, r, r, scratch_out);
+
+      memset (b->used, 0, nbuckets);
+      for (j = 0; j < npoints; j++)
+	{
+	  int d = b->digits[j * windows + w];
+	  const mp_limb_t *p;
+	  mp_limb_t *bucket;
+	  size_t bi;
+
+	  if (!d)
+	    continue;
+
+	  /* Even points are A, odd points are R. */
+	  p = RECORD (b, first + j/2) + (j & 1) * 4*size;
+	  if (d < 0)
+	    {
+	      p += 2*size;
+	      d = -d;
+	    }
+	  bi = d - 1;
+	  bucket = b->buckets + bi * 3*size;
+	  if (b->used[bi])
+	    ecc->add_hh (ecc, bucket, bucket, p, scratch_out);
+	  else
+	    {
+	      mpn_copyi (bucket, p, 2*size);
+	      mpn_copyi (bucket + 2*size, ecc->unit, size);
+	      b->used[bi] = 1;
+	    }
+	}
+
+      /* Compute sum_i (i+1) B_i as a sum of partial sums. */
+      for (i = nbuckets, have_sum = have_total = 0; i-- > 0; )
+	{
+	  mp_limb_t *bucket = b->buckets + i * 3*size;
+	  if (b->used[i])
+	    {
+	      if (have_sum)
+		ecc->add_hhh (ecc, sum, sum, bucket, scratch_out);
+	      else
+		{
+		  mpn_copyi (sum, bucket, 3*size);
+		  have_sum = 1;
+		}
+	    }
+	  if (have_sum)
+	    {
+	      if (have_total)
+		ecc->add_hhh (ecc, total, total, sum, scratch_out);
+	      else
+		{
+		  mpn_copyi (total, sum, 3*size);
+		  have_total = 1;
+		}
+	    }
+	}
+      if (have_total)
+	ecc->add_hhh (ecc, r, r, total, scratch_out);
+    }
+}
+
+/* Checks the combined verification equation for the k records
+   starting at first. */
+static int
+batch_check (struct eddsa_batch *b, size_t first, size_t k)
+{
+  const struct ecc_curve *ecc = b->ecc;
+  mp_size_t size = ecc->p.size;
+  uint8_t zb[16];
+  mp_limb_t cofactor;
+  size_t i;
+
+#define M b->scratch
+#define T (b->scratch + 3*size)
+#define tp (b->scratch + 6*size)
+#define up (b->scratch + 7*size)
+#define scratch_out (b->scratch + 14*size)
+
+  mpn_zero (tp, size);
+  for (i = 0; i < k; i++)
+    {
+      const mp_limb_t *rp = RECORD (b, first + i);
+      mp_limb_t *zp = b->scalars + (2*i + 1) * size;
+      mp_limb_t cy;
+
+      b->random (b->random_ctx, sizeof (zb), zb);
+      mpn_set_base256_le (zp, size, zb, sizeof (zb));
+
+      ecc_mod_mul_canonical (&ecc->q, zp - size, zp, rp + 8*size, scratch_out);
+      ecc_mod_mul_canonical (&ecc->q, up, zp, rp + 9*size, scratch_out);
+      cy = mpn_add_n (tp, tp, up, size);
+      if (cy || mpn_cmp (tp, ecc->q.m, size) >= 0)
+	mpn_sub_n (tp, tp, ecc->q.m, size);
+    }
+
+  batch_msm (b, first, k, M);
+  ecc->mul_g (ecc, T, tp, scratch_out);
+
+  for (cofactor = ~b->eddsa->low_mask; cofactor > 1; cofactor >>= 1)
+    {
+      ecc->dup (ecc, M, M, scratch_out);
+      ecc->dup (ecc, T, T, scratch_out);
+    }
+
+  return _eddsa_equal_h (&ecc->p,
+			 M, M + 2*size,
+			 T, T + 2*size, scratch_out)
+    && _eddsa_equal_h (&ecc->p,
+		       M + size, M + 2*size,
+		       T + size, T + 2*size, scratch_out);
+#undef M
+#undef T
+#undef tp
+#undef up
+#undef scratch_out
+}
+
+/* Checks the k records starting at first. If the combined check
+   fails, and valid is non-NULL, bisect to identify the invalid
+   signatures. */
+static int
+batch_verify (struct eddsa_batch *b, size_t first, size_t k, int *valid)
+{
+  size_t i;
+  int res;
+
+  if (batch_check (b, first, k))
+    {
+      if (valid)
+	for (i = 0; i < k; i++)
+	  valid[b->index[first + i]] = 1;
+      return 1;
+    }
+  if (!valid)
+    return 0;
+
+  if (k == 1)
+    {
+      valid[b->index[first]] = 0;
+      return 0;
+    }
+  /* Evaluate both halves unconditionally, to fill in valid. */
+  res = batch_verify (b, first, k/2, valid);
+  return batch_verify (b, first + k/2, k - k/2, valid) & res;
+}
+
+int
+_eddsa_verify_batch (const struct ecc_curve *ecc,
+		     const struct ecc_eddsa *eddsa,
+		     void *ctx,
+		     size_t n, const uint8_t * const *pub,
+		     const size_t *length, const uint8_t * const *msg,
+		     const uint8_t * const *signature,
+		     void *random_ctx, nettle_random_func *random,
+		     int *valid)
+{
+  struct eddsa_batch b;
+  size_t max_chunk = n < EDDSA_BATCH_SIZE ? n : EDDSA_BATCH_SIZE;
+  mp_size_t size = ecc->p.size;
+  unsigned windows = ecc->q.bit_size / 2 + 1;
+  size_t nbuckets = (size_t) 1 << (EDDSA_BATCH_MAX_C - 1);
+  mp_size_t itch;
+  size_t done;
+  int res;
+
+  if (n == 0)
+    return 1;
+
+  /* Window size is at least 2, see batch_window_size. */
+  itch = (EDDSA_BATCH_RECORD + 2) * max_chunk * size
+    + 3 * nbuckets * size + batch_scratch_itch (ecc);
+
+  b.ecc = ecc;
+  b.eddsa = eddsa;
+  b.ctx = ctx;
+  b.random_ctx = random_ctx;
+  b.random = random;
+  b.records = gmp_alloc_limbs (itch);
+  b.scalars = b.records + EDDSA_BATCH_RECORD * max_chunk * size;
+  b.buckets = b.scalars + 2 * max_chunk * size;
+  b.scratch = b.buckets + 3 * nbuckets * size;
+  b.index = gmp_alloc (max_chunk * sizeof (*b.index));
+  b.digits = gmp_alloc (2 * max_chunk * windows);
+  b.used = gmp_alloc (nbuckets);
+
+  for (done = 0, res = 1; done < n; done += max_chunk)
+    {
+      size_t chunk = n - done < max_chunk ? n - done : max_chunk;
+      size_t i, k;
+
+      for (i = k = 0; i < chunk; i++)
+	{
+	  size_t j = done + i;
+	  if (batch_prepare (&b, k, pub[j], length[j], msg[j], signature[j]))
+	    b.index[k++] = j;
+	  else
+	    {
+	      res = 0;
+	      if (!valid)
+		goto done;
+	      valid[j] = 0;
+	    }
+	}
+      if (k > 0 && !batch_verify (&b, 0, k, valid))
+	{
+	  res = 0;
+	  if (!valid)
+	    goto done;
+	}
+    }
+ done:
+  gmp_free_limbs (b.records, itch);
+  gmp_free (b.index, max_chunk * sizeof (*b.index));
+  gmp_free (b.digits, 2 * max_chunk * windows);
+  gmp_free (b.used, nbuckets);
+
+  return res;
+}
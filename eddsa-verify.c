@@ -42,13 +42,11 @@
 #include "ecc-internal.h"
 #include "nettle-meta.h"
 
-/* Checks if x1/z1 == x2/z2 (mod p). Assumes z1 and z2 are
-   non-zero. */
-static int
-equal_h (const struct ecc_modulo *p,
-	 const mp_limb_t *x1, const mp_limb_t *z1,
-	 const mp_limb_t *x2, const mp_limb_t *z2,
-	 mp_limb_t *scratch)
+int
+_eddsa_equal_h (const struct ecc_modulo *p,
+		const mp_limb_t *x1, const mp_limb_t *z1,
+		const mp_limb_t *x2, const mp_limb_t *z2,
+		mp_limb_t *scratch)
 {
 #define t0 scratch
 #define t1 (scratch + p->size)
@@ -62,32 +60,25 @@ equal_h (const struct ecc_modulo *p,
 #undef t1
 }
 
-mp_size_t
-_eddsa_verify_itch (const struct ecc_curve *ecc)
-{
-  assert (_eddsa_decompress_itch (ecc) <= ecc->mul_itch);
-  return 8*ecc->p.size + ecc->mul_itch;
-}
-
-int
-_eddsa_verify (const struct ecc_curve *ecc,
-	       const struct ecc_eddsa *eddsa,
-	       const uint8_t *pub,
-	       const mp_limb_t *A,
-	       void *ctx,
-	       size_t length,
-	       const uint8_t *msg,
-	       const uint8_t *signature,
-	       mp_limb_t *scratch)
+/* Decodes R and s from the signature, and computes h, storing R at
+   scratch, s at scratch + 2*size and h at scratch + 3*size. Returns
+   0 if R or s is invalid. Needs 8*size of scratch, and at least
+   2*size + _eddsa_decompress_itch. */
+static int
+eddsa_verify_decode (const struct ecc_curve *ecc,
+		     const struct ecc_eddsa *eddsa,
+		     const uint8_t *pub,
+		     void *ctx,
+		     size_t length,
+		     const uint8_t *msg,
+		     const uint8_t *signature,
+		     mp_limb_t *scratch)
 {
   size_t nbytes;
 #define R scratch
 #define sp (scratch + 2*ecc->p.size)
 #define hp (scratch + 3*ecc->p.size)
-#define P (scratch + 5*ecc->p.size)
-#define scratch_out (scratch + 8*ecc->p.size)
-#define S R
-#define hash ((uint8_t *) P)
+#define hash ((uint8_t *) (scratch + 5*ecc->p.size))
 
   nbytes = 1 + ecc->p.bit_size / 8;
 
@@ -111,24 +102,131 @@ _eddsa_verify (const struct ecc_curve *ecc,
   eddsa->update (ctx, length, msg);
   eddsa->digest (ctx, hash);
   _eddsa_hash (&ecc->q, hp, 2*nbytes, hash);
+  return 1;
+#undef R
+#undef sp
+#undef hp
+#undef hash
+}
+
+/* Checks if the point P, in homogeneous coordinates, equals the
+   affine point R. */
+static int
+equal_a (const struct ecc_curve *ecc,
+	 const mp_limb_t *P, const mp_limb_t *R,
+	 mp_limb_t *scratch)
+{
+  return _eddsa_equal_h (&ecc->p,
+			 P, P + 2*ecc->p.size,
+			 R, ecc->unit, scratch)
+    && _eddsa_equal_h (&ecc->p,
+		       P + ecc->p.size, P + 2*ecc->p.size,
+		       R + ecc->p.size, ecc->unit, scratch);
+}
+
+mp_size_t
+_eddsa_verify_itch (const struct ecc_curve *ecc)
+{
+  assert (_eddsa_decompress_itch (ecc)
+	  <= ECC_NONSEC_MUL_GA_EH_ITCH (ecc->p.size));
+  return 10*ecc->p.size + ECC_NONSEC_MUL_GA_EH_ITCH (ecc->p.size);
+}
+
+int
+_eddsa_verify (const struct ecc_curve *ecc,
+	       const struct ecc_eddsa *eddsa,
+	       const uint8_t *pub,
+	       const mp_limb_t *A,
+	       void *ctx,
+	       size_t length,
+	       const uint8_t *msg,
+	       const uint8_t *signature,
+	       mp_limb_t *scratch)
+{
+#define R scratch
+#define sp (scratch + 2*ecc->p.size)
+#define hp (scratch + 3*ecc->p.size)
+#define P (scratch + 5*ecc->p.size)
+#define negA (scratch + 8*ecc->p.size)
+#define scratch_out (scratch + 10*ecc->p.size)
+
+  if (!eddsa_verify_decode (ecc, eddsa, pub, ctx, length, msg, signature,
+			    scratch))
+    return 0;
+
+  /* Compute s G - h A, which should equal R. Everything here is
+     public, so use the faster variable time multiplication. */
+  ecc_mod_sub (&ecc->p, negA, ecc->p.m, A);
+  mpn_copyi (negA + ecc->p.size, A + ecc->p.size, ecc->p.size);
+  ecc_nonsec_mul_ga_eh (ecc, P, sp, hp, negA, scratch_out);
+
+  return equal_a (ecc, P, R, scratch_out);
+
+#undef R
+#undef sp
+#undef hp
+#undef P
+#undef negA
+#undef scratch_out
+}
+
+mp_size_t
+_eddsa_table_init_itch (const struct ecc_curve *ecc)
+{
+  return 2*ecc->p.size + ECC_NONSEC_TABLE_INIT_ITCH (ecc);
+}
+
+void
+_eddsa_table_init (const struct ecc_curve *ecc,
+		   mp_limb_t *T, const mp_limb_t *A,
+		   mp_limb_t *scratch)
+{
+#define negA scratch
+#define scratch_out (scratch + 2*ecc->p.size)
+  /* The table is for -A, so that verification needs no negation. */
+  ecc_mod_sub (&ecc->p, negA, ecc->p.m, A);
+  mpn_copyi (negA + ecc->p.size, A + ecc->p.size, ecc->p.size);
+  ecc_nonsec_table_init (ecc, T, negA, scratch_out);
+#undef negA
+#undef scratch_out
+}
+
+mp_size_t
+_eddsa_verify_table_itch (const struct ecc_curve *ecc)
+{
+  assert (_eddsa_decompress_itch (ecc)
+	  <= ECC_NONSEC_MUL_GT_ITCH (ecc->p.size));
+  return 8*ecc->p.size + ECC_NONSEC_MUL_GT_ITCH (ecc->p.size);
+}
+
+int
+_eddsa_verify_table (const struct ecc_curve *ecc,
+		     const struct ecc_eddsa *eddsa,
+		     const uint8_t *pub,
+		     const mp_limb_t *T,
+		     void *ctx,
+		     size_t length,
+		     const uint8_t *msg,
+		     const uint8_t *signature,
+		     mp_limb_t *scratch)
+{
+#define R scratch
+#define sp (scratch + 2*ecc->p.size)
+#define hp (scratch + 3*ecc->p.size)
+#define P (scratch + 5*ecc->p.size)
+#define scratch_out (scratch + 8*ecc->p.size)
+
+  if (!eddsa_verify_decode (ecc, eddsa, pub, ctx, length, msg, signature,
+			    scratch))
+    return 0;
 
-  /* Compute h A + R - s G, which should be the neutral point */
-  ecc->mul (ecc, P, hp, A, scratch_out);
-  ecc->add_hh (ecc, P, P, R, scratch_out);
-  /* Move out of the way. */
-  mpn_copyi (hp, sp, ecc->q.size);
-  ecc->mul_g (ecc, S, hp, scratch_out);
+  ecc_nonsec_mul_gt (ecc, P, sp, hp, T, scratch_out);
 
-  return equal_h (&ecc->p,
-		   P, P + 2*ecc->p.size,
-		   S, S + 2*ecc->p.size, scratch_out)
-    && equal_h (&ecc->p,
-		P + ecc->p.size, P + 2*ecc->p.size,
-		S + ecc->p.size, S + 2*ecc->p.size, scratch_out);
+  return equal_a (ecc, P, R, scratch_out);
 
 #undef R
 #undef sp
 #undef hp
 #undef P
-#undef S
+#undef scratch_out
 }
@@ -45,9 +45,24 @@ extern "C" {
 #define ed25519_sha512_public_key nettle_ed25519_sha512_public_key
 #define ed25519_sha512_sign nettle_ed25519_sha512_sign
 #define ed25519_sha512_verify nettle_ed25519_sha512_verify
+#define ed25519_sha512_verify_batch nettle_ed25519_sha512_verify_batch
+#define ed25519_sha512_public_table_init nettle_ed25519_sha512_public_table_init
+#define ed25519_sha512_public_table_clear nettle_ed25519_sha512_public_table_clear
+#define ed25519_sha512_verify_table nettle_ed25519_sha512_verify_table
 #define ed448_shake256_public_key nettle_ed448_shake256_public_key
 #define ed448_shake256_sign nettle_ed448_shake256_sign
 #define ed448_shake256_verify nettle_ed448_shake256_verify
+#define ed448_shake256_public_table_init nettle_ed448_shake256_public_table_init
+#define ed448_shake256_public_table_clear nettle_ed448_shake256_public_table_clear
+#define ed448_shake256_verify_table nettle_ed448_shake256_verify_table
+#define ecc_ed25519_sha512_sign nettle_ecc_ed25519_sha512_sign
+#define ecc_ed25519_sha512_sign_itch nettle_ecc_ed25519_sha512_sign_itch
+#define ecc_ed25519_sha512_verify nettle_ecc_ed25519_sha512_verify
+#define ecc_ed25519_sha512_verify_itch nettle_ecc_ed25519_sha512_verify_itch
+#define ecc_ed448_shake256_sign nettle_ecc_ed448_shake256_sign
+#define ecc_ed448_shake256_sign_itch nettle_ecc_ed448_shake256_sign_itch
+#define ecc_ed448_shake256_verify nettle_ecc_ed448_shake256_verify
+#define ecc_ed448_shake256_verify_itch nettle_ecc_ed448_shake256_verify_itch
 
 #define ED25519_KEY_SIZE 32
 #define ED25519_SIGNATURE_SIZE 64
@@ -66,6 +81,35 @@ ed25519_sha512_verify (const uint8_t *pub,
 		       size_t length, const uint8_t *msg,
 		       const uint8_t *signature);
 
+int
+ed25519_sha512_verify_batch (size_t n, const uint8_t * const *pub,
+			     const size_t *length,
+			     const uint8_t * const *msg,
+			     const uint8_t * const *signature,
+			     void *random_ctx, nettle_random_func *random,
+			     int *valid);
+
+/* Precomputed tables for a public key, making verification faster
+   when many signatures are verified using the same key. */
+struct ed25519_public_table
+{
+  uint8_t pub[ED25519_KEY_SIZE];
+  mp_limb_t *p;
+};
+
+/* Returns 0 if the public key is invalid. */
+int
+ed25519_sha512_public_table_init (struct ed25519_public_table *table,
+				  const uint8_t *pub);
+
+void
+ed25519_sha512_public_table_clear (struct ed25519_public_table *table);
+
+int
+ed25519_sha512_verify_table (const struct ed25519_public_table *table,
+			     size_t length, const uint8_t *msg,
+			     const uint8_t *signature);
+
 #define ED448_KEY_SIZE 57
 #define ED448_SIGNATURE_SIZE 114
 
@@ -82,7 +126,65 @@ int
 ed448_shake256_verify (const uint8_t *pub,
 		       size_t length, const uint8_t *msg,
 		       const uint8_t *signature);
-			   
+
+struct ed448_public_table
+{
+  uint8_t pub[ED448_KEY_SIZE];
+  mp_limb_t *p;
+};
+
+int
+ed448_shake256_public_table_init (struct ed448_public_table *table,
+				  const uint8_t *pub);
+
+void
+ed448_shake256_public_table_clear (struct ed448_public_table *table);
+
+int
+ed448_shake256_verify_table (const struct ed448_public_table *table,
+			     size_t length, const uint8_t *msg,
+			     const uint8_t *signature);
+
+/* Low-level functions, using caller-provided scratch space of the
+   size returned by the corresponding _itch function. */
+mp_size_t
+ecc_ed25519_sha512_sign_itch (void);
+
+void
+ecc_ed25519_sha512_sign (const uint8_t *pub,
+			 const uint8_t *priv,
+			 size_t length, const uint8_t *msg,
+			 uint8_t *signature,
+			 mp_limb_t *scratch);
+
+mp_size_t
+ecc_ed25519_sha512_verify_itch (void);
+
+int
+ecc_ed25519_sha512_verify (const uint8_t *pub,
+			   size_t length, const uint8_t *msg,
+			   const uint8_t *signature,
+			   mp_limb_t *scratch);
+
+mp_size_t
+ecc_ed448_shake256_sign_itch (void);
+
+void
+ecc_ed448_shake256_sign (const uint8_t *pub,
+			 const uint8_t *priv,
+			 size_t length, const uint8_t *msg,
+			 uint8_t *signature,
+			 mp_limb_t *scratch);
+
+mp_size_t
+ecc_ed448_shake256_verify_itch (void);
+
+int
+ecc_ed448_shake256_verify (const uint8_t *pub,
+			   size_t length, const uint8_t *msg,
+			   const uint8_t *signature,
+			   mp_limb_t *scratch);
+
 #ifdef __cplusplus
 }
 #endif
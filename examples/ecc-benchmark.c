@@ -251,6 +251,8 @@ bench_curve (const struct ecc_curve *ecc)
 
   mp_limb_t mask;
   mp_size_t itch;
+  unsigned g_rows;
+  double g_kb;
 
   ctx.ecc = ecc;
   ctx.rp = xalloc_limbs (3*ecc->p.size);
@@ -306,11 +308,18 @@ bench_curve (const struct ecc_curve *ecc)
   free (ctx.bp);
   free (ctx.tp);
 
-  printf ("%4d %6.4f %6.4f %6.4f %6.2f %6.2f %6.3f %6.2f %6.3f %6.3f %6.3f %6.1f %6.1f\n",
+  /* Size of the ecc_mul_g tables, depending on the configured k and
+     c. */
+  g_rows = (ecc->p.bit_size + ecc->pippenger_k - 1) / ecc->pippenger_k;
+  g_kb = (double) ((g_rows + ecc->pippenger_c - 1) / ecc->pippenger_c)
+    * (2*ecc->p.size << ecc->pippenger_c) * sizeof (mp_limb_t) / 1024;
+
+  printf ("%4d %6.4f %6.4f %6.4f %6.2f %6.2f %6.3f %6.2f %6.3f %6.3f %6.3f %6.1f %6.1f %2d %1d %4.0f\n",
 	  ecc->p.bit_size, 1e6 * modp, 1e6 * reduce, 1e6 * modq,
 	  1e6 * pinv, 1e6 * qinv, 1e6 * modinv_gcd, 1e6 * modinv_powm,
 	  1e6 * dup_hh, 1e6 * add_hh, 1e6 * add_hhh,
-	  1e6 * mul_g, 1e6 * mul_a);
+	  1e6 * mul_g, 1e6 * mul_a,
+	  ecc->pippenger_k, ecc->pippenger_c, g_kb);
 }
 
 const struct ecc_curve * const curves[] = {
@@ -333,10 +342,10 @@ main (int argc UNUSED, char **argv UNUSED)
   unsigned i;
 
   time_init();
-  printf ("%4s %6s %6s %6s %6s %6s %6s %6s %6s %6s %6s %6s %6s (us)\n",
+  printf ("%4s %6s %6s %6s %6s %6s %6s %6s %6s %6s %6s %6s %6s %2s %1s %4s (us, KB)\n",
 	  "size", "modp", "reduce", "modq", "pinv", "qinv", "mi_gcd", "mi_pow",
 	  "dup_hh", "add_hh", "ad_hhh",
-	  "mul_g", "mul_a");
+	  "mul_g", "mul_a", "k", "c", "g_kb");
   for (i = 0; i < numberof (curves); i++)
     bench_curve (curves[i]);
 
@@ -964,11 +964,217 @@ bench_slh_dsa_clear (void *p)
   free (ctx);
 }
 
+struct rsa_prepared_ctx
+{
+  struct rsa_ctx *rsa;
+  struct rsa_prepared_key prep;
+};
+
+static void *
+bench_rsa_prepared_init (unsigned size)
+{
+  struct rsa_prepared_ctx *ctx;
+
+  ctx = xalloc(sizeof(*ctx));
+  ctx->rsa = bench_rsa_init (size);
+
+  if (!rsa_prepared_key_init (&ctx->prep, &ctx->rsa->pub, &ctx->rsa->key))
+    die ("Internal error, rsa_prepared_key_init failed.\n");
+
+  if (!rsa_prepared_pkcs1_sign_tr (&ctx->prep, &ctx->rsa->lfib,
+				   (nettle_random_func *) knuth_lfib_random,
+				   SHA256_DIGEST_SIZE, ctx->rsa->digest,
+				   ctx->rsa->s))
+    die ("Internal error, rsa_prepared_pkcs1_sign_tr failed.\n");
+
+  return ctx;
+}
+
+static void
+bench_rsa_prepared_sign (void *p)
+{
+  struct rsa_prepared_ctx *ctx = p;
+
+  mpz_t s;
+  mpz_init (s);
+  rsa_prepared_pkcs1_sign_tr (&ctx->prep, &ctx->rsa->lfib,
+			      (nettle_random_func *) knuth_lfib_random,
+			      SHA256_DIGEST_SIZE, ctx->rsa->digest, s);
+  mpz_clear (s);
+}
+
+static void
+bench_rsa_prepared_verify (void *p)
+{
+  struct rsa_prepared_ctx *ctx = p;
+  if (! rsa_prepared_pkcs1_verify (&ctx->prep, SHA256_DIGEST_SIZE,
+				   ctx->rsa->digest, ctx->rsa->s))
+    die ("Internal error, rsa_prepared_pkcs1_verify failed.\n");
+}
+
+static void
+bench_rsa_prepared_clear (void *p)
+{
+  struct rsa_prepared_ctx *ctx = p;
+
+  rsa_prepared_key_clear (&ctx->prep);
+  bench_rsa_clear (ctx->rsa);
+  free (ctx);
+}
+
+struct rsa_multi_ctx
+{
+  struct rsa_public_key pub;
+  struct rsa_multi_private_key key;
+  struct knuth_lfib_ctx lfib;
+  uint8_t *digest;
+  mpz_t s;
+};
+
+static void *
+bench_rsa_multi_init (unsigned size, unsigned nprimes)
+{
+  struct rsa_multi_ctx *ctx;
+
+  ctx = xalloc(sizeof(*ctx));
+
+  rsa_public_key_init (&ctx->pub);
+  rsa_multi_private_key_init (&ctx->key);
+  mpz_init (ctx->s);
+  knuth_lfib_init (&ctx->lfib, 1);
+
+  mpz_set_ui (ctx->pub.e, 65537);
+  if (!rsa_multi_generate_keypair (&ctx->pub, &ctx->key,
+				   &ctx->lfib, (nettle_random_func *) knuth_lfib_random,
+				   NULL, NULL, size, 0, nprimes))
+    die ("Internal error, rsa_multi_generate_keypair failed.\n");
+
+  ctx->digest = hash_string (&nettle_sha256, "foo");
+
+  if (!rsa_multi_pkcs1_sign_tr (&ctx->pub, &ctx->key,
+				&ctx->lfib, (nettle_random_func *) knuth_lfib_random,
+				SHA256_DIGEST_SIZE, ctx->digest, ctx->s))
+    die ("Internal error, rsa_multi_pkcs1_sign_tr failed.\n");
+
+  return ctx;
+}
+
+static void *
+bench_rsa_2p_init (unsigned size)
+{
+  return bench_rsa_multi_init (size, 2);
+}
+
+static void *
+bench_rsa_3p_init (unsigned size)
+{
+  return bench_rsa_multi_init (size, 3);
+}
+
+static void *
+bench_rsa_4p_init (unsigned size)
+{
+  return bench_rsa_multi_init (size, 4);
+}
+
+static void
+bench_rsa_multi_sign (void *p)
+{
+  struct rsa_multi_ctx *ctx = p;
+
+  mpz_t s;
+  mpz_init (s);
+  rsa_multi_pkcs1_sign_tr (&ctx->pub, &ctx->key,
+			   &ctx->lfib, (nettle_random_func *) knuth_lfib_random,
+			   SHA256_DIGEST_SIZE, ctx->digest, s);
+  mpz_clear (s);
+}
+
+static void
+bench_rsa_multi_verify (void *p)
+{
+  struct rsa_multi_ctx *ctx = p;
+  if (! rsa_pkcs1_verify (&ctx->pub, SHA256_DIGEST_SIZE, ctx->digest, ctx->s))
+    die ("Internal error, rsa_pkcs1_verify failed.\n");
+}
+
+static void
+bench_rsa_multi_clear (void *p)
+{
+  struct rsa_multi_ctx *ctx = p;
+
+  rsa_public_key_clear (&ctx->pub);
+  rsa_multi_private_key_clear (&ctx->key);
+  mpz_clear (ctx->s);
+
+  free (ctx->digest);
+  free (ctx);
+}
+
+struct rsa_keygen_ctx
+{
+  unsigned size;
+  struct rsa_public_key pub;
+  struct rsa_private_key key;
+  struct knuth_lfib_ctx lfib;
+};
+
+static void
+bench_rsa_keygen_generate (void *p)
+{
+  struct rsa_keygen_ctx *ctx = p;
+  mpz_set_ui (ctx->pub.e, 65537);
+  if (!rsa_generate_keypair (&ctx->pub, &ctx->key,
+			     &ctx->lfib, (nettle_random_func *) knuth_lfib_random,
+			     NULL, NULL, ctx->size, 0))
+    die ("Internal error, rsa_generate_keypair failed.\n");
+}
+
+/* Generates a single prime of half the size, the work of each thread
+   when p and q are generated in parallel. */
+static void
+bench_rsa_keygen_prime (void *p)
+{
+  struct rsa_keygen_ctx *ctx = p;
+  rsa_generate_prime (ctx->key.p, ctx->size / 2, ctx->pub.e,
+		      &ctx->lfib, (nettle_random_func *) knuth_lfib_random,
+		      NULL, NULL);
+}
+
+static void
+bench_rsa_keygen (unsigned size)
+{
+  struct rsa_keygen_ctx ctx;
+  double keypair, prime;
+
+  ctx.size = size;
+  rsa_public_key_init (&ctx.pub);
+  rsa_private_key_init (&ctx.key);
+  knuth_lfib_init (&ctx.lfib, 1);
+  mpz_set_ui (ctx.pub.e, 65537);
+
+  keypair = time_function (bench_rsa_keygen_generate, &ctx);
+  prime = time_function (bench_rsa_keygen_prime, &ctx);
+
+  rsa_public_key_clear (&ctx.pub);
+  rsa_private_key_clear (&ctx.key);
+
+  printf ("%16s %4d %9.2f %9.2f\n",
+	  "rsa-keygen", size, 1.0/keypair, 1.0/prime);
+}
+
 struct alg alg_list[] = {
   { "rsa",   1024, bench_rsa_init,   bench_rsa_sign,   bench_rsa_verify,   bench_rsa_clear },
   { "rsa",   2048, bench_rsa_init,   bench_rsa_sign,   bench_rsa_verify,   bench_rsa_clear },
   { "rsa-tr",   1024, bench_rsa_init,   bench_rsa_sign_tr,   bench_rsa_verify,   bench_rsa_clear },
   { "rsa-tr",   2048, bench_rsa_init,   bench_rsa_sign_tr,   bench_rsa_verify,   bench_rsa_clear },
+  { "rsa-prepared", 1024, bench_rsa_prepared_init, bench_rsa_prepared_sign, bench_rsa_prepared_verify, bench_rsa_prepared_clear },
+  { "rsa-prepared", 2048, bench_rsa_prepared_init, bench_rsa_prepared_sign, bench_rsa_prepared_verify, bench_rsa_prepared_clear },
+  { "rsa-2p",   3072, bench_rsa_2p_init, bench_rsa_multi_sign, bench_rsa_multi_verify, bench_rsa_multi_clear },
+  { "rsa-3p",   3072, bench_rsa_3p_init, bench_rsa_multi_sign, bench_rsa_multi_verify, bench_rsa_multi_clear },
+  { "rsa-2p",   4096, bench_rsa_2p_init, bench_rsa_multi_sign, bench_rsa_multi_verify, bench_rsa_multi_clear },
+  { "rsa-3p",   4096, bench_rsa_3p_init, bench_rsa_multi_sign, bench_rsa_multi_verify, bench_rsa_multi_clear },
+  { "rsa-4p",   4096, bench_rsa_4p_init, bench_rsa_multi_sign, bench_rsa_multi_verify, bench_rsa_multi_clear },
 #if WITH_OPENSSL
   { "rsa (openssl)",  1024, bench_openssl_rsa_init, bench_openssl_sign, bench_openssl_verify, bench_openssl_clear },
   { "rsa (openssl)",  2048, bench_openssl_rsa_init, bench_openssl_sign, bench_openssl_verify, bench_openssl_clear },
@@ -1020,5 +1226,13 @@ main (int argc, char **argv)
     if (!filter || strstr (alg_list[i].name, filter))
       bench_alg (&alg_list[i]);
 
+  if (!filter || strstr ("rsa-keygen", filter))
+    {
+      printf ("%16s %4s %9s %9s\n",
+	      "name", "size", "keys/s", "primes/s");
+      bench_rsa_keygen (1024);
+      bench_rsa_keygen (2048);
+    }
+
   return EXIT_SUCCESS;
 }
@@ -186,9 +186,17 @@ typedef void sha1_compress_func(uint32_t *state, const uint8_t *input);
 typedef const uint8_t *
 sha256_compress_n_func(uint32_t *state, const uint32_t *k,
 		       size_t blocks, const uint8_t *input);
+typedef void digest_many_func(size_t n, const size_t *length,
+			      const uint8_t * const *data, uint8_t *digest);
+typedef void sha256_many_func(const uint32_t *state, uint64_t count,
+			      size_t n, const size_t *length,
+			      const uint8_t * const *data, uint8_t *digest);
 
 struct sha3_state;
 typedef void sha3_permute_func (struct sha3_state *state);
+typedef void shake_many_func (size_t n, const size_t *length,
+			      const uint8_t * const *data,
+			      size_t output_length, uint8_t *output);
 
 typedef void sha512_compress_func (uint64_t *state, const uint8_t *input, const uint64_t *k);
 
@@ -235,3 +243,20 @@ typedef void cbc_aes192_encrypt_func (const struct aes192_ctx *ctx, uint8_t *iv,
 				      size_t length, uint8_t *dst, const uint8_t *src);
 typedef void cbc_aes256_encrypt_func (const struct aes256_ctx *ctx, uint8_t *iv,
 				      size_t length, uint8_t *dst, const uint8_t *src);
+typedef void cbc_aes128_decrypt_func (const struct aes128_ctx *ctx, uint8_t *iv,
+				      size_t length, uint8_t *dst, const uint8_t *src);
+typedef void cbc_aes192_decrypt_func (const struct aes192_ctx *ctx, uint8_t *iv,
+				      size_t length, uint8_t *dst, const uint8_t *src);
+typedef void cbc_aes256_decrypt_func (const struct aes256_ctx *ctx, uint8_t *iv,
+				      size_t length, uint8_t *dst, const uint8_t *src);
+
+struct ocb_ctx;
+typedef size_t
+ocb_aes128_crypt_n_func (struct ocb_ctx *ctx, const struct aes128_ctx *cipher,
+			 const union nettle_block16 *L,
+			 size_t n, uint8_t *dst, const uint8_t *src);
+
+struct ccm_ctx;
+typedef size_t
+ccm_aes128_crypt_n_func (struct ccm_ctx *ctx, const struct aes128_ctx *cipher,
+			 size_t n, uint8_t *dst, const uint8_t *src);
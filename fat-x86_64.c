@@ -43,11 +43,18 @@
 #include "nettle-types.h"
 
 #include "aes-internal.h"
+#include "chacha-internal.h"
 #include "ghash-internal.h"
+#include "gcm-internal.h"
+#include "md-many-internal.h"
 #include "memxor.h"
+#include "ocb-internal.h"
+#include "ccm-internal.h"
+#include "poly1305-internal.h"
 #include "fat-setup.h"
 
 void _nettle_cpuid (uint32_t input, uint32_t regs[4]);
+uint64_t _nettle_xgetbv (uint32_t xcr);
 
 struct x86_features
 {
@@ -55,8 +62,21 @@ struct x86_features
   int have_aesni;
   int have_sha_ni;
   int have_pclmul;
+  int have_bmi2;
+  /* Set only if also supported by the operating system, i.e., if the
+     corresponding register state is saved on context switch. */
+  int have_avx2;
+  int have_avx512;
+  int have_vaes;
+  int have_vpclmul;
+  int have_ifma;
 };
 
+/* Bits in the xcr0 register. */
+#define XCR0_SSE 0x02
+#define XCR0_AVX 0x04
+#define XCR0_AVX512 0xe0
+
 #define SKIP(s, slen, literal, llen)				\
   (((slen) >= (llen) && memcmp ((s), (literal), llen) == 0)	\
    ? ((slen) -= (llen), (s) += (llen), 1) : 0)
@@ -71,6 +91,12 @@ get_x86_features (struct x86_features *features)
   features->have_aesni = 0;
   features->have_sha_ni = 0;
   features->have_pclmul = 0;
+  features->have_bmi2 = 0;
+  features->have_avx2 = 0;
+  features->have_avx512 = 0;
+  features->have_vaes = 0;
+  features->have_vpclmul = 0;
+  features->have_ifma = 0;
 
   s = secure_getenv (ENV_OVERRIDE);
   if (s)
@@ -93,6 +119,18 @@ get_x86_features (struct x86_features *features)
 	  features->have_sha_ni = 1;
 	else if (MATCH (s, length, "pclmul", 6))
 	  features->have_pclmul = 1;
+	else if (MATCH (s, length, "bmi2", 4))
+	  features->have_bmi2 = 1;
+	else if (MATCH (s, length, "avx2", 4))
+	  features->have_avx2 = 1;
+	else if (MATCH (s, length, "avx512", 6))
+	  features->have_avx512 = 1;
+	else if (MATCH (s, length, "vaes", 4))
+	  features->have_vaes = 1;
+	else if (MATCH (s, length, "vpclmul", 7))
+	  features->have_vpclmul = 1;
+	else if (MATCH (s, length, "ifma", 4))
+	  features->have_ifma = 1;
 	if (!sep)
 	  break;
 	s = sep + 1;
@@ -100,7 +138,11 @@ get_x86_features (struct x86_features *features)
   else
     {
       uint32_t cpuid_data[4];
+      uint32_t max_leaf;
+      uint64_t xcr0 = 0;
+
       _nettle_cpuid (0, cpuid_data);
+      max_leaf = cpuid_data[0];
       if (memcmp (cpuid_data + 1, "Genu" "ntel" "ineI", 12) == 0)
 	features->vendor = X86_INTEL;
       else if (memcmp (cpuid_data + 1, "Auth" "cAMD" "enti", 12) == 0)
@@ -111,10 +153,33 @@ get_x86_features (struct x86_features *features)
 	features->have_pclmul = 1;
       if (cpuid_data[2] & 0x02000000)
 	features->have_aesni = 1;
-
-      _nettle_cpuid (7, cpuid_data);
-      if (cpuid_data[1] & 0x20000000)
-	features->have_sha_ni = 1;
+      /* The osxsave bit says if xgetbv can be used. */
+      if (cpuid_data[2] & 0x08000000)
+	xcr0 = _nettle_xgetbv (0);
+
+      if (max_leaf >= 7)
+	{
+	  int os_avx = (xcr0 & (XCR0_SSE | XCR0_AVX)) == (XCR0_SSE | XCR0_AVX);
+	  int os_avx512 = os_avx && (xcr0 & XCR0_AVX512) == XCR0_AVX512;
+
+	  _nettle_cpuid (7, cpuid_data);
+	  if (cpuid_data[1] & 0x20000000)
+	    features->have_sha_ni = 1;
+	  if (cpuid_data[1] & 0x100)
+	    features->have_bmi2 = 1;
+	  if (os_avx && (cpuid_data[1] & 0x20))
+	    features->have_avx2 = 1;
+	  /* Require the avx512f, avx512bw and avx512vl subsets. */
+	  if (os_avx512
+	      && (cpuid_data[1] & 0xc0010000) == 0xc0010000)
+	    features->have_avx512 = 1;
+	  if (os_avx512 && (cpuid_data[1] & 0x00200000))
+	    features->have_ifma = 1;
+	  if (os_avx && (cpuid_data[2] & 0x200))
+	    features->have_vaes = 1;
+	  if (os_avx && (cpuid_data[2] & 0x400))
+	    features->have_vpclmul = 1;
+	}
     }
 }
 
@@ -122,20 +187,39 @@ DECLARE_FAT_FUNC(nettle_aes128_encrypt, aes128_crypt_func)
 DECLARE_FAT_FUNC(nettle_aes128_decrypt, aes128_crypt_func)
 DECLARE_FAT_FUNC_VAR(aes128_encrypt, aes128_crypt_func, c)
 DECLARE_FAT_FUNC_VAR(aes128_encrypt, aes128_crypt_func, aesni)
+DECLARE_FAT_FUNC_VAR(aes128_encrypt, aes128_crypt_func, vaes)
+DECLARE_FAT_FUNC_VAR(aes128_encrypt, aes128_crypt_func, avx512)
 DECLARE_FAT_FUNC_VAR(aes128_decrypt, aes128_crypt_func, c)
 DECLARE_FAT_FUNC_VAR(aes128_decrypt, aes128_crypt_func, aesni)
+DECLARE_FAT_FUNC_VAR(aes128_decrypt, aes128_crypt_func, vaes)
+DECLARE_FAT_FUNC_VAR(aes128_decrypt, aes128_crypt_func, avx512)
 DECLARE_FAT_FUNC(nettle_aes192_encrypt, aes192_crypt_func)
 DECLARE_FAT_FUNC(nettle_aes192_decrypt, aes192_crypt_func)
 DECLARE_FAT_FUNC_VAR(aes192_encrypt, aes192_crypt_func, c)
 DECLARE_FAT_FUNC_VAR(aes192_encrypt, aes192_crypt_func, aesni)
+DECLARE_FAT_FUNC_VAR(aes192_encrypt, aes192_crypt_func, vaes)
+DECLARE_FAT_FUNC_VAR(aes192_encrypt, aes192_crypt_func, avx512)
 DECLARE_FAT_FUNC_VAR(aes192_decrypt, aes192_crypt_func, c)
 DECLARE_FAT_FUNC_VAR(aes192_decrypt, aes192_crypt_func, aesni)
+DECLARE_FAT_FUNC_VAR(aes192_decrypt, aes192_crypt_func, vaes)
+DECLARE_FAT_FUNC_VAR(aes192_decrypt, aes192_crypt_func, avx512)
 DECLARE_FAT_FUNC(nettle_aes256_encrypt, aes256_crypt_func)
 DECLARE_FAT_FUNC(nettle_aes256_decrypt, aes256_crypt_func)
 DECLARE_FAT_FUNC_VAR(aes256_encrypt, aes256_crypt_func, c)
 DECLARE_FAT_FUNC_VAR(aes256_encrypt, aes256_crypt_func, aesni)
+DECLARE_FAT_FUNC_VAR(aes256_encrypt, aes256_crypt_func, vaes)
+DECLARE_FAT_FUNC_VAR(aes256_encrypt, aes256_crypt_func, avx512)
 DECLARE_FAT_FUNC_VAR(aes256_decrypt, aes256_crypt_func, c)
 DECLARE_FAT_FUNC_VAR(aes256_decrypt, aes256_crypt_func, aesni)
+DECLARE_FAT_FUNC_VAR(aes256_decrypt, aes256_crypt_func, vaes)
+DECLARE_FAT_FUNC_VAR(aes256_decrypt, aes256_crypt_func, avx512)
+
+DECLARE_FAT_FUNC(nettle_aes128_set_encrypt_key, aes128_set_key_func)
+DECLARE_FAT_FUNC_VAR(aes128_set_encrypt_key, aes128_set_key_func, c)
+DECLARE_FAT_FUNC_VAR(aes128_set_encrypt_key, aes128_set_key_func, aesni)
+DECLARE_FAT_FUNC(nettle_aes256_set_encrypt_key, aes256_set_key_func)
+DECLARE_FAT_FUNC_VAR(aes256_set_encrypt_key, aes256_set_key_func, c)
+DECLARE_FAT_FUNC_VAR(aes256_set_encrypt_key, aes256_set_key_func, aesni)
 
 DECLARE_FAT_FUNC(nettle_cbc_aes128_encrypt, cbc_aes128_encrypt_func)
 DECLARE_FAT_FUNC_VAR(cbc_aes128_encrypt, cbc_aes128_encrypt_func, c)
@@ -146,6 +230,18 @@ DECLARE_FAT_FUNC_VAR(cbc_aes192_encrypt, cbc_aes192_encrypt_func, aesni)
 DECLARE_FAT_FUNC(nettle_cbc_aes256_encrypt, cbc_aes256_encrypt_func)
 DECLARE_FAT_FUNC_VAR(cbc_aes256_encrypt, cbc_aes256_encrypt_func, c)
 DECLARE_FAT_FUNC_VAR(cbc_aes256_encrypt, cbc_aes256_encrypt_func, aesni)
+DECLARE_FAT_FUNC(nettle_cbc_aes128_decrypt, cbc_aes128_decrypt_func)
+DECLARE_FAT_FUNC_VAR(cbc_aes128_decrypt, cbc_aes128_decrypt_func, c)
+DECLARE_FAT_FUNC_VAR(cbc_aes128_decrypt, cbc_aes128_decrypt_func, aesni)
+DECLARE_FAT_FUNC_VAR(cbc_aes128_decrypt, cbc_aes128_decrypt_func, vaes)
+DECLARE_FAT_FUNC(nettle_cbc_aes192_decrypt, cbc_aes192_decrypt_func)
+DECLARE_FAT_FUNC_VAR(cbc_aes192_decrypt, cbc_aes192_decrypt_func, c)
+DECLARE_FAT_FUNC_VAR(cbc_aes192_decrypt, cbc_aes192_decrypt_func, aesni)
+DECLARE_FAT_FUNC_VAR(cbc_aes192_decrypt, cbc_aes192_decrypt_func, vaes)
+DECLARE_FAT_FUNC(nettle_cbc_aes256_decrypt, cbc_aes256_decrypt_func)
+DECLARE_FAT_FUNC_VAR(cbc_aes256_decrypt, cbc_aes256_decrypt_func, c)
+DECLARE_FAT_FUNC_VAR(cbc_aes256_decrypt, cbc_aes256_decrypt_func, aesni)
+DECLARE_FAT_FUNC_VAR(cbc_aes256_decrypt, cbc_aes256_decrypt_func, vaes)
 
 DECLARE_FAT_FUNC(nettle_memxor, memxor_func)
 DECLARE_FAT_FUNC_VAR(memxor, memxor_func, x86_64)
@@ -159,6 +255,25 @@ DECLARE_FAT_FUNC(_nettle_sha256_compress_n, sha256_compress_n_func)
 DECLARE_FAT_FUNC_VAR(sha256_compress_n, sha256_compress_n_func, x86_64)
 DECLARE_FAT_FUNC_VAR(sha256_compress_n, sha256_compress_n_func, sha_ni)
 
+DECLARE_FAT_FUNC(_nettle_sha512_compress, sha512_compress_func)
+DECLARE_FAT_FUNC_VAR(sha512_compress, sha512_compress_func, x86_64)
+DECLARE_FAT_FUNC_VAR(sha512_compress, sha512_compress_func, avx2)
+
+DECLARE_FAT_FUNC(nettle_sha1_digest_many, digest_many_func)
+DECLARE_FAT_FUNC_VAR(sha1_digest_many, digest_many_func, 1x)
+DECLARE_FAT_FUNC_VAR(sha1_digest_many, digest_many_func, 8x)
+DECLARE_FAT_FUNC_VAR(sha1_digest_many, digest_many_func, 16x)
+
+DECLARE_FAT_FUNC(_nettle_sha256_many, sha256_many_func)
+DECLARE_FAT_FUNC_VAR(sha256_many, sha256_many_func, 1x)
+DECLARE_FAT_FUNC_VAR(sha256_many, sha256_many_func, 8x)
+DECLARE_FAT_FUNC_VAR(sha256_many, sha256_many_func, 16x)
+
+DECLARE_FAT_FUNC(nettle_sha3_256_shake_many, shake_many_func)
+DECLARE_FAT_FUNC_VAR(sha3_256_shake_many, shake_many_func, 1x)
+DECLARE_FAT_FUNC_VAR(sha3_256_shake_many, shake_many_func, 4x)
+DECLARE_FAT_FUNC_VAR(sha3_256_shake_many, shake_many_func, 8x)
+
 DECLARE_FAT_FUNC(_nettle_ghash_set_key, ghash_set_key_func)
 DECLARE_FAT_FUNC_VAR(ghash_set_key, ghash_set_key_func, c)
 DECLARE_FAT_FUNC_VAR(ghash_set_key, ghash_set_key_func, pclmul)
@@ -167,6 +282,92 @@ DECLARE_FAT_FUNC(_nettle_ghash_update, ghash_update_func)
 DECLARE_FAT_FUNC_VAR(ghash_update, ghash_update_func, table)
 DECLARE_FAT_FUNC_VAR(ghash_update, ghash_update_func, pclmul)
 
+DECLARE_FAT_FUNC(_nettle_siv_ghash_set_key, ghash_set_key_func)
+DECLARE_FAT_FUNC_VAR(siv_ghash_set_key, ghash_set_key_func, c)
+DECLARE_FAT_FUNC_VAR(siv_ghash_set_key, ghash_set_key_func, pclmul)
+
+DECLARE_FAT_FUNC(_nettle_siv_ghash_update, ghash_update_func)
+DECLARE_FAT_FUNC_VAR(siv_ghash_update, ghash_update_func, c)
+DECLARE_FAT_FUNC_VAR(siv_ghash_update, ghash_update_func, pclmul)
+
+DECLARE_FAT_FUNC(_nettle_gcm_aes_encrypt, gcm_aes_crypt_func)
+DECLARE_FAT_FUNC_VAR(gcm_aes_encrypt, gcm_aes_crypt_func, c)
+DECLARE_FAT_FUNC_VAR(gcm_aes_encrypt, gcm_aes_crypt_func, aesni)
+DECLARE_FAT_FUNC_VAR(gcm_aes_encrypt, gcm_aes_crypt_func, avx512)
+
+DECLARE_FAT_FUNC(_nettle_gcm_aes_decrypt, gcm_aes_crypt_func)
+DECLARE_FAT_FUNC_VAR(gcm_aes_decrypt, gcm_aes_crypt_func, c)
+DECLARE_FAT_FUNC_VAR(gcm_aes_decrypt, gcm_aes_crypt_func, aesni)
+DECLARE_FAT_FUNC_VAR(gcm_aes_decrypt, gcm_aes_crypt_func, avx512)
+
+DECLARE_FAT_FUNC(_nettle_ocb_aes128_encrypt_n, ocb_aes128_crypt_n_func)
+DECLARE_FAT_FUNC_VAR(ocb_aes128_encrypt_n, ocb_aes128_crypt_n_func, c)
+DECLARE_FAT_FUNC_VAR(ocb_aes128_encrypt_n, ocb_aes128_crypt_n_func, aesni)
+
+DECLARE_FAT_FUNC(_nettle_ocb_aes128_decrypt_n, ocb_aes128_crypt_n_func)
+DECLARE_FAT_FUNC_VAR(ocb_aes128_decrypt_n, ocb_aes128_crypt_n_func, c)
+DECLARE_FAT_FUNC_VAR(ocb_aes128_decrypt_n, ocb_aes128_crypt_n_func, aesni)
+
+DECLARE_FAT_FUNC(_nettle_ccm_aes128_encrypt_n, ccm_aes128_crypt_n_func)
+DECLARE_FAT_FUNC_VAR(ccm_aes128_encrypt_n, ccm_aes128_crypt_n_func, c)
+DECLARE_FAT_FUNC_VAR(ccm_aes128_encrypt_n, ccm_aes128_crypt_n_func, aesni)
+
+DECLARE_FAT_FUNC(_nettle_ccm_aes128_decrypt_n, ccm_aes128_crypt_n_func)
+DECLARE_FAT_FUNC_VAR(ccm_aes128_decrypt_n, ccm_aes128_crypt_n_func, c)
+DECLARE_FAT_FUNC_VAR(ccm_aes128_decrypt_n, ccm_aes128_crypt_n_func, aesni)
+
+DECLARE_FAT_FUNC(_nettle_chacha_4core, chacha_core_func)
+DECLARE_FAT_FUNC_VAR(chacha_4core, chacha_core_func, sse2)
+DECLARE_FAT_FUNC_VAR(chacha_4core, chacha_core_func, avx2)
+
+DECLARE_FAT_FUNC(_nettle_chacha_4core32, chacha_core_func)
+DECLARE_FAT_FUNC_VAR(chacha_4core32, chacha_core_func, sse2)
+DECLARE_FAT_FUNC_VAR(chacha_4core32, chacha_core_func, avx2)
+
+DECLARE_FAT_FUNC(nettle_chacha_crypt, chacha_crypt_func)
+DECLARE_FAT_FUNC_VAR(chacha_crypt, chacha_crypt_func, 4core)
+DECLARE_FAT_FUNC_VAR(chacha_crypt, chacha_crypt_func, 16core)
+
+DECLARE_FAT_FUNC(nettle_chacha_crypt32, chacha_crypt_func)
+DECLARE_FAT_FUNC_VAR(chacha_crypt32, chacha_crypt_func, 4core)
+DECLARE_FAT_FUNC_VAR(chacha_crypt32, chacha_crypt_func, 16core)
+
+DECLARE_FAT_FUNC(_nettle_poly1305_blocks, poly1305_blocks_func)
+DECLARE_FAT_FUNC_VAR(poly1305_blocks, poly1305_blocks_func, x86_64)
+DECLARE_FAT_FUNC_VAR(poly1305_blocks, poly1305_blocks_func, avx2)
+DECLARE_FAT_FUNC_VAR(poly1305_blocks, poly1305_blocks_func, ifma)
+
+/* Nop implementation for _gcm_aes_encrypt and _gcm_aes_decrypt. */
+static size_t
+gcm_aes_crypt_c (struct gcm_key *key UNUSED, unsigned rounds UNUSED,
+		 size_t size UNUSED, uint8_t *dst UNUSED, const uint8_t *src UNUSED)
+{
+  return 0;
+}
+
+/* Nop implementation for _ocb_aes128_encrypt_n and
+   _ocb_aes128_decrypt_n. */
+static size_t
+ocb_aes128_crypt_n_c (struct ocb_ctx *ctx UNUSED,
+		      const struct aes128_ctx *cipher UNUSED,
+		      const union nettle_block16 *L UNUSED,
+		      size_t n UNUSED, uint8_t *dst UNUSED,
+		      const uint8_t *src UNUSED)
+{
+  return 0;
+}
+
+/* Nop implementation for _ccm_aes128_encrypt_n and
+   _ccm_aes128_decrypt_n. */
+static size_t
+ccm_aes128_crypt_n_c (struct ccm_ctx *ctx UNUSED,
+		      const struct aes128_ctx *cipher UNUSED,
+		      size_t n UNUSED, uint8_t *dst UNUSED,
+		      const uint8_t *src UNUSED)
+{
+  return 0;
+}
+
 
 /* This function should usually be called only once, at startup. But
    it is idempotent, and on x86, pointer updates are atomic, so
@@ -188,22 +389,64 @@ fat_init (void)
     {
       const char * const vendor_names[3] =
 	{ "other", "intel", "amd" };
-      fprintf (stderr, "libnettle: cpu features: vendor:%s%s%s%s\n",
+      fprintf (stderr, "libnettle: cpu features: vendor:%s%s%s%s%s%s%s%s%s%s\n",
 	       vendor_names[features.vendor],
 	       features.have_aesni ? ",aesni" : "",
 	       features.have_sha_ni ? ",sha_ni" : "",
-	       features.have_pclmul ? ",pclmul" : "");
+	       features.have_pclmul ? ",pclmul" : "",
+	       features.have_bmi2 ? ",bmi2" : "",
+	       features.have_avx2 ? ",avx2" : "",
+	       features.have_avx512 ? ",avx512" : "",
+	       features.have_vaes ? ",vaes" : "",
+	       features.have_vpclmul ? ",vpclmul" : "",
+	       features.have_ifma ? ",ifma" : "");
     }
   if (features.have_aesni)
     {
-      if (verbose)
-	fprintf (stderr, "libnettle: using aes instructions.\n");
-      nettle_aes128_encrypt_vec = _nettle_aes128_encrypt_aesni;
-      nettle_aes128_decrypt_vec = _nettle_aes128_decrypt_aesni;
-      nettle_aes192_encrypt_vec = _nettle_aes192_encrypt_aesni;
-      nettle_aes192_decrypt_vec = _nettle_aes192_decrypt_aesni;
-      nettle_aes256_encrypt_vec = _nettle_aes256_encrypt_aesni;
-      nettle_aes256_decrypt_vec = _nettle_aes256_decrypt_aesni;
+      if (features.have_vaes && features.have_avx512)
+	{
+	  if (verbose)
+	    fprintf (stderr, "libnettle: using 512-bit vaes instructions.\n");
+	  nettle_aes128_encrypt_vec = _nettle_aes128_encrypt_avx512;
+	  nettle_aes128_decrypt_vec = _nettle_aes128_decrypt_avx512;
+	  nettle_aes192_encrypt_vec = _nettle_aes192_encrypt_avx512;
+	  nettle_aes192_decrypt_vec = _nettle_aes192_decrypt_avx512;
+	  nettle_aes256_encrypt_vec = _nettle_aes256_encrypt_avx512;
+	  nettle_aes256_decrypt_vec = _nettle_aes256_decrypt_avx512;
+	  nettle_cbc_aes128_decrypt_vec = _nettle_cbc_aes128_decrypt_vaes;
+	  nettle_cbc_aes192_decrypt_vec = _nettle_cbc_aes192_decrypt_vaes;
+	  nettle_cbc_aes256_decrypt_vec = _nettle_cbc_aes256_decrypt_vaes;
+	}
+      else if (features.have_vaes && features.have_avx2)
+	{
+	  if (verbose)
+	    fprintf (stderr, "libnettle: using 256-bit vaes instructions.\n");
+	  nettle_aes128_encrypt_vec = _nettle_aes128_encrypt_vaes;
+	  nettle_aes128_decrypt_vec = _nettle_aes128_decrypt_vaes;
+	  nettle_aes192_encrypt_vec = _nettle_aes192_encrypt_vaes;
+	  nettle_aes192_decrypt_vec = _nettle_aes192_decrypt_vaes;
+	  nettle_aes256_encrypt_vec = _nettle_aes256_encrypt_vaes;
+	  nettle_aes256_decrypt_vec = _nettle_aes256_decrypt_vaes;
+	  nettle_cbc_aes128_decrypt_vec = _nettle_cbc_aes128_decrypt_vaes;
+	  nettle_cbc_aes192_decrypt_vec = _nettle_cbc_aes192_decrypt_vaes;
+	  nettle_cbc_aes256_decrypt_vec = _nettle_cbc_aes256_decrypt_vaes;
+	}
+      else
+	{
+	  if (verbose)
+	    fprintf (stderr, "libnettle: using aes instructions.\n");
+	  nettle_aes128_encrypt_vec = _nettle_aes128_encrypt_aesni;
+	  nettle_aes128_decrypt_vec = _nettle_aes128_decrypt_aesni;
+	  nettle_aes192_encrypt_vec = _nettle_aes192_encrypt_aesni;
+	  nettle_aes192_decrypt_vec = _nettle_aes192_decrypt_aesni;
+	  nettle_aes256_encrypt_vec = _nettle_aes256_encrypt_aesni;
+	  nettle_aes256_decrypt_vec = _nettle_aes256_decrypt_aesni;
+	  nettle_cbc_aes128_decrypt_vec = _nettle_cbc_aes128_decrypt_aesni;
+	  nettle_cbc_aes192_decrypt_vec = _nettle_cbc_aes192_decrypt_aesni;
+	  nettle_cbc_aes256_decrypt_vec = _nettle_cbc_aes256_decrypt_aesni;
+	}
+      nettle_aes128_set_encrypt_key_vec = _nettle_aes128_set_encrypt_key_aesni;
+      nettle_aes256_set_encrypt_key_vec = _nettle_aes256_set_encrypt_key_aesni;
       nettle_cbc_aes128_encrypt_vec = _nettle_cbc_aes128_encrypt_aesni;
       nettle_cbc_aes192_encrypt_vec = _nettle_cbc_aes192_encrypt_aesni;
       nettle_cbc_aes256_encrypt_vec = _nettle_cbc_aes256_encrypt_aesni;
@@ -212,6 +455,8 @@ fat_init (void)
     {
       if (verbose)
 	fprintf (stderr, "libnettle: not using aes instructions.\n");
+      nettle_aes128_set_encrypt_key_vec = _nettle_aes128_set_encrypt_key_c;
+      nettle_aes256_set_encrypt_key_vec = _nettle_aes256_set_encrypt_key_c;
       nettle_aes128_encrypt_vec = _nettle_aes128_encrypt_c;
       nettle_aes128_decrypt_vec = _nettle_aes128_decrypt_c;
       nettle_aes192_encrypt_vec = _nettle_aes192_encrypt_c;
@@ -221,6 +466,9 @@ fat_init (void)
       nettle_cbc_aes128_encrypt_vec = _nettle_cbc_aes128_encrypt_c;
       nettle_cbc_aes192_encrypt_vec = _nettle_cbc_aes192_encrypt_c;
       nettle_cbc_aes256_encrypt_vec = _nettle_cbc_aes256_encrypt_c;
+      nettle_cbc_aes128_decrypt_vec = _nettle_cbc_aes128_decrypt_c;
+      nettle_cbc_aes192_decrypt_vec = _nettle_cbc_aes192_decrypt_c;
+      nettle_cbc_aes256_decrypt_vec = _nettle_cbc_aes256_decrypt_c;
     }
 
   if (features.have_sha_ni)
@@ -238,12 +486,66 @@ fat_init (void)
       _nettle_sha256_compress_n_vec = _nettle_sha256_compress_n_x86_64;
     }
 
+  if (features.have_avx2 && features.have_bmi2)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using avx2 and bmi2 sha512.\n");
+      _nettle_sha512_compress_vec = _nettle_sha512_compress_avx2;
+    }
+  else
+    _nettle_sha512_compress_vec = _nettle_sha512_compress_x86_64;
+
+  if (features.have_avx512)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using 16-way avx512 sha1 and sha256.\n");
+      nettle_sha1_digest_many_vec = _nettle_sha1_digest_many_16x;
+      _nettle_sha256_many_vec = _nettle_sha256_many_16x;
+    }
+  else if (features.have_avx2)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using 8-way avx2 sha1.\n");
+      nettle_sha1_digest_many_vec = _nettle_sha1_digest_many_8x;
+      /* The sha_ni instructions are faster than 8-way sha256. */
+      if (features.have_sha_ni)
+	_nettle_sha256_many_vec = _nettle_sha256_many_1x;
+      else
+	{
+	  if (verbose)
+	    fprintf (stderr, "libnettle: using 8-way avx2 sha256.\n");
+	  _nettle_sha256_many_vec = _nettle_sha256_many_8x;
+	}
+    }
+  else
+    {
+      nettle_sha1_digest_many_vec = _nettle_sha1_digest_many_1x;
+      _nettle_sha256_many_vec = _nettle_sha256_many_1x;
+    }
+
+  if (features.have_avx512)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using 8-way avx512 sha3.\n");
+      nettle_sha3_256_shake_many_vec = _nettle_sha3_256_shake_many_8x;
+    }
+  else if (features.have_avx2)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using 4-way avx2 sha3.\n");
+      nettle_sha3_256_shake_many_vec = _nettle_sha3_256_shake_many_4x;
+    }
+  else
+    nettle_sha3_256_shake_many_vec = _nettle_sha3_256_shake_many_1x;
+
   if (features.have_pclmul)
     {
       if (verbose)
 	fprintf (stderr, "libnettle: using pclmulqdq instructions.\n");
       _nettle_ghash_set_key_vec = _nettle_ghash_set_key_pclmul;
       _nettle_ghash_update_vec = _nettle_ghash_update_pclmul;
+      _nettle_siv_ghash_set_key_vec = _nettle_siv_ghash_set_key_pclmul;
+      _nettle_siv_ghash_update_vec = _nettle_siv_ghash_update_pclmul;
     }
   else
     {
@@ -251,8 +553,99 @@ fat_init (void)
 	fprintf (stderr, "libnettle: not using pclmulqdq instructions.\n");
       _nettle_ghash_set_key_vec = _nettle_ghash_set_key_c;
       _nettle_ghash_update_vec = _nettle_ghash_update_table;
+      _nettle_siv_ghash_set_key_vec = _nettle_siv_ghash_set_key_c;
+      _nettle_siv_ghash_update_vec = _nettle_siv_ghash_update_c;
+    }
+
+  /* The combined gcm functions use the table of key powers set up by
+     _nettle_ghash_set_key_pclmul. */
+  if (features.have_aesni && features.have_pclmul)
+    {
+      if (features.have_avx512 && features.have_vaes
+	  && features.have_vpclmul)
+	{
+	  if (verbose)
+	    fprintf (stderr, "libnettle: using 512-bit gcm-aes functions.\n");
+	  _nettle_gcm_aes_encrypt_vec = _nettle_gcm_aes_encrypt_avx512;
+	  _nettle_gcm_aes_decrypt_vec = _nettle_gcm_aes_decrypt_avx512;
+	}
+      else
+	{
+	  if (verbose)
+	    fprintf (stderr, "libnettle: using combined gcm-aes functions.\n");
+	  _nettle_gcm_aes_encrypt_vec = _nettle_gcm_aes_encrypt_aesni;
+	  _nettle_gcm_aes_decrypt_vec = _nettle_gcm_aes_decrypt_aesni;
+	}
+    }
+  else
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: not using combined gcm-aes functions.\n");
+      _nettle_gcm_aes_encrypt_vec = gcm_aes_crypt_c;
+      _nettle_gcm_aes_decrypt_vec = gcm_aes_crypt_c;
+    }
+
+  if (features.have_aesni)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using combined ocb-aes and ccm-aes functions.\n");
+      _nettle_ocb_aes128_encrypt_n_vec = _nettle_ocb_aes128_encrypt_n_aesni;
+      _nettle_ocb_aes128_decrypt_n_vec = _nettle_ocb_aes128_decrypt_n_aesni;
+      _nettle_ccm_aes128_encrypt_n_vec = _nettle_ccm_aes128_encrypt_n_aesni;
+      _nettle_ccm_aes128_decrypt_n_vec = _nettle_ccm_aes128_decrypt_n_aesni;
+    }
+  else
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: not using combined ocb-aes and ccm-aes functions.\n");
+      _nettle_ocb_aes128_encrypt_n_vec = ocb_aes128_crypt_n_c;
+      _nettle_ocb_aes128_decrypt_n_vec = ocb_aes128_crypt_n_c;
+      _nettle_ccm_aes128_encrypt_n_vec = ccm_aes128_crypt_n_c;
+      _nettle_ccm_aes128_decrypt_n_vec = ccm_aes128_crypt_n_c;
+    }
+
+  if (features.have_avx2)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using avx2 chacha functions.\n");
+      _nettle_chacha_4core_vec = _nettle_chacha_4core_avx2;
+      _nettle_chacha_4core32_vec = _nettle_chacha_4core32_avx2;
+    }
+  else
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using sse2 chacha functions.\n");
+      _nettle_chacha_4core_vec = _nettle_chacha_4core_sse2;
+      _nettle_chacha_4core32_vec = _nettle_chacha_4core32_sse2;
+    }
+  if (features.have_avx512)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using 16-way avx512 chacha.\n");
+      nettle_chacha_crypt_vec = _nettle_chacha_crypt_16core;
+      nettle_chacha_crypt32_vec = _nettle_chacha_crypt32_16core;
+    }
+  else
+    {
+      nettle_chacha_crypt_vec = _nettle_chacha_crypt_4core;
+      nettle_chacha_crypt32_vec = _nettle_chacha_crypt32_4core;
     }
 
+  if (features.have_avx512 && features.have_ifma)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using avx512 ifma poly1305.\n");
+      _nettle_poly1305_blocks_vec = _nettle_poly1305_blocks_ifma;
+    }
+  else if (features.have_avx2)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using avx2 poly1305.\n");
+      _nettle_poly1305_blocks_vec = _nettle_poly1305_blocks_avx2;
+    }
+  else
+    _nettle_poly1305_blocks_vec = _nettle_poly1305_blocks_x86_64;
+
   if (features.vendor == X86_INTEL)
     {
       if (verbose)
@@ -294,6 +687,11 @@ DEFINE_FAT_FUNC(nettle_aes256_decrypt, void,
   uint8_t *dst,const uint8_t *src),
  (ctx, length, dst, src))
 
+DEFINE_FAT_FUNC(nettle_aes128_set_encrypt_key, void,
+ (struct aes128_ctx *ctx, const uint8_t *key), (ctx, key))
+DEFINE_FAT_FUNC(nettle_aes256_set_encrypt_key, void,
+ (struct aes256_ctx *ctx, const uint8_t *key), (ctx, key))
+
 DEFINE_FAT_FUNC(nettle_cbc_aes128_encrypt, void,
  (const struct aes128_ctx *ctx, uint8_t *iv,
   size_t length, uint8_t *dst, const uint8_t *src),
@@ -306,6 +704,46 @@ DEFINE_FAT_FUNC(nettle_cbc_aes256_encrypt, void,
  (const struct aes256_ctx *ctx, uint8_t *iv,
   size_t length, uint8_t *dst, const uint8_t *src),
  (ctx, iv, length, dst, src))
+DEFINE_FAT_FUNC(nettle_cbc_aes128_decrypt, void,
+ (const struct aes128_ctx *ctx, uint8_t *iv,
+  size_t length, uint8_t *dst, const uint8_t *src),
+ (ctx, iv, length, dst, src))
+DEFINE_FAT_FUNC(nettle_cbc_aes192_decrypt, void,
+ (const struct aes192_ctx *ctx, uint8_t *iv,
+  size_t length, uint8_t *dst, const uint8_t *src),
+ (ctx, iv, length, dst, src))
+DEFINE_FAT_FUNC(nettle_cbc_aes256_decrypt, void,
+ (const struct aes256_ctx *ctx, uint8_t *iv,
+  size_t length, uint8_t *dst, const uint8_t *src),
+ (ctx, iv, length, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_chacha_4core, void,
+		(uint32_t *dst, const uint32_t *src, unsigned rounds),
+		(dst, src, rounds))
+
+DEFINE_FAT_FUNC(_nettle_chacha_4core32, void,
+		(uint32_t *dst, const uint32_t *src, unsigned rounds),
+		(dst, src, rounds))
+
+DEFINE_FAT_FUNC(nettle_chacha_crypt, void,
+		(struct chacha_ctx *ctx,
+		 size_t length,
+		 uint8_t *dst,
+		 const uint8_t *src),
+		(ctx, length, dst, src))
+
+DEFINE_FAT_FUNC(nettle_chacha_crypt32, void,
+		(struct chacha_ctx *ctx,
+		 size_t length,
+		 uint8_t *dst,
+		 const uint8_t *src),
+		(ctx, length, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_poly1305_blocks, const uint8_t *,
+		(struct poly1305_ctx *ctx,
+		 size_t blocks,
+		 const uint8_t *m),
+		(ctx, blocks, m))
 
 DEFINE_FAT_FUNC(nettle_memxor, void *,
 		(void *dst, const void *src, size_t n),
@@ -320,6 +758,27 @@ DEFINE_FAT_FUNC(_nettle_sha256_compress_n, const uint8_t *,
 		 size_t blocks, const uint8_t *input),
 		(state, k, blocks, input))
 
+DEFINE_FAT_FUNC(_nettle_sha512_compress, void,
+		(uint64_t *state, const uint8_t *input, const uint64_t *k),
+		(state, input, k))
+
+DEFINE_FAT_FUNC(nettle_sha1_digest_many, void,
+		(size_t n, const size_t *length,
+		 const uint8_t * const *data, uint8_t *digest),
+		(n, length, data, digest))
+
+DEFINE_FAT_FUNC(_nettle_sha256_many, void,
+		(const uint32_t *state, uint64_t count,
+		 size_t n, const size_t *length,
+		 const uint8_t * const *data, uint8_t *digest),
+		(state, count, n, length, data, digest))
+
+DEFINE_FAT_FUNC(nettle_sha3_256_shake_many, void,
+		(size_t n, const size_t *length,
+		 const uint8_t * const *data,
+		 size_t output_length, uint8_t *output),
+		(n, length, data, output_length, output))
+
 DEFINE_FAT_FUNC(_nettle_ghash_set_key, void,
 		(struct gcm_key *ctx, const union nettle_block16 *key),
 		(ctx, key))
@@ -327,3 +786,44 @@ DEFINE_FAT_FUNC(_nettle_ghash_update, const uint8_t *,
 		(const struct gcm_key *ctx, union nettle_block16 *state,
 		 size_t blocks, const uint8_t *data),
 		(ctx, state, blocks, data))
+
+DEFINE_FAT_FUNC(_nettle_siv_ghash_set_key, void,
+		(struct gcm_key *ctx, const union nettle_block16 *key),
+		(ctx, key))
+
+DEFINE_FAT_FUNC(_nettle_siv_ghash_update, const uint8_t *,
+		(const struct gcm_key *ctx, union nettle_block16 *state,
+		 size_t blocks, const uint8_t *data),
+		(ctx, state, blocks, data))
+
+DEFINE_FAT_FUNC(_nettle_gcm_aes_encrypt, size_t,
+		(struct gcm_key *key, unsigned rounds,
+		 size_t len, uint8_t *dst, const uint8_t *src),
+		(key, rounds, len, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_gcm_aes_decrypt, size_t,
+		(struct gcm_key *key, unsigned rounds,
+		 size_t len, uint8_t *dst, const uint8_t *src),
+		(key, rounds, len, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_ocb_aes128_encrypt_n, size_t,
+		(struct ocb_ctx *ctx, const struct aes128_ctx *cipher,
+		 const union nettle_block16 *L,
+		 size_t n, uint8_t *dst, const uint8_t *src),
+		(ctx, cipher, L, n, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_ocb_aes128_decrypt_n, size_t,
+		(struct ocb_ctx *ctx, const struct aes128_ctx *cipher,
+		 const union nettle_block16 *L,
+		 size_t n, uint8_t *dst, const uint8_t *src),
+		(ctx, cipher, L, n, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_ccm_aes128_encrypt_n, size_t,
+		(struct ccm_ctx *ctx, const struct aes128_ctx *cipher,
+		 size_t n, uint8_t *dst, const uint8_t *src),
+		(ctx, cipher, n, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_ccm_aes128_decrypt_n, size_t,
+		(struct ccm_ctx *ctx, const struct aes128_ctx *cipher,
+		 size_t n, uint8_t *dst, const uint8_t *src),
+		(ctx, cipher, n, dst, src))
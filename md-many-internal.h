@@ -0,0 +1,115 @@
+/* md-many-internal.h
+
+   Hashing of many independent messages, using multi-buffer
+   compression functions.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_MD_MANY_INTERNAL_H_INCLUDED
+#define NETTLE_MD_MANY_INTERNAL_H_INCLUDED
+
+#include "nettle-types.h"
+
+/* Max number of lanes of a multi-buffer compression function. */
+#define MD_MANY_MAX_LANES 16
+
+/* Processes one block for each of the lanes. The state is
+   word-major, with word i of lane j at STATE[i * lanes + j], and
+   INPUT points to one pointer per lane, each to 64 bytes of data,
+   possibly unaligned. */
+typedef void md_many_compress_func(uint32_t *state,
+				   const uint8_t * const *input);
+
+/* Description of a Merkle-Damgård hash function with 64-byte blocks,
+   32-bit state words and a big-endian length. */
+struct md_many_algorithm
+{
+  unsigned state_size;	/* In words */
+  unsigned digest_size;	/* In bytes */
+  /* Single block compression, used when only a few messages are
+     left. */
+  void (*compress)(uint32_t *state, const uint8_t *input);
+};
+
+/* Computes the digests of N messages, using the LANES-way compression
+   function F, or only the single block compression function if LANES
+   is 1. Each message is hashed starting from the state IV, which is
+   the result of compressing COUNT blocks of some common prefix. */
+void
+_nettle_md_many (const struct md_many_algorithm *alg,
+		 const uint32_t *iv, uint64_t count,
+		 unsigned lanes, md_many_compress_func *f,
+		 size_t n, const size_t *length,
+		 const uint8_t * const *data, uint8_t *digest);
+
+/* Functions available only in some configurations */
+void
+_nettle_sha1_compress_8x(uint32_t *state, const uint8_t * const *input);
+
+void
+_nettle_sha1_compress_16x(uint32_t *state, const uint8_t * const *input);
+
+void
+_nettle_sha256_compress_8x(uint32_t *state, const uint8_t * const *input);
+
+void
+_nettle_sha256_compress_16x(uint32_t *state, const uint8_t * const *input);
+
+void
+_nettle_sha1_digest_many_1x(size_t n, const size_t *length,
+			    const uint8_t * const *data, uint8_t *digest);
+void
+_nettle_sha1_digest_many_8x(size_t n, const size_t *length,
+			    const uint8_t * const *data, uint8_t *digest);
+void
+_nettle_sha1_digest_many_16x(size_t n, const size_t *length,
+			     const uint8_t * const *data, uint8_t *digest);
+
+/* Like sha256_digest_many, but hashing each message starting from
+   STATE, after COUNT blocks, rather than from the initial state. */
+void
+_nettle_sha256_many(const uint32_t *state, uint64_t count,
+		    size_t n, const size_t *length,
+		    const uint8_t * const *data, uint8_t *digest);
+
+void
+_nettle_sha256_many_1x(const uint32_t *state, uint64_t count,
+		       size_t n, const size_t *length,
+		       const uint8_t * const *data, uint8_t *digest);
+void
+_nettle_sha256_many_8x(const uint32_t *state, uint64_t count,
+		       size_t n, const size_t *length,
+		       const uint8_t * const *data, uint8_t *digest);
+void
+_nettle_sha256_many_16x(const uint32_t *state, uint64_t count,
+			size_t n, const size_t *length,
+			const uint8_t * const *data, uint8_t *digest);
+
+#endif /* NETTLE_MD_MANY_INTERNAL_H_INCLUDED */
@@ -0,0 +1,204 @@
+/* md-many.c
+
+   Hashing of many independent messages, using multi-buffer
+   compression functions.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "md-many-internal.h"
+
+#include "macros.h"
+#include "nettle-write.h"
+
+#define MD_MANY_BLOCK_SIZE 64
+#define MD_MANY_MAX_STATE 8
+
+struct md_many_lane
+{
+  /* Index of the message, or n for an idle lane. */
+  size_t index;
+  /* Next full message block, and number of such blocks left. */
+  const uint8_t *data;
+  size_t blocks;
+  /* Final one or two blocks, with the message tail and padding. */
+  unsigned pad_index;
+  unsigned pad_blocks;
+  uint8_t pad[2 * MD_MANY_BLOCK_SIZE];
+};
+
+static void
+md_many_start (struct md_many_lane *lane, uint64_t count, size_t index,
+	       size_t length, const uint8_t *data)
+{
+  unsigned left = length % MD_MANY_BLOCK_SIZE;
+  unsigned size;
+
+  lane->index = index;
+  lane->data = data;
+  lane->blocks = length / MD_MANY_BLOCK_SIZE;
+  lane->pad_index = 0;
+  lane->pad_blocks = (left < MD_MANY_BLOCK_SIZE - 8) ? 1 : 2;
+
+  size = lane->pad_blocks * MD_MANY_BLOCK_SIZE;
+  memcpy (lane->pad, data + lane->blocks * MD_MANY_BLOCK_SIZE, left);
+  lane->pad[left] = 0x80;
+  memset (lane->pad + left + 1, 0, size - 8 - left - 1);
+  /* There are 512 = 2^9 bits in one block. */
+  WRITE_UINT64 (lane->pad + size - 8, (count << 9) + ((uint64_t) length << 3));
+}
+
+/* Returns the next block, or NULL if the lane is done. */
+static const uint8_t *
+md_many_next (struct md_many_lane *lane)
+{
+  const uint8_t *block;
+  if (lane->blocks > 0)
+    {
+      block = lane->data;
+      lane->data += MD_MANY_BLOCK_SIZE;
+      lane->blocks--;
+    }
+  else if (lane->pad_index < lane->pad_blocks)
+    block = lane->pad + MD_MANY_BLOCK_SIZE * lane->pad_index++;
+  else
+    block = NULL;
+  return block;
+}
+
+/* Processes the remaining blocks of a lane, with STATE contiguous. */
+static void
+md_many_finish (const struct md_many_algorithm *alg,
+		struct md_many_lane *lane, uint32_t *state, uint8_t *digest)
+{
+  const uint8_t *block;
+  while ( (block = md_many_next (lane)) )
+    alg->compress (state, block);
+
+  _nettle_write_be32 (alg->digest_size,
+		      digest + lane->index * alg->digest_size, state);
+}
+
+void
+_nettle_md_many (const struct md_many_algorithm *alg,
+		 const uint32_t *iv, uint64_t count,
+		 unsigned lanes, md_many_compress_func *f,
+		 size_t n, const size_t *length,
+		 const uint8_t * const *data, uint8_t *digest)
+{
+  struct md_many_lane lane[MD_MANY_MAX_LANES];
+  uint32_t state[MD_MANY_MAX_LANES * MD_MANY_MAX_STATE];
+  const uint8_t *input[MD_MANY_MAX_LANES];
+  uint32_t tmp[MD_MANY_MAX_STATE];
+  size_t next;
+  unsigned active;
+  unsigned i, j;
+
+  assert (lanes <= MD_MANY_MAX_LANES);
+  assert (alg->state_size <= MD_MANY_MAX_STATE);
+
+  if (lanes < 2 || n <= lanes / 4)
+    {
+      /* Too few messages to make the lanes worthwhile. */
+      for (next = 0; next < n; next++)
+	{
+	  memcpy (tmp, iv, alg->state_size * sizeof(*tmp));
+	  md_many_start (&lane[0], count, next, length[next], data[next]);
+	  md_many_finish (alg, &lane[0], tmp, digest);
+	}
+      return;
+    }
+
+  for (j = 0, next = 0; j < lanes; j++)
+    {
+      if (next < n)
+	{
+	  md_many_start (&lane[j], count, next, length[next], data[next]);
+	  next++;
+	}
+      else
+	/* Idle, hashing an all-zero block. */
+	md_many_start (&lane[j], count, n, 0, lane[j].pad);
+
+      for (i = 0; i < alg->state_size; i++)
+	state[i*lanes + j] = iv[i];
+    }
+  active = next;
+
+  /* Keep the lanes busy while there is enough work for them. When
+     only a few messages are left, finish them one at a time. */
+  while (active > lanes / 4)
+    {
+      for (j = 0; j < lanes; j++)
+	{
+	  input[j] = md_many_next (&lane[j]);
+	  while (!input[j])
+	    {
+	      if (lane[j].index < n)
+		{
+		  for (i = 0; i < alg->state_size; i++)
+		    tmp[i] = state[i*lanes + j];
+		  _nettle_write_be32 (alg->digest_size,
+				      digest + lane[j].index * alg->digest_size,
+				      tmp);
+		  active--;
+		}
+	      if (next < n)
+		{
+		  md_many_start (&lane[j], count, next, length[next], data[next]);
+		  next++;
+		  active++;
+		}
+	      else
+		md_many_start (&lane[j], count, n, 0, lane[j].pad);
+
+	      for (i = 0; i < alg->state_size; i++)
+		state[i*lanes + j] = iv[i];
+
+	      input[j] = md_many_next (&lane[j]);
+	    }
+	}
+      f (state, input);
+    }
+
+  for (j = 0; j < lanes; j++)
+    if (lane[j].index < n)
+      {
+	for (i = 0; i < alg->state_size; i++)
+	  tmp[i] = state[i*lanes + j];
+	md_many_finish (alg, &lane[j], tmp, digest);
+      }
+}
@@ -159,6 +159,11 @@ cbc_aes128_set_encrypt_key(struct cbc_aes128_ctx *ctx, const uint8_t *key)
   aes128_set_encrypt_key(&ctx->ctx, key);
 }
 static void
+cbc_aes128_set_decrypt_key(struct cbc_aes128_ctx *ctx, const uint8_t *key)
+{
+  aes128_set_decrypt_key(&ctx->ctx, key);
+}
+static void
 cbc_aes128_set_iv(struct cbc_aes128_ctx *ctx, const uint8_t *iv)
 {
   CBC_SET_IV(ctx, iv);
@@ -170,6 +175,13 @@ cbc_aes128_encrypt_wrapper(struct cbc_aes128_ctx *ctx,
 {
   cbc_aes128_encrypt(&ctx->ctx, ctx->iv, length, dst, src);
 }
+static void
+cbc_aes128_decrypt_wrapper(struct cbc_aes128_ctx *ctx,
+			   size_t length, uint8_t *dst,
+			   const uint8_t *src)
+{
+  cbc_aes128_decrypt(&ctx->ctx, ctx->iv, length, dst, src);
+}
 
 const struct nettle_aead
 nettle_cbc_aes128 = {
@@ -177,11 +189,11 @@ nettle_cbc_aes128 = {
   AES_BLOCK_SIZE, AES128_KEY_SIZE,
   AES_BLOCK_SIZE, 0,
   (nettle_set_key_func*) cbc_aes128_set_encrypt_key,
-  NULL,
+  (nettle_set_key_func*) cbc_aes128_set_decrypt_key,
   (nettle_set_key_func*) cbc_aes128_set_iv,
   NULL,
   (nettle_crypt_func *) cbc_aes128_encrypt_wrapper,
-  NULL,
+  (nettle_crypt_func *) cbc_aes128_decrypt_wrapper,
   NULL,
 };
 
@@ -192,6 +204,11 @@ cbc_aes192_set_encrypt_key(struct cbc_aes192_ctx *ctx, const uint8_t *key)
   aes192_set_encrypt_key(&ctx->ctx, key);
 }
 static void
+cbc_aes192_set_decrypt_key(struct cbc_aes192_ctx *ctx, const uint8_t *key)
+{
+  aes192_set_decrypt_key(&ctx->ctx, key);
+}
+static void
 cbc_aes192_set_iv(struct cbc_aes192_ctx *ctx, const uint8_t *iv)
 {
   CBC_SET_IV(ctx, iv);
@@ -203,17 +220,24 @@ cbc_aes192_encrypt_wrapper(struct cbc_aes192_ctx *ctx,
 {
   cbc_aes192_encrypt(&ctx->ctx, ctx->iv, length, dst, src);
 }
+static void
+cbc_aes192_decrypt_wrapper(struct cbc_aes192_ctx *ctx,
+			   size_t length, uint8_t *dst,
+			   const uint8_t *src)
+{
+  cbc_aes192_decrypt(&ctx->ctx, ctx->iv, length, dst, src);
+}
 const struct nettle_aead
 nettle_cbc_aes192 = {
   "cbc_aes192", sizeof(struct cbc_aes192_ctx),
   AES_BLOCK_SIZE, AES192_KEY_SIZE,
   AES_BLOCK_SIZE, 0,
   (nettle_set_key_func*) cbc_aes192_set_encrypt_key,
-  NULL,
+  (nettle_set_key_func*) cbc_aes192_set_decrypt_key,
   (nettle_set_key_func*) cbc_aes192_set_iv,
   NULL,
   (nettle_crypt_func *) cbc_aes192_encrypt_wrapper,
-  NULL,
+  (nettle_crypt_func *) cbc_aes192_decrypt_wrapper,
   NULL,
 };
 
@@ -224,6 +248,11 @@ cbc_aes256_set_encrypt_key(struct cbc_aes256_ctx *ctx, const uint8_t *key)
   aes256_set_encrypt_key(&ctx->ctx, key);
 }
 static void
+cbc_aes256_set_decrypt_key(struct cbc_aes256_ctx *ctx, const uint8_t *key)
+{
+  aes256_set_decrypt_key(&ctx->ctx, key);
+}
+static void
 cbc_aes256_set_iv(struct cbc_aes256_ctx *ctx, const uint8_t *iv)
 {
   CBC_SET_IV(ctx, iv);
@@ -235,17 +264,24 @@ cbc_aes256_encrypt_wrapper(struct cbc_aes256_ctx *ctx,
 {
   cbc_aes256_encrypt(&ctx->ctx, ctx->iv, length, dst, src);
 }
+static void
+cbc_aes256_decrypt_wrapper(struct cbc_aes256_ctx *ctx,
+			   size_t length, uint8_t *dst,
+			   const uint8_t *src)
+{
+  cbc_aes256_decrypt(&ctx->ctx, ctx->iv, length, dst, src);
+}
 const struct nettle_aead
 nettle_cbc_aes256 = {
   "cbc_aes256", sizeof(struct cbc_aes256_ctx),
   AES_BLOCK_SIZE, AES256_KEY_SIZE,
   AES_BLOCK_SIZE, 0,
   (nettle_set_key_func*) cbc_aes256_set_encrypt_key,
-  NULL,
+  (nettle_set_key_func*) cbc_aes256_set_decrypt_key,
   (nettle_set_key_func*) cbc_aes256_set_iv,
   NULL,
   (nettle_crypt_func *) cbc_aes256_encrypt_wrapper,
-  NULL,
+  (nettle_crypt_func *) cbc_aes256_decrypt_wrapper,
   NULL,
 };
 
@@ -33,7 +33,27 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
+
 #include "ocb.h"
+#include "ocb-internal.h"
+#include "block-internal.h"
+#include "memops.h"
+
+#if HAVE_NATIVE_ocb_aes128_encrypt_n || HAVE_NATIVE_ocb_aes128_decrypt_n
+/* Sets L[i] = L_i = x^i L_0, for all i up to the largest number of
+   trailing zeros of any block index <= last, i.e., floor(log2(last)).
+   At most 64 entries are used. */
+static void
+ocb_aes128_fill_l (const struct ocb_key *key, uint64_t last,
+		   union nettle_block16 *L)
+{
+  unsigned i;
+  block16_set (&L[0], &key->L[2]);
+  for (i = 0; (last >>= 1) > 0; i++)
+    block16_mulx_be (&L[i+1], &L[i]);
+}
+#endif
 
 void
 ocb_aes128_set_encrypt_key (struct ocb_aes128_encrypt_key *ocb_key, const uint8_t *key)
@@ -70,6 +90,21 @@ void
 ocb_aes128_encrypt(struct ocb_ctx *ctx, const struct ocb_aes128_encrypt_key *key,
 		   size_t length, uint8_t *dst, const uint8_t *src)
 {
+#if HAVE_NATIVE_ocb_aes128_encrypt_n
+  size_t n = length / OCB_BLOCK_SIZE;
+  if (n > 0)
+    {
+      union nettle_block16 L[64];
+      size_t done;
+
+      if (ctx->message_count == 0)
+	ctx->offset = ctx->initial;
+      ocb_aes128_fill_l (&key->ocb, ctx->message_count + n, L);
+      done = OCB_BLOCK_SIZE
+	* _ocb_aes128_encrypt_n (ctx, &key->encrypt, L, n, dst, src);
+      length -= done; dst += done; src += done;
+    }
+#endif
   ocb_encrypt (ctx, &key->ocb, &key->encrypt, (nettle_cipher_func *) aes128_encrypt,
 	       length, dst, src);
 }
@@ -79,6 +114,21 @@ ocb_aes128_decrypt(struct ocb_ctx *ctx, const struct ocb_aes128_encrypt_key *key
 		   const struct aes128_ctx *decrypt,
 		   size_t length, uint8_t *dst, const uint8_t *src)
 {
+#if HAVE_NATIVE_ocb_aes128_decrypt_n
+  size_t n = length / OCB_BLOCK_SIZE;
+  if (n > 0)
+    {
+      union nettle_block16 L[64];
+      size_t done;
+
+      if (ctx->message_count == 0)
+	ctx->offset = ctx->initial;
+      ocb_aes128_fill_l (&key->ocb, ctx->message_count + n, L);
+      done = OCB_BLOCK_SIZE
+	* _ocb_aes128_decrypt_n (ctx, decrypt, L, n, dst, src);
+      length -= done; dst += done; src += done;
+    }
+#endif
   ocb_decrypt (ctx, &key->ocb, &key->encrypt, (nettle_cipher_func *) aes128_encrypt,
 	       decrypt, (nettle_cipher_func *) aes128_decrypt,
 	       length, dst, src);
@@ -98,8 +148,12 @@ ocb_aes128_encrypt_message (const struct ocb_aes128_encrypt_key *key,
 			    size_t tlength,
 			    size_t clength, uint8_t *dst, const uint8_t *src)
 {
-  ocb_encrypt_message (&key->ocb, &key->encrypt, (nettle_cipher_func *) aes128_encrypt,
-		       nlength, nonce, alength, adata, tlength, clength, dst, src);
+  struct ocb_ctx ctx;
+  assert (clength >= tlength);
+  ocb_aes128_set_nonce (&ctx, key, tlength, nlength, nonce);
+  ocb_aes128_update (&ctx, key, alength, adata);
+  ocb_aes128_encrypt (&ctx, key, clength - tlength, dst, src);
+  ocb_aes128_digest (&ctx, key, dst + clength - tlength);
 }
 
 int
@@ -110,8 +164,11 @@ ocb_aes128_decrypt_message (const struct ocb_aes128_encrypt_key *key,
 			    size_t tlength,
 			    size_t mlength, uint8_t *dst, const uint8_t *src)
 {
-  return ocb_decrypt_message (&key->ocb, &key->encrypt, (nettle_cipher_func *) aes128_encrypt,
-			      &decrypt, (nettle_cipher_func *) aes128_decrypt,
-			      nlength, nonce, alength, adata,
-			      tlength, mlength, dst, src);
+  struct ocb_ctx ctx;
+  union nettle_block16 digest;
+  ocb_aes128_set_nonce (&ctx, key, tlength, nlength, nonce);
+  ocb_aes128_update (&ctx, key, alength, adata);
+  ocb_aes128_decrypt (&ctx, key, decrypt, mlength, dst, src);
+  ocb_aes128_digest (&ctx, key, digest.b);
+  return memeql_sec (digest.b, src + mlength, tlength);
 }
@@ -0,0 +1,60 @@
+/* ocb-internal.h
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_OCB_INTERNAL_H_INCLUDED
+#define NETTLE_OCB_INTERNAL_H_INCLUDED
+
+#include "ocb.h"
+
+/* Name mangling */
+#define _ocb_aes128_encrypt_n _nettle_ocb_aes128_encrypt_n
+#define _ocb_aes128_decrypt_n _nettle_ocb_aes128_decrypt_n
+
+/* Process n complete message blocks, updating offset, checksum and
+   message_count of ctx. The table L holds L_i, for all i up to the
+   largest number of trailing zeros of any of the block indices.
+   Returns the number of blocks processed, which is either n or, if
+   not supported by the cpu, zero. */
+#if HAVE_NATIVE_ocb_aes128_encrypt_n
+size_t
+_ocb_aes128_encrypt_n (struct ocb_ctx *ctx, const struct aes128_ctx *cipher,
+		       const union nettle_block16 *L,
+		       size_t n, uint8_t *dst, const uint8_t *src);
+#endif
+
+#if HAVE_NATIVE_ocb_aes128_decrypt_n
+size_t
+_ocb_aes128_decrypt_n (struct ocb_ctx *ctx, const struct aes128_ctx *cipher,
+		       const union nettle_block16 *L,
+		       size_t n, uint8_t *dst, const uint8_t *src);
+#endif
+
+#endif /* NETTLE_OCB_INTERNAL_H_INCLUDED */
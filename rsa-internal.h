@@ -43,6 +43,14 @@
 #define _rsa_sec_compute_root_itch _nettle_rsa_sec_compute_root_itch
 #define _rsa_sec_compute_root _nettle_rsa_sec_compute_root
 #define _rsa_sec_compute_root_tr _nettle_rsa_sec_compute_root_tr
+#define _rsa_sec_compute_root_tr_itch _nettle_rsa_sec_compute_root_tr_itch
+#define _rsa_multi_sec_compute_root_itch _nettle_rsa_multi_sec_compute_root_itch
+#define _rsa_multi_sec_compute_root _nettle_rsa_multi_sec_compute_root
+#define _rsa_multi_sec_compute_root_tr _nettle_rsa_multi_sec_compute_root_tr
+#define _rsa_multi_sec_compute_root_tr_itch _nettle_rsa_multi_sec_compute_root_tr_itch
+#define _rsa_redc_ninv _nettle_rsa_redc_ninv
+#define _rsa_redc _nettle_rsa_redc
+#define _rsa_redc_powm _nettle_rsa_redc_powm
 #define _rsa_oaep_encrypt _nettle_rsa_oaep_encrypt
 #define _rsa_oaep_decrypt _nettle_rsa_oaep_decrypt
 
@@ -76,6 +84,48 @@ _rsa_sec_compute_root_tr(const struct rsa_public_key *pub,
 			 void *random_ctx, nettle_random_func *random,
 			 mp_limb_t *x, const mp_limb_t *m);
 
+/* Scratch space for rsa_mpn_compute_root_tr. */
+mp_size_t
+_rsa_sec_compute_root_tr_itch(const struct rsa_public_key *pub,
+			      const struct rsa_private_key *key);
+
+/* Multi-prime variants. m and the result use as many limbs as the
+   full modulo. */
+mp_size_t
+_rsa_multi_sec_compute_root_itch(const struct rsa_multi_private_key *key);
+void
+_rsa_multi_sec_compute_root(const struct rsa_multi_private_key *key,
+			    mp_limb_t *rp, const mp_limb_t *mp,
+			    mp_limb_t *scratch);
+
+int
+_rsa_multi_sec_compute_root_tr(const struct rsa_public_key *pub,
+			       const struct rsa_multi_private_key *key,
+			       void *random_ctx, nettle_random_func *random,
+			       mp_limb_t *x, const mp_limb_t *m);
+
+mp_size_t
+_rsa_multi_sec_compute_root_tr_itch(const struct rsa_public_key *pub,
+				    const struct rsa_multi_private_key *key);
+
+/* Montgomery arithmetic modulo n, for operations involving only
+   public values. Not side-channel silent. */
+mp_limb_t
+_rsa_redc_ninv(const struct rsa_public_key *pub);
+
+/* Sets rp = tp B^{-nn} (mod n), with 0 <= rp < n. The input is 2 nn
+   limbs, and requires tp < n B^{nn}. Clobbers the input. */
+void
+_rsa_redc(const struct rsa_public_key *pub, mp_limb_t ninv,
+	  mp_limb_t *rp, mp_limb_t *tp);
+
+/* Sets rp = s^e (mod n), in ordinary representation, where sp holds s
+   in Montgomery representation, s B^nn (mod n). Uses 2 nn limbs of
+   scratch at tp. */
+void
+_rsa_redc_powm(const struct rsa_public_key *pub, mp_limb_t ninv,
+	       mp_limb_t *rp, const mp_limb_t *sp, mp_limb_t *tp);
+
 int
 _rsa_oaep_encrypt (const struct rsa_public_key *key,
 		   void *random_ctx, nettle_random_func *random,
@@ -51,6 +51,79 @@
 #endif
 
 
+void
+rsa_generate_prime(mpz_t p, unsigned bits, const mpz_t e,
+		   void *random_ctx, nettle_random_func *random,
+		   void *progress_ctx, nettle_progress_func *progress)
+{
+  mpz_t p1;
+  mpz_t tmp;
+
+  mpz_init(p1); mpz_init(tmp);
+
+  for (;;)
+    {
+      nettle_random_prime(p, bits, 1,
+			  random_ctx, random,
+			  progress_ctx, progress);
+
+      /* If e was given, we must choose p such that p-1 has no factors in
+       * common with e. */
+      if (!e)
+	break;
+
+      mpz_sub_ui(p1, p, 1);
+      mpz_gcd(tmp, e, p1);
+
+      if (mpz_cmp_ui(tmp, 1) == 0)
+	break;
+      else if (progress) progress(progress_ctx, 'c');
+    }
+
+  mpz_clear(p1); mpz_clear(tmp);
+}
+
+int
+rsa_keypair_from_primes(struct rsa_public_key *pub,
+			struct rsa_private_key *key)
+{
+  mpz_t p1;
+  mpz_t q1;
+  mpz_t phi;
+  int res = 0;
+
+  mpz_mul(pub->n, key->p, key->q);
+  if (mpz_sizeinbase(pub->n, 2) < RSA_MINIMUM_N_BITS)
+    return 0;
+
+  /* c = q^{-1} (mod p) */
+  if (!mpz_invert(key->c, key->q, key->p))
+    return 0;
+
+  mpz_init(p1); mpz_init(q1); mpz_init(phi);
+
+  mpz_sub_ui(p1, key->p, 1);
+  mpz_sub_ui(q1, key->q, 1);
+  mpz_mul(phi, p1, q1);
+
+  /* Needs gmp-3, or inverse might be negative. */
+  if (mpz_invert(key->d, pub->e, phi))
+    {
+      /* a = d % (p-1) */
+      mpz_fdiv_r(key->a, key->d, p1);
+
+      /* b = d % (q-1) */
+      mpz_fdiv_r(key->b, key->d, q1);
+
+      pub->size = key->size = (mpz_sizeinbase(pub->n, 2) + 7) / 8;
+      res = 1;
+    }
+
+  mpz_clear(p1); mpz_clear(q1); mpz_clear(phi);
+
+  return res;
+}
+
 int
 rsa_generate_keypair(struct rsa_public_key *pub,
 		     struct rsa_private_key *key,
@@ -59,11 +132,6 @@ rsa_generate_keypair(struct rsa_public_key *pub,
 		     unsigned n_size,
 		     unsigned e_size)
 {
-  mpz_t p1;
-  mpz_t q1;
-  mpz_t phi;
-  mpz_t tmp;
-
   if (e_size)
     {
       /* We should choose e randomly. Is the size reasonable? */
@@ -89,121 +157,67 @@ rsa_generate_keypair(struct rsa_public_key *pub,
 
   if (n_size < RSA_MINIMUM_N_BITS)
     return 0;
-  
-  mpz_init(p1); mpz_init(q1); mpz_init(phi); mpz_init(tmp);
 
-  /* Generate primes */
   for (;;)
     {
-      /* Generate p, such that gcd(p-1, e) = 1 */
-      for (;;)
-	{
-	  nettle_random_prime(key->p, (n_size+1)/2, 1,
-			      random_ctx, random,
-			      progress_ctx, progress);
-
-	  mpz_sub_ui(p1, key->p, 1);
-      
-	  /* If e was given, we must choose p such that p-1 has no factors in
-	   * common with e. */
-	  if (e_size)
-	    break;
-	  
-	  mpz_gcd(tmp, pub->e, p1);
-
-	  if (mpz_cmp_ui(tmp, 1) == 0)
-	    break;
-	  else if (progress) progress(progress_ctx, 'c');
-	} 
+      /* Generate p and q, such that gcd(p-1, e) = gcd(q-1, e) = 1 */
+      rsa_generate_prime(key->p, (n_size+1)/2, e_size ? NULL : pub->e,
+			 random_ctx, random, progress_ctx, progress);
 
       if (progress)
 	progress(progress_ctx, '\n');
-      
-      /* Generate q, such that gcd(q-1, e) = 1 */
-      for (;;)
-	{
-	  nettle_random_prime(key->q, n_size/2, 1,
-			      random_ctx, random,
-			      progress_ctx, progress);
-
-	  mpz_sub_ui(q1, key->q, 1);
-      
-	  /* If e was given, we must choose q such that q-1 has no factors in
-	   * common with e. */
-	  if (e_size)
-	    break;
-	  
-	  mpz_gcd(tmp, pub->e, q1);
-
-	  if (mpz_cmp_ui(tmp, 1) == 0)
-	    break;
-	  else if (progress) progress(progress_ctx, 'c');
-	}
 
-      /* Now we have the primes. Is the product of the right size? */
-      mpz_mul(pub->n, key->p, key->q);
-
-      assert (mpz_sizeinbase(pub->n, 2) == n_size);
+      rsa_generate_prime(key->q, n_size/2, e_size ? NULL : pub->e,
+			 random_ctx, random, progress_ctx, progress);
 
       if (progress)
 	progress(progress_ctx, '\n');
 
-      /* c = q^{-1} (mod p) */
-      if (mpz_invert(key->c, key->q, key->p))
-	/* This should succeed everytime. But if it doesn't,
-	 * we try again. */
-	break;
-      else if (progress) progress(progress_ctx, '?');
-    }
-
-  mpz_mul(phi, p1, q1);
-  
-  /* If we didn't have a given e, generate one now. */
-  if (e_size)
-    {
-      int retried = 0;
-      for (;;)
+      /* If we didn't have a given e, generate one now. */
+      if (e_size)
 	{
-	  nettle_mpz_random_size(pub->e,
-				 random_ctx, random,
-				 e_size);
-	
-	  /* Make sure it's odd and that the most significant bit is
-	   * set */
-	  mpz_setbit(pub->e, 0);
-	  mpz_setbit(pub->e, e_size - 1);
-
-	  /* Needs gmp-3, or inverse might be negative. */
-	  if (mpz_invert(key->d, pub->e, phi))
-	    break;
-
-	  if (progress) progress(progress_ctx, 'e');
-	  retried = 1;
+	  mpz_t phi;
+	  mpz_t tmp;
+	  int retried = 0;
+
+	  mpz_init(phi); mpz_init(tmp);
+	  mpz_sub_ui(phi, key->p, 1);
+	  mpz_sub_ui(tmp, key->q, 1);
+	  mpz_mul(phi, phi, tmp);
+
+	  for (;;)
+	    {
+	      nettle_mpz_random_size(pub->e,
+				     random_ctx, random,
+				     e_size);
+
+	      /* Make sure it's odd and that the most significant bit is
+	       * set */
+	      mpz_setbit(pub->e, 0);
+	      mpz_setbit(pub->e, e_size - 1);
+
+	      mpz_gcd(tmp, pub->e, phi);
+	      if (mpz_cmp_ui(tmp, 1) == 0)
+		break;
+
+	      if (progress) progress(progress_ctx, 'e');
+	      retried = 1;
+	    }
+	  if (retried && progress)
+	    progress(progress_ctx, '\n');
+
+	  mpz_clear(phi); mpz_clear(tmp);
 	}
-      if (retried && progress)
-	progress(progress_ctx, '\n');	
-    }
-  else
-    {
-      /* Must always succeed, as we already that e
-       * doesn't have any common factor with p-1 or q-1. */
-      int res = mpz_invert(key->d, pub->e, phi);
-      assert(res);
-    }
-
-  /* Done! Almost, we must compute the auxillary private values. */
-  /* a = d % (p-1) */
-  mpz_fdiv_r(key->a, key->d, p1);
-
-  /* b = d % (q-1) */
-  mpz_fdiv_r(key->b, key->d, q1);
 
-  /* c was computed earlier */
+      /* This should succeed everytime. But if it doesn't, we try
+       * again. */
+      if (rsa_keypair_from_primes(pub, key))
+	break;
+      else if (progress) progress(progress_ctx, '?');
+    }
 
-  pub->size = key->size = (n_size + 7) / 8;
+  assert (mpz_sizeinbase(pub->n, 2) == n_size);
   assert(pub->size >= RSA_MINIMUM_N_OCTETS);
-  
-  mpz_clear(p1); mpz_clear(q1); mpz_clear(phi); mpz_clear(tmp);
 
   return 1;
 }
@@ -0,0 +1,246 @@
+/* rsa-mpn.c
+
+   Allocation-free RSA operations on mpn numbers.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "rsa.h"
+#include "rsa-internal.h"
+#include "pkcs1-internal.h"
+
+#include "gmp-glue.h"
+#include "hogweed-internal.h"
+
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+/* Size of the encoded message, in limbs. */
+#define EM_LIMBS(size) \
+  (((size) + sizeof (mp_limb_t) - 1) / sizeof (mp_limb_t))
+
+#if NETTLE_USE_MINI_GMP
+/* Reuses the mpz functions, which do their own allocation. */
+static mp_size_t
+rsa_mpn_verify_itch (const struct rsa_public_key *pub UNUSED)
+{
+  return 0;
+}
+
+int
+rsa_mpn_pkcs1_verify(const struct rsa_public_key *pub,
+		     size_t length, const uint8_t *digest_info,
+		     const mp_limb_t *s,
+		     mp_limb_t *scratch UNUSED)
+{
+  mpz_t sz;
+
+  return rsa_pkcs1_verify (pub, length, digest_info,
+			   mpz_roinit_n (sz, s, mpz_size (pub->n)));
+}
+
+#else /* !NETTLE_USE_MINI_GMP */
+
+mp_limb_t
+_rsa_redc_ninv(const struct rsa_public_key *pub)
+{
+  mp_limb_t n0 = mpz_getlimbn (pub->n, 0);
+  mp_limb_t inv;
+  unsigned i;
+
+  /* Newton iteration for 1/n mod B, doubling the number of correct
+     bits each step, starting from 3 correct bits. */
+  for (i = 0, inv = n0; i < 5; i++)
+    inv *= 2 - n0 * inv;
+
+  return -inv;
+}
+
+void
+_rsa_redc(const struct rsa_public_key *pub, mp_limb_t ninv,
+	  mp_limb_t *rp, mp_limb_t *tp)
+{
+  const mp_limb_t *np = mpz_limbs_read (pub->n);
+  mp_size_t nn = mpz_size (pub->n);
+  mp_limb_t cy;
+  mp_size_t i;
+
+  /* Each iteration clears the low limb, and then we can store the
+     carry there, to be added in at the end. */
+  for (i = 0; i < nn; i++)
+    tp[i] = mpn_addmul_1 (tp + i, np, nn, tp[i] * ninv);
+
+  cy = mpn_add_n (rp, tp + nn, tp, nn);
+  if (cy || mpn_cmp (rp, np, nn) >= 0)
+    mpn_sub_n (rp, rp, np, nn);
+}
+
+void
+_rsa_redc_powm(const struct rsa_public_key *pub, mp_limb_t ninv,
+	       mp_limb_t *rp, const mp_limb_t *sp, mp_limb_t *tp)
+{
+  mp_size_t nn = mpz_size (pub->n);
+  mp_size_t ebn = mpz_sizeinbase (pub->e, 2);
+
+  /* Left-to-right binary exponentiation, for the usual small e. */
+  mpn_copyi (rp, sp, nn);
+  while (--ebn > 0)
+    {
+      mpn_sqr (tp, rp, nn);
+      _rsa_redc (pub, ninv, rp, tp);
+      if (mpz_tstbit (pub->e, ebn - 1))
+	{
+	  mpn_mul_n (tp, rp, sp, nn);
+	  _rsa_redc (pub, ninv, rp, tp);
+	}
+    }
+
+  /* Convert back. */
+  mpn_copyi (tp, rp, nn);
+  mpn_zero (tp + nn, nn);
+  _rsa_redc (pub, ninv, rp, tp);
+}
+
+/* Needs the encoded message, m, s B^nn, s^e and a temporary of 2nn
+   limbs, followed by scratch for the division. */
+static mp_size_t
+rsa_mpn_verify_itch (const struct rsa_public_key *pub)
+{
+  mp_size_t nn = mpz_size (pub->n);
+
+  return EM_LIMBS (pub->size) + 5*nn + mpn_sec_div_r_itch (2*nn, nn);
+}
+
+int
+rsa_mpn_pkcs1_verify(const struct rsa_public_key *pub,
+		     size_t length, const uint8_t *digest_info,
+		     const mp_limb_t *s,
+		     mp_limb_t *scratch)
+{
+  const mp_limb_t *np = mpz_limbs_read (pub->n);
+  mp_size_t nn = mpz_size (pub->n);
+  uint8_t *em = (uint8_t *) scratch;
+  mp_limb_t *mp = scratch + EM_LIMBS (pub->size);
+  mp_limb_t *sp = mp + nn;
+  mp_limb_t *xp = sp + nn;
+  mp_limb_t *tp = xp + nn;
+
+  if (mpn_zero_p (s, nn) || mpn_cmp (s, np, nn) >= 0)
+    return 0;
+
+  if (!_pkcs1_signature_prefix (pub->size, em, length, digest_info, 0))
+    return 0;
+
+  mpn_set_base256 (mp, nn, em, pub->size);
+
+  /* Convert s to Montgomery representation, s B^nn (mod n). */
+  mpn_zero (tp, nn);
+  mpn_copyi (tp + nn, s, nn);
+  mpn_sec_div_r (tp, 2*nn, np, nn, tp + 2*nn);
+  mpn_copyi (sp, tp, nn);
+
+  _rsa_redc_powm (pub, _rsa_redc_ninv (pub), xp, sp, tp);
+
+  return mpn_cmp (xp, mp, nn) == 0;
+}
+#endif /* !NETTLE_USE_MINI_GMP */
+
+mp_size_t
+rsa_mpn_itch(const struct rsa_public_key *pub,
+	     const struct rsa_private_key *key)
+{
+  mp_size_t itch = rsa_mpn_verify_itch (pub);
+
+  if (key)
+    {
+      /* For rsa_mpn_sec_decrypt, a copy of c followed by the scratch
+	 for the root computation, which is also large enough for the
+	 encoded message. */
+      mp_size_t i2 = mpz_size (pub->n)
+	+ _rsa_sec_compute_root_tr_itch (pub, key);
+      itch = MAX (itch, i2);
+    }
+  return itch;
+}
+
+int
+rsa_mpn_pkcs1_sign_tr(const struct rsa_public_key *pub,
+		      const struct rsa_private_key *key,
+		      void *random_ctx, nettle_random_func *random,
+		      size_t length, const uint8_t *digest_info,
+		      mp_limb_t *s,
+		      mp_limb_t *scratch)
+{
+  mp_size_t nn = mpz_size (pub->n);
+  uint8_t *em = (uint8_t *) scratch;
+
+  if (!_pkcs1_signature_prefix (key->size, em, length, digest_info, 0))
+    {
+      mpn_zero (s, nn);
+      return 0;
+    }
+
+  mpn_set_base256 (s, nn, em, key->size);
+
+  return rsa_mpn_compute_root_tr (pub, key, random_ctx, random,
+				  s, s, scratch);
+}
+
+int
+rsa_mpn_sec_decrypt(const struct rsa_public_key *pub,
+		    const struct rsa_private_key *key,
+		    void *random_ctx, nettle_random_func *random,
+		    size_t length, uint8_t *message,
+		    const mp_limb_t *c,
+		    mp_limb_t *scratch)
+{
+  mp_size_t nn = mpz_size (pub->n);
+  mp_limb_t *mp = scratch;
+  uint8_t *em = (uint8_t *) (scratch + nn);
+  int res;
+
+  /* First check that input is in range. */
+  if (mpn_cmp (c, mpz_limbs_read (pub->n), nn) >= 0)
+    return 0;
+
+  mpn_copyi (mp, c, nn);
+
+  res = rsa_mpn_compute_root_tr (pub, key, random_ctx, random,
+				 mp, mp, scratch + nn);
+
+  mpn_get_base256 (em, key->size, mp, nn);
+
+  res &= _pkcs1_sec_decrypt (length, message, key->size, em);
+
+  return res;
+}
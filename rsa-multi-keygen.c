@@ -0,0 +1,231 @@
+/* rsa-multi-keygen.c
+
+   Generation of multi-prime RSA keypairs.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include "rsa.h"
+#include "bignum.h"
+
+/* Computes the product of the primes. */
+static void
+multi_product (mpz_t n, unsigned nprimes, mpz_srcptr *primes)
+{
+  unsigned i;
+
+  mpz_mul (n, primes[0], primes[1]);
+  for (i = 2; i < nprimes; i++)
+    mpz_mul (n, n, primes[i]);
+}
+
+/* Computes all the private values, given the primes and e. Returns 0
+   if some required inverse doesn't exist, e.g., if two primes are
+   equal. */
+static int
+multi_complete (struct rsa_public_key *pub,
+		struct rsa_multi_private_key *key)
+{
+  mpz_t phi;
+  mpz_t R;
+  mpz_t tmp;
+  unsigned i;
+  int res = 0;
+
+  /* c = q^{-1} (mod p) */
+  if (!mpz_invert (key->key.c, key->key.q, key->key.p))
+    return 0;
+
+  mpz_init (phi); mpz_init (R); mpz_init (tmp);
+
+  mpz_sub_ui (phi, key->key.p, 1);
+  mpz_sub_ui (tmp, key->key.q, 1);
+  mpz_mul (phi, phi, tmp);
+  for (i = 0; i < key->nprimes - 2; i++)
+    {
+      mpz_sub_ui (tmp, key->r[i], 1);
+      mpz_mul (phi, phi, tmp);
+    }
+
+  if (!mpz_invert (key->key.d, pub->e, phi))
+    goto fail;
+
+  /* a = d % (p-1) */
+  mpz_sub_ui (tmp, key->key.p, 1);
+  mpz_fdiv_r (key->key.a, key->key.d, tmp);
+
+  /* b = d % (q-1) */
+  mpz_sub_ui (tmp, key->key.q, 1);
+  mpz_fdiv_r (key->key.b, key->key.d, tmp);
+
+  mpz_mul (R, key->key.p, key->key.q);
+  for (i = 0; i < key->nprimes - 2; i++)
+    {
+      /* d_i = d % (r_i - 1) */
+      mpz_sub_ui (tmp, key->r[i], 1);
+      mpz_fdiv_r (key->d[i], key->key.d, tmp);
+
+      /* t_i = (p q r_3 ... r_{i-1})^{-1} (mod r_i) */
+      if (!mpz_invert (key->t[i], R, key->r[i]))
+	goto fail;
+
+      mpz_mul (R, R, key->r[i]);
+    }
+
+  mpz_set (pub->n, R);
+  pub->size = key->key.size = (mpz_sizeinbase (R, 2) + 7) / 8;
+  res = 1;
+
+ fail:
+  mpz_clear (phi); mpz_clear (R); mpz_clear (tmp);
+  return res;
+}
+
+int
+rsa_multi_generate_keypair(struct rsa_public_key *pub,
+			   struct rsa_multi_private_key *key,
+			   void *random_ctx, nettle_random_func *random,
+			   void *progress_ctx, nettle_progress_func *progress,
+			   unsigned n_size,
+			   unsigned e_size,
+			   unsigned nprimes)
+{
+  mpz_ptr primes[RSA_MAX_PRIMES];
+  mpz_t n;
+  unsigned i;
+
+  if (nprimes < 2 || nprimes > RSA_MAX_PRIMES)
+    return 0;
+
+  if (e_size)
+    {
+      /* We should choose e randomly. Is the size reasonable? */
+      if ((e_size < 16) || (e_size >= n_size) )
+	return 0;
+    }
+  else
+    {
+      /* We have a fixed e. It must be odd, 3 or larger, and smaller
+       * than n. */
+      if (!mpz_tstbit(pub->e, 0)
+	  || mpz_cmp_ui(pub->e, 3) < 0
+	  || mpz_sizeinbase(pub->e, 2) >= n_size)
+	return 0;
+    }
+
+  if (n_size < RSA_MINIMUM_N_BITS)
+    return 0;
+
+  key->nprimes = nprimes;
+  primes[0] = key->key.p;
+  primes[1] = key->key.q;
+  for (i = 2; i < nprimes; i++)
+    primes[i] = key->r[i-2];
+
+  mpz_init (n);
+
+  for (;;)
+    {
+      /* Distribute the bits as evenly as possible, with the largest
+       * primes first. */
+      for (i = 0; i < nprimes; i++)
+	{
+	  rsa_generate_prime (primes[i], (n_size + nprimes - 1 - i) / nprimes,
+			      e_size ? NULL : pub->e,
+			      random_ctx, random, progress_ctx, progress);
+	  if (progress)
+	    progress(progress_ctx, '\n');
+	}
+
+      /* With more than two primes, the product can be one bit too
+       * small. Then replace the last prime. */
+      for (;;)
+	{
+	  multi_product (n, nprimes, (mpz_srcptr *) primes);
+	  if (mpz_sizeinbase (n, 2) == n_size)
+	    break;
+
+	  if (progress) progress(progress_ctx, 's');
+	  rsa_generate_prime (primes[nprimes-1], n_size / nprimes,
+			      e_size ? NULL : pub->e,
+			      random_ctx, random, progress_ctx, progress);
+	}
+
+      /* If we didn't have a given e, generate one now. */
+      if (e_size)
+	{
+	  mpz_t phi;
+	  mpz_t tmp;
+
+	  mpz_init (phi); mpz_init (tmp);
+	  mpz_set_ui (phi, 1);
+	  for (i = 0; i < nprimes; i++)
+	    {
+	      mpz_sub_ui (tmp, primes[i], 1);
+	      mpz_mul (phi, phi, tmp);
+	    }
+	  for (;;)
+	    {
+	      nettle_mpz_random_size(pub->e,
+				     random_ctx, random,
+				     e_size);
+
+	      /* Make sure it's odd and that the most significant bit is
+	       * set */
+	      mpz_setbit(pub->e, 0);
+	      mpz_setbit(pub->e, e_size - 1);
+
+	      mpz_gcd(tmp, pub->e, phi);
+	      if (mpz_cmp_ui(tmp, 1) == 0)
+		break;
+
+	      if (progress) progress(progress_ctx, 'e');
+	    }
+	  mpz_clear (phi); mpz_clear (tmp);
+	}
+
+      if (multi_complete (pub, key))
+	break;
+      else if (progress) progress(progress_ctx, '?');
+    }
+
+  mpz_clear (n);
+
+  assert (mpz_sizeinbase(pub->n, 2) == n_size);
+  assert (pub->size >= RSA_MINIMUM_N_OCTETS);
+
+  return 1;
+}
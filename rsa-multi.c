@@ -0,0 +1,107 @@
+/* rsa-multi.c
+
+   Multi-prime RSA private keys.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "rsa.h"
+#include "rsa-internal.h"
+
+void
+rsa_multi_private_key_init(struct rsa_multi_private_key *key)
+{
+  unsigned i;
+
+  rsa_private_key_init(&key->key);
+  for (i = 0; i < RSA_MAX_PRIMES - 2; i++)
+    {
+      mpz_init(key->r[i]);
+      mpz_init(key->d[i]);
+      mpz_init(key->t[i]);
+    }
+  key->nprimes = 2;
+}
+
+void
+rsa_multi_private_key_clear(struct rsa_multi_private_key *key)
+{
+  unsigned i;
+
+  rsa_private_key_clear(&key->key);
+  for (i = 0; i < RSA_MAX_PRIMES - 2; i++)
+    {
+      mpz_clear(key->r[i]);
+      mpz_clear(key->d[i]);
+      mpz_clear(key->t[i]);
+    }
+}
+
+int
+rsa_multi_private_key_prepare(struct rsa_multi_private_key *key)
+{
+  mpz_t n;
+  unsigned i;
+
+  if (key->nprimes < 2 || key->nprimes > RSA_MAX_PRIMES)
+    return 0;
+
+  /* Same requirement as for rsa_private_key_prepare. */
+  if (mpz_size (key->key.q) + mpz_size (key->key.c) < mpz_size(key->key.p))
+    return 0;
+
+  if (mpz_even_p (key->key.p) || mpz_even_p (key->key.q))
+    return 0;
+
+  /* The root computation requires that the exponent and coefficient
+   * for each additional prime are non-zero, and no larger than the
+   * prime. */
+  for (i = 0; i < key->nprimes - 2; i++)
+    if (mpz_even_p (key->r[i])
+	|| mpz_sgn (key->d[i]) <= 0 || mpz_sgn (key->t[i]) <= 0
+	|| mpz_size (key->d[i]) > mpz_size (key->r[i])
+	|| mpz_size (key->t[i]) > mpz_size (key->r[i]))
+      return 0;
+
+  mpz_init(n);
+  mpz_mul(n, key->key.p, key->key.q);
+  for (i = 0; i < key->nprimes - 2; i++)
+    mpz_mul(n, n, key->r[i]);
+
+  key->key.size = _rsa_check_size(n);
+
+  mpz_clear(n);
+
+  return (key->key.size > 0);
+}
@@ -58,3 +58,22 @@ rsa_pkcs1_sign_tr(const struct rsa_public_key *pub,
   mpz_clear(m);
   return ret;
 }
+
+int
+rsa_multi_pkcs1_sign_tr(const struct rsa_public_key *pub,
+			const struct rsa_multi_private_key *key,
+			void *random_ctx, nettle_random_func *random,
+			size_t length, const uint8_t *digest_info,
+			mpz_t s)
+{
+  mpz_t m;
+  int ret;
+
+  mpz_init(m);
+
+  ret = (pkcs1_rsa_digest_encode (m, key->key.size, length, digest_info)
+	 && rsa_multi_compute_root_tr (pub, key, random_ctx, random,
+				       s, m));
+  mpz_clear(m);
+  return ret;
+}
@@ -0,0 +1,284 @@
+/* rsa-prepared.c
+
+   RSA operations using precomputed per-key values.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "rsa.h"
+#include "rsa-internal.h"
+
+#include "gmp-glue.h"
+#include "hogweed-internal.h"
+
+#if NETTLE_USE_MINI_GMP
+/* No mpn_sec_* functions, fall back to the ordinary functions. */
+int
+rsa_prepared_key_init(struct rsa_prepared_key *prep,
+		      const struct rsa_public_key *pub,
+		      const struct rsa_private_key *key)
+{
+  prep->pub = pub;
+  prep->key = key;
+  prep->storage = NULL;
+  prep->storage_size = 0;
+  return !(mpz_even_p (pub->n)
+	   || (key && (mpz_even_p (key->p) || mpz_even_p (key->q))));
+}
+
+void
+rsa_prepared_key_clear(struct rsa_prepared_key *prep)
+{
+  prep->pub = NULL;
+  prep->key = NULL;
+}
+
+int
+rsa_prepared_pkcs1_sign_tr(struct rsa_prepared_key *prep,
+			   void *random_ctx, nettle_random_func *random,
+			   size_t length, const uint8_t *digest_info,
+			   mpz_t s)
+{
+  return prep->key && rsa_pkcs1_sign_tr (prep->pub, prep->key,
+					 random_ctx, random,
+					 length, digest_info, s);
+}
+
+int
+rsa_prepared_pkcs1_verify(struct rsa_prepared_key *prep,
+			  size_t length, const uint8_t *digest_info,
+			  const mpz_t signature)
+{
+  return rsa_pkcs1_verify (prep->pub, length, digest_info, signature);
+}
+
+#else /* !NETTLE_USE_MINI_GMP */
+
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+/* Size of the encoded message, in limbs. */
+#define EM_LIMBS(size) \
+  (((size) + sizeof (mp_limb_t) - 1) / sizeof (mp_limb_t))
+
+/* The storage holds r2, blind, unblind, the encoded message, and then
+   the areas m, c, x, t of size nn, nn, nn, 2nn, followed by scratch
+   space for the mpn_sec functions. */
+#define WORK(prep, nn) \
+  ((prep)->storage + 3*(nn) + EM_LIMBS ((prep)->pub->size))
+
+/* Sets rp = ap bp (mod n). Side-channel silent, using tp as a 2nn
+   limb temporary. Allows rp == ap or rp == bp. */
+static void
+sec_mod_mul (const struct rsa_prepared_key *prep, mp_size_t nn,
+	     mp_limb_t *rp, const mp_limb_t *ap, const mp_limb_t *bp,
+	     mp_limb_t *tp, mp_limb_t *scratch)
+{
+  mpn_sec_mul (tp, ap, nn, bp, nn, scratch);
+  mpn_sec_div_r (tp, 2*nn, mpz_limbs_read (prep->pub->n), nn, scratch);
+  mpn_copyi (rp, tp, nn);
+}
+
+/* Generates new blinding factors, as in rsa_sec_blind. */
+static void
+blind_generate (struct rsa_prepared_key *prep, mp_size_t nn,
+		void *random_ctx, nettle_random_func *random,
+		mp_limb_t *rp, mp_limb_t *tp, mp_limb_t *scratch)
+{
+  const struct rsa_public_key *pub = prep->pub;
+  const mp_limb_t *np = mpz_limbs_read (pub->n);
+
+  do
+    {
+      random (random_ctx, nn * sizeof (mp_limb_t), (uint8_t *) tp);
+      mpn_set_base256 (rp, nn, (uint8_t *) tp, nn * sizeof (mp_limb_t));
+      mpn_copyi (tp, rp, nn);
+    }
+  while (!mpn_sec_invert (prep->unblind, tp, np, nn,
+			  2 * nn * GMP_NUMB_BITS, scratch));
+
+  mpn_sec_powm (prep->blind, rp, nn, mpz_limbs_read (pub->e),
+		mpz_sizeinbase (pub->e, 2), np, nn, scratch);
+}
+
+static int
+sec_equal (const mp_limb_t *a, const mp_limb_t *b, size_t limbs)
+{
+  volatile mp_limb_t z = 0;
+  size_t i;
+
+  for (i = 0; i < limbs; i++)
+    z |= (a[i] ^ b[i]);
+
+  return z == 0;
+}
+
+int
+rsa_prepared_key_init(struct rsa_prepared_key *prep,
+		      const struct rsa_public_key *pub,
+		      const struct rsa_private_key *key)
+{
+  mp_size_t nn = mpz_size (pub->n);
+  mp_size_t ebn = mpz_sizeinbase (pub->e, 2);
+  mp_size_t itch;
+  mpz_t r2;
+
+  if (mpz_even_p (pub->n) || !pub->size || mpz_sgn (pub->e) <= 0)
+    return 0;
+  if (key && (mpz_even_p (key->p) || mpz_even_p (key->q)
+	      || key->size != pub->size))
+    return 0;
+
+  itch = MAX (mpn_sec_mul_itch (nn, nn), mpn_sec_div_r_itch (2*nn, nn));
+  itch = MAX (itch, mpn_sec_powm_itch (nn, ebn, nn));
+  itch = MAX (itch, mpn_sec_invert_itch (nn));
+  if (key)
+    itch = MAX (itch, _rsa_sec_compute_root_itch (key));
+
+  prep->pub = pub;
+  prep->key = key;
+  prep->storage_size = 3*nn + EM_LIMBS (pub->size) + 5*nn + itch;
+  prep->storage = gmp_alloc_limbs (prep->storage_size);
+  prep->r2 = prep->storage;
+  prep->blind = prep->storage + nn;
+  prep->unblind = prep->storage + 2*nn;
+  prep->blind_uses = 0;
+
+  prep->ninv = _rsa_redc_ninv (pub);
+
+  mpz_init (r2);
+  mpz_setbit (r2, 2 * nn * GMP_NUMB_BITS);
+  mpz_fdiv_r (r2, r2, pub->n);
+  mpz_limbs_copy (prep->r2, r2, nn);
+  mpz_clear (r2);
+
+  return 1;
+}
+
+void
+rsa_prepared_key_clear(struct rsa_prepared_key *prep)
+{
+  gmp_free_limbs (prep->storage, prep->storage_size);
+  prep->storage = NULL;
+}
+
+int
+rsa_prepared_pkcs1_sign_tr(struct rsa_prepared_key *prep,
+			   void *random_ctx, nettle_random_func *random,
+			   size_t length, const uint8_t *digest_info,
+			   mpz_t s)
+{
+  const struct rsa_public_key *pub = prep->pub;
+  const struct rsa_private_key *key = prep->key;
+  mp_size_t nn = mpz_size (pub->n);
+  uint8_t *em = (uint8_t *) (prep->storage + 3*nn);
+  mp_limb_t *mp = WORK (prep, nn);
+  mp_limb_t *cp = mp + nn;
+  mp_limb_t *xp = cp + nn;
+  mp_limb_t *tp = xp + nn;
+  mp_limb_t *scratch = tp + 2*nn;
+  int res;
+
+  if (!key
+      || !_pkcs1_signature_prefix (key->size, em, length, digest_info, 0))
+    return 0;
+
+  mpn_set_base256 (mp, nn, em, key->size);
+
+  /* Get blinding factors, either new ones, or by squaring the
+     previous ones. */
+  if (prep->blind_uses == 0)
+    {
+      blind_generate (prep, nn, random_ctx, random, xp, tp, scratch);
+      prep->blind_uses = RSA_PREPARED_BLIND_UPDATES;
+    }
+  else
+    {
+      sec_mod_mul (prep, nn, prep->blind, prep->blind, prep->blind,
+		   tp, scratch);
+      sec_mod_mul (prep, nn, prep->unblind, prep->unblind, prep->unblind,
+		   tp, scratch);
+    }
+  prep->blind_uses--;
+
+  /* c = m r^e, x = c^d = m^d r */
+  sec_mod_mul (prep, nn, cp, mp, prep->blind, tp, scratch);
+  _rsa_sec_compute_root (key, xp, cp, scratch);
+
+  /* Check the result, to protect against faults. */
+  mpn_sec_powm (tp, xp, nn, mpz_limbs_read (pub->e),
+		mpz_sizeinbase (pub->e, 2), mpz_limbs_read (pub->n), nn,
+		scratch);
+  res = sec_equal (tp, cp, nn);
+
+  sec_mod_mul (prep, nn, xp, xp, prep->unblind, tp, scratch);
+
+  if (res)
+    {
+      mpn_copyi (mpz_limbs_write (s, nn), xp, nn);
+      mpz_limbs_finish (s, nn);
+    }
+  return res;
+}
+
+int
+rsa_prepared_pkcs1_verify(struct rsa_prepared_key *prep,
+			  size_t length, const uint8_t *digest_info,
+			  const mpz_t signature)
+{
+  const struct rsa_public_key *pub = prep->pub;
+  mp_size_t nn = mpz_size (pub->n);
+  uint8_t *em = (uint8_t *) (prep->storage + 3*nn);
+  mp_limb_t *mp = WORK (prep, nn);
+  mp_limb_t *sp = mp + nn;
+  mp_limb_t *xp = sp + nn;
+  mp_limb_t *tp = xp + nn;
+
+  if (mpz_sgn (signature) <= 0 || mpz_cmp (signature, pub->n) >= 0)
+    return 0;
+
+  if (!_pkcs1_signature_prefix (pub->size, em, length, digest_info, 0))
+    return 0;
+
+  mpn_set_base256 (mp, nn, em, pub->size);
+
+  /* Convert s to Montgomery representation, s B^nn (mod n). */
+  mpz_limbs_copy (xp, signature, nn);
+  mpn_mul_n (tp, xp, prep->r2, nn);
+  _rsa_redc (pub, prep->ninv, sp, tp);
+
+  _rsa_redc_powm (pub, prep->ninv, xp, sp, tp);
+
+  return mpn_cmp (xp, mp, nn) == 0;
+}
+#endif /* !NETTLE_USE_MINI_GMP */
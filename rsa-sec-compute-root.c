@@ -44,6 +44,7 @@
 
 #if !NETTLE_USE_MINI_GMP
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
 
 /* Like mpn_sec_mul_itch, monotonously increasing in operand sizes. */
 static mp_size_t
@@ -163,6 +164,7 @@ _rsa_sec_compute_root (const struct rsa_private_key *key,
   mp_limb_t *r_mod_p = scratch;
   mp_limb_t *r_mod_q = scratch + pn;
   mp_limb_t *scratch_out = r_mod_q + qn;
+  mp_size_t xn;
   mp_limb_t cy;
 
   assert (pn <= nn);
@@ -186,10 +188,130 @@ _rsa_sec_compute_root (const struct rsa_private_key *key,
   cy = mpn_sub_n (r_mod_p, r_mod_p, scratch_out, pn);
   mpn_cnd_add_n (cy, r_mod_p, r_mod_p, pp, pn);
 
-  /* Finally, compute x = r_mod_q + q r_mod_p' */
+  /* Finally, compute x = r_mod_q + q r_mod_p'. The result is smaller
+     than p q, and for multi-prime keys, where nn > pn + qn is
+     possible, the high limbs are zero. */
   sec_mul (scratch_out, qp, qn, r_mod_p, pn, scratch_out + pn + qn);
 
+  xn = MIN (nn, pn + qn);
   cy = mpn_add_n (rp, scratch_out, r_mod_q, qn);
-  mpn_sec_add_1 (rp + qn, scratch_out + qn, nn - qn, cy, scratch_out + pn + qn);
+  mpn_sec_add_1 (rp + qn, scratch_out + qn, xn - qn, cy, scratch_out + pn + qn);
+  if (xn < nn)
+    mpn_zero (rp + xn, nn - xn);
+}
+
+/* Total number of limbs for all the primes, an upper bound for the
+   size of any product of a subset of them. */
+static mp_size_t
+multi_primes_size (const struct rsa_multi_private_key *key)
+{
+  mp_size_t size = mpz_size (key->key.p) + mpz_size (key->key.q);
+  unsigned i;
+
+  for (i = 0; i < key->nprimes - 2; i++)
+    size += mpz_size (key->r[i]);
+
+  return size;
+}
+
+mp_size_t
+_rsa_multi_sec_compute_root_itch (const struct rsa_multi_private_key *key)
+{
+  mp_size_t nn = NETTLE_OCTET_SIZE_TO_LIMB_SIZE (key->key.size);
+  mp_size_t pn = mpz_size (key->key.p);
+  mp_size_t qn = mpz_size (key->key.q);
+  mp_size_t rmax = multi_primes_size (key);
+  mp_size_t itch = _rsa_sec_compute_root_itch (&key->key);
+  mp_size_t Rn;
+  unsigned i;
+
+  for (i = 0, Rn = pn + qn; i < key->nprimes - 2; i++)
+    {
+      mp_size_t rn = mpz_size (key->r[i]);
+      mp_size_t dn = mpz_size (key->d[i]);
+      mp_size_t tn = mpz_size (key->t[i]);
+      mp_size_t tmp_size = MAX (nn, MAX (Rn + rn, rn + tn));
+      mp_size_t prime_itch = sec_mul_itch (pn, qn);
+
+      prime_itch = MAX (prime_itch, sec_powm_itch (nn, dn, rn));
+      prime_itch = MAX (prime_itch, mpn_sec_div_r_itch (nn, rn));
+      prime_itch = MAX (prime_itch, sec_mod_mul_itch (rn, tn, rn));
+      prime_itch = MAX (prime_itch, sec_mul_itch (Rn, rn));
+      prime_itch = MAX (prime_itch, mpn_sec_add_1_itch (nn));
+
+      /* rmax for the product of the primes so far, rn for the
+	 current residue, and tmp_size for a temporary. */
+      itch = MAX (itch, rmax + rn + tmp_size + prime_itch);
+      Rn += rn;
+    }
+  return itch;
+}
+
+/* Computes the root modulo p q using the two-prime code, and then
+   adds in one additional prime at a time, using Garner's algorithm:
+   With x = m^d (mod R), R = p q r_3 ... r_{i-1}, the root modulo R
+   r_i is x + R ((m^{d_i} - x) t_i mod r_i). */
+void
+_rsa_multi_sec_compute_root (const struct rsa_multi_private_key *key,
+			     mp_limb_t *rp, const mp_limb_t *mp,
+			     mp_limb_t *scratch)
+{
+  mp_size_t nn = NETTLE_OCTET_SIZE_TO_LIMB_SIZE (key->key.size);
+  mp_size_t pn = mpz_size (key->key.p);
+  mp_size_t qn = mpz_size (key->key.q);
+  mp_limb_t *Rp = scratch;
+  mp_limb_t *sp = scratch + multi_primes_size (key);
+  mp_size_t Rn;
+  unsigned i;
+
+  _rsa_sec_compute_root (&key->key, rp, mp, scratch);
+
+  for (i = 0, Rn = pn + qn; i < key->nprimes - 2; i++)
+    {
+      const mp_limb_t *ip = mpz_limbs_read (key->r[i]);
+      mp_size_t rn = mpz_size (key->r[i]);
+      mp_size_t dn = mpz_size (key->d[i]);
+      mp_size_t tn = mpz_size (key->t[i]);
+      mp_limb_t *tp = sp + rn;
+      mp_limb_t *scratch_out = tp + MAX (nn, MAX (Rn + rn, rn + tn));
+      mp_size_t xn;
+      mp_limb_t cy;
+
+      assert (dn <= rn);
+      assert (tn <= rn);
+
+      if (i == 0)
+	sec_mul (Rp, mpz_limbs_read (key->key.p), pn,
+		 mpz_limbs_read (key->key.q), qn, scratch_out);
+
+      /* Compute s = m^d % r_i = (m%r_i)^{d_i} % r_i */
+      sec_powm (sp, mp, nn, mpz_limbs_read (key->d[i]), dn, ip, rn,
+		scratch_out);
+
+      /* Set s' = (s - x) t_i % r_i */
+      mpn_copyi (tp, rp, nn);
+      mpn_sec_div_r (tp, nn, ip, rn, scratch_out);
+      cy = mpn_sub_n (sp, sp, tp, rn);
+      mpn_cnd_add_n (cy, sp, sp, ip, rn);
+
+      sec_mod_mul (tp, sp, rn, mpz_limbs_read (key->t[i]), tn, ip, rn,
+		   scratch_out);
+      mpn_copyi (sp, tp, rn);
+
+      /* Compute x + R s', which is smaller than R r_i <= n, so any
+	 limbs beyond nn are zero. */
+      sec_mul (tp, Rp, Rn, sp, rn, scratch_out);
+      xn = MIN (Rn + rn, nn);
+      cy = mpn_add_n (rp, rp, tp, xn);
+      if (xn < nn)
+	mpn_sec_add_1 (rp + xn, rp + xn, nn - xn, cy, scratch_out);
+
+      if (i + 3 < key->nprimes)
+	{
+	  sec_mul (tp, Rp, Rn, ip, rn, scratch_out);
+	  mpn_copyi (Rp, tp, Rn + rn);
+	}
+      Rn += rn;
+    }
 }
 #endif
@@ -50,6 +50,36 @@ rsa_sec_decrypt(const struct rsa_public_key *pub,
 	        void *random_ctx, nettle_random_func *random,
 	        size_t length, uint8_t *message,
 	        const mpz_t gibberish)
+{
+  TMP_GMP_DECL (scratch, mp_limb_t);
+  mp_size_t nn = mpz_size (pub->n);
+  int res;
+
+  /* First check that input is in range. */
+  if (mpz_sgn (gibberish) < 0 || mpz_cmp (gibberish, pub->n) >= 0)
+    return 0;
+
+  TMP_GMP_ALLOC (scratch, nn + rsa_mpn_itch (pub, key));
+
+  /* We need a copy because m can be shorter than key_size,
+   * but rsa_mpn_sec_decrypt expect all inputs to be
+   * normalized to a key_size long buffer length */
+  mpz_limbs_copy(scratch, gibberish, nn);
+
+  res = rsa_mpn_sec_decrypt (pub, key, random_ctx, random,
+			     length, message, scratch, scratch + nn);
+
+  TMP_GMP_FREE (scratch);
+  return res;
+}
+
+
+int
+rsa_multi_sec_decrypt(const struct rsa_public_key *pub,
+		      const struct rsa_multi_private_key *key,
+		      void *random_ctx, nettle_random_func *random,
+		      size_t length, uint8_t *message,
+		      const mpz_t gibberish)
 {
   TMP_GMP_DECL (m, mp_limb_t);
   TMP_GMP_DECL (em, uint8_t);
@@ -60,18 +90,15 @@ rsa_sec_decrypt(const struct rsa_public_key *pub,
     return 0;
 
   TMP_GMP_ALLOC (m, mpz_size(pub->n));
-  TMP_GMP_ALLOC (em, key->size);
+  TMP_GMP_ALLOC (em, key->key.size);
 
-  /* We need a copy because m can be shorter than key_size,
-   * but _rsa_sec_compute_root_tr expect all inputs to be
-   * normalized to a key_size long buffer length */
   mpz_limbs_copy(m, gibberish, mpz_size(pub->n));
 
-  res = _rsa_sec_compute_root_tr (pub, key, random_ctx, random, m, m);
+  res = _rsa_multi_sec_compute_root_tr (pub, key, random_ctx, random, m, m);
 
-  mpn_get_base256 (em, key->size, m, mpz_size(pub->n));
+  mpn_get_base256 (em, key->key.size, m, mpz_size(pub->n));
 
-  res &= _pkcs1_sec_decrypt (length, message, key->size, em);
+  res &= _pkcs1_sec_decrypt (length, message, key->key.size, em);
 
   TMP_GMP_FREE (em);
   TMP_GMP_FREE (m);
@@ -151,86 +151,192 @@ _rsa_sec_compute_root_tr(const struct rsa_public_key *pub,
   mpz_clear(xz);
   return res;
 }
+
+/* The mpz functions allocate as needed, but the caller still needs
+   some scratch space for the encoded message. */
+mp_size_t
+_rsa_sec_compute_root_tr_itch(const struct rsa_public_key *pub,
+			      const struct rsa_private_key *key UNUSED)
+{
+  return mpz_size (pub->n);
+}
+
+int
+rsa_mpn_compute_root_tr(const struct rsa_public_key *pub,
+			const struct rsa_private_key *key,
+			void *random_ctx, nettle_random_func *random,
+			mp_limb_t *x, const mp_limb_t *m,
+			mp_limb_t *scratch UNUSED)
+{
+  return _rsa_sec_compute_root_tr (pub, key, random_ctx, random, x, m);
+}
+
+/* Like rsa_compute_root, adding in the additional primes using
+   Garner's algorithm. */
+static void
+rsa_multi_compute_root(const struct rsa_multi_private_key *key,
+		       mpz_t x, const mpz_t m)
+{
+  mpz_t R, s;
+  unsigned i;
+
+  mpz_init (R);
+  mpz_init (s);
+
+  rsa_compute_root (&key->key, x, m);
+  mpz_mul (R, key->key.p, key->key.q);
+
+  for (i = 0; i < key->nprimes - 2; i++)
+    {
+      /* s = ((m^d % r_i) - x) t_i % r_i */
+      mpz_fdiv_r (s, m, key->r[i]);
+      mpz_powm_sec (s, s, key->d[i], key->r[i]);
+      mpz_sub (s, s, x);
+      mpz_mul (s, s, key->t[i]);
+      mpz_fdiv_r (s, s, key->r[i]);
+
+      mpz_addmul (x, R, s);
+      mpz_mul (R, R, key->r[i]);
+    }
+  mpz_clear (R);
+  mpz_clear (s);
+}
+
+int
+rsa_multi_compute_root_tr(const struct rsa_public_key *pub,
+			  const struct rsa_multi_private_key *key,
+			  void *random_ctx, nettle_random_func *random,
+			  mpz_t x, const mpz_t m)
+{
+  int res;
+  mpz_t t, mb, xb, ri;
+  unsigned i;
+
+  if (mpz_even_p (pub->n) || mpz_even_p (key->key.p)
+      || mpz_even_p (key->key.q))
+    return 0;
+  for (i = 0; i < key->nprimes - 2; i++)
+    if (mpz_even_p (key->r[i]))
+      return 0;
+
+  mpz_init (mb);
+  mpz_init (xb);
+  mpz_init (ri);
+  mpz_init (t);
+
+  rsa_blind (pub, random_ctx, random, mb, ri, m);
+
+  rsa_multi_compute_root (key, xb, mb);
+
+  mpz_powm_sec(t, xb, pub->e, pub->n);
+  res = (mpz_cmp(mb, t) == 0);
+
+  if (res)
+    rsa_unblind (pub, x, ri, xb);
+
+  mpz_clear (mb);
+  mpz_clear (xb);
+  mpz_clear (ri);
+  mpz_clear (t);
+
+  return res;
+}
+
+int
+_rsa_multi_sec_compute_root_tr(const struct rsa_public_key *pub,
+			       const struct rsa_multi_private_key *key,
+			       void *random_ctx, nettle_random_func *random,
+			       mp_limb_t *x, const mp_limb_t *m)
+{
+  mp_size_t nn;
+  mpz_t mz;
+  mpz_t xz;
+  int res;
+
+  mpz_init(xz);
+
+  nn = mpz_size (pub->n);
+
+  res = rsa_multi_compute_root_tr(pub, key, random_ctx, random, xz,
+				  mpz_roinit_n(mz, m, nn));
+
+  if (res)
+    mpz_limbs_copy(x, xz, nn);
+
+  mpz_clear(xz);
+  return res;
+}
 #else
+/* Scratch space needed by rsa_sec_blind, rsa_sec_unblind and
+   rsa_sec_check_root. */
+static mp_size_t
+rsa_sec_blind_itch (const struct rsa_public_key *pub)
+{
+  mp_size_t nn = mpz_size (pub->n);
+  mp_size_t itch;
+  mp_size_t i2;
+
+  itch = mpn_sec_powm_itch(nn, mpz_sizeinbase (pub->e, 2), nn);
+  i2 = mpn_sec_mul_itch(nn, nn);
+  itch = MAX(itch, i2);
+  i2 = mpn_sec_div_r_itch(2*nn, nn);
+  itch = MAX(itch, i2);
+  i2 = mpn_sec_invert_itch(nn);
+  itch = MAX(itch, i2);
+
+  return 3*nn + itch;
+}
+
 /* Blinds m, by computing c = m r^e (mod n), for a random r. Also
    returns the inverse (ri), for use by rsa_unblind. Must have c != m,
    no in-place operation.*/
 static void
 rsa_sec_blind (const struct rsa_public_key *pub,
                void *random_ctx, nettle_random_func *random,
-               mp_limb_t *c, mp_limb_t *ri, const mp_limb_t *m)
+               mp_limb_t *c, mp_limb_t *ri, const mp_limb_t *m,
+               mp_limb_t *scratch)
 {
   const mp_limb_t *ep = mpz_limbs_read (pub->e);
   const mp_limb_t *np = mpz_limbs_read (pub->n);
   mp_bitcnt_t ebn = mpz_sizeinbase (pub->e, 2);
   mp_size_t nn = mpz_size (pub->n);
-  size_t itch;
-  size_t i2;
-  mp_limb_t *scratch;
-  TMP_GMP_DECL (tp, mp_limb_t);
-  TMP_GMP_DECL (rp, mp_limb_t);
-  TMP_GMP_DECL (r, uint8_t);
-
-  TMP_GMP_ALLOC (rp, nn);
-  TMP_GMP_ALLOC (r, nn * sizeof(mp_limb_t));
-
-  /* c = m*(r^e) mod n */
-  itch = mpn_sec_powm_itch(nn, ebn, nn);
-  i2 = mpn_sec_mul_itch(nn, nn);
-  itch = MAX(itch, i2);
-  i2 = mpn_sec_div_r_itch(2*nn, nn);
-  itch = MAX(itch, i2);
-  i2 = mpn_sec_invert_itch(nn);
-  itch = MAX(itch, i2);
+  mp_limb_t *rp = scratch;
+  mp_limb_t *tp = scratch + nn;
 
-  TMP_GMP_ALLOC (tp, 2*nn  + itch);
   scratch = tp + 2*nn;
 
   /* ri = r^(-1) */
   do
     {
-      random(random_ctx, nn * sizeof(mp_limb_t), (uint8_t *)r);
-      mpn_set_base256(rp, nn, r, nn * sizeof(mp_limb_t));
+      random(random_ctx, nn * sizeof(mp_limb_t), (uint8_t *)tp);
+      mpn_set_base256(rp, nn, (uint8_t *)tp, nn * sizeof(mp_limb_t));
       mpn_copyi(tp, rp, nn);
       /* invert r */
     }
   while (!mpn_sec_invert (ri, tp, np, nn, 2 * nn * GMP_NUMB_BITS, scratch));
 
+  /* c = m*(r^e) mod n */
   mpn_sec_powm (c, rp, nn, ep, ebn, np, nn, scratch);
   mpn_sec_mul (tp, c, nn, m, nn, scratch);
   mpn_sec_div_r (tp, 2*nn, np, nn, scratch);
   mpn_copyi(c, tp, nn);
-
-  TMP_GMP_FREE (r);
-  TMP_GMP_FREE (rp);
-  TMP_GMP_FREE (tp);
 }
 
 /* m = c ri mod n. Allows x == c. */
 static void
 rsa_sec_unblind (const struct rsa_public_key *pub,
-                 mp_limb_t *x, mp_limb_t *ri, const mp_limb_t *c)
+                 mp_limb_t *x, mp_limb_t *ri, const mp_limb_t *c,
+                 mp_limb_t *scratch)
 {
   const mp_limb_t *np = mpz_limbs_read (pub->n);
   mp_size_t nn = mpz_size (pub->n);
+  mp_limb_t *tp = scratch;
 
-  size_t itch;
-  size_t i2;
-  mp_limb_t *scratch;
-  TMP_GMP_DECL(tp, mp_limb_t);
-
-  itch = mpn_sec_mul_itch(nn, nn);
-  i2 = mpn_sec_div_r_itch(nn + nn, nn);
-  itch = MAX(itch, i2);
-
-  TMP_GMP_ALLOC (tp, nn + nn + itch);
-  scratch = tp + nn + nn;
+  scratch = tp + 2*nn;
 
   mpn_sec_mul (tp, c, nn, ri, nn, scratch);
   mpn_sec_div_r (tp, nn + nn, np, nn, scratch);
   mpn_copyi(x, tp, nn);
-
-  TMP_GMP_FREE (tp);
 }
 
 static int
@@ -249,28 +355,17 @@ sec_equal(const mp_limb_t *a, const mp_limb_t *b, size_t limbs)
 
 static int
 rsa_sec_check_root(const struct rsa_public_key *pub,
-                   const mp_limb_t *x, const mp_limb_t *m)
+                   const mp_limb_t *x, const mp_limb_t *m,
+                   mp_limb_t *scratch)
 {
   mp_size_t nn = mpz_size (pub->n);
   mp_size_t ebn = mpz_sizeinbase (pub->e, 2);
   const mp_limb_t *np = mpz_limbs_read (pub->n);
   const mp_limb_t *ep = mpz_limbs_read (pub->e);
-  int ret;
+  mp_limb_t *tp = scratch;
 
-  mp_size_t itch;
-
-  mp_limb_t *scratch;
-  TMP_GMP_DECL(tp, mp_limb_t);
-
-  itch = mpn_sec_powm_itch (nn, ebn, nn);
-  TMP_GMP_ALLOC (tp, nn + itch);
-  scratch = tp + nn;
-
-  mpn_sec_powm(tp, x, nn, ep, ebn, np, nn, scratch);
-  ret = sec_equal(tp, m, nn);
-
-  TMP_GMP_FREE (tp);
-  return ret;
+  mpn_sec_powm(tp, x, nn, ep, ebn, np, nn, scratch + nn);
+  return sec_equal(tp, m, nn);
 }
 
 static void
@@ -287,21 +382,43 @@ cnd_mpn_zero (int cnd, volatile mp_ptr rp, mp_size_t n)
     }
 }
 
+mp_size_t
+_rsa_sec_compute_root_tr_itch(const struct rsa_public_key *pub,
+			      const struct rsa_private_key *key)
+{
+  mp_size_t itch = _rsa_sec_compute_root_itch (key);
+  mp_size_t i2 = rsa_sec_blind_itch (pub);
+
+  return 2*mpz_size (pub->n) + MAX(itch, i2);
+}
+
+mp_size_t
+_rsa_multi_sec_compute_root_tr_itch(const struct rsa_public_key *pub,
+				    const struct rsa_multi_private_key *key)
+{
+  mp_size_t itch = _rsa_multi_sec_compute_root_itch (key);
+  mp_size_t i2 = rsa_sec_blind_itch (pub);
+
+  return 2*mpz_size (pub->n) + MAX(itch, i2);
+}
+
 /* Checks for any errors done in the RSA computation. That avoids
  * attacks which rely on faults on hardware, or even software MPI
  * implementation.
  * This version is side-channel silent even in case of error,
- * the destination buffer is always overwritten */
-int
-_rsa_sec_compute_root_tr(const struct rsa_public_key *pub,
-			 const struct rsa_private_key *key,
-			 void *random_ctx, nettle_random_func *random,
-			 mp_limb_t *x, const mp_limb_t *m)
+ * the destination buffer is always overwritten. Uses the multi-prime
+ * key mkey if non-NULL, otherwise the two-prime key key. */
+static int
+sec_compute_root_tr(const struct rsa_public_key *pub,
+		    const struct rsa_private_key *key,
+		    const struct rsa_multi_private_key *mkey,
+		    void *random_ctx, nettle_random_func *random,
+		    mp_limb_t *x, const mp_limb_t *m,
+		    mp_limb_t *scratch)
 {
-  TMP_GMP_DECL (c, mp_limb_t);
-  TMP_GMP_DECL (ri, mp_limb_t);
-  TMP_GMP_DECL (scratch, mp_limb_t);
   size_t key_limb_size;
+  mp_limb_t *c;
+  mp_limb_t *ri;
   int ret;
 
   key_limb_size = mpz_size(pub->n);
@@ -317,25 +434,79 @@ _rsa_sec_compute_root_tr(const struct rsa_public_key *pub,
       return 0;
     }
 
-  assert(mpz_size(pub->n) == key_limb_size);
-
-  TMP_GMP_ALLOC (c, key_limb_size);
-  TMP_GMP_ALLOC (ri, key_limb_size);
-  TMP_GMP_ALLOC (scratch, _rsa_sec_compute_root_itch(key));
+  c = scratch;
+  ri = scratch + key_limb_size;
+  scratch += 2*key_limb_size;
 
-  rsa_sec_blind (pub, random_ctx, random, c, ri, m);
+  rsa_sec_blind (pub, random_ctx, random, c, ri, m, scratch);
 
-  _rsa_sec_compute_root(key, x, c, scratch);
+  if (mkey)
+    _rsa_multi_sec_compute_root(mkey, x, c, scratch);
+  else
+    _rsa_sec_compute_root(key, x, c, scratch);
 
-  ret = rsa_sec_check_root(pub, x, c);
+  ret = rsa_sec_check_root(pub, x, c, scratch);
 
-  rsa_sec_unblind(pub, x, ri, x);
+  rsa_sec_unblind(pub, x, ri, x, scratch);
 
   cnd_mpn_zero(1 - ret, x, key_limb_size);
 
+  return ret;
+}
+
+int
+rsa_mpn_compute_root_tr(const struct rsa_public_key *pub,
+			const struct rsa_private_key *key,
+			void *random_ctx, nettle_random_func *random,
+			mp_limb_t *x, const mp_limb_t *m,
+			mp_limb_t *scratch)
+{
+  return sec_compute_root_tr (pub, key, NULL,
+			      random_ctx, random, x, m, scratch);
+}
+
+int
+_rsa_sec_compute_root_tr(const struct rsa_public_key *pub,
+			 const struct rsa_private_key *key,
+			 void *random_ctx, nettle_random_func *random,
+			 mp_limb_t *x, const mp_limb_t *m)
+{
+  TMP_GMP_DECL (scratch, mp_limb_t);
+  int ret;
+
+  TMP_GMP_ALLOC (scratch, _rsa_sec_compute_root_tr_itch (pub, key));
+
+  ret = sec_compute_root_tr (pub, key, NULL,
+			     random_ctx, random, x, m, scratch);
+
+  TMP_GMP_FREE (scratch);
+  return ret;
+}
+
+int
+_rsa_multi_sec_compute_root_tr(const struct rsa_public_key *pub,
+			       const struct rsa_multi_private_key *key,
+			       void *random_ctx, nettle_random_func *random,
+			       mp_limb_t *x, const mp_limb_t *m)
+{
+  TMP_GMP_DECL (scratch, mp_limb_t);
+  unsigned i;
+  int ret;
+
+  /* The additional primes must be odd, too. */
+  for (i = 0; i < key->nprimes - 2; i++)
+    if (mpz_even_p (key->r[i]))
+      {
+	mpn_zero(x, mpz_size(pub->n));
+	return 0;
+      }
+
+  TMP_GMP_ALLOC (scratch, _rsa_multi_sec_compute_root_tr_itch (pub, key));
+
+  ret = sec_compute_root_tr (pub, &key->key, key,
+			     random_ctx, random, x, m, scratch);
+
   TMP_GMP_FREE (scratch);
-  TMP_GMP_FREE (ri);
-  TMP_GMP_FREE (c);
   return ret;
 }
 
@@ -369,4 +540,28 @@ rsa_compute_root_tr(const struct rsa_public_key *pub,
   TMP_GMP_FREE (l);
   return res;
 }
+
+int
+rsa_multi_compute_root_tr(const struct rsa_public_key *pub,
+			  const struct rsa_multi_private_key *key,
+			  void *random_ctx, nettle_random_func *random,
+			  mpz_t x, const mpz_t m)
+{
+  TMP_GMP_DECL (l, mp_limb_t);
+  mp_size_t nn = mpz_size(pub->n);
+  int res;
+
+  TMP_GMP_ALLOC (l, nn);
+  mpz_limbs_copy(l, m, nn);
+
+  res = _rsa_multi_sec_compute_root_tr (pub, key, random_ctx, random, l, l);
+  if (res) {
+    mp_limb_t *xp = mpz_limbs_write (x, nn);
+    mpn_copyi (xp, l, nn);
+    mpz_limbs_finish (x, nn);
+  }
+
+  TMP_GMP_FREE (l);
+  return res;
+}
 #endif
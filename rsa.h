@@ -98,12 +98,34 @@ extern "C" {
 #define rsa_compute_root nettle_rsa_compute_root
 #define rsa_compute_root_tr nettle_rsa_compute_root_tr
 #define rsa_generate_keypair nettle_rsa_generate_keypair
+#define rsa_generate_prime nettle_rsa_generate_prime
+#define rsa_keypair_from_primes nettle_rsa_keypair_from_primes
+#define rsa_multi_private_key_init nettle_rsa_multi_private_key_init
+#define rsa_multi_private_key_clear nettle_rsa_multi_private_key_clear
+#define rsa_multi_private_key_prepare nettle_rsa_multi_private_key_prepare
+#define rsa_multi_compute_root_tr nettle_rsa_multi_compute_root_tr
+#define rsa_multi_pkcs1_sign_tr nettle_rsa_multi_pkcs1_sign_tr
+#define rsa_multi_sec_decrypt nettle_rsa_multi_sec_decrypt
+#define rsa_multi_generate_keypair nettle_rsa_multi_generate_keypair
+#define rsa_prepared_key_init nettle_rsa_prepared_key_init
+#define rsa_prepared_key_clear nettle_rsa_prepared_key_clear
+#define rsa_prepared_pkcs1_sign_tr nettle_rsa_prepared_pkcs1_sign_tr
+#define rsa_prepared_pkcs1_verify nettle_rsa_prepared_pkcs1_verify
+#define rsa_mpn_itch nettle_rsa_mpn_itch
+#define rsa_mpn_compute_root_tr nettle_rsa_mpn_compute_root_tr
+#define rsa_mpn_pkcs1_sign_tr nettle_rsa_mpn_pkcs1_sign_tr
+#define rsa_mpn_pkcs1_verify nettle_rsa_mpn_pkcs1_verify
+#define rsa_mpn_sec_decrypt nettle_rsa_mpn_sec_decrypt
 #define rsa_keypair_to_sexp nettle_rsa_keypair_to_sexp
 #define rsa_keypair_from_sexp_alist nettle_rsa_keypair_from_sexp_alist
 #define rsa_keypair_from_sexp nettle_rsa_keypair_from_sexp
+#define rsa_multi_keypair_from_sexp_alist nettle_rsa_multi_keypair_from_sexp_alist
+#define rsa_multi_keypair_from_sexp nettle_rsa_multi_keypair_from_sexp
 #define rsa_public_key_from_der_iterator nettle_rsa_public_key_from_der_iterator
 #define rsa_private_key_from_der_iterator nettle_rsa_private_key_from_der_iterator
 #define rsa_keypair_from_der nettle_rsa_keypair_from_der
+#define rsa_multi_private_key_from_der_iterator nettle_rsa_multi_private_key_from_der_iterator
+#define rsa_multi_keypair_from_der nettle_rsa_multi_keypair_from_der
 
 /* This limit is somewhat arbitrary. Technically, the smallest modulo
    which makes sense at all is 15 = 3*5, phi(15) = 8, size 4 bits. But
@@ -509,6 +531,190 @@ rsa_generate_keypair(struct rsa_public_key *pub,
 		      * zero, the passed in value pub->e is used. */
 		     unsigned e_size);
 
+/* Generates a single prime p of exactly bits bits, with the two most
+   significant bits set, and, unless e is NULL, with gcd(p-1, e) = 1.
+   Calls with separate random contexts can run concurrently, e.g., to
+   generate p and q of a key in parallel threads. */
+void
+rsa_generate_prime(mpz_t p, unsigned bits, const mpz_t e,
+		   void *random_ctx, nettle_random_func *random,
+		   void *progress_ctx, nettle_progress_func *progress);
+
+/* Completes a key from the primes key->p and key->q, and the public
+   exponent pub->e, computing n, d, a, b, c and the size attributes.
+   Returns 0 if the inputs don't make a valid key. */
+int
+rsa_keypair_from_primes(struct rsa_public_key *pub,
+			struct rsa_private_key *key);
+
+/* Multi-prime RSA, as specified in RFC 8017. With more than two
+   primes, each private key exponentiation is done modulo a smaller
+   prime, which makes private key operations faster. */
+
+#define RSA_MAX_PRIMES 4
+
+struct rsa_multi_private_key
+{
+  /* The first two primes, p and q, with d, a, b and c as for
+   * two-prime keys. But the size attribute is the size of the
+   * complete modulo, the product of all the primes. */
+  struct rsa_private_key key;
+
+  /* Total number of primes, 2 <= nprimes <= RSA_MAX_PRIMES. */
+  unsigned nprimes;
+
+  /* The additional primes r_i, for 3 <= i <= nprimes, stored at
+   * index i - 3. */
+  mpz_t r[RSA_MAX_PRIMES - 2];
+
+  /* d % (r_i - 1) */
+  mpz_t d[RSA_MAX_PRIMES - 2];
+
+  /* modular inverse of p q r_3 ... r_{i-1}, i.e.,
+   * t_i p q r_3 ... r_{i-1} = 1 (mod r_i) */
+  mpz_t t[RSA_MAX_PRIMES - 2];
+};
+
+/* Calls mpz_init to initialize bignum storage, and sets nprimes to 2. */
+void
+rsa_multi_private_key_init(struct rsa_multi_private_key *key);
+
+/* Calls mpz_clear to deallocate bignum storage. */
+void
+rsa_multi_private_key_clear(struct rsa_multi_private_key *key);
+
+/* Checks the number of primes and the sizes of the values, and
+   computes the size attribute. */
+int
+rsa_multi_private_key_prepare(struct rsa_multi_private_key *key);
+
+/* Like rsa_compute_root_tr, using blinding, and checking the result
+   after CRT. It is required that 0 <= m < n. */
+int
+rsa_multi_compute_root_tr(const struct rsa_public_key *pub,
+			  const struct rsa_multi_private_key *key,
+			  void *random_ctx, nettle_random_func *random,
+			  mpz_t x, const mpz_t m);
+
+int
+rsa_multi_pkcs1_sign_tr(const struct rsa_public_key *pub,
+			const struct rsa_multi_private_key *key,
+			void *random_ctx, nettle_random_func *random,
+			size_t length, const uint8_t *digest_info,
+			mpz_t s);
+
+int
+rsa_multi_sec_decrypt(const struct rsa_public_key *pub,
+		      const struct rsa_multi_private_key *key,
+		      void *random_ctx, nettle_random_func *random,
+		      size_t length, uint8_t *message,
+		      const mpz_t gibberish);
+
+/* Like rsa_generate_keypair, but with nprimes primes of roughly equal
+   size, 2 <= nprimes <= RSA_MAX_PRIMES. */
+int
+rsa_multi_generate_keypair(struct rsa_public_key *pub,
+			   struct rsa_multi_private_key *key,
+			   void *random_ctx, nettle_random_func *random,
+			   void *progress_ctx, nettle_progress_func *progress,
+			   unsigned n_size,
+			   unsigned e_size,
+			   unsigned nprimes);
+
+/* Prepared keys, for many operations with the same key. Holds
+   Montgomery constants for n, used for verification, and blinding
+   factors for signing. Between refreshes, the blinding factors are
+   updated by squaring, avoiding the expensive modular inversion. All
+   storage is allocated up front, so operations don't allocate any
+   memory (except for growing the output bignum). Each operation
+   updates the struct, so each thread needs its own prepared key. */
+
+/* Number of signatures between generation of new random blinding
+   factors. */
+#define RSA_PREPARED_BLIND_UPDATES 32
+
+struct rsa_prepared_key
+{
+  const struct rsa_public_key *pub;
+  /* NULL for keys used only for verification. */
+  const struct rsa_private_key *key;
+
+  /* -1/n mod B, and B^{2 nn} mod n, where nn is the size of n in
+   * limbs. */
+  mp_limb_t ninv;
+  mp_limb_t *r2;
+
+  /* Blinding factors r^e and r^{-1} (mod n). */
+  mp_limb_t *blind;
+  mp_limb_t *unblind;
+  /* Number of signatures before new factors are generated. */
+  unsigned blind_uses;
+
+  /* Single allocation, holding the above values and scratch space. */
+  mp_limb_t *storage;
+  mp_size_t storage_size;
+};
+
+/* The keys must be prepared, and must not be modified or deallocated
+   while the prepared key is in use. Returns 0 for invalid keys. */
+int
+rsa_prepared_key_init(struct rsa_prepared_key *prep,
+		      const struct rsa_public_key *pub,
+		      const struct rsa_private_key *key);
+
+void
+rsa_prepared_key_clear(struct rsa_prepared_key *prep);
+
+int
+rsa_prepared_pkcs1_sign_tr(struct rsa_prepared_key *prep,
+			   void *random_ctx, nettle_random_func *random,
+			   size_t length, const uint8_t *digest_info,
+			   mpz_t s);
+
+int
+rsa_prepared_pkcs1_verify(struct rsa_prepared_key *prep,
+			  size_t length, const uint8_t *digest_info,
+			  const mpz_t signature);
+
+/* Low-level functions, without any memory allocation. Numbers are
+   represented as mpz_size (pub->n) limbs, and scratch space of
+   rsa_mpn_itch limbs is provided by the caller. The key may be NULL
+   if only rsa_mpn_pkcs1_verify is used. */
+mp_size_t
+rsa_mpn_itch(const struct rsa_public_key *pub,
+	     const struct rsa_private_key *key);
+
+/* Like rsa_compute_root_tr. Requires m < n, and x == m is allowed.
+   On failure, x is set to zero. */
+int
+rsa_mpn_compute_root_tr(const struct rsa_public_key *pub,
+			const struct rsa_private_key *key,
+			void *random_ctx, nettle_random_func *random,
+			mp_limb_t *x, const mp_limb_t *m,
+			mp_limb_t *scratch);
+
+int
+rsa_mpn_pkcs1_sign_tr(const struct rsa_public_key *pub,
+		      const struct rsa_private_key *key,
+		      void *random_ctx, nettle_random_func *random,
+		      size_t length, const uint8_t *digest_info,
+		      mp_limb_t *s,
+		      mp_limb_t *scratch);
+
+int
+rsa_mpn_pkcs1_verify(const struct rsa_public_key *pub,
+		     size_t length, const uint8_t *digest_info,
+		     const mp_limb_t *s,
+		     mp_limb_t *scratch);
+
+int
+rsa_mpn_sec_decrypt(const struct rsa_public_key *pub,
+		    const struct rsa_private_key *key,
+		    void *random_ctx, nettle_random_func *random,
+		    size_t length, uint8_t *message,
+		    const mp_limb_t *c,
+		    mp_limb_t *scratch);
+
 
 #define RSA_SIGN(key, algorithm, ctx, length, data, signature) ( \
   algorithm##_update(ctx, length, data), \
@@ -550,6 +756,20 @@ rsa_keypair_from_sexp(struct rsa_public_key *pub,
 		      unsigned limit,
 		      size_t length, const uint8_t *expr);
 
+/* For multi-prime keys, the additional primes are stored as r3, r4,
+ * with the corresponding exponents d3, d4 and coefficients t3, t4. */
+int
+rsa_multi_keypair_from_sexp_alist(struct rsa_public_key *pub,
+				  struct rsa_multi_private_key *priv,
+				  unsigned limit,
+				  struct sexp_iterator *i);
+
+int
+rsa_multi_keypair_from_sexp(struct rsa_public_key *pub,
+			    struct rsa_multi_private_key *priv,
+			    unsigned limit,
+			    size_t length, const uint8_t *expr);
+
 
 /* Keys in PKCS#1 format. */
 struct asn1_der_iterator;
@@ -572,6 +792,19 @@ rsa_keypair_from_der(struct rsa_public_key *pub,
 		     unsigned limit, 
 		     size_t length, const uint8_t *data);
 
+/* Also accepts version 1 keys, with otherPrimeInfos. */
+int
+rsa_multi_private_key_from_der_iterator(struct rsa_public_key *pub,
+					struct rsa_multi_private_key *priv,
+					unsigned limit,
+					struct asn1_der_iterator *i);
+
+int
+rsa_multi_keypair_from_der(struct rsa_public_key *pub,
+			   struct rsa_multi_private_key *priv,
+			   unsigned limit,
+			   size_t length, const uint8_t *data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -113,3 +113,81 @@ rsa_keypair_from_sexp(struct rsa_public_key *pub,
 
   return rsa_keypair_from_sexp_alist(pub, priv, limit, &i);
 }
+
+int
+rsa_multi_keypair_from_sexp_alist(struct rsa_public_key *pub,
+				  struct rsa_multi_private_key *priv,
+				  unsigned limit,
+				  struct sexp_iterator *i)
+{
+  static const char * const names[8 + 3*(RSA_MAX_PRIMES - 2)]
+    = { "n", "e", "d", "p", "q", "a", "b", "c",
+	"r3", "d3", "t3", "r4", "d4", "t4" };
+  struct sexp_iterator values[8 + 3*(RSA_MAX_PRIMES - 2)];
+  unsigned nprimes;
+
+  /* Try the largest number of primes first, since additional
+     values are ignored. */
+  for (nprimes = RSA_MAX_PRIMES; nprimes >= 2; nprimes--)
+    {
+      struct sexp_iterator start = *i;
+      if (sexp_iterator_assoc(&start, 8 + 3*(nprimes - 2), names, values))
+	{
+	  *i = start;
+	  break;
+	}
+    }
+  if (nprimes < 2)
+    return 0;
+
+  priv->nprimes = nprimes;
+  GET(priv->key.d, limit, &values[2]);
+  GET(priv->key.p, limit, &values[3]);
+  GET(priv->key.q, limit, &values[4]);
+  GET(priv->key.a, limit, &values[5]);
+  GET(priv->key.b, limit, &values[6]);
+  GET(priv->key.c, limit, &values[7]);
+
+  for (nprimes = 0; nprimes < priv->nprimes - 2; nprimes++)
+    {
+      GET(priv->r[nprimes], limit, &values[8 + 3*nprimes]);
+      GET(priv->d[nprimes], limit, &values[9 + 3*nprimes]);
+      GET(priv->t[nprimes], limit, &values[10 + 3*nprimes]);
+    }
+
+  if (!rsa_multi_private_key_prepare(priv))
+    return 0;
+
+  if (pub)
+    {
+      GET(pub->n, limit, &values[0]);
+      GET(pub->e, limit, &values[1]);
+
+      if (!rsa_public_key_prepare(pub))
+	return 0;
+    }
+  
+  return 1;
+}
+
+int
+rsa_multi_keypair_from_sexp(struct rsa_public_key *pub,
+			    struct rsa_multi_private_key *priv,
+			    unsigned limit,
+			    size_t length, const uint8_t *expr)
+{
+  struct sexp_iterator i;
+  static const char * const names[3]
+    = { "rsa", "rsa-pkcs1", "rsa-pkcs1-sha1" };
+
+  if (!sexp_iterator_first(&i, length, expr))
+    return 0;
+  
+  if (!sexp_iterator_check_type(&i, "private-key"))
+    return 0;
+
+  if (!sexp_iterator_check_types(&i, 3, names))
+    return 0;
+
+  return rsa_multi_keypair_from_sexp_alist(pub, priv, limit, &i);
+}
@@ -0,0 +1,94 @@
+/* sha1-many.c
+
+   Hashing of many independent messages with sha1.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "sha1.h"
+#include "md-many-internal.h"
+
+#if HAVE_NATIVE_sha1_compress_16x
+#define _nettle_sha1_digest_many_16x sha1_digest_many
+#elif HAVE_NATIVE_sha1_compress_8x
+#define _nettle_sha1_digest_many_8x sha1_digest_many
+#elif !(HAVE_NATIVE_fat_sha1_compress_8x \
+	|| HAVE_NATIVE_fat_sha1_compress_16x)
+#define _nettle_sha1_digest_many_1x sha1_digest_many
+#endif
+
+static const struct md_many_algorithm
+sha1_many_algorithm =
+  {
+    _SHA1_DIGEST_LENGTH,
+    SHA1_DIGEST_SIZE,
+    sha1_compress,
+  };
+
+static void
+sha1_many (unsigned lanes, md_many_compress_func *f,
+	   size_t n, const size_t *length,
+	   const uint8_t * const *data, uint8_t *digest)
+{
+  struct sha1_ctx ctx;
+  sha1_init (&ctx);
+  _nettle_md_many (&sha1_many_algorithm, ctx.state, 0, lanes, f,
+		   n, length, data, digest);
+}
+
+#if HAVE_NATIVE_sha1_compress_16x || HAVE_NATIVE_fat_sha1_compress_16x
+void
+_nettle_sha1_digest_many_16x(size_t n, const size_t *length,
+			     const uint8_t * const *data, uint8_t *digest)
+{
+  sha1_many (16, _nettle_sha1_compress_16x, n, length, data, digest);
+}
+#endif
+
+#if HAVE_NATIVE_sha1_compress_8x || HAVE_NATIVE_fat_sha1_compress_8x
+void
+_nettle_sha1_digest_many_8x(size_t n, const size_t *length,
+			    const uint8_t * const *data, uint8_t *digest)
+{
+  sha1_many (8, _nettle_sha1_compress_8x, n, length, data, digest);
+}
+#endif
+
+#if !(HAVE_NATIVE_sha1_compress_16x || HAVE_NATIVE_sha1_compress_8x)
+void
+_nettle_sha1_digest_many_1x(size_t n, const size_t *length,
+			    const uint8_t * const *data, uint8_t *digest)
+{
+  sha1_many (1, NULL, n, length, data, digest);
+}
+#endif
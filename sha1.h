@@ -45,6 +45,7 @@ extern "C" {
 #define sha1_update nettle_sha1_update
 #define sha1_digest nettle_sha1_digest
 #define sha1_compress nettle_sha1_compress
+#define sha1_digest_many nettle_sha1_digest_many
 
 /* SHA1 */
 
@@ -79,6 +80,13 @@ sha1_digest(struct sha1_ctx *ctx,
 void
 sha1_compress(uint32_t *state, const uint8_t *data);
 
+/* Computes the digests of N independent messages, message i being
+   LENGTH[i] bytes at DATA[i]. The digests are stored consecutively
+   at DIGEST, N * SHA1_DIGEST_SIZE bytes in total. */
+void
+sha1_digest_many(size_t n, const size_t *length,
+		 const uint8_t * const *data, uint8_t *digest);
+
 #ifdef __cplusplus
 }
 #endif
@@ -47,6 +47,7 @@ extern "C" {
 #define sha256_update nettle_sha256_update
 #define sha256_digest nettle_sha256_digest
 #define sha256_compress nettle_sha256_compress
+#define sha256_digest_many nettle_sha256_digest_many
 #define sha384_init nettle_sha384_init
 #define sha384_digest nettle_sha384_digest
 #define sha512_init nettle_sha512_init
@@ -89,6 +90,14 @@ sha256_digest(struct sha256_ctx *ctx,
 void
 sha256_compress(uint32_t *state, const uint8_t *input);
 
+/* Computes the digests of N independent messages, message i being
+   LENGTH[i] bytes at DATA[i]. The digests are stored consecutively
+   at DIGEST, N * SHA256_DIGEST_SIZE bytes in total. Where supported,
+   several messages are hashed in parallel. */
+void
+sha256_digest_many(size_t n, const size_t *length,
+		   const uint8_t * const *data, uint8_t *digest);
+
 /* SHA224, a truncated SHA256 with different initial state. */
 
 #define SHA224_DIGEST_SIZE 28
@@ -0,0 +1,98 @@
+/* sha256-many.c
+
+   Hashing of many independent messages with sha256.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "sha2.h"
+#include "md-many-internal.h"
+
+#if HAVE_NATIVE_sha256_compress_16x
+#define _nettle_sha256_many_16x _nettle_sha256_many
+#elif HAVE_NATIVE_sha256_compress_8x
+#define _nettle_sha256_many_8x _nettle_sha256_many
+#elif !(HAVE_NATIVE_fat_sha256_compress_8x \
+	|| HAVE_NATIVE_fat_sha256_compress_16x)
+#define _nettle_sha256_many_1x _nettle_sha256_many
+#endif
+
+static const struct md_many_algorithm
+sha256_many_algorithm =
+  {
+    _SHA256_DIGEST_LENGTH,
+    SHA256_DIGEST_SIZE,
+    sha256_compress,
+  };
+
+#if HAVE_NATIVE_sha256_compress_16x || HAVE_NATIVE_fat_sha256_compress_16x
+void
+_nettle_sha256_many_16x(const uint32_t *state, uint64_t count,
+			size_t n, const size_t *length,
+			const uint8_t * const *data, uint8_t *digest)
+{
+  _nettle_md_many (&sha256_many_algorithm, state, count,
+		   16, _nettle_sha256_compress_16x, n, length, data, digest);
+}
+#endif
+
+#if HAVE_NATIVE_sha256_compress_8x || HAVE_NATIVE_fat_sha256_compress_8x
+void
+_nettle_sha256_many_8x(const uint32_t *state, uint64_t count,
+		       size_t n, const size_t *length,
+		       const uint8_t * const *data, uint8_t *digest)
+{
+  _nettle_md_many (&sha256_many_algorithm, state, count,
+		   8, _nettle_sha256_compress_8x, n, length, data, digest);
+}
+#endif
+
+#if !(HAVE_NATIVE_sha256_compress_16x || HAVE_NATIVE_sha256_compress_8x)
+void
+_nettle_sha256_many_1x(const uint32_t *state, uint64_t count,
+		       size_t n, const size_t *length,
+		       const uint8_t * const *data, uint8_t *digest)
+{
+  _nettle_md_many (&sha256_many_algorithm, state, count,
+		   1, NULL, n, length, data, digest);
+}
+#endif
+
+void
+sha256_digest_many(size_t n, const size_t *length,
+		   const uint8_t * const *data, uint8_t *digest)
+{
+  struct sha256_ctx ctx;
+  sha256_init (&ctx);
+  _nettle_sha256_many (ctx.state, 0, n, length, data, digest);
+}
@@ -62,6 +62,44 @@ void
 _nettle_sha3_shake_output (struct sha3_ctx *ctx, unsigned block_size,
 			   size_t length, uint8_t *dst);
 
+/* Max number of lanes of a multi-lane permutation. */
+#define SHA3_MANY_MAX_LANES 8
+
+/* Applies the permutation to each of the lanes. The state is
+   word-major, with word i of lane j at STATE[i * lanes + j]. */
+typedef void sha3_many_permute_func(uint64_t *state);
+
+/* Computes OUTPUT_LENGTH bytes of sponge output for each of N
+   messages, using the LANES-way permutation F, or only sha3_permute
+   if LANES is 1. The output for message i is written at OUTPUT + i *
+   OUTPUT_LENGTH. */
+void
+_nettle_sha3_many (unsigned block_size, uint8_t magic,
+		   unsigned lanes, sha3_many_permute_func *f,
+		   size_t n, const size_t *length,
+		   const uint8_t * const *data,
+		   size_t output_length, uint8_t *output);
+
+/* Functions available only in some configurations */
+void
+_nettle_sha3_permute_4x (uint64_t *state);
+
+void
+_nettle_sha3_permute_8x (uint64_t *state);
+
+void
+_nettle_sha3_256_shake_many_1x (size_t n, const size_t *length,
+				const uint8_t * const *data,
+				size_t output_length, uint8_t *output);
+void
+_nettle_sha3_256_shake_many_4x (size_t n, const size_t *length,
+				const uint8_t * const *data,
+				size_t output_length, uint8_t *output);
+void
+_nettle_sha3_256_shake_many_8x (size_t n, const size_t *length,
+				const uint8_t * const *data,
+				size_t output_length, uint8_t *output);
+
 #define _NETTLE_SHA3_HASH(name, NAME) {		\
  #name,						\
  sizeof(struct sha3_ctx),			\
@@ -0,0 +1,255 @@
+/* sha3-many.c
+
+   Keccak sponge over many independent messages, using multi-lane
+   permutations.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "sha3.h"
+#include "sha3-internal.h"
+
+#include "macros.h"
+#include "nettle-write.h"
+
+/* Largest block size, for shake128. */
+#define SHA3_MANY_MAX_BLOCK SHA3_128_BLOCK_SIZE
+
+struct sha3_many_lane
+{
+  /* Index of the message, or n for an idle lane. */
+  size_t index;
+  /* Next full message block, and number of such blocks left. */
+  const uint8_t *data;
+  size_t blocks;
+  /* Set when the final padded block has been absorbed. */
+  int pad_done;
+  /* Number of output bytes produced so far. */
+  size_t done;
+  uint8_t pad[SHA3_MANY_MAX_BLOCK];
+};
+
+static void
+sha3_many_start (struct sha3_many_lane *lane, unsigned block_bytes,
+		 uint8_t magic, size_t index, size_t length,
+		 const uint8_t *data)
+{
+  unsigned left = length % block_bytes;
+
+  lane->index = index;
+  lane->data = data;
+  lane->blocks = length / block_bytes;
+  lane->pad_done = 0;
+  lane->done = 0;
+
+  memcpy (lane->pad, data + lane->blocks * block_bytes, left);
+  lane->pad[left] = magic;
+  memset (lane->pad + left + 1, 0, block_bytes - left - 1);
+  lane->pad[block_bytes - 1] |= 0x80;
+}
+
+/* Returns the next block to absorb, or NULL if the lane is
+   squeezing. */
+static const uint8_t *
+sha3_many_next (struct sha3_many_lane *lane, unsigned block_bytes)
+{
+  const uint8_t *block;
+  if (lane->blocks > 0)
+    {
+      block = lane->data;
+      lane->data += block_bytes;
+      lane->blocks--;
+    }
+  else if (!lane->pad_done)
+    {
+      block = lane->pad;
+      lane->pad_done = 1;
+    }
+  else
+    block = NULL;
+  return block;
+}
+
+/* Produces the output following a permutation, if the lane is
+   squeezing. The words are at STATE[0], STATE[stride], .... */
+static void
+sha3_many_output (struct sha3_many_lane *lane, unsigned block_bytes,
+		  const uint64_t *state, unsigned stride,
+		  size_t output_length, uint8_t *output)
+{
+  struct sha3_state tmp;
+  size_t size;
+  unsigned i;
+
+  if (!lane->pad_done || lane->done >= output_length)
+    return;
+
+  size = output_length - lane->done;
+  if (size > block_bytes)
+    size = block_bytes;
+
+  for (i = 0; 8*i < size; i++)
+    tmp.a[i] = state[i * stride];
+
+  _nettle_write_le64 (size, output + lane->index * output_length + lane->done,
+		      tmp.a);
+  lane->done += size;
+}
+
+/* Processes the rest of a lane, with STATE contiguous. */
+static void
+sha3_many_finish (struct sha3_many_lane *lane, unsigned block_bytes,
+		  struct sha3_state *state,
+		  size_t output_length, uint8_t *output)
+{
+  for (;;)
+    {
+      const uint8_t *block = sha3_many_next (lane, block_bytes);
+      unsigned i;
+
+      if (block)
+	for (i = 0; i < block_bytes / 8; i++)
+	  state->a[i] ^= LE_READ_UINT64 (block + 8*i);
+      else if (lane->done >= output_length)
+	break;
+
+      sha3_permute (state);
+      sha3_many_output (lane, block_bytes, state->a, 1,
+			output_length, output);
+    }
+}
+
+void
+_nettle_sha3_many (unsigned block_size, uint8_t magic,
+		   unsigned lanes, sha3_many_permute_func *f,
+		   size_t n, const size_t *length,
+		   const uint8_t * const *data,
+		   size_t output_length, uint8_t *output)
+{
+  struct sha3_many_lane lane[SHA3_MANY_MAX_LANES];
+  uint64_t state[SHA3_MANY_MAX_LANES * 25];
+  struct sha3_state tmp;
+  unsigned block_bytes = block_size * 8;
+  size_t next;
+  unsigned active;
+  unsigned i, j;
+
+  assert (lanes <= SHA3_MANY_MAX_LANES);
+  assert (block_bytes <= SHA3_MANY_MAX_BLOCK);
+
+  if (!output_length)
+    return;
+
+  if (lanes < 2 || n <= lanes / 4)
+    {
+      /* Too few messages to make the lanes worthwhile. */
+      for (next = 0; next < n; next++)
+	{
+	  memset (&tmp, 0, sizeof (tmp));
+	  sha3_many_start (&lane[0], block_bytes, magic,
+			   next, length[next], data[next]);
+	  sha3_many_finish (&lane[0], block_bytes, &tmp,
+			    output_length, output);
+	}
+      return;
+    }
+
+  memset (state, 0, lanes * 25 * sizeof (*state));
+
+  for (j = 0, next = 0; j < lanes; j++)
+    {
+      if (next < n)
+	{
+	  sha3_many_start (&lane[j], block_bytes, magic,
+			   next, length[next], data[next]);
+	  next++;
+	}
+      else
+	/* Idle, hashing the empty message. */
+	sha3_many_start (&lane[j], block_bytes, magic, n, 0, lane[j].pad);
+    }
+  active = next;
+
+  /* Keep the lanes busy while there is enough work for them. When
+     only a few messages are left, finish them one at a time. */
+  while (active > lanes / 4)
+    {
+      for (j = 0; j < lanes; j++)
+	{
+	  const uint8_t *block = sha3_many_next (&lane[j], block_bytes);
+	  if (!block && (lane[j].index == n
+			 || lane[j].done >= output_length))
+	    {
+	      if (lane[j].index < n)
+		active--;
+
+	      if (next < n)
+		{
+		  sha3_many_start (&lane[j], block_bytes, magic,
+				   next, length[next], data[next]);
+		  next++;
+		  active++;
+		}
+	      else
+		sha3_many_start (&lane[j], block_bytes, magic,
+				 n, 0, lane[j].pad);
+
+	      for (i = 0; i < 25; i++)
+		state[i*lanes + j] = 0;
+
+	      block = sha3_many_next (&lane[j], block_bytes);
+	    }
+	  if (block)
+	    for (i = 0; i < block_size; i++)
+	      state[i*lanes + j] ^= LE_READ_UINT64 (block + 8*i);
+	}
+      f (state);
+
+      for (j = 0; j < lanes; j++)
+	if (lane[j].index < n)
+	  sha3_many_output (&lane[j], block_bytes, state + j, lanes,
+			    output_length, output);
+    }
+
+  for (j = 0; j < lanes; j++)
+    if (lane[j].index < n)
+      {
+	for (i = 0; i < 25; i++)
+	  tmp.a[i] = state[i*lanes + j];
+	sha3_many_finish (&lane[j], block_bytes, &tmp,
+			  output_length, output);
+      }
+}
@@ -52,6 +52,7 @@ extern "C" {
 #define sha3_256_digest nettle_sha3_256_digest
 #define sha3_256_shake nettle_sha3_256_shake
 #define sha3_256_shake_output nettle_sha3_256_shake_output
+#define sha3_256_shake_many nettle_sha3_256_shake_many
 #define sha3_384_update nettle_sha3_384_update
 #define sha3_384_digest nettle_sha3_384_digest
 #define sha3_512_update nettle_sha3_512_update
@@ -141,6 +142,16 @@ sha3_256_shake(struct sha3_ctx *ctx, size_t length, uint8_t *digest);
 void
 sha3_256_shake_output(struct sha3_ctx *ctx, size_t length, uint8_t *digest);
 
+/* Computes OUTPUT_LENGTH bytes of shake256 output for each of N
+   independent messages, message i being LENGTH[i] bytes at DATA[i].
+   The outputs are stored consecutively at OUTPUT, N * OUTPUT_LENGTH
+   bytes in total. Where supported, several messages are processed in
+   parallel. */
+void
+sha3_256_shake_many(size_t n, const size_t *length,
+		    const uint8_t * const *data,
+		    size_t output_length, uint8_t *output);
+
 void
 sha3_384_update (struct sha3_ctx *ctx, size_t length, const uint8_t *data);
 
@@ -0,0 +1,84 @@
+/* shake256-many.c
+
+   Shake256 of many independent messages.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "sha3.h"
+#include "sha3-internal.h"
+
+#if HAVE_NATIVE_sha3_permute_8x
+#define _nettle_sha3_256_shake_many_8x sha3_256_shake_many
+#elif HAVE_NATIVE_sha3_permute_4x
+#define _nettle_sha3_256_shake_many_4x sha3_256_shake_many
+#elif !(HAVE_NATIVE_fat_sha3_permute_4x \
+	|| HAVE_NATIVE_fat_sha3_permute_8x)
+#define _nettle_sha3_256_shake_many_1x sha3_256_shake_many
+#endif
+
+#if HAVE_NATIVE_sha3_permute_8x || HAVE_NATIVE_fat_sha3_permute_8x
+void
+_nettle_sha3_256_shake_many_8x (size_t n, const size_t *length,
+				const uint8_t * const *data,
+				size_t output_length, uint8_t *output)
+{
+  _nettle_sha3_many (SHA3_256_BLOCK_SIZE >> 3, SHA3_SHAKE_MAGIC,
+		     8, _nettle_sha3_permute_8x,
+		     n, length, data, output_length, output);
+}
+#endif
+
+#if HAVE_NATIVE_sha3_permute_4x || HAVE_NATIVE_fat_sha3_permute_4x
+void
+_nettle_sha3_256_shake_many_4x (size_t n, const size_t *length,
+				const uint8_t * const *data,
+				size_t output_length, uint8_t *output)
+{
+  _nettle_sha3_many (SHA3_256_BLOCK_SIZE >> 3, SHA3_SHAKE_MAGIC,
+		     4, _nettle_sha3_permute_4x,
+		     n, length, data, output_length, output);
+}
+#endif
+
+#if !(HAVE_NATIVE_sha3_permute_8x || HAVE_NATIVE_sha3_permute_4x)
+void
+_nettle_sha3_256_shake_many_1x (size_t n, const size_t *length,
+				const uint8_t * const *data,
+				size_t output_length, uint8_t *output)
+{
+  _nettle_sha3_many (SHA3_256_BLOCK_SIZE >> 3, SHA3_SHAKE_MAGIC,
+		     1, NULL, n, length, data, output_length, output);
+}
+#endif
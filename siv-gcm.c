@@ -46,6 +46,10 @@
 
 #define MIN(a,b) (((a) < (b)) ? (a) : (b))
 
+/* Derives the per-nonce keys. All the input blocks, two for the
+   authentication key and two or four for the encryption key, are
+   encrypted with a single call, so that ciphers processing several
+   blocks in parallel can do so. */
 static void
 siv_gcm_derive_keys (const void *ctx,
 		     nettle_cipher_func *f,
@@ -54,28 +58,26 @@ siv_gcm_derive_keys (const void *ctx,
 		     union nettle_block16 *auth_key,
 		     uint8_t *encryption_key)
 {
-  union nettle_block16 block;
-  union nettle_block16 out;
+  union nettle_block16 block[2 + NETTLE_MAX_CIPHER_KEY_SIZE / 8];
+  size_t blocks = 2 + key_size / 8;
   size_t i;
 
-  block16_zero (&block);
-  memcpy (block.b + 4, nonce, MIN(nlength, SIV_GCM_NONCE_SIZE));
+  assert (key_size % 8 == 0 && key_size <= NETTLE_MAX_CIPHER_KEY_SIZE);
 
-  f (ctx, SIV_GCM_BLOCK_SIZE, out.b, block.b);
-  auth_key->u64[0] = out.u64[0];
+  for (i = 0; i < blocks; i++)
+    {
+      block16_zero (&block[i]);
+      block[i].b[0] = i;
+      memcpy (block[i].b + 4, nonce, MIN(nlength, SIV_GCM_NONCE_SIZE));
+    }
 
-  block.b[0] = 1;
-  f (ctx, SIV_GCM_BLOCK_SIZE, out.b, block.b);
-  auth_key->u64[1] = out.u64[0];
+  f (ctx, blocks * SIV_GCM_BLOCK_SIZE, block[0].b, block[0].b);
 
-  assert (key_size % 8 == 0 && key_size / 8 + 2 <= UINT8_MAX);
+  auth_key->u64[0] = block[0].u64[0];
+  auth_key->u64[1] = block[1].u64[0];
 
   for (i = 0; i < key_size; i += 8)
-    {
-      block.b[0]++;
-      f (ctx, SIV_GCM_BLOCK_SIZE, out.b, block.b);
-      memcpy (encryption_key + i, out.b, 8);
-    }
+    memcpy (encryption_key + i, block[2 + i / 8].b, 8);
 }
 
 static nettle_fill16_func siv_gcm_fill;
@@ -5,6 +5,7 @@
    Copyright (C) 2011 Katholieke Universiteit Leuven
    Copyright (C) 2011, 2013, 2018, 2022 Niels Möller
    Copyright (C) 2018, 2022 Red Hat, Inc.
+   Copyright (C) 2026 agent
 
    This file is part of GNU Nettle.
 
@@ -41,25 +42,44 @@
 #include "block-internal.h"
 #include "macros.h"
 
+/* For fat builds */
+#if HAVE_NATIVE_siv_ghash_update
+const uint8_t *
+_nettle_siv_ghash_update_c (const struct gcm_key *ctx, union nettle_block16 *state,
+			    size_t blocks, const uint8_t *data);
+#define _nettle_siv_ghash_update _nettle_siv_ghash_update_c
+#endif
+
+/* Number of byte reversed blocks passed to each _ghash_update call,
+   so that implementations processing several blocks at a time can
+   do so. */
+#define SIV_GHASH_BUFFER_BLOCKS 8
+
 const uint8_t *
 _siv_ghash_update (const struct gcm_key *ctx, union nettle_block16 *state,
 		 size_t blocks, const uint8_t *data)
 {
-  for (; blocks-- > 0; data += GCM_BLOCK_SIZE)
+  union nettle_block16 buffer[SIV_GHASH_BUFFER_BLOCKS];
+
+  while (blocks > 0)
     {
-      union nettle_block16 b;
+      size_t n = (blocks < SIV_GHASH_BUFFER_BLOCKS)
+	? blocks : SIV_GHASH_BUFFER_BLOCKS;
+      size_t i;
 
+      for (i = 0; i < n; i++, data += GCM_BLOCK_SIZE)
+	{
 #if WORDS_BIGENDIAN
-      b.u64[1] = LE_READ_UINT64(data);
-      b.u64[0] = LE_READ_UINT64(data + 8);
+	  buffer[i].u64[1] = LE_READ_UINT64(data);
+	  buffer[i].u64[0] = LE_READ_UINT64(data + 8);
 #else
-      b.u64[1] = READ_UINT64(data);
-      b.u64[0] = READ_UINT64(data + 8);
+	  buffer[i].u64[1] = READ_UINT64(data);
+	  buffer[i].u64[0] = READ_UINT64(data + 8);
 #endif
-
-      _ghash_update (ctx, state, 1, b.b);
+	}
+      _ghash_update (ctx, state, n, buffer[0].b);
+      blocks -= n;
     }
 
   return data;
 }
-
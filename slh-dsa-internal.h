@@ -116,6 +116,22 @@ typedef void slh_hash_node_func (const void *tree_ctx,
 				 const struct slh_address_hash *ah,
 				 const uint8_t *left, const uint8_t *right,
 				 uint8_t *out);
+/* Like _secret, but for N independent values. The address for value
+   i is AH[i], the input is at SECRET + i * STRIDE (STRIDE may be
+   zero, to use the same input for all values), and the output is
+   written at OUT + i * _SLH_DSA_128_SIZE. OUT may equal SECRET. Where
+   supported, several values are hashed in parallel. */
+typedef void slh_hash_secret_many_func (const void *tree_ctx, size_t n,
+					const struct slh_address_hash *ah,
+					const uint8_t *secret, size_t stride,
+					uint8_t *out);
+/* Like _node, but for N independent nodes. The address of node i is
+   AH[i], its left and right child hashes are stored consecutively at
+   CHILDREN + 2 * i * _SLH_DSA_128_SIZE, and the output is written at
+   OUT + i * _SLH_DSA_128_SIZE. OUT may equal CHILDREN. */
+typedef void slh_hash_node_many_func (const void *tree_ctx, size_t n,
+				      const struct slh_address_hash *ah,
+				      const uint8_t *children, uint8_t *out);
 
 struct slh_hash
 {
@@ -125,6 +141,8 @@ struct slh_hash
   nettle_hash_digest_func *digest;
   slh_hash_secret_func *secret;
   slh_hash_node_func *node;
+  slh_hash_secret_many_func *secret_many;
+  slh_hash_node_many_func *node_many;
   slh_hash_randomizer_func *randomizer;
   slh_hash_msg_digest_func *msg_digest;
 };
@@ -204,9 +222,19 @@ _wots_verify (const struct slh_hash *hash, const void *tree_ctx,
 
 /* Merkle tree functions. Could be generalized for other merkle tree
    applications, by using const void* for the ctx argument. */
-typedef void merkle_leaf_hash_func (const struct slh_merkle_ctx_secret *ctx, unsigned index, uint8_t *out);
+
+/* Max number of leaves or nodes computed by one call of a
+   merkle_leaf_hash_func or merkle_node_hash_func. */
+#define MERKLE_BATCH_SIZE 32
+
+/* Computes COUNT consecutive leaf hashes, starting at INDEX. */
+typedef void merkle_leaf_hash_func (const struct slh_merkle_ctx_secret *ctx, unsigned index,
+				    unsigned count, uint8_t *out);
+/* Computes COUNT consecutive nodes at the given height, starting at
+   INDEX, from their 2 * COUNT child hashes stored consecutively at
+   CHILDREN. OUT may equal CHILDREN. */
 typedef void merkle_node_hash_func (const struct slh_merkle_ctx_public *ctx, unsigned height, unsigned index,
-				    const uint8_t *left, const uint8_t *right, uint8_t *out);
+				    unsigned count, const uint8_t *children, uint8_t *out);
 
 void
 _merkle_root (const struct slh_merkle_ctx_secret *ctx,
@@ -35,9 +35,15 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
+#include <string.h>
+
 #include "bswap-internal.h"
 #include "slh-dsa-internal.h"
 
+/* Max number of trees processed in parallel by _fors_verify. */
+#define FORS_VERIFY_BATCH 16
+
 void
 _fors_gen (const struct slh_merkle_ctx_secret *ctx,
 	   unsigned idx, uint8_t *sk, uint8_t *leaf)
@@ -56,24 +62,49 @@ _fors_gen (const struct slh_merkle_ctx_secret *ctx,
   ctx->pub.hash->secret (ctx->pub.tree_ctx, &ah, sk, leaf);
 }
 
+/* Sets up addresses for COUNT consecutive leaves or nodes. */
+static void
+fors_addresses (const struct slh_merkle_ctx_public *ctx, enum slh_addr_type type,
+		unsigned height, unsigned index, unsigned count,
+		struct slh_address_hash *ah)
+{
+  unsigned i;
+  for (i = 0; i < count; i++)
+    {
+      ah[i].type = bswap32_if_le (type);
+      ah[i].keypair = bswap32_if_le (ctx->keypair);
+      ah[i].height_chain = bswap32_if_le (height);
+      ah[i].index_hash = bswap32_if_le (index + i);
+    }
+}
+
 static void
-fors_leaf (const struct slh_merkle_ctx_secret *ctx, unsigned idx, uint8_t *out)
+fors_leaf (const struct slh_merkle_ctx_secret *ctx, unsigned idx,
+	   unsigned count, uint8_t *out)
 {
-  _fors_gen (ctx, idx, out, out);
+  struct slh_address_hash ah[MERKLE_BATCH_SIZE];
+  unsigned i;
+
+  assert (count > 0 && count <= MERKLE_BATCH_SIZE);
+  /* Like _fors_gen, for all leaves in parallel. */
+  fors_addresses (&ctx->pub, SLH_FORS_PRF, 0, idx, count, ah);
+  ctx->pub.hash->secret_many (ctx->pub.tree_ctx, count, ah,
+			      ctx->secret_seed, 0, out);
+  for (i = 0; i < count; i++)
+    ah[i].type = bswap32_if_le (SLH_FORS_TREE);
+  ctx->pub.hash->secret_many (ctx->pub.tree_ctx, count, ah,
+			      out, _SLH_DSA_128_SIZE, out);
 }
 
 static void
 fors_node (const struct slh_merkle_ctx_public *ctx, unsigned height, unsigned index,
-	   const uint8_t *left, const uint8_t *right, uint8_t *out)
+	   unsigned count, const uint8_t *children, uint8_t *out)
 {
-  struct slh_address_hash ah =
-    {
-      bswap32_if_le (SLH_FORS_TREE),
-      bswap32_if_le (ctx->keypair),
-      bswap32_if_le (height),
-      bswap32_if_le (index),
-    };
-  ctx->hash->node (ctx->tree_ctx, &ah, left, right, out);
+  struct slh_address_hash ah[MERKLE_BATCH_SIZE];
+
+  assert (count > 0 && count <= MERKLE_BATCH_SIZE);
+  fors_addresses (ctx, SLH_FORS_TREE, height, index, count, ah);
+  ctx->hash->node_many (ctx->tree_ctx, count, ah, children, out);
 }
 
 static void
@@ -120,23 +151,46 @@ _fors_sign (const struct slh_merkle_ctx_secret *ctx,
   ctx->pub.hash->digest (pub_ctx, pub);
 }
 
+/* Computes the roots of N trees, from their leaf secrets and
+   authentication paths, all in parallel, and passes them on to
+   PUB_CTX. The signature for tree i starts at SIGNATURE + i * (a + 1)
+   * _SLH_DSA_128_SIZE, and idx[i] is the index of its leaf. */
 static void
-fors_verify_one (const struct slh_merkle_ctx_public *ctx, unsigned a,
-		 unsigned idx, const uint8_t *signature, void *pub_ctx)
+fors_verify_many (const struct slh_merkle_ctx_public *ctx, unsigned a,
+		  unsigned n, const unsigned *idx, const uint8_t *signature,
+		  void *pub_ctx)
 {
-  uint8_t root[_SLH_DSA_128_SIZE];
-  struct slh_address_hash ah =
+  struct slh_address_hash ah[FORS_VERIFY_BATCH];
+  uint8_t roots[FORS_VERIFY_BATCH * _SLH_DSA_128_SIZE];
+  uint8_t children[FORS_VERIFY_BATCH * 2 * _SLH_DSA_128_SIZE];
+  unsigned i, h;
+
+  assert (n <= FORS_VERIFY_BATCH);
+  for (i = 0; i < n; i++)
     {
-      bswap32_if_le (SLH_FORS_TREE),
-      bswap32_if_le (ctx->keypair),
-      0,
-      bswap32_if_le (idx),
-    };
+      fors_addresses (ctx, SLH_FORS_TREE, 0, idx[i], 1, &ah[i]);
+      memcpy (roots + i * _SLH_DSA_128_SIZE,
+	      signature + i * (a + 1) * _SLH_DSA_128_SIZE, _SLH_DSA_128_SIZE);
+    }
+  ctx->hash->secret_many (ctx->tree_ctx, n, ah, roots, _SLH_DSA_128_SIZE, roots);
 
-  ctx->hash->secret (ctx->tree_ctx, &ah, signature, root);
-  _merkle_verify (ctx, fors_node, a, idx, signature + _SLH_DSA_128_SIZE, root);
+  for (h = 1; h <= a; h++)
+    {
+      for (i = 0; i < n; i++)
+	{
+	  unsigned right = (idx[i] >> (h - 1)) & 1;
+	  memcpy (children + (2*i + right) * _SLH_DSA_128_SIZE,
+		  roots + i * _SLH_DSA_128_SIZE, _SLH_DSA_128_SIZE);
+	  memcpy (children + (2*i + !right) * _SLH_DSA_128_SIZE,
+		  signature + (i * (a + 1) + h) * _SLH_DSA_128_SIZE,
+		  _SLH_DSA_128_SIZE);
+	  ah[i].height_chain = bswap32_if_le (h);
+	  ah[i].index_hash = bswap32_if_le (idx[i] >> h);
+	}
+      ctx->hash->node_many (ctx->tree_ctx, n, ah, children, roots);
+    }
 
-  ctx->hash->update (pub_ctx, _SLH_DSA_128_SIZE, root);
+  ctx->hash->update (pub_ctx, n * _SLH_DSA_128_SIZE, roots);
 }
 
 void
@@ -151,18 +205,25 @@ _fors_verify (const struct slh_merkle_ctx_public *ctx,
       bswap32_if_le (ctx->keypair),
       0, 0,
     };
-  unsigned i, w, bits;
+  unsigned idx[FORS_VERIFY_BATCH];
+  unsigned i, n, w, bits;
   unsigned mask = (1 << fors->a) - 1;
 
   ctx->hash->init_hash (ctx->tree_ctx, pub_ctx, &ah);
 
-  for (i = w = bits = 0; i < fors->k; i++, signature += (fors->a + 1) * _SLH_DSA_128_SIZE)
+  for (i = w = bits = n = 0; i < fors->k; i++)
     {
       for (; bits < fors->a; bits += 8)
 	w = (w << 8) | *msg++;
       bits -= fors->a;
 
-      fors_verify_one (ctx, fors->a, (i << fors->a) + ((w >> bits) & mask), signature, pub_ctx);
+      idx[n++] = (i << fors->a) + ((w >> bits) & mask);
+      if (n == FORS_VERIFY_BATCH || i == fors->k - 1u)
+	{
+	  fors_verify_many (ctx, fors->a, n, idx, signature, pub_ctx);
+	  signature += n * (fors->a + 1) * _SLH_DSA_128_SIZE;
+	  n = 0;
+	}
     }
   ctx->hash->digest (pub_ctx, pub);
 }
@@ -34,11 +34,15 @@
 #endif
 
 #include <assert.h>
+#include <string.h>
 
 #include "slh-dsa-internal.h"
 
-/* Computes root hash of a tree.
-   Example for height == 2, 4 entries:
+/* Computes root hash of a tree. Leaves are generated in batches of up
+   to MERKLE_BATCH_SIZE, and each batch is reduced to the root of a
+   subtree of height batch_height. Those subtree roots are then
+   combined using a stack.
+   Example for height == batch_height + 2, 4 subtrees:
 
    i = 0 ==> stack: [0], i = 1
    i = 1 ==> stack: [0, 1] ==> [0|1], i = 2
@@ -54,21 +58,36 @@ _merkle_root (const struct slh_merkle_ctx_secret *ctx,
 	      /* Must have space for (height + 1) node hashes */
 	      uint8_t *stack)
 {
+  uint8_t batch[MERKLE_BATCH_SIZE * _SLH_DSA_128_SIZE];
+  unsigned batch_height;
   unsigned stack_size = 0;
   unsigned i;
   assert (height > 0);
   assert ( (start & ((1<<height) - 1)) == 0);
 
-  for (i = 0; i < (1<<height); i++)
+  for (batch_height = height; (1 << batch_height) > MERKLE_BATCH_SIZE; batch_height--)
+    ;
+
+  for (i = 0; i < (1 << (height - batch_height)); i++)
     {
-      /* Leaf index. */
-      unsigned idx = start + i;
+      /* Subtree index. */
+      unsigned idx = (start >> batch_height) + i;
       unsigned h;
-      assert (stack_size <= height);
+      assert (stack_size <= height - batch_height);
+
+      leaf_hash (ctx, idx << batch_height, 1 << batch_height, batch);
+      for (h = 1; h <= batch_height; h++)
+	node_hash (&ctx->pub, h, idx << (batch_height - h),
+		   1 << (batch_height - h), batch, batch);
 
-      leaf_hash (ctx, idx, stack + stack_size++ * _SLH_DSA_128_SIZE);
+      if (batch_height == height)
+	{
+	  memcpy (root, batch, _SLH_DSA_128_SIZE);
+	  return;
+	}
+      memcpy (stack + stack_size++ * _SLH_DSA_128_SIZE, batch, _SLH_DSA_128_SIZE);
 
-      for (h = 1; (idx&1); h++)
+      for (h = batch_height + 1; (idx&1); h++)
 	{
 	  assert (stack_size >= 2);
 	  idx >>= 1;
@@ -76,15 +95,13 @@ _merkle_root (const struct slh_merkle_ctx_secret *ctx,
 	  if (h == height)
 	    {
 	      assert (stack_size == 1);
-	      node_hash (&ctx->pub, h, idx,
+	      node_hash (&ctx->pub, h, idx, 1,
 			 stack + (stack_size - 1) * _SLH_DSA_128_SIZE,
-			 stack + stack_size * _SLH_DSA_128_SIZE,
 			 root);
 	      return;
 	    }
-	  node_hash (&ctx->pub, h, idx,
+	  node_hash (&ctx->pub, h, idx, 1,
 		     stack + (stack_size - 1) * _SLH_DSA_128_SIZE,
-		     stack + stack_size * _SLH_DSA_128_SIZE,
 		     stack + (stack_size - 1)* _SLH_DSA_128_SIZE);
 	}
     }
@@ -102,22 +119,22 @@ _merkle_sign (const struct slh_merkle_ctx_secret *ctx,
     _merkle_root (ctx, leaf_hash, node_hash, h, (idx & -(1 << h)) ^ (1 << h),
 		  signature + h*_SLH_DSA_128_SIZE, signature);
 
-  leaf_hash (ctx, idx ^ 1, signature);
+  leaf_hash (ctx, idx ^ 1, 1, signature);
 }
 
 void
 _merkle_verify (const struct slh_merkle_ctx_public *ctx, merkle_node_hash_func *node_hash,
 		unsigned height, unsigned idx, const uint8_t *signature, uint8_t *hash)
 {
+  uint8_t children[2*_SLH_DSA_128_SIZE];
   unsigned h;
 
   for (h = 1; h <= height; h++, signature += _SLH_DSA_128_SIZE)
     {
       unsigned right = idx & 1;
       idx >>= 1;
-      if (right)
-	node_hash (ctx, h, idx, signature, hash, hash);
-      else
-	node_hash (ctx, h, idx, hash, signature, hash);
+      memcpy (children + right * _SLH_DSA_128_SIZE, hash, _SLH_DSA_128_SIZE);
+      memcpy (children + (!right) * _SLH_DSA_128_SIZE, signature, _SLH_DSA_128_SIZE);
+      node_hash (ctx, h, idx, 1, children, hash);
     }
 }
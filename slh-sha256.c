@@ -33,14 +33,19 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
 #include <string.h>
 
 #include "slh-dsa-internal.h"
 
 #include "bswap-internal.h"
 #include "hmac.h"
+#include "md-many-internal.h"
 #include "sha2.h"
 
+/* Max number of values passed to each _nettle_sha256_many call. */
+#define SLH_SHA256_MANY 64
+
 /* Uses a "compressed" address,
 
      uint8_t layer
@@ -110,6 +115,64 @@ slh_sha256_node (const struct sha256_ctx *tree_ctx,
   slh_sha256_digest (&ctx, out);
 }
 
+/* Hashes N values of size INPUT_SIZE, like _secret and _node. */
+static void
+slh_sha256_many (const struct sha256_ctx *tree_ctx, size_t n,
+		 const struct slh_address_hash *ah,
+		 const uint8_t *input, size_t stride, size_t input_size,
+		 uint8_t *out)
+{
+  /* Compressed tree address, hash address and input, following the
+     first block already processed by the tree context. */
+  uint8_t buffer[SLH_SHA256_MANY][SHA256_BLOCK_SIZE];
+  uint8_t digest[SLH_SHA256_MANY * SHA256_DIGEST_SIZE];
+  const uint8_t *data[SLH_SHA256_MANY];
+  size_t length[SLH_SHA256_MANY];
+  size_t i, m;
+
+  assert (tree_ctx->index + sizeof (*ah) - 3 + input_size
+	  <= SHA256_BLOCK_SIZE);
+
+  for (; n > 0; n -= m, ah += m, input += m * stride,
+	 out += m * _SLH_DSA_128_SIZE)
+    {
+      m = (n < SLH_SHA256_MANY) ? n : SLH_SHA256_MANY;
+      for (i = 0; i < m; i++)
+	{
+	  uint8_t *p = buffer[i];
+	  memcpy (p, tree_ctx->block, tree_ctx->index);
+	  p += tree_ctx->index;
+	  memcpy (p, (const uint8_t *) &ah[i] + 3, sizeof (*ah) - 3);
+	  p += sizeof (*ah) - 3;
+	  memcpy (p, input + i * stride, input_size);
+	  data[i] = buffer[i];
+	  length[i] = p + input_size - buffer[i];
+	}
+      _nettle_sha256_many (tree_ctx->state, tree_ctx->count,
+			   m, length, data, digest);
+      for (i = 0; i < m; i++)
+	memcpy (out + i * _SLH_DSA_128_SIZE,
+		digest + i * SHA256_DIGEST_SIZE, _SLH_DSA_128_SIZE);
+    }
+}
+
+static void
+slh_sha256_secret_many (const struct sha256_ctx *tree_ctx, size_t n,
+			const struct slh_address_hash *ah,
+			const uint8_t *secret, size_t stride, uint8_t *out)
+{
+  slh_sha256_many (tree_ctx, n, ah, secret, stride, _SLH_DSA_128_SIZE, out);
+}
+
+static void
+slh_sha256_node_many (const struct sha256_ctx *tree_ctx, size_t n,
+		      const struct slh_address_hash *ah,
+		      const uint8_t *children, uint8_t *out)
+{
+  slh_sha256_many (tree_ctx, n, ah, children, 2*_SLH_DSA_128_SIZE,
+		   2*_SLH_DSA_128_SIZE, out);
+}
+
 static void
 slh_sha256_randomizer (const uint8_t *public_seed, const uint8_t *secret_prf,
 		       size_t prefix_length, const uint8_t *prefix,
@@ -171,6 +234,8 @@ _slh_hash_sha256 =
     (nettle_hash_digest_func *) slh_sha256_digest,
     (slh_hash_secret_func *) slh_sha256_secret,
     (slh_hash_node_func *) slh_sha256_node,
+    (slh_hash_secret_many_func *) slh_sha256_secret_many,
+    (slh_hash_node_many_func *) slh_sha256_node_many,
     slh_sha256_randomizer,
     slh_sha256_msg_digest
   };
@@ -33,11 +33,18 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
+#include <string.h>
+
 #include "slh-dsa-internal.h"
 
 #include "bswap-internal.h"
+#include "nettle-write.h"
 #include "sha3.h"
 
+/* Max number of values passed to each sha3_256_shake_many call. */
+#define SLH_SHAKE_MANY 64
+
 /* Fields always big-endian */
 struct slh_address_tree
 {
@@ -86,6 +93,60 @@ slh_shake_node (const struct sha3_ctx *tree_ctx, const struct slh_address_hash *
   sha3_256_shake (&ctx, _SLH_DSA_128_SIZE, out);
 }
 
+/* Hashes N values of size INPUT_SIZE, like _secret and _node. */
+static void
+slh_shake_many (const struct sha3_ctx *tree_ctx, size_t n,
+		const struct slh_address_hash *ah,
+		const uint8_t *input, size_t stride, size_t input_size,
+		uint8_t *out)
+{
+  /* Public seed, tree address, hash address and input. */
+  uint8_t buffer[SLH_SHAKE_MANY][4*_SLH_DSA_128_SIZE + 16];
+  const uint8_t *data[SLH_SHAKE_MANY];
+  size_t length[SLH_SHAKE_MANY];
+  uint8_t prefix[2*_SLH_DSA_128_SIZE];
+  size_t i, m;
+
+  /* The tree context has absorbed only the public seed and the tree
+     address, with no permutation yet, so they can be read back from
+     the state. */
+  assert (tree_ctx->index == sizeof (prefix));
+  _nettle_write_le64 (sizeof (prefix), prefix, tree_ctx->state.a);
+
+  for (; n > 0; n -= m, ah += m, input += m * stride,
+	 out += m * _SLH_DSA_128_SIZE)
+    {
+      m = (n < SLH_SHAKE_MANY) ? n : SLH_SHAKE_MANY;
+      for (i = 0; i < m; i++)
+	{
+	  memcpy (buffer[i], prefix, sizeof (prefix));
+	  memcpy (buffer[i] + sizeof (prefix), &ah[i], sizeof (*ah));
+	  memcpy (buffer[i] + sizeof (prefix) + sizeof (*ah),
+		  input + i * stride, input_size);
+	  data[i] = buffer[i];
+	  length[i] = sizeof (prefix) + sizeof (*ah) + input_size;
+	}
+      sha3_256_shake_many (m, length, data, _SLH_DSA_128_SIZE, out);
+    }
+}
+
+static void
+slh_shake_secret_many (const struct sha3_ctx *tree_ctx, size_t n,
+		       const struct slh_address_hash *ah,
+		       const uint8_t *secret, size_t stride, uint8_t *out)
+{
+  slh_shake_many (tree_ctx, n, ah, secret, stride, _SLH_DSA_128_SIZE, out);
+}
+
+static void
+slh_shake_node_many (const struct sha3_ctx *tree_ctx, size_t n,
+		     const struct slh_address_hash *ah,
+		     const uint8_t *children, uint8_t *out)
+{
+  slh_shake_many (tree_ctx, n, ah, children, 2*_SLH_DSA_128_SIZE,
+		  2*_SLH_DSA_128_SIZE, out);
+}
+
 static void
 slh_shake_digest (struct sha3_ctx *ctx, uint8_t *out)
 {
@@ -133,6 +194,8 @@ _slh_hash_shake =
     (nettle_hash_digest_func *) slh_shake_digest,
     (slh_hash_secret_func *) slh_shake_secret,
     (slh_hash_node_func *) slh_shake_node,
+    (slh_hash_secret_many_func *) slh_shake_secret_many,
+    (slh_hash_node_many_func *) slh_shake_node_many,
     slh_shake_randomizer,
     slh_shake_msg_digest
   };
@@ -35,48 +35,71 @@
 # include "config.h"
 #endif
 
+#include <string.h>
+
 #include "slh-dsa-internal.h"
 
 #include "bswap-internal.h"
 
-/* If s == 0, returns src and leaves dst unchanged. Otherwise, returns
-   dst. For the ah argument, leaves ah->keypair and ah->height_chain
-   unchanged, but overwrites the other fields. */
-static const uint8_t *
-wots_chain (const struct slh_hash *hash, const void *ctx,
-	    struct slh_address_hash *ah,
-	    unsigned i, unsigned s,
-	    const uint8_t *src, uint8_t *dst)
+/* Computes the message digits, followed by the checksum digits. */
+static void
+wots_digits (const uint8_t *msg, uint8_t *digits)
 {
-  unsigned j;
-
-  if (s == 0)
-    return src;
-
-  ah->type = bswap32_if_le (SLH_WOTS_HASH);
-  ah->index_hash = bswap32_if_le (i);
+  unsigned i;
+  uint32_t csum;
 
-  hash->secret (ctx, ah, src, dst);
+  for (i = 0, csum = 15*32; i < _SLH_DSA_128_SIZE; i++)
+    {
+      digits[2*i] = msg[i] >> 4;
+      digits[2*i + 1] = msg[i] & 0xf;
+      csum -= digits[2*i] + digits[2*i + 1];
+    }
+  digits[32] = csum >> 8;
+  digits[33] = (csum >> 4) & 0xf;
+  digits[34] = csum & 0xf;
+}
 
-  for (j = 1; j < s; j++)
+/* Sets up addresses for chain values, with ah[i] for chain i. */
+static void
+wots_addresses (uint32_t keypair, enum slh_addr_type type,
+		struct slh_address_hash *ah)
+{
+  unsigned i;
+  for (i = 0; i < _WOTS_SIGNATURE_LENGTH; i++)
     {
-      ah->index_hash = bswap32_if_le (i + j);
-      hash->secret (ctx, ah, dst, dst);
+      ah[i].type = bswap32_if_le (type);
+      ah[i].keypair = bswap32_if_le (keypair);
+      ah[i].height_chain = bswap32_if_le (i);
+      ah[i].index_hash = 0;
     }
+}
 
-  return dst;
+/* Does hashing step i for the first n chains, processing all of them
+   in one batch. */
+static void
+wots_step (const struct slh_hash *hash, const void *tree_ctx,
+	   unsigned n, struct slh_address_hash *ah, unsigned i,
+	   uint8_t *chains)
+{
+  unsigned j;
+  for (j = 0; j < n; j++)
+    {
+      ah[j].type = bswap32_if_le (SLH_WOTS_HASH);
+      ah[j].index_hash = bswap32_if_le (i);
+    }
+  hash->secret_many (tree_ctx, n, ah, chains, _SLH_DSA_128_SIZE, chains);
 }
 
 static void
 wots_pk_init (const struct slh_hash *hash, const void *tree_ctx,
-	      unsigned keypair, struct slh_address_hash *ah,
-	      void *ctx)
+	      unsigned keypair, void *ctx)
 {
-  ah->type = bswap32_if_le (SLH_WOTS_PK);
-  ah->keypair = bswap32_if_le (keypair);
-  ah->height_chain = 0;
-  ah->index_hash = 0;
-  hash->init_hash (tree_ctx, ctx, ah);
+  struct slh_address_hash ah;
+  ah.type = bswap32_if_le (SLH_WOTS_PK);
+  ah.keypair = bswap32_if_le (keypair);
+  ah.height_chain = 0;
+  ah.index_hash = 0;
+  hash->init_hash (tree_ctx, ctx, &ah);
 }
 
 void
@@ -84,126 +107,103 @@ _wots_gen (const struct slh_hash *hash, const void *tree_ctx,
 	   const uint8_t *secret_seed,
 	   uint32_t keypair, uint8_t *pub, void *pub_ctx)
 {
-  struct slh_address_hash ah;
+  struct slh_address_hash ah[_WOTS_SIGNATURE_LENGTH];
+  uint8_t chains[WOTS_SIGNATURE_SIZE];
   unsigned i;
 
-  wots_pk_init (hash, tree_ctx, keypair, &ah, pub_ctx);
-
-  for (i = 0; i < _WOTS_SIGNATURE_LENGTH; i++)
-    {
-      uint8_t out[_SLH_DSA_128_SIZE];
+  /* Generate secret values. */
+  wots_addresses (keypair, SLH_WOTS_PRF, ah);
+  hash->secret_many (tree_ctx, _WOTS_SIGNATURE_LENGTH, ah, secret_seed, 0, chains);
 
-      /* Generate secret value. */
-      ah.type = bswap32_if_le (SLH_WOTS_PRF);
-      ah.height_chain = bswap32_if_le (i);
-      ah.index_hash = 0;
-      hash->secret (tree_ctx, &ah, secret_seed, out);
+  /* Hash chains, all in parallel. */
+  for (i = 0; i < 15; i++)
+    wots_step (hash, tree_ctx, _WOTS_SIGNATURE_LENGTH, ah, i, chains);
 
-      /* Hash chain. */
-      wots_chain (hash, tree_ctx, &ah, 0, 15, out, out);
-
-      hash->update (pub_ctx, _SLH_DSA_128_SIZE, out);
-    }
+  wots_pk_init (hash, tree_ctx, keypair, pub_ctx);
+  hash->update (pub_ctx, sizeof (chains), chains);
   hash->digest (pub_ctx, pub);
 }
 
-/* Produces signature hash corresponding to the ith message nybble. Modifies addr. */
-static void
-wots_sign_one (const struct slh_hash *hash, const void *tree_ctx,
-	       const uint8_t *secret_seed, uint32_t keypair,
-	       unsigned i, uint8_t msg,
-	       uint8_t *signature, void *pub_ctx)
-{
-  struct slh_address_hash ah;
-  uint8_t pub[_SLH_DSA_128_SIZE];
-  signature += i*_SLH_DSA_128_SIZE;
-
-  /* Generate secret value. */
-  ah.type = bswap32_if_le (SLH_WOTS_PRF);
-  ah.keypair = bswap32_if_le (keypair);
-  ah.height_chain = bswap32_if_le (i);
-  ah.index_hash = 0;
-  hash->secret (tree_ctx, &ah, secret_seed, signature);
-
-  /* Hash chain. */
-  wots_chain (hash, tree_ctx, &ah, 0, msg, signature, signature);
-
-  hash->update (pub_ctx, _SLH_DSA_128_SIZE,
-		wots_chain (hash, tree_ctx, &ah, msg, 15 - msg, signature, pub));
-}
-
 void
 _wots_sign (const struct slh_hash *hash, const void *tree_ctx,
 	    const uint8_t *secret_seed, unsigned keypair, const uint8_t *msg,
 	    uint8_t *signature, uint8_t *pub, void *pub_ctx)
 {
-  struct slh_address_hash ah;
-  unsigned i;
-  uint32_t csum;
+  struct slh_address_hash ah[_WOTS_SIGNATURE_LENGTH];
+  uint8_t chains[WOTS_SIGNATURE_SIZE];
+  uint8_t digits[_WOTS_SIGNATURE_LENGTH];
+  unsigned i, j;
 
-  wots_pk_init (hash, tree_ctx, keypair, &ah, pub_ctx);
+  wots_digits (msg, digits);
 
-  for (i = 0, csum = 15*32; i < _SLH_DSA_128_SIZE; i++)
+  /* Generate secret values. */
+  wots_addresses (keypair, SLH_WOTS_PRF, ah);
+  hash->secret_many (tree_ctx, _WOTS_SIGNATURE_LENGTH, ah, secret_seed, 0, chains);
+
+  /* Hash all chains to the end, picking out the signature values on
+     the way. */
+  for (i = 0; ; i++)
     {
-      uint8_t m0, m1;
-      m0 = msg[i] >> 4;
-      csum -= m0;
-      wots_sign_one (hash, tree_ctx, secret_seed, keypair, 2*i, m0, signature, pub_ctx);
-
-      m1 = msg[i] & 0xf;
-      csum -= m1;
-      wots_sign_one (hash, tree_ctx, secret_seed, keypair, 2*i + 1, m1, signature, pub_ctx);
+      for (j = 0; j < _WOTS_SIGNATURE_LENGTH; j++)
+	if (digits[j] == i)
+	  memcpy (signature + j*_SLH_DSA_128_SIZE,
+		  chains + j*_SLH_DSA_128_SIZE, _SLH_DSA_128_SIZE);
+      if (i == 15)
+	break;
+      wots_step (hash, tree_ctx, _WOTS_SIGNATURE_LENGTH, ah, i, chains);
     }
 
-  wots_sign_one (hash, tree_ctx, secret_seed, keypair, 32, csum >> 8, signature, pub_ctx);
-  wots_sign_one (hash, tree_ctx, secret_seed, keypair, 33, (csum >> 4) & 0xf, signature, pub_ctx);
-  wots_sign_one (hash, tree_ctx, secret_seed, keypair, 34, csum & 0xf, signature, pub_ctx);
-
+  wots_pk_init (hash, tree_ctx, keypair, pub_ctx);
+  hash->update (pub_ctx, sizeof (chains), chains);
   hash->digest (pub_ctx, pub);
 }
 
-static void
-wots_verify_one (const struct slh_hash *hash, const void *tree_ctx,
-		 uint32_t keypair, unsigned i, uint8_t msg,
-		 const uint8_t *signature, void *pub_ctx)
-{
-  struct slh_address_hash ah;
-  uint8_t out[_SLH_DSA_128_SIZE];
-  signature += i*_SLH_DSA_128_SIZE;
-
-  ah.keypair = bswap32_if_le (keypair);
-  ah.height_chain = bswap32_if_le (i);
-
-  hash->update (pub_ctx, _SLH_DSA_128_SIZE,
-		wots_chain (hash, tree_ctx, &ah, msg, 15 - msg, signature, out));
-}
-
 void
 _wots_verify (const struct slh_hash *hash, const void *tree_ctx,
 	      unsigned keypair, const uint8_t *msg, const uint8_t *signature, uint8_t *pub,
 	      void *pub_ctx)
 {
-  struct slh_address_hash ah;
-  unsigned i;
-  uint32_t csum;
-
-  wots_pk_init (hash, tree_ctx, keypair, &ah, pub_ctx);
+  struct slh_address_hash ah[_WOTS_SIGNATURE_LENGTH];
+  uint8_t chains[WOTS_SIGNATURE_SIZE];
+  uint8_t digits[_WOTS_SIGNATURE_LENGTH];
+  /* Chains sorted by digit, position of each chain in that order,
+     and start of each digit's range. */
+  uint8_t order[_WOTS_SIGNATURE_LENGTH];
+  uint8_t pos[_WOTS_SIGNATURE_LENGTH];
+  uint8_t start[17];
+  unsigned i, j;
+
+  wots_digits (msg, digits);
+
+  /* Chain j needs steps digits[j], ..., 14. Sort the chains by digit,
+     so that the chains needing step i are always the first
+     start[i+1] ones. */
+  memset (start, 0, sizeof (start));
+  for (j = 0; j < _WOTS_SIGNATURE_LENGTH; j++)
+    start[digits[j] + 1]++;
+  for (i = 1; i < 17; i++)
+    start[i] += start[i-1];
+  for (j = 0; j < _WOTS_SIGNATURE_LENGTH; j++)
+    {
+      pos[j] = start[digits[j]]++;
+      order[pos[j]] = j;
+    }
+  /* Now start[i] is the end of the range for digit i. */
 
-  for (i = 0, csum = 15*32; i < _SLH_DSA_128_SIZE; i++)
+  wots_addresses (keypair, SLH_WOTS_HASH, ah);
+  for (j = 0; j < _WOTS_SIGNATURE_LENGTH; j++)
     {
-      uint8_t m0, m1;
-      m0 = msg[i] >> 4;
-      csum -= m0;
-      wots_verify_one (hash, tree_ctx, keypair, 2*i, m0, signature, pub_ctx);
-
-      m1 = msg[i] & 0xf;
-      csum -= m1;
-      wots_verify_one (hash, tree_ctx, keypair, 2*i + 1, m1, signature, pub_ctx);
+      ah[j].height_chain = bswap32_if_le (order[j]);
+      memcpy (chains + j*_SLH_DSA_128_SIZE,
+	      signature + order[j]*_SLH_DSA_128_SIZE, _SLH_DSA_128_SIZE);
     }
 
-  wots_verify_one (hash, tree_ctx, keypair, 32, csum >> 8, signature, pub_ctx);
-  wots_verify_one (hash, tree_ctx, keypair, 33, (csum >> 4) & 0xf, signature, pub_ctx);
-  wots_verify_one (hash, tree_ctx, keypair, 34, csum & 0xf, signature, pub_ctx);
+  for (i = 0; i < 15; i++)
+    if (start[i] > 0)
+      wots_step (hash, tree_ctx, start[i], ah, i, chains);
 
+  wots_pk_init (hash, tree_ctx, keypair, pub_ctx);
+  for (j = 0; j < _WOTS_SIGNATURE_LENGTH; j++)
+    hash->update (pub_ctx, _SLH_DSA_128_SIZE, chains + pos[j]*_SLH_DSA_128_SIZE);
   hash->digest (pub_ctx, pub);
 }
@@ -1,5 +1,6 @@
 #include "testutils.h"
 #include "aes.h"
+#include "knuth-lfib.h"
 #include "nettle-internal.h"
 
 typedef void invert_func (void *, void *) ;
@@ -53,6 +54,67 @@ test_invert(const struct nettle_cipher *cipher,
   free (data);
 }
 
+/* Large enough to exercise all code paths of implementations
+   processing many blocks in parallel. */
+#define AES_BULK_BLOCKS 100
+
+/* Check that processing n blocks at once gives the same result as
+   processing one block at a time, for all n up to AES_BULK_BLOCKS. */
+static void
+test_bulk(const struct nettle_cipher *cipher)
+{
+  struct knuth_lfib_ctx random;
+  void *ctx = xalloc(cipher->context_size);
+  uint8_t *key = xalloc(cipher->key_size);
+  uint8_t *clear = xalloc(AES_BULK_BLOCKS * AES_BLOCK_SIZE);
+  uint8_t *data = xalloc(AES_BULK_BLOCKS * AES_BLOCK_SIZE);
+  uint8_t *ref = xalloc(AES_BULK_BLOCKS * AES_BLOCK_SIZE);
+  size_t blocks, i;
+
+  knuth_lfib_init(&random, cipher->key_size);
+  knuth_lfib_random(&random, cipher->key_size, key);
+  knuth_lfib_random(&random, AES_BULK_BLOCKS * AES_BLOCK_SIZE, clear);
+
+  cipher->set_encrypt_key(ctx, key);
+  for (i = 0; i < AES_BULK_BLOCKS; i++)
+    cipher->encrypt(ctx, AES_BLOCK_SIZE,
+		    ref + i*AES_BLOCK_SIZE, clear + i*AES_BLOCK_SIZE);
+
+  for (blocks = 1; blocks <= AES_BULK_BLOCKS; blocks++)
+    {
+      size_t length = blocks * AES_BLOCK_SIZE;
+      cipher->set_encrypt_key(ctx, key);
+      cipher->encrypt(ctx, length, data, clear);
+      if (!MEMEQ(length, data, ref))
+	{
+	  fprintf(stderr, "test_bulk: %s encrypt failed, %u blocks:\nOutput: ",
+		  cipher->name, (unsigned) blocks);
+	  print_hex(length, data);
+	  fprintf(stderr, "\nExpected:");
+	  print_hex(length, ref);
+	  fprintf(stderr, "\n");
+	  FAIL();
+	}
+      cipher->set_decrypt_key(ctx, key);
+      cipher->decrypt(ctx, length, data, data);
+      if (!MEMEQ(length, data, clear))
+	{
+	  fprintf(stderr, "test_bulk: %s decrypt failed, %u blocks:\nOutput: ",
+		  cipher->name, (unsigned) blocks);
+	  print_hex(length, data);
+	  fprintf(stderr, "\nExpected:");
+	  print_hex(length, clear);
+	  fprintf(stderr, "\n");
+	  FAIL();
+	}
+    }
+  free(ctx);
+  free(key);
+  free(clear);
+  free(data);
+  free(ref);
+}
+
 void
 test_main(void)
 {
@@ -162,6 +224,10 @@ test_main(void)
 		   "14151617191A1B1C 1E1F202123242526"),
 	      SHEX("834EADFCCAC7E1B30664B1ABA44815AB"),
 	      SHEX("1946DABF6A03A2A2 C3D0B05080AED6FC"));
+
+  test_bulk(&nettle_aes128);
+  test_bulk(&nettle_aes192);
+  test_bulk(&nettle_aes256);
 }
 
 /* Internal state for the first test case:
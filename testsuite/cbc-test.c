@@ -65,6 +65,68 @@ test_cbc_bulk(void)
   ASSERT (MEMEQ(CBC_BULK_DATA, clear, cipher));
 }
 
+/* Check the cbc_aes*_decrypt functions, which may have an optimized
+ * implementation processing several blocks at a time, against
+ * cbc_decrypt for all lengths up to CBC_AES_BLOCKS blocks. */
+#define CBC_AES_BLOCKS 40
+
+static void
+test_cbc_aes_decrypt(void)
+{
+  struct knuth_lfib_ctx random;
+  uint8_t key[AES256_KEY_SIZE];
+  uint8_t iv[AES_BLOCK_SIZE];
+  uint8_t ref_iv[AES_BLOCK_SIZE];
+  uint8_t dst_iv[AES_BLOCK_SIZE];
+  uint8_t src[CBC_AES_BLOCKS * AES_BLOCK_SIZE];
+  uint8_t ref[CBC_AES_BLOCKS * AES_BLOCK_SIZE];
+  uint8_t dst[CBC_AES_BLOCKS * AES_BLOCK_SIZE + 1];
+  struct aes128_ctx aes128;
+  struct aes192_ctx aes192;
+  struct aes256_ctx aes256;
+  unsigned blocks;
+
+  knuth_lfib_init(&random, 4711);
+  knuth_lfib_random(&random, sizeof(key), key);
+  knuth_lfib_random(&random, sizeof(iv), iv);
+  knuth_lfib_random(&random, sizeof(src), src);
+
+  aes128_set_decrypt_key(&aes128, key);
+  aes192_set_decrypt_key(&aes192, key);
+  aes256_set_decrypt_key(&aes256, key);
+
+  for (blocks = 0; blocks <= CBC_AES_BLOCKS; blocks++)
+    {
+      size_t length = blocks * AES_BLOCK_SIZE;
+
+#define CHECK_CBC_AES_DECRYPT(size) do {				\
+	memcpy(ref_iv, iv, AES_BLOCK_SIZE);				\
+	cbc_decrypt(&aes##size, (nettle_cipher_func *) aes##size##_decrypt, \
+		    AES_BLOCK_SIZE, ref_iv, length, ref, src);		\
+									\
+	memcpy(dst_iv, iv, AES_BLOCK_SIZE);				\
+	dst[length] = 17;						\
+	cbc_aes##size##_decrypt(&aes##size, dst_iv, length, dst, src);	\
+	ASSERT(dst[length] == 17);					\
+	ASSERT(MEMEQ(length, dst, ref));				\
+	ASSERT(MEMEQ(AES_BLOCK_SIZE, dst_iv, ref_iv));			\
+									\
+	/* In place */							\
+	memcpy(dst_iv, iv, AES_BLOCK_SIZE);				\
+	memcpy(dst, src, length);					\
+	cbc_aes##size##_decrypt(&aes##size, dst_iv, length, dst, dst);	\
+	ASSERT(dst[length] == 17);					\
+	ASSERT(MEMEQ(length, dst, ref));				\
+	ASSERT(MEMEQ(AES_BLOCK_SIZE, dst_iv, ref_iv));			\
+      } while (0)
+
+      CHECK_CBC_AES_DECRYPT(128);
+      CHECK_CBC_AES_DECRYPT(192);
+      CHECK_CBC_AES_DECRYPT(256);
+#undef CHECK_CBC_AES_DECRYPT
+    }
+}
+
 void
 test_main(void)
 {
@@ -207,6 +269,7 @@ test_main(void)
 	    NULL);
 
   test_cbc_bulk();
+  test_cbc_aes_decrypt();
 }
 
 /*
@@ -43,6 +43,7 @@
 #include "testutils.h"
 #include "aes.h"
 #include "ccm.h"
+#include "ctr.h"
 #include "knuth-lfib.h"
 
 static void
@@ -288,6 +289,120 @@ test_cipher_ccm(const struct nettle_cipher *cipher,
   free(de_data);
 }
 
+#define CCM_LONG_BLOCKS 50
+/* With 14 bytes of associated data, the associated data and its
+   length encoding fill exactly one block, so the CBC-MAC of the
+   message can be computed with ccm_update, as a reference. */
+#define CCM_LONG_ADATA_SIZE 14
+
+static void
+test_ccm_aes128_long (void)
+{
+  struct knuth_lfib_ctx random;
+  struct ccm_aes128_ctx ctx;
+  struct ccm_ctx ref;
+  uint8_t aes_key[AES128_KEY_SIZE];
+  uint8_t nonce[13];
+  uint8_t adata[CCM_LONG_ADATA_SIZE];
+  uint8_t clear[CCM_LONG_BLOCKS * CCM_BLOCK_SIZE + 5];
+  uint8_t cipher[CCM_LONG_BLOCKS * CCM_BLOCK_SIZE + 5];
+  uint8_t data[CCM_LONG_BLOCKS * CCM_BLOCK_SIZE + 5 + CCM_DIGEST_SIZE];
+  uint8_t digest[CCM_DIGEST_SIZE];
+  uint8_t ref_digest[CCM_DIGEST_SIZE];
+  unsigned step;
+
+  knuth_lfib_init (&random, 4711);
+  knuth_lfib_random (&random, sizeof(aes_key), aes_key);
+  knuth_lfib_random (&random, sizeof(nonce), nonce);
+  knuth_lfib_random (&random, sizeof(adata), adata);
+  knuth_lfib_random (&random, sizeof(clear), clear);
+
+  ccm_aes128_set_key (&ctx, aes_key);
+
+  ccm_set_nonce (&ref, &ctx.cipher, (nettle_cipher_func *) aes128_encrypt,
+		 sizeof(nonce), nonce, sizeof(adata), sizeof(clear),
+		 CCM_DIGEST_SIZE);
+  ccm_update (&ref, &ctx.cipher, (nettle_cipher_func *) aes128_encrypt,
+	      sizeof(adata), adata);
+  ccm_update (&ref, &ctx.cipher, (nettle_cipher_func *) aes128_encrypt,
+	      sizeof(clear), clear);
+  ctr_crypt (&ctx.cipher, (nettle_cipher_func *) aes128_encrypt,
+	     CCM_BLOCK_SIZE, ref.ctr.b, sizeof(clear), cipher, clear);
+  ccm_digest (&ref, &ctx.cipher, (nettle_cipher_func *) aes128_encrypt,
+	      ref_digest);
+
+  for (step = 1; step <= 37; step += 4)
+    {
+      size_t done, size;
+
+      ccm_aes128_set_nonce (&ctx, sizeof(nonce), nonce, sizeof(adata),
+			    sizeof(clear), CCM_DIGEST_SIZE);
+      ccm_aes128_update (&ctx, sizeof(adata), adata);
+      for (done = 0; done < sizeof(clear); done += size)
+	{
+	  size = step * CCM_BLOCK_SIZE;
+	  if (size > sizeof(clear) - done)
+	    size = sizeof(clear) - done;
+	  ccm_aes128_encrypt (&ctx, size, data + done, clear + done);
+	}
+      ccm_aes128_digest (&ctx, digest);
+      ASSERT (MEMEQ (sizeof(cipher), data, cipher));
+      ASSERT (MEMEQ (CCM_DIGEST_SIZE, digest, ref_digest));
+
+      /* Decrypt in place */
+      ccm_aes128_set_nonce (&ctx, sizeof(nonce), nonce, sizeof(adata),
+			    sizeof(clear), CCM_DIGEST_SIZE);
+      ccm_aes128_update (&ctx, sizeof(adata), adata);
+      for (done = 0; done < sizeof(clear); done += size)
+	{
+	  size = step * CCM_BLOCK_SIZE;
+	  if (size > sizeof(clear) - done)
+	    size = sizeof(clear) - done;
+	  ccm_aes128_decrypt (&ctx, size, data + done, data + done);
+	}
+      ccm_aes128_digest (&ctx, digest);
+      ASSERT (MEMEQ (sizeof(clear), data, clear));
+      ASSERT (MEMEQ (CCM_DIGEST_SIZE, digest, ref_digest));
+
+      /* Generic functions, which process two blocks per call to
+	 the cipher. */
+      ccm_set_nonce (&ref, &ctx.cipher, (nettle_cipher_func *) aes128_encrypt,
+		     sizeof(nonce), nonce, sizeof(adata), sizeof(clear),
+		     CCM_DIGEST_SIZE);
+      ccm_update (&ref, &ctx.cipher, (nettle_cipher_func *) aes128_encrypt,
+		  sizeof(adata), adata);
+      for (done = 0; done < sizeof(clear); done += size)
+	{
+	  size = step * CCM_BLOCK_SIZE;
+	  if (size > sizeof(clear) - done)
+	    size = sizeof(clear) - done;
+	  ccm_decrypt (&ref, &ctx.cipher, (nettle_cipher_func *) aes128_encrypt,
+		       size, data + done, cipher + done);
+	}
+      ccm_digest (&ref, &ctx.cipher, (nettle_cipher_func *) aes128_encrypt,
+		  digest);
+      ASSERT (MEMEQ (sizeof(clear), data, clear));
+      ASSERT (MEMEQ (CCM_DIGEST_SIZE, digest, ref_digest));
+    }
+
+  ccm_aes128_encrypt_message (&ctx.cipher, sizeof(nonce), nonce,
+			      sizeof(adata), adata, CCM_DIGEST_SIZE,
+			      sizeof(data), data, clear);
+  ASSERT (MEMEQ (sizeof(cipher), data, cipher));
+  ASSERT (MEMEQ (CCM_DIGEST_SIZE, data + sizeof(cipher), ref_digest));
+
+  ccm_encrypt_message (&ctx.cipher, (nettle_cipher_func *) aes128_encrypt,
+		       sizeof(nonce), nonce, sizeof(adata), adata,
+		       CCM_DIGEST_SIZE, sizeof(data), data, clear);
+  ASSERT (MEMEQ (sizeof(cipher), data, cipher));
+  ASSERT (MEMEQ (CCM_DIGEST_SIZE, data + sizeof(cipher), ref_digest));
+
+  ASSERT (ccm_aes128_decrypt_message (&ctx.cipher, sizeof(nonce), nonce,
+				      sizeof(adata), adata, CCM_DIGEST_SIZE,
+				      sizeof(clear), data, data));
+  ASSERT (MEMEQ (sizeof(clear), data, clear));
+}
+
 void
 test_main(void)
 {
@@ -755,4 +870,6 @@ test_main(void)
 		  SHEX("90ae61cf7baebd4cade494c54a29ae70269aec71"),
 		  SHEX("6c05313e45dc8ec10bea6c670bd94f31569386a6"
 		       "8f3829e8e76ee23c04f566189e63c686"));
+
+  test_ccm_aes128_long ();
 }
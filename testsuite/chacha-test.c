@@ -36,6 +36,7 @@
 
 #include "chacha.h"
 #include "chacha-internal.h"
+#include "memxor.h"
 
 static int
 memzero_p (const uint8_t *p, size_t n)
@@ -121,6 +122,78 @@ test_chacha_core(void)
     }
 }
 
+/* Compares chacha_crypt and chacha_crypt32 for all lengths up to
+   a bit more than 16 blocks, at several counter values, against
+   _nettle_chacha_core applied one block at a time. */
+static void
+test_chacha_bulk(void)
+{
+  static const uint32_t counters[] =
+    { 0, 0xfffffff9, 0xfffffffe };
+  uint8_t src[17*CHACHA_BLOCK_SIZE + 3];
+  uint8_t output[sizeof(src)];
+  uint8_t expected[sizeof(src)];
+  unsigned i;
+
+  for (i = 0; i < sizeof(src); i++)
+    src[i] = i * 17 + 5;
+
+  for (i = 0; i < sizeof(counters) / sizeof(counters[0]); i++)
+    {
+      unsigned wide;
+      for (wide = 0; wide < 2; wide++)
+	{
+	  size_t length;
+	  for (length = 1; length <= sizeof(src); length += 1 + (length > 300) * 6)
+	    {
+	      struct chacha_ctx ctx, ref;
+	      size_t done;
+	      unsigned j;
+
+	      for (j = 0; j < _CHACHA_STATE_LENGTH; j++)
+		ref.state[j] = j * 0x01010101 + 0x55;
+	      ref.state[12] = counters[i];
+	      ref.state[13] = 0x77;
+	      ctx = ref;
+
+	      for (done = 0; done < length; done += CHACHA_BLOCK_SIZE)
+		{
+		  uint32_t x[_CHACHA_STATE_LENGTH];
+		  size_t left = length - done;
+
+		  _nettle_chacha_core (x, ref.state, 20);
+		  if (wide)
+		    ref.state[13] += (++ref.state[12] == 0);
+		  else
+		    ++ref.state[12];
+		  memxor3 (expected + done, src + done, x,
+			   left < CHACHA_BLOCK_SIZE ? left : CHACHA_BLOCK_SIZE);
+		}
+
+	      if (wide)
+		chacha_crypt (&ctx, length, output, src);
+	      else
+		chacha_crypt32 (&ctx, length, output, src);
+
+	      if (!MEMEQ (length, output, expected)
+		  || ctx.state[12] != ref.state[12]
+		  || ctx.state[13] != ref.state[13])
+		{
+		  fprintf (stderr, "%s failed, length %u, counter %08x:\n",
+			   wide ? "chacha_crypt" : "chacha_crypt32",
+			   (unsigned) length, counters[i]);
+		  fprintf (stderr, "\nOutput: ");
+		  print_hex (length, output);
+		  fprintf (stderr, "\nExpected:");
+		  print_hex (length, expected);
+		  fprintf (stderr, "\n");
+		  FAIL ();
+		}
+	    }
+	}
+    }
+}
+
 /* For tests with non-standard number of rounds, calling
    _nettle_chacha_core directly. */
 static void
@@ -261,6 +334,7 @@ void
 test_main(void)
 {
   test_chacha_core();
+  test_chacha_bulk();
 
   /* Test vectors from draft-strombergson-chacha-test-vectors */
   test_chacha_rounds (SHEX("0000000000000000 0000000000000000"
@@ -32,6 +32,7 @@
 #include "testutils.h"
 
 #include "curve25519.h"
+#include "knuth-lfib.h"
 
 static void
 test_g (const uint8_t *s, const uint8_t *r)
@@ -80,6 +81,46 @@ test_a (const uint8_t *s, const uint8_t *b, const uint8_t *r)
     }
 }
 
+/* Compares curve25519_mul_batch to curve25519_mul, for random scalars
+   and points. Point 2 is u = 0, with zero result, which must not
+   affect the other outputs. */
+static void
+test_batch (unsigned count)
+{
+  struct knuth_lfib_ctx rctx;
+  uint8_t *n = xalloc (count * CURVE25519_SIZE);
+  uint8_t *p = xalloc (count * CURVE25519_SIZE);
+  uint8_t *q = xalloc (count * CURVE25519_SIZE);
+  uint8_t r[CURVE25519_SIZE];
+  unsigned i;
+
+  knuth_lfib_init (&rctx, 17);
+  knuth_lfib_random (&rctx, count * CURVE25519_SIZE, n);
+  knuth_lfib_random (&rctx, count * CURVE25519_SIZE, p);
+  if (count > 2)
+    memset (p + 2*CURVE25519_SIZE, 0, CURVE25519_SIZE);
+
+  curve25519_mul_batch (count, q, n, p);
+
+  for (i = 0; i < count; i++)
+    {
+      curve25519_mul (r, n + i*CURVE25519_SIZE, p + i*CURVE25519_SIZE);
+      if (!MEMEQ (CURVE25519_SIZE, q + i*CURVE25519_SIZE, r))
+	{
+	  printf ("curve25519_mul_batch failure (count %u, i %u):\nq = ",
+		  count, i);
+	  print_hex (CURVE25519_SIZE, q + i*CURVE25519_SIZE);
+	  printf (" (bad)\nr = ");
+	  print_hex (CURVE25519_SIZE, r);
+	  printf (" (expected)\n");
+	  abort ();
+	}
+    }
+  free (n);
+  free (p);
+  free (q);
+}
+
 void
 test_main (void)
 {
@@ -150,4 +191,7 @@ test_main (void)
 	    "3f8343c85b78674dadfc7e146f882bcf"),
 	  H("4a5d9d5ba4ce2de1728e3bf480350f25"
 	    "e07e21c947d19e3376f09b3c1e161742"));
+
+  test_batch (1);
+  test_batch (5);
 }
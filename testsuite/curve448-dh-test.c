@@ -33,6 +33,7 @@
 #include "testutils.h"
 
 #include "curve448.h"
+#include "knuth-lfib.h"
 
 static void
 test_g (const uint8_t *s, const uint8_t *r)
@@ -79,6 +80,46 @@ test_a (const uint8_t *s, const uint8_t *b, const uint8_t *r)
     }
 }
 
+/* Compares curve448_mul_batch to curve448_mul, for random scalars
+   and points. Point 2 is u = 0, with zero result, which must not
+   affect the other outputs. */
+static void
+test_batch (unsigned count)
+{
+  struct knuth_lfib_ctx rctx;
+  uint8_t *n = xalloc (count * CURVE448_SIZE);
+  uint8_t *p = xalloc (count * CURVE448_SIZE);
+  uint8_t *q = xalloc (count * CURVE448_SIZE);
+  uint8_t r[CURVE448_SIZE];
+  unsigned i;
+
+  knuth_lfib_init (&rctx, 17);
+  knuth_lfib_random (&rctx, count * CURVE448_SIZE, n);
+  knuth_lfib_random (&rctx, count * CURVE448_SIZE, p);
+  if (count > 2)
+    memset (p + 2*CURVE448_SIZE, 0, CURVE448_SIZE);
+
+  curve448_mul_batch (count, q, n, p);
+
+  for (i = 0; i < count; i++)
+    {
+      curve448_mul (r, n + i*CURVE448_SIZE, p + i*CURVE448_SIZE);
+      if (!MEMEQ (CURVE448_SIZE, q + i*CURVE448_SIZE, r))
+	{
+	  printf ("curve448_mul_batch failure (count %u, i %u):\nq = ",
+		  count, i);
+	  print_hex (CURVE448_SIZE, q + i*CURVE448_SIZE);
+	  printf (" (bad)\nr = ");
+	  print_hex (CURVE448_SIZE, r);
+	  printf (" (expected)\n");
+	  abort ();
+	}
+    }
+  free (n);
+  free (p);
+  free (q);
+}
+
 void
 test_main (void)
 {
@@ -108,4 +149,7 @@ test_main (void)
 	    "22c5d9bbc836647241d953d40c5b12da88120d53177f80e532c41fa0"),
 	  H("07fff4181ac6cc95ec1c16a94a0f74d12da232ce40a77552281d282b"
 	    "b60c0b56fd2464c335543936521c24403085d59a449a5037514a879d"));
+
+  test_batch (1);
+  test_batch (5);
 }
@@ -100,6 +100,73 @@ test_sub(const char *name,
   mpz_clear (ref);
 }
 
+static void
+test_mul(const char *name,
+	 const struct ecc_modulo *m,
+	 const mpz_t az, const mpz_t bz)
+{
+  mp_limb_t a[MAX_SIZE];
+  mp_limb_t b[MAX_SIZE];
+  mp_limb_t t[MAX_SIZE];
+  mp_limb_t scratch[2*MAX_SIZE];
+  mpz_t mz;
+  mpz_t tz;
+  mpz_t ref;
+  int sqr = (mpz_cmp (az, bz) == 0);
+
+  mpz_init (ref);
+  mpz_mul (ref, az, bz);
+  mpz_mod (ref, ref, mpz_roinit_n (mz, m->m, m->size));
+  if (m->reduce != m->mod)
+    {
+      /* Reduction is redc, so the result includes a factor B^{-size}. */
+      mpz_t binv;
+      mpz_init (binv);
+      mpz_setbit (binv, m->size * GMP_NUMB_BITS);
+      mpz_invert (binv, binv, mz);
+      mpz_mul (ref, ref, binv);
+      mpz_mod (ref, ref, mz);
+      mpz_clear (binv);
+    }
+
+  mpz_limbs_copy (a, az, m->size);
+  mpz_limbs_copy (b, bz, m->size);
+  if (sqr)
+    ecc_mod_sqr (m, t, a, scratch);
+  else
+    ecc_mod_mul (m, t, a, b, scratch);
+
+  if (!mpz_congruent_p (ref, mpz_roinit_n (tz, t, m->size), mz))
+    {
+      fprintf (stderr, "ecc_mod_%s %s failed: bit_size = %u\n",
+	       sqr ? "sqr" : "mul", name, m->bit_size);
+      goto fail;
+    }
+
+  if (sqr)
+    ecc_mod_sqr_canonical (m, t, a, scratch);
+  else
+    ecc_mod_mul_canonical (m, t, a, b, scratch);
+
+  if (mpz_cmp (ref, mpz_roinit_n (tz, t, m->size)) != 0)
+    {
+      fprintf (stderr, "ecc_mod_%s_canonical %s failed: bit_size = %u\n",
+	       sqr ? "sqr" : "mul", name, m->bit_size);
+    fail:
+      fprintf (stderr, "a   = ");
+      mpn_out_str (stderr, 16, a, m->size);
+      fprintf (stderr, "\nb   = ");
+      mpn_out_str (stderr, 16, b, m->size);
+      fprintf (stderr, "\nt   = ");
+      mpn_out_str (stderr, 16, t, m->size);
+      fprintf (stderr, " (bad)\nref = ");
+      mpz_out_str (stderr, 16, ref);
+      fprintf (stderr, "\n");
+      abort ();
+    }
+  mpz_clear (ref);
+}
+
 static void
 test_modulo (gmp_randstate_t rands, const char *name,
 	     const struct ecc_modulo *m, unsigned count)
@@ -124,6 +191,8 @@ test_modulo (gmp_randstate_t rands, const char *name,
 	}
       test_add (name, m, a, b);
       test_sub (name, m, NULL, a, b);
+      test_mul (name, m, a, b);
+      test_mul (name, m, a, a);
     }
   if (m->bit_size < m->size * GMP_NUMB_BITS)
     {
@@ -43,7 +43,8 @@ ref_modinv (mp_limb_t *rp, const mp_limb_t *ap,
 
 static void
 test_modulo (gmp_randstate_t rands, const char *name,
-	     const struct ecc_modulo *m, int use_redc)
+	     const struct ecc_modulo *m, int use_redc,
+	     ecc_mod_inv_func *invert, mp_size_t invert_itch)
 {
   mp_limb_t *a;
   mp_limb_t *ai;
@@ -57,12 +58,12 @@ test_modulo (gmp_randstate_t rands, const char *name,
   a = xalloc_limbs (m->size);
   ai = xalloc_limbs (m->size);
   ref = xalloc_limbs (m->size);;
-  scratch = xalloc_limbs (m->invert_itch);
+  scratch = xalloc_limbs (invert_itch);
 
   /* Check behaviour for zero input */
   mpn_zero (a, m->size);
   memset (ai, 17, m->size * sizeof(*ai));
-  m->invert (m, ai, a, scratch);
+  invert (m, ai, a, scratch);
   if (!ecc_mod_zero_p (m, ai))
     {
       fprintf (stderr, "%s->invert failed for zero input (bit size %u):\n",
@@ -77,7 +78,7 @@ test_modulo (gmp_randstate_t rands, const char *name,
 	  
   /* Check behaviour for a = m */
   memset (ai, 17, m->size * sizeof(*ai));
-  m->invert (m, ai, m->m, scratch);
+  invert (m, ai, m->m, scratch);
   if (!ecc_mod_zero_p (m, ai))
     {
       fprintf (stderr, "%s->invert failed for a = p input (bit size %u):\n",
@@ -107,7 +108,7 @@ test_modulo (gmp_randstate_t rands, const char *name,
 		     j, m->bit_size, name);
 	  continue;
 	}
-      m->invert (m, ai, a, scratch);
+      invert (m, ai, a, scratch);
       if (!ecc_mod_equal_p (m, ai, ref, scratch))
 	{
 	  fprintf (stderr, "%s->invert failed (test %u, bit size %u):\n",
@@ -133,6 +134,84 @@ test_modulo (gmp_randstate_t rands, const char *name,
   free (scratch);
 }
 
+/* Checks that ecc_mod_inv_batch gives canonical inverses, also for
+   the first element, which is not produced by
+   ecc_mod_mul_canonical. */
+static void
+test_batch (gmp_randstate_t rands, const char *name,
+	    const struct ecc_modulo *m, int use_redc)
+{
+  static const size_t counts[3] = { 1, 2, 5 };
+  mp_limb_t *a;
+  mp_limb_t *ai;
+  mp_limb_t *ref;
+  mp_limb_t *scratch;
+  unsigned j, k;
+  size_t i;
+  mpz_t r, mz, m2;
+
+  mpz_init (r);
+  mpz_init (m2);
+  mpz_roinit_n (mz, m->m, m->size);
+  mpz_mul_2exp (m2, mz, 1);
+
+  a = xalloc_limbs (5 * m->size);
+  ai = xalloc_limbs (5 * m->size);
+  ref = xalloc_limbs (m->size);
+  scratch = xalloc_limbs (2*m->size + m->invert_itch);
+
+  for (j = 0; j < COUNT; j++)
+    for (k = 0; k < 3; k++)
+      {
+	size_t n = counts[k];
+	for (i = 0; i < n; i++)
+	  {
+	    if (j & 1)
+	      mpz_rrandomb (r, rands, m->size * GMP_NUMB_BITS);
+	    else
+	      mpz_urandomb (r, rands, m->size * GMP_NUMB_BITS);
+	    /* Inputs must be less than 2m. */
+	    mpz_mod (r, r, m2);
+	    mpz_limbs_copy (a + i*m->size, r, m->size);
+	  }
+	/* Zero inputs must not spoil the other outputs. */
+	if (n > 2)
+	  mpn_zero (a + m->size, m->size);
+
+	ecc_mod_inv_batch (m, n, ai, a, m->size, scratch);
+
+	for (i = 0; i < n; i++)
+	  {
+	    if (!ref_modinv (ref, a + i*m->size, m->m, m->size, use_redc))
+	      mpn_zero (ref, m->size);
+
+	    if (mpn_cmp (ai + i*m->size, ref, m->size) != 0)
+	      {
+		fprintf (stderr, "ecc_mod_inv_batch %s failed "
+			 "(test %u, n = %u, i = %u, bit size %u):\n",
+			 name, j, (unsigned) n, (unsigned) i, m->bit_size);
+		fprintf (stderr, "a = ");
+		mpn_out_str (stderr, 16, a + i*m->size, m->size);
+		fprintf (stderr, "\np = ");
+		mpn_out_str (stderr, 16, m->m, m->size);
+		fprintf (stderr, "\nt = ");
+		mpn_out_str (stderr, 16, ai + i*m->size, m->size);
+		fprintf (stderr, " (bad)\nr = ");
+		mpn_out_str (stderr, 16, ref, m->size);
+		fprintf (stderr, "\n");
+		abort ();
+	      }
+	  }
+      }
+
+  mpz_clear (r);
+  mpz_clear (m2);
+  free (a);
+  free (ai);
+  free (ref);
+  free (scratch);
+}
+
 void
 test_main (void)
 {
@@ -144,8 +223,21 @@ test_main (void)
 
   for (i = 0; ecc_curves[i]; i++)
     {
-      test_modulo (rands, "p", &ecc_curves[i]->p, ecc_curves[i]->use_redc);
-      test_modulo (rands, "q", &ecc_curves[i]->q, 0);
+      const struct ecc_curve *ecc = ecc_curves[i];
+      test_modulo (rands, "p", &ecc->p, ecc->use_redc,
+		   ecc->p.invert, ecc->p.invert_itch);
+      test_modulo (rands, "q", &ecc->q, 0,
+		   ecc->q.invert, ecc->q.invert_itch);
+
+      /* Also check the safegcd inversion with all moduli, including
+	 those where it's not the default. */
+      test_modulo (rands, "p safegcd", &ecc->p, 0, ecc_mod_inv_safegcd,
+		   ECC_MOD_INV_SAFEGCD_ITCH (ecc->p.size));
+      test_modulo (rands, "q safegcd", &ecc->q, 0, ecc_mod_inv_safegcd,
+		   ECC_MOD_INV_SAFEGCD_ITCH (ecc->q.size));
+
+      test_batch (rands, "p", &ecc->p, ecc->use_redc);
+      test_batch (rands, "q", &ecc->q, 0);
     }
   gmp_randclear (rands);
 }
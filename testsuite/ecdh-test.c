@@ -128,6 +128,31 @@ test_dh (const char *name, const struct ecc_curve *ecc,
   ecc_point_mul (&T, &A_priv,  &T);
   check_point (name, "a (b g)", &T, &S);
 
+  /* Same products, computed in batches. */
+  {
+    struct ecc_point U, V;
+    struct ecc_point *r[2];
+    const struct ecc_scalar *n[2];
+    const struct ecc_point *p[2];
+
+    ecc_point_init (&U, ecc);
+    ecc_point_init (&V, ecc);
+    r[0] = &U; r[1] = &V;
+    n[0] = &A_priv; n[1] = &B_priv;
+
+    ecc_point_mul_g_batch (2, r, n);
+    check_point (name, "a g (batch)", &U, &A);
+    check_point (name, "b g (batch)", &V, &B);
+
+    p[0] = &B; p[1] = &A;
+    ecc_point_mul_batch (2, r, n, p);
+    check_point (name, "a (b g) (batch)", &U, &S);
+    check_point (name, "b (a g) (batch)", &V, &S);
+
+    ecc_point_clear (&U);
+    ecc_point_clear (&V);
+  }
+
   ecc_scalar_clear (&A_priv);
   ecc_scalar_clear (&B_priv);
 
@@ -1,4 +1,156 @@
 #include "testutils.h"
+#include "knuth-lfib.h"
+
+/* Checks a batch of the valid signature, followed by copies with r
+   and s modified, and the valid signature again. */
+static void
+test_ecdsa_batch (const struct ecc_point *pub,
+		  const struct tstring *h,
+		  const struct dsa_signature *signature)
+{
+  struct dsa_signature bad_r, bad_s;
+  const struct ecc_point *pubs[4];
+  const struct dsa_signature *signatures[4];
+  const uint8_t *digests[4];
+  size_t lengths[4];
+  int valid[4];
+  unsigned i;
+
+  dsa_signature_init (&bad_r);
+  dsa_signature_init (&bad_s);
+  mpz_set (bad_r.r, signature->r);
+  mpz_set (bad_r.s, signature->s);
+  mpz_combit (bad_r.r, 1);
+  mpz_set (bad_s.r, signature->r);
+  mpz_set (bad_s.s, signature->s);
+  mpz_combit (bad_s.s, 1);
+
+  signatures[0] = signatures[3] = signature;
+  signatures[1] = &bad_r;
+  signatures[2] = &bad_s;
+  for (i = 0; i < 4; i++)
+    {
+      pubs[i] = pub;
+      digests[i] = h->data;
+      lengths[i] = h->length;
+      valid[i] = -1;
+    }
+  ASSERT (ecdsa_verify_batch (1, pubs, lengths, digests, signatures, NULL));
+  ASSERT (!ecdsa_verify_batch (4, pubs, lengths, digests, signatures, NULL));
+  ASSERT (!ecdsa_verify_batch (4, pubs, lengths, digests, signatures, valid));
+  ASSERT (valid[0] == 1 && valid[1] == 0 && valid[2] == 0 && valid[3] == 1);
+
+  signatures[1] = signatures[2] = signature;
+  ASSERT (ecdsa_verify_batch (4, pubs, lengths, digests, signatures, valid));
+  ASSERT (valid[0] == 1 && valid[1] == 1 && valid[2] == 1 && valid[3] == 1);
+
+  dsa_signature_clear (&bad_r);
+  dsa_signature_clear (&bad_s);
+}
+
+/* Checks verification with a precomputed table for the public key. */
+static void
+test_ecdsa_table (const struct ecc_point *pub,
+		  struct tstring *h,
+		  struct dsa_signature *signature)
+{
+  const struct ecc_curve *ecc = pub->ecc;
+  struct ecdsa_public_table table;
+
+  ecdsa_public_table_init (&table, pub);
+  ASSERT (ecdsa_verify_table (&table, h->length, h->data, signature));
+
+  mpz_combit (signature->r, ecc->p.bit_size / 3);
+  ASSERT (!ecdsa_verify_table (&table, h->length, h->data, signature));
+  mpz_combit (signature->r, ecc->p.bit_size / 3);
+
+  mpz_combit (signature->s, 4*ecc->p.bit_size / 5);
+  ASSERT (!ecdsa_verify_table (&table, h->length, h->data, signature));
+  mpz_combit (signature->s, 4*ecc->p.bit_size / 5);
+
+  h->data[2*h->length / 3] ^= 0x40;
+  ASSERT (!ecdsa_verify_table (&table, h->length, h->data, signature));
+  h->data[2*h->length / 3] ^= 0x40;
+  ASSERT (ecdsa_verify_table (&table, h->length, h->data, signature));
+
+  ecdsa_public_table_clear (&table);
+}
+
+#define TABLE_RANDOM_COUNT 500
+
+/* Compares ecdsa_verify_table with ecdsa_verify, for public keys
+   that are small multiples of the generator, and random
+   signatures. With such keys, points from the public key table often
+   coincide with intermediate points, exercising the doubling and
+   infinity cases of the table additions. */
+static void
+test_ecdsa_table_random (const struct ecc_curve *ecc)
+{
+  struct knuth_lfib_ctx rctx;
+  struct ecc_scalar key;
+  struct ecc_point pub;
+  struct ecdsa_public_table table;
+  struct dsa_signature signature;
+  uint8_t digest[66];
+  size_t digest_length = (ecc->q.bit_size + 7) / 8;
+  mpz_t d, q;
+  unsigned k, i;
+
+  mpz_roinit_n (q, ecc->q.m, ecc->q.size);
+  ASSERT (digest_length <= sizeof(digest));
+
+  knuth_lfib_init (&rctx, 17);
+  ecc_scalar_init (&key, ecc);
+  ecc_point_init (&pub, ecc);
+  dsa_signature_init (&signature);
+  mpz_init (d);
+
+  for (k = 1; k <= 3; k++)
+    {
+      mpz_set_ui (d, k);
+      ecc_scalar_set (&key, d);
+      ecc_point_mul_g (&pub, &key);
+      ecdsa_public_table_init (&table, &pub);
+
+      for (i = 0; i < TABLE_RANDOM_COUNT; i++)
+	{
+	  int res;
+	  knuth_lfib_random (&rctx, digest_length, digest);
+	  if (i % 8 == 0)
+	    ecdsa_sign (&key, &rctx, (nettle_random_func *) knuth_lfib_random,
+			digest_length, digest, &signature);
+	  else
+	    {
+	      nettle_mpz_random (signature.r, &rctx,
+				 (nettle_random_func *) knuth_lfib_random,
+				 q);
+	      nettle_mpz_random (signature.s, &rctx,
+				 (nettle_random_func *) knuth_lfib_random,
+				 q);
+	    }
+	  res = ecdsa_verify (&pub, digest_length, digest, &signature);
+	  ASSERT (res == (i % 8 == 0));
+	  if (ecdsa_verify_table (&table, digest_length, digest, &signature)
+	      != res)
+	    {
+	      fprintf (stderr, "ecdsa_verify_table disagrees with ecdsa_verify,"
+		       " bit_size = %u, d = %u\nr = ", ecc->p.bit_size, k);
+	      mpz_out_str (stderr, 16, signature.r);
+	      fprintf (stderr, "\ns = ");
+	      mpz_out_str (stderr, 16, signature.s);
+	      fprintf (stderr, "\ndigest ");
+	      print_hex (digest_length, digest);
+	      abort ();
+	    }
+	}
+      ecdsa_public_table_clear (&table);
+    }
+
+  ecc_scalar_clear (&key);
+  ecc_point_clear (&pub);
+  dsa_signature_clear (&signature);
+  mpz_clear (d);
+}
 
 static void
 test_ecdsa (const struct ecc_curve *ecc,
@@ -72,12 +224,134 @@ test_ecdsa (const struct ecc_curve *ecc,
       goto fail;
     }
 
+  test_ecdsa_batch (&pub, h, &signature);
+  test_ecdsa_table (&pub, h, &signature);
+
   ecc_point_clear (&pub);
   dsa_signature_clear (&signature);
   mpz_clear (x);
   mpz_clear (y);  
 }
 
+/* Checks that signatures are rejected when R = u1 G + u2 Y is the
+   infinity point. With public key Y = d G, that happens for h = -r d
+   (mod q), for any s. Then the jacobian Z coordinate is zero, and
+   X = r Z^2 holds for every r, so the point must be rejected before
+   that comparison. */
+static void
+test_ecdsa_infinity (const struct ecc_curve *ecc)
+{
+  struct ecc_scalar key;
+  struct ecc_point pub;
+  struct dsa_signature signature;
+  const struct ecc_point *pubs[1];
+  const struct dsa_signature *signatures[1];
+  const uint8_t *digests[1];
+  size_t lengths[1];
+  uint8_t digest[66];
+  size_t digest_length = ecc->q.bit_size / 8;
+  mpz_t d, h, q;
+  unsigned k, i;
+
+  /* Digest must be exactly the bit size of q, so that h is used as
+     is. */
+  ASSERT (ecc->q.bit_size % 8 == 0);
+  ASSERT (digest_length <= sizeof(digest));
+
+  ecc_scalar_init (&key, ecc);
+  ecc_point_init (&pub, ecc);
+  dsa_signature_init (&signature);
+  mpz_init (d);
+  mpz_init (h);
+  mpz_roinit_n (q, ecc->q.m, ecc->q.size);
+
+  for (k = 1; k <= 3; k++)
+    {
+      mpz_set_ui (d, k);
+      ecc_scalar_set (&key, d);
+      ecc_point_mul_g (&pub, &key);
+
+      for (i = 1; i <= 5; i++)
+	{
+	  mpz_set_ui (signature.r, 0x1234567 * i);
+	  mpz_set_ui (signature.s, 0x89abcde + i);
+	  mpz_mul (h, signature.r, d);
+	  mpz_neg (h, h);
+	  mpz_mod (h, h, q);
+	  nettle_mpz_get_str_256 (digest_length, digest, h);
+
+	  ASSERT (!ecdsa_verify (&pub, digest_length, digest, &signature));
+
+	  pubs[0] = &pub;
+	  signatures[0] = &signature;
+	  digests[0] = digest;
+	  lengths[0] = digest_length;
+	  ASSERT (!ecdsa_verify_batch (1, pubs, lengths, digests,
+				       signatures, NULL));
+	}
+    }
+
+  ecc_scalar_clear (&key);
+  ecc_point_clear (&pub);
+  dsa_signature_clear (&signature);
+  mpz_clear (d);
+  mpz_clear (h);
+}
+
+/* Calls ecc_ecdsa_check_x directly with Z = 0. Both the canonical zero
+   and the non-canonical representation p must be rejected, for any r. As a control, the generator in jacobian
+   coordinates must match its own x coordinate. */
+static void
+test_ecdsa_check_x (const struct ecc_curve *ecc)
+{
+  mp_size_t size = ecc->p.size;
+  mp_limb_t *P = xalloc_limbs (3*size);
+  mp_limb_t *r = xalloc_limbs (size);
+  mp_limb_t *scratch = xalloc_limbs (6*size);
+  struct ecc_scalar one;
+  struct ecc_point g;
+  mpz_t t;
+  unsigned i;
+
+  ecc_scalar_init (&one, ecc);
+  ecc_point_init (&g, ecc);
+  mpz_init_set_ui (t, 1);
+  ecc_scalar_set (&one, t);
+  ecc_point_mul_g (&g, &one);
+
+  /* r = x(G) mod q */
+  mpn_copyi (r, g.p, size);
+  if (mpn_cmp (r, ecc->q.m, size) >= 0)
+    mpn_sub_n (r, r, ecc->q.m, size);
+
+  ecc_a_to_j (ecc, P, g.p);
+  ASSERT (ecc_ecdsa_check_x (ecc, P, r, scratch));
+
+  mpn_zero (P + 2*size, size);
+  ASSERT (!ecc_ecdsa_check_x (ecc, P, r, scratch));
+
+  for (i = 1; i <= 5; i++)
+    {
+      mpn_zero (r, size);
+      r[0] = 0x1234567 * i;
+
+      mpn_zero (P, 3*size);
+      ASSERT (!ecc_ecdsa_check_x (ecc, P, r, scratch));
+
+      /* X = Z = p, which is zero, but not in canonical form. */
+      mpn_copyi (P, ecc->p.m, size);
+      mpn_copyi (P + 2*size, ecc->p.m, size);
+      ASSERT (!ecc_ecdsa_check_x (ecc, P, r, scratch));
+    }
+
+  ecc_scalar_clear (&one);
+  ecc_point_clear (&g);
+  mpz_clear (t);
+  free (P);
+  free (r);
+  free (scratch);
+}
+
 void
 test_main (void)
 {
@@ -188,4 +462,17 @@ test_main (void)
 	      "97536710 1F67D1CF 9BCCBF2F 3D239534" 
 	      "FA509E70 AAC851AE 01AAC68D 62F86647"
 	      "2660"); /* s */
+
+  test_ecdsa_infinity (&_nettle_secp_224r1);
+  test_ecdsa_infinity (&_nettle_secp_256r1);
+  test_ecdsa_infinity (&_nettle_secp_384r1);
+
+  test_ecdsa_check_x (&_nettle_secp_192r1);
+  test_ecdsa_check_x (&_nettle_secp_224r1);
+  test_ecdsa_check_x (&_nettle_secp_256r1);
+  test_ecdsa_check_x (&_nettle_secp_384r1);
+  test_ecdsa_check_x (&_nettle_secp_521r1);
+
+  test_ecdsa_table_random (&_nettle_secp_224r1);
+  test_ecdsa_table_random (&_nettle_secp_521r1);
 }
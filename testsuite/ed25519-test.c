@@ -38,6 +38,7 @@
 #include "eddsa.h"
 
 #include "base16.h"
+#include "knuth-lfib.h"
 
 static void
 decode_hex (size_t length, uint8_t *dst, const char *src)
@@ -70,6 +71,8 @@ test_one (const char *line)
   uint8_t *msg;
   size_t msg_size;
   uint8_t s2[ED25519_SIGNATURE_SIZE];
+  mp_limb_t *scratch;
+  struct ed25519_public_table table;
 
   decode_hex (ED25519_KEY_SIZE, sk, line);
 
@@ -105,6 +108,19 @@ test_one (const char *line)
 
   ASSERT (ed25519_sha512_verify (pk, msg_size, msg, s));
 
+  scratch = xalloc_limbs (ecc_ed25519_sha512_sign_itch ());
+  ecc_ed25519_sha512_sign (pk, sk, msg_size, msg, s2, scratch);
+  mark_bytes_defined (ED25519_SIGNATURE_SIZE, s2);
+  ASSERT (MEMEQ (ED25519_SIGNATURE_SIZE, s, s2));
+  free (scratch);
+
+  scratch = xalloc_limbs (ecc_ed25519_sha512_verify_itch ());
+  ASSERT (ecc_ed25519_sha512_verify (pk, msg_size, msg, s, scratch));
+  free (scratch);
+
+  ASSERT (ed25519_sha512_public_table_init (&table, pk));
+  ASSERT (ed25519_sha512_verify_table (&table, msg_size, msg, s));
+
   s2[ED25519_SIGNATURE_SIZE/3] ^= 0x40;
   ASSERT (!ed25519_sha512_verify (pk, msg_size, msg, s2));
 
@@ -113,6 +129,9 @@ test_one (const char *line)
   ASSERT (!ed25519_sha512_verify (pk, msg_size, msg, s2));
 
   ASSERT (!ed25519_sha512_verify (pk, msg_size + 1, msg, s));
+  ASSERT (!ed25519_sha512_verify_table (&table, msg_size + 1, msg, s));
+  ASSERT (!ed25519_sha512_verify_table (&table, msg_size, msg, s2));
+  ed25519_sha512_public_table_clear (&table);
 
   if (msg_size > 0)
     {
@@ -122,6 +141,78 @@ test_one (const char *line)
   free (msg);
 }
 
+/* Signs n messages of varying length with different keys, and checks
+   batch verification, with a few of the signatures corrupted. */
+static void
+test_batch (size_t n)
+{
+  struct knuth_lfib_ctx rctx;
+  uint8_t *keys = xalloc (n * 2 * ED25519_KEY_SIZE);
+  uint8_t *sigs = xalloc (n * ED25519_SIGNATURE_SIZE);
+  uint8_t *data = xalloc (n);
+  const uint8_t **pub = xalloc (n * sizeof (*pub));
+  const uint8_t **msg = xalloc (n * sizeof (*msg));
+  const uint8_t **sig = xalloc (n * sizeof (*sig));
+  size_t *length = xalloc (n * sizeof (*length));
+  int *valid = xalloc (n * sizeof (*valid));
+  size_t i;
+
+  knuth_lfib_init (&rctx, 4711);
+  knuth_lfib_random (&rctx, n, data);
+
+  for (i = 0; i < n; i++)
+    {
+      uint8_t *priv = keys + 2*i*ED25519_KEY_SIZE;
+      uint8_t *pk = priv + ED25519_KEY_SIZE;
+      knuth_lfib_random (&rctx, ED25519_KEY_SIZE, priv);
+      ed25519_sha512_public_key (pk, priv);
+
+      pub[i] = pk;
+      msg[i] = data;
+      length[i] = i % (n + 1);
+      sig[i] = sigs + i*ED25519_SIGNATURE_SIZE;
+      ed25519_sha512_sign (pk, priv, length[i], msg[i],
+			   sigs + i*ED25519_SIGNATURE_SIZE);
+    }
+
+  memset (valid, 0, n * sizeof (*valid));
+  ASSERT (ed25519_sha512_verify_batch (n, pub, length, msg, sig,
+				       &rctx, (nettle_random_func *) knuth_lfib_random,
+				       valid));
+  for (i = 0; i < n; i++)
+    ASSERT (valid[i] == 1);
+  ASSERT (ed25519_sha512_verify_batch (n, pub, length, msg, sig,
+				       &rctx, (nettle_random_func *) knuth_lfib_random,
+				       NULL));
+  if (n < 3)
+    goto done;
+
+  /* Corrupt R of the first signature, s of the middle one, and the
+     message of the last one. */
+  sigs[3] ^= 0x10;
+  sigs[(n/2)*ED25519_SIGNATURE_SIZE + 40] ^= 0x01;
+  length[n-1]++;
+
+  ASSERT (!ed25519_sha512_verify_batch (n, pub, length, msg, sig,
+					&rctx, (nettle_random_func *) knuth_lfib_random,
+					NULL));
+  ASSERT (!ed25519_sha512_verify_batch (n, pub, length, msg, sig,
+					&rctx, (nettle_random_func *) knuth_lfib_random,
+					valid));
+  for (i = 0; i < n; i++)
+    ASSERT (valid[i] == (i != 0 && i != n/2 && i != n-1));
+
+ done:
+  free (keys);
+  free (sigs);
+  free (data);
+  free (pub);
+  free (msg);
+  free (sig);
+  free (length);
+  free (valid);
+}
+
 #ifndef HAVE_GETLINE
 static ssize_t
 getline(char **lineptr, size_t *n, FILE *f)
@@ -191,4 +282,8 @@ test_main(void)
       test_one ("c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025:fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025:af82:6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40aaf82:");
       test_one ("0d4a05b07352a5436e180356da0ae6efa0345ff7fb1572575772e8005ed978e9e61a185bcef2613a6c7cb79763ce945d3b245d76114dd440bcf5f2dc1aa57057:e61a185bcef2613a6c7cb79763ce945d3b245d76114dd440bcf5f2dc1aa57057:cbc77b:d9868d52c2bebce5f3fa5a79891970f309cb6591e3e1702a70276fa97c24b3a8e58606c38c9758529da50ee31b8219cba45271c689afa60b0ea26c99db19b00ccbc77b:");
     }
+  test_batch (1);
+  test_batch (5);
+  test_batch (64);
+  test_batch (200);
 }
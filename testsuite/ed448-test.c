@@ -71,6 +71,8 @@ test_one (const char *line)
   uint8_t *msg;
   size_t msg_size;
   uint8_t s2[ED448_SIGNATURE_SIZE];
+  mp_limb_t *scratch;
+  struct ed448_public_table table;
 
   decode_hex (ED448_KEY_SIZE, sk, line);
 
@@ -106,6 +108,19 @@ test_one (const char *line)
 
   ASSERT (ed448_shake256_verify (pk, msg_size, msg, s));
 
+  scratch = xalloc_limbs (ecc_ed448_shake256_sign_itch ());
+  ecc_ed448_shake256_sign (pk, sk, msg_size, msg, s2, scratch);
+  mark_bytes_defined (ED448_SIGNATURE_SIZE, s2);
+  ASSERT (MEMEQ (ED448_SIGNATURE_SIZE, s, s2));
+  free (scratch);
+
+  scratch = xalloc_limbs (ecc_ed448_shake256_verify_itch ());
+  ASSERT (ecc_ed448_shake256_verify (pk, msg_size, msg, s, scratch));
+  free (scratch);
+
+  ASSERT (ed448_shake256_public_table_init (&table, pk));
+  ASSERT (ed448_shake256_verify_table (&table, msg_size, msg, s));
+
   s2[ED448_SIGNATURE_SIZE/3] ^= 0x40;
   ASSERT (!ed448_shake256_verify (pk, msg_size, msg, s2));
 
@@ -114,6 +129,9 @@ test_one (const char *line)
   ASSERT (!ed448_shake256_verify (pk, msg_size, msg, s2));
 
   ASSERT (!ed448_shake256_verify (pk, msg_size + 1, msg, s));
+  ASSERT (!ed448_shake256_verify_table (&table, msg_size + 1, msg, s));
+  ASSERT (!ed448_shake256_verify_table (&table, msg_size, msg, s2));
+  ed448_shake256_public_table_clear (&table);
 
   if (msg_size > 0)
     {
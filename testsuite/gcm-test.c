@@ -2,6 +2,7 @@
 #include "nettle-internal.h"
 #include "gcm.h"
 #include "ghash-internal.h"
+#include "knuth-lfib.h"
 
 static void
 test_gcm_hash (const struct tstring *msg, const struct tstring *ref)
@@ -79,6 +80,94 @@ gcm_aes128_set_iv_hack (struct gcm_aes128_ctx *ctx, size_t size, const uint8_t *
   memcpy (ctx->gcm.ctr.b + 12, iv + 12, 4);
 }
 
+#define GCM_BULK_MAX 1100
+
+/* Compares the gcm_aes* functions, which may use combined aes and
+   ghash code, to the general gcm functions, for a range of message
+   sizes, with the data split across two calls. If wrap is non-zero,
+   the low 32 bits of the counter wrap around during processing. */
+static void
+test_gcm_bulk (const struct nettle_aead *aead,
+	       const struct nettle_cipher *cipher, int wrap)
+{
+  static const uint8_t wrap_ctr[4] = { 0xff, 0xff, 0xff, 0xf3 };
+  struct knuth_lfib_ctx lfib;
+  void *ctx = xalloc (aead->context_size);
+  void *cipher_ctx = xalloc (cipher->context_size);
+  struct gcm_key ref_key;
+  struct gcm_ctx ref;
+  uint8_t key[AES256_KEY_SIZE];
+  uint8_t iv[GCM_IV_SIZE];
+  uint8_t digest[GCM_DIGEST_SIZE];
+  uint8_t ref_digest[GCM_DIGEST_SIZE];
+  uint8_t *msg = xalloc (GCM_BULK_MAX);
+  uint8_t *ciphertext = xalloc (GCM_BULK_MAX);
+  uint8_t *ref_ciphertext = xalloc (GCM_BULK_MAX);
+  uint8_t *cleartext = xalloc (GCM_BULK_MAX);
+  size_t length;
+
+  knuth_lfib_init (&lfib, 4711);
+  knuth_lfib_random (&lfib, cipher->key_size, key);
+  knuth_lfib_random (&lfib, sizeof(iv), iv);
+  knuth_lfib_random (&lfib, GCM_BULK_MAX, msg);
+
+  aead->set_encrypt_key (ctx, key);
+  cipher->set_encrypt_key (cipher_ctx, key);
+  gcm_set_key (&ref_key, cipher_ctx, cipher->encrypt);
+
+  for (length = 0; length <= GCM_BULK_MAX; length += 23)
+    {
+      size_t split = (length / 3) & -GCM_BLOCK_SIZE;
+
+      aead->set_nonce (ctx, iv);
+      gcm_set_iv (&ref, &ref_key, sizeof(iv), iv);
+      if (wrap)
+	{
+	  memcpy (((struct gcm_aes128_ctx *) ctx)->gcm.ctr.b + 12, wrap_ctr, 4);
+	  memcpy (ref.ctr.b + 12, wrap_ctr, 4);
+	}
+      aead->encrypt (ctx, split, ciphertext, msg);
+      aead->encrypt (ctx, length - split, ciphertext + split, msg + split);
+      aead->digest (ctx, digest);
+
+      gcm_encrypt (&ref, &ref_key, cipher_ctx, cipher->encrypt,
+		   length, ref_ciphertext, msg);
+      gcm_digest (&ref, &ref_key, cipher_ctx, cipher->encrypt, ref_digest);
+
+      if (!MEMEQ (length, ciphertext, ref_ciphertext)
+	  || !MEMEQ (sizeof(digest), digest, ref_digest))
+	{
+	  fprintf (stderr, "%s bulk encrypt failed, length %u, split %u\n",
+		   aead->name, (unsigned) length, (unsigned) split);
+	  FAIL ();
+	}
+
+      aead->set_nonce (ctx, iv);
+      if (wrap)
+	memcpy (((struct gcm_aes128_ctx *) ctx)->gcm.ctr.b + 12, wrap_ctr, 4);
+      /* Split differently for decryption. */
+      split = (length - split) & -GCM_BLOCK_SIZE;
+      aead->decrypt (ctx, split, cleartext, ciphertext);
+      aead->decrypt (ctx, length - split, cleartext + split,
+		     ciphertext + split);
+      aead->digest (ctx, digest);
+
+      if (!MEMEQ (length, cleartext, msg)
+	  || !MEMEQ (sizeof(digest), digest, ref_digest))
+	{
+	  fprintf (stderr, "%s bulk decrypt failed, length %u, split %u\n",
+		   aead->name, (unsigned) length, (unsigned) split);
+	  FAIL ();
+	}
+    }
+  free (ctx);
+  free (cipher_ctx);
+  free (msg);
+  free (ciphertext);
+  free (ref_ciphertext);
+  free (cleartext);
+}
+
 void
 test_main(void)
 {
@@ -887,4 +976,9 @@ test_main(void)
 		      SHEX("0000000000000000 0000000000000000"),
 		      SHEX("0011223344556677 89abcdef01234567"),
 		      SHEX("1503b3c4a3c44c3a 800f1ff13ff0e00f"));
+
+  test_gcm_bulk (&nettle_gcm_aes128, &nettle_aes128, 0);
+  test_gcm_bulk (&nettle_gcm_aes192, &nettle_aes192, 0);
+  test_gcm_bulk (&nettle_gcm_aes256, &nettle_aes256, 0);
+  test_gcm_bulk (&nettle_gcm_aes128, &nettle_aes128, 1);
 }
@@ -1,5 +1,6 @@
 #include "testutils.h"
 #include "non-nettle.h"
+#include "knuth-lfib.h"
 
 struct ocb_aes128_message_key
 {
@@ -52,6 +53,74 @@ ocb_aes128_message = {
   (nettle_decrypt_message_func*) ocb_aes128_decrypt_message_wrapper,
 };
 
+/* Check ocb_aes128_encrypt and ocb_aes128_decrypt, which may use an
+   optimized implementation processing several blocks at a time,
+   against the general ocb functions, for messages processed in
+   pieces of varying size. */
+#define OCB_LONG_BLOCKS 300
+
+static void
+test_ocb_aes128_long (void)
+{
+  struct knuth_lfib_ctx random;
+  struct ocb_aes128_encrypt_key key;
+  struct aes128_ctx decrypt;
+  struct ocb_ctx ctx, ref;
+  uint8_t aes_key[AES128_KEY_SIZE];
+  uint8_t nonce[OCB_NONCE_SIZE];
+  uint8_t clear[OCB_LONG_BLOCKS * OCB_BLOCK_SIZE + 5];
+  uint8_t cipher[OCB_LONG_BLOCKS * OCB_BLOCK_SIZE + 5];
+  uint8_t data[OCB_LONG_BLOCKS * OCB_BLOCK_SIZE + 5];
+  uint8_t digest[OCB_DIGEST_SIZE];
+  uint8_t ref_digest[OCB_DIGEST_SIZE];
+  unsigned step;
+
+  knuth_lfib_init (&random, 4711);
+  knuth_lfib_random (&random, sizeof(aes_key), aes_key);
+  knuth_lfib_random (&random, sizeof(nonce), nonce);
+  knuth_lfib_random (&random, sizeof(clear), clear);
+
+  ocb_aes128_set_decrypt_key (&key, &decrypt, aes_key);
+
+  ocb_set_nonce (&ref, &key.encrypt, (nettle_cipher_func *) aes128_encrypt,
+		 OCB_DIGEST_SIZE, sizeof(nonce), nonce);
+  ocb_encrypt (&ref, &key.ocb, &key.encrypt,
+	       (nettle_cipher_func *) aes128_encrypt,
+	       sizeof(clear), cipher, clear);
+  ocb_digest (&ref, &key.ocb, &key.encrypt,
+	      (nettle_cipher_func *) aes128_encrypt, ref_digest);
+
+  for (step = 1; step <= 37; step += 4)
+    {
+      size_t done, size;
+
+      ocb_aes128_set_nonce (&ctx, &key, OCB_DIGEST_SIZE, sizeof(nonce), nonce);
+      for (done = 0; done < sizeof(clear); done += size)
+	{
+	  size = step * OCB_BLOCK_SIZE;
+	  if (size > sizeof(clear) - done)
+	    size = sizeof(clear) - done;
+	  ocb_aes128_encrypt (&ctx, &key, size, data + done, clear + done);
+	}
+      ocb_aes128_digest (&ctx, &key, digest);
+      ASSERT (MEMEQ (sizeof(cipher), data, cipher));
+      ASSERT (MEMEQ (OCB_DIGEST_SIZE, digest, ref_digest));
+
+      /* Decrypt in place */
+      ocb_aes128_set_nonce (&ctx, &key, OCB_DIGEST_SIZE, sizeof(nonce), nonce);
+      for (done = 0; done < sizeof(clear); done += size)
+	{
+	  size = step * OCB_BLOCK_SIZE;
+	  if (size > sizeof(clear) - done)
+	    size = sizeof(clear) - done;
+	  ocb_aes128_decrypt (&ctx, &key, &decrypt, size, data + done, data + done);
+	}
+      ocb_aes128_digest (&ctx, &key, digest);
+      ASSERT (MEMEQ (sizeof(clear), data, clear));
+      ASSERT (MEMEQ (OCB_DIGEST_SIZE, digest, ref_digest));
+    }
+}
+
 void
 test_main(void)
 {
@@ -289,6 +358,36 @@ test_main(void)
 	    SHEX("0001020304050607"), /* plaintext */
 	    SHEX("6820B3657B6F615A5725BDA0D3B4EB3A257C9AF1F8F03009")); /* ciphertext */
 
+  test_aead_message(&ocb_aes128_message,
+	    SHEX("000102030405060708090A0B0C0D0E0F"), /* key */
+	    SHEX("BBAA9988776655443322110F"), /* nonce */
+	    SHEX(""), /* auth data */
+	    SHEX("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+		 "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+		 "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+		 "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+		 "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+		 "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+		 "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+		 "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"), /* plaintext */
+	    SHEX("4412923493c57d5d e0d700f753cce0d1"
+		 "d2d95060122e9f15 a5ddbfc5787e50b5"
+		 "11dfb888da244711 f051dbce82b0b9a7"
+		 "cb14869b164e55eb 578e41fa435ff220"
+		 "25ed114f6ec18cd6 7b743ab299e596f6"
+		 "6100fba539db164d 765eaff0bf489ace"
+		 "90ff6af96d1c395b 8dd586b154a0ecea"
+		 "504395c5592cf2f0 03a3878585a0bfd3"
+		 "b4039d15bc47a6d6 4a51f7302a976bb0"
+		 "175167bcb5d8f071 a3faff70544ab2ba"
+		 "52947d35d6e545e9 bda57b3972ecad10"
+		 "f0e85aec389f4276 2e58978918d4c285"
+		 "c2088ca8ac48095c 976065aa47766756"
+		 "7a507bab08315b2e 36327e8103a6a70d"
+		 "7f9f5318684697b2 bf95d65fa5458e6e"
+		 "f40a974cb940e8fd 63baf0ce96773279"
+		 "3aa4f4e4b4ff142c 9357291589fa25d8")); /* ciphertext */
+
   /* Test-vector from libgcrypt:tests/basic.c: */
   test_aead(&nettle_ocb_aes128_t96, NULL,
 	   SHEX("0F0E0D0C0B0A09080706050403020100"), /* key */
@@ -393,4 +492,6 @@ test_main(void)
 		"140452dc850989f6762e3578bbb04be3"), /* ciphertext */
 	   SHEX("BBAA9988776655443322110D"), /* nonce */
 	   SHEX("1a237c599c4649f4e586b2de")); /* tag */
+
+  test_ocb_aes128_long ();
 }
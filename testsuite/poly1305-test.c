@@ -218,6 +218,90 @@ test_random(void)
     }
 }
 
+/* Like poly1305_internal, but passing the message to
+   _nettle_poly1305_update in two pieces, to exercise any multi-block
+   code. */
+static void
+poly1305_update_internal (const uint8_t key[16],
+			  size_t length, const uint8_t *message,
+			  size_t split, union nettle_block16 *nonce)
+{
+  struct poly1305_ctx ctx;
+  uint8_t block[16];
+  unsigned index;
+
+  _nettle_poly1305_set_key (&ctx, key);
+  index = _nettle_poly1305_update (&ctx, block, 0, split, message);
+  index = _nettle_poly1305_update (&ctx, block, index,
+				   length - split, message + split);
+  if (index > 0)
+    {
+      block[index] = 1;
+      memset (block + index + 1, 0, sizeof(block) - 1 - index);
+      _nettle_poly1305_block (&ctx, block, 0);
+    }
+  _nettle_poly1305_digest (&ctx, nonce);
+}
+
+#define LONG_COUNT 300
+#define MAX_LONG_MESSAGE_SIZE 2200
+
+static void
+test_random_long(void)
+{
+  struct knuth_lfib_ctx rand_ctx;
+  uint8_t message[MAX_LONG_MESSAGE_SIZE];
+  unsigned j;
+
+  knuth_lfib_init (&rand_ctx, 4711);
+  for (j = 0; j < LONG_COUNT; j++)
+    {
+      uint8_t key[16];
+      uint8_t nonce[16];
+      size_t length;
+      size_t split;
+      union nettle_block16 ref;
+      union nettle_block16 digest;
+
+      knuth_lfib_random (&rand_ctx, sizeof(key), key);
+      knuth_lfib_random (&rand_ctx, sizeof(nonce), nonce);
+
+      knuth_lfib_random (&rand_ctx, sizeof(length), (uint8_t *) &length);
+      length %= MAX_LONG_MESSAGE_SIZE + 1;
+      knuth_lfib_random (&rand_ctx, sizeof(split), (uint8_t *) &split);
+      split %= length + 1;
+
+      /* Use some messages and keys with all bits set, to get
+	 maximum size of intermediate values. */
+      if (j % 3 == 0)
+	{
+	  memset (message, 0xff, length);
+	  if (j % 2 == 0)
+	    memset (key, 0xff, sizeof(key));
+	}
+      else
+	knuth_lfib_random (&rand_ctx, length, message);
+
+      memcpy (ref.b, nonce, sizeof(ref.b));
+      ref_poly1305_internal (key, length, message, &ref);
+
+      memcpy (digest.b, nonce, sizeof(digest.b));
+      poly1305_update_internal (key, length, message, split, &digest);
+
+      if (!MEMEQ (sizeof(digest.b), digest.b, ref.b))
+	{
+	  printf ("poly1305 update failed\n");
+	  printf ("key: "); print_hex (16, key);
+	  printf ("nonce: "); print_hex (16, nonce);
+	  printf ("length: %u, split: %u\n",
+		  (unsigned) length, (unsigned) split);
+	  printf ("tag: "); print_hex (16, digest.b);
+	  printf ("ref: "); print_hex (16, ref.b);
+	  abort();
+	}
+    }
+}
+
 void
 test_main(void)
 {
@@ -252,4 +336,5 @@ test_main(void)
 
   test_fixed();
   test_random();
+  test_random_long();
 }
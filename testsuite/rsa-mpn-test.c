@@ -0,0 +1,120 @@
+#include "testutils.h"
+
+#include "knuth-lfib.h"
+
+static void
+test_mpn(const struct rsa_public_key *pub,
+	 const struct rsa_private_key *key)
+{
+  struct knuth_lfib_ctx lfib;
+  mp_size_t nn = mpz_size(pub->n);
+  mp_size_t itch = rsa_mpn_itch(pub, key);
+  mp_size_t verify_itch = rsa_mpn_itch(pub, NULL);
+  mp_limb_t *scratch = xalloc_limbs(itch);
+  mp_limb_t *verify_scratch = xalloc_limbs(verify_itch);
+  mp_limb_t *sp = xalloc_limbs(nn);
+  mp_limb_t *cp = xalloc_limbs(nn);
+  uint8_t digest_info[30];
+  uint8_t message[20];
+  uint8_t decrypted[20];
+  mpz_t s, expected, c;
+  unsigned i;
+
+  mpz_init(s);
+  mpz_init(expected);
+  mpz_init(c);
+  knuth_lfib_init(&lfib, 17);
+
+  ASSERT(verify_itch <= itch);
+
+  for (i = 0; i < 10; i++)
+    {
+      knuth_lfib_random(&lfib, sizeof(digest_info), digest_info);
+
+      ASSERT(rsa_pkcs1_sign(key, sizeof(digest_info), digest_info, expected));
+      ASSERT(rsa_mpn_pkcs1_sign_tr(pub, key, &lfib,
+				   (nettle_random_func *) knuth_lfib_random,
+				   sizeof(digest_info), digest_info,
+				   sp, scratch));
+      ASSERT(mpz_cmp(mpz_roinit_n(s, sp, nn), expected) == 0);
+
+      ASSERT(rsa_mpn_pkcs1_verify(pub, sizeof(digest_info), digest_info,
+				  sp, verify_scratch));
+
+      /* Bad signatures */
+      sp[0] ^= 2;
+      ASSERT(!rsa_mpn_pkcs1_verify(pub, sizeof(digest_info), digest_info,
+				   sp, verify_scratch));
+      sp[0] ^= 2;
+      digest_info[i % sizeof(digest_info)] ^= 1;
+      ASSERT(!rsa_mpn_pkcs1_verify(pub, sizeof(digest_info), digest_info,
+				   sp, verify_scratch));
+
+      knuth_lfib_random(&lfib, sizeof(message), message);
+      ASSERT(rsa_encrypt(pub, &lfib, (nettle_random_func *) knuth_lfib_random,
+			 sizeof(message), message, c));
+      mpz_limbs_copy(cp, c, nn);
+      ASSERT(rsa_mpn_sec_decrypt(pub, key, &lfib,
+				 (nettle_random_func *) knuth_lfib_random,
+				 sizeof(decrypted), decrypted, cp, scratch));
+      ASSERT(MEMEQ(sizeof(message), message, decrypted));
+
+      /* Wrong length */
+      ASSERT(!rsa_mpn_sec_decrypt(pub, key, &lfib,
+				  (nettle_random_func *) knuth_lfib_random,
+				  sizeof(decrypted) - 1, decrypted, cp, scratch));
+    }
+
+  /* Out of range */
+  mpz_limbs_copy(sp, pub->n, nn);
+  ASSERT(!rsa_mpn_pkcs1_verify(pub, sizeof(digest_info), digest_info,
+			       sp, verify_scratch));
+  ASSERT(!rsa_mpn_sec_decrypt(pub, key, &lfib,
+			      (nettle_random_func *) knuth_lfib_random,
+			      sizeof(decrypted), decrypted, sp, scratch));
+  mpn_zero(sp, nn);
+  ASSERT(!rsa_mpn_pkcs1_verify(pub, sizeof(digest_info), digest_info,
+			       sp, verify_scratch));
+
+  /* Too long digest_info */
+  ASSERT(!rsa_mpn_pkcs1_sign_tr(pub, key, &lfib,
+				(nettle_random_func *) knuth_lfib_random,
+				key->size, (const uint8_t *) "", sp, scratch));
+  ASSERT(mpn_zero_p(sp, nn));
+
+  free(scratch);
+  free(verify_scratch);
+  free(sp);
+  free(cp);
+  mpz_clear(s);
+  mpz_clear(expected);
+  mpz_clear(c);
+}
+
+void
+test_main(void)
+{
+  struct rsa_public_key pub;
+  struct rsa_private_key key;
+  struct knuth_lfib_ctx lfib;
+
+  rsa_private_key_init(&key);
+  rsa_public_key_init(&pub);
+
+  test_rsa_set_key_1(&pub, &key);
+  test_mpn(&pub, &key);
+
+  test_rsa_set_key_2(&pub, &key);
+  test_mpn(&pub, &key);
+
+  /* Public exponent 3 */
+  knuth_lfib_init(&lfib, 11);
+  mpz_set_ui(pub.e, 3);
+  ASSERT(rsa_generate_keypair(&pub, &key, &lfib,
+			      (nettle_random_func *) knuth_lfib_random,
+			      NULL, NULL, 777, 0));
+  test_mpn(&pub, &key);
+
+  rsa_private_key_clear(&key);
+  rsa_public_key_clear(&pub);
+}
@@ -0,0 +1,182 @@
+#include "testutils.h"
+
+#include "knuth-lfib.h"
+#include "buffer.h"
+#include "sexp.h"
+
+static void
+test_multi_key(const struct rsa_public_key *pub,
+	       const struct rsa_multi_private_key *key)
+{
+  struct knuth_lfib_ctx lfib;
+  mpz_t m, x, expected;
+  uint8_t decrypted[20];
+  unsigned i;
+
+  mpz_init(m);
+  mpz_init(x);
+  mpz_init(expected);
+
+  knuth_lfib_init(&lfib, 17);
+
+  ASSERT(key->key.size == pub->size);
+
+  for (i = 0; i < 20; i++)
+    {
+      nettle_mpz_random(m, &lfib, (nettle_random_func *) knuth_lfib_random,
+			pub->n);
+      ASSERT(rsa_multi_compute_root_tr(pub, key, &lfib,
+				       (nettle_random_func *) knuth_lfib_random,
+				       x, m));
+      mpz_powm(expected, m, key->key.d, pub->n);
+      ASSERT(mpz_cmp(x, expected) == 0);
+    }
+
+  ASSERT(rsa_multi_pkcs1_sign_tr(pub, key, &lfib,
+				 (nettle_random_func *) knuth_lfib_random,
+				 LDATA("not really a digest info"), x));
+  ASSERT(rsa_pkcs1_verify(pub, LDATA("not really a digest info"), x));
+  ASSERT(!rsa_pkcs1_verify(pub, LDATA("not really a digest inf0"), x));
+
+  ASSERT(rsa_encrypt(pub, &lfib, (nettle_random_func *) knuth_lfib_random,
+		     LDATA("squeamish ossifrage"), m));
+  ASSERT(rsa_multi_sec_decrypt(pub, key, &lfib,
+			       (nettle_random_func *) knuth_lfib_random,
+			       19, decrypted, m));
+  ASSERT(MEMEQ(19, decrypted, "squeamish ossifrage"));
+
+  mpz_clear(m);
+  mpz_clear(x);
+  mpz_clear(expected);
+}
+
+/* Converts the key to sexp form, and reads it back. */
+static void
+test_multi_sexp(const struct rsa_public_key *pub,
+		const struct rsa_multi_private_key *key)
+{
+  struct rsa_public_key pub2;
+  struct rsa_multi_private_key key2;
+  static const char * const names[] = { "r3", "d3", "t3", "r4", "d4", "t4" };
+  struct nettle_buffer buffer;
+  unsigned i;
+
+  rsa_public_key_init(&pub2);
+  rsa_multi_private_key_init(&key2);
+  nettle_buffer_init(&buffer);
+
+  ASSERT(sexp_format(&buffer, "%(private-key%(rsa(n%b)(e%b)(d%b)(p%b)(q%b)"
+		     "(a%b)(b%b)(c%b)",
+		     pub->n, pub->e, key->key.d, key->key.p, key->key.q,
+		     key->key.a, key->key.b, key->key.c));
+  for (i = 0; i < key->nprimes - 2; i++)
+    ASSERT(sexp_format(&buffer, "(%0s%b)(%0s%b)(%0s%b)",
+		       names[3*i], key->r[i], names[3*i+1], key->d[i],
+		       names[3*i+2], key->t[i]));
+  ASSERT(sexp_format(&buffer, "%)%)"));
+
+  ASSERT(rsa_multi_keypair_from_sexp(&pub2, &key2, 0,
+				     buffer.size, buffer.contents));
+  ASSERT(key2.nprimes == key->nprimes);
+  ASSERT(mpz_cmp(pub2.n, pub->n) == 0);
+  for (i = 0; i < key->nprimes - 2; i++)
+    ASSERT(mpz_cmp(key2.r[i], key->r[i]) == 0);
+
+  test_multi_key(&pub2, &key2);
+
+  nettle_buffer_clear(&buffer);
+  rsa_public_key_clear(&pub2);
+  rsa_multi_private_key_clear(&key2);
+}
+
+void
+test_main(void)
+{
+  struct rsa_public_key pub;
+  struct rsa_multi_private_key key;
+  struct knuth_lfib_ctx lfib;
+  const struct tstring *der;
+  unsigned nprimes;
+
+  rsa_public_key_init(&pub);
+  rsa_multi_private_key_init(&key);
+
+  /* A 1024-bit key with three primes, generated by openssl. */
+  der = SHEX(
+	"3082027d0201010281810099091681cf"
+	"096b9f9be3f1d24c1d0eb3af181fbca4"
+	"bcf924cedd73e32b2f4870b1eba7b657"
+	"3e6378fbacd91e4d936f263bd543f776"
+	"449a27c13a5dcbd59c68fbf1fd3b5c72"
+	"0684ea8b050c91a13f820e646f9ec5df"
+	"94a258017ef14a2c95b52e36458f5731"
+	"bfc3a7b3bd5507f7dd600ceaef2799a5"
+	"fa3703a892425820d318530203010001"
+	"028180655880603cc4c7522f01b89e85"
+	"2b651617a98932fb81ee18b32a32d9c9"
+	"3a89e59fde28f5f736e8d7310c904c6d"
+	"908fab921a2e856f2f4073bc464c5972"
+	"4c39a109910370806a38e52725b45f8c"
+	"653880cadbc38c5e00a8b9de9a139a05"
+	"c4cc63363abce0a32e25be578e756d29"
+	"1d606c914302514468538a8e5fddbb3f"
+	"fea429022b381392762a58148b72efa0"
+	"25f09a8826d6b309fbc94311ab8a0ca7"
+	"7378b1dc2d5dd5bf17cb52c5ddc13853"
+	"022b1929e42698ce9e05c773ec1582d6"
+	"ff5b28c3076aefed5ca3fcb77781f813"
+	"944b2c75df85ee157352ed8543022b14"
+	"cebe63f66664893206d487ff7577dbe1"
+	"82e1cb79ecd71badc7f0429aa074b0a8"
+	"c6ed7768ccb7fb06fd5d022b0acfa9bb"
+	"3f79be00e3a19573e483f4b038c21a24"
+	"c2b26b53f556e9dc8835f94796f189b8"
+	"6403094a3ecc3b022b017ae9c7dc3f2d"
+	"aa48258df6fe165fca63aaa2754f5c60"
+	"59eca470ef29fe49ad3eb6682adfa233"
+	"f0d4996b30818a308187022b1bc38564"
+	"73490371f985b0d36fd9045c781a33de"
+	"67c4da03a5fce2e92127e337bd5b91a2"
+	"6f0628bc070f6b022b05d9604df457ca"
+	"8905879be43fa919d91d586fdb084399"
+	"a6b11ea0f37a8fbbb7ef85ce1dc98423"
+	"aad155f7022b0f3c824dc110c771954d"
+	"934a89159cc52750b8bdce604a84a327"
+	"1cbb3e568896f355c1a7213e5022f0c7"
+	"ef");
+  ASSERT(rsa_multi_keypair_from_der(&pub, &key, 0, der->length, der->data));
+  ASSERT(key.nprimes == 3);
+  ASSERT(mpz_sizeinbase(pub.n, 2) == 1024);
+  test_multi_key(&pub, &key);
+
+  /* Truncated otherPrimeInfos */
+  ASSERT(!rsa_multi_keypair_from_der(&pub, &key, 0, der->length - 45, der->data));
+
+  knuth_lfib_init(&lfib, 13);
+  mpz_set_ui(pub.e, 65537);
+
+  for (nprimes = 2; nprimes <= RSA_MAX_PRIMES; nprimes++)
+    {
+      ASSERT(rsa_multi_generate_keypair(&pub, &key, &lfib,
+					(nettle_random_func *) knuth_lfib_random,
+					NULL, NULL, 1000 + nprimes, 0, nprimes));
+      ASSERT(key.nprimes == nprimes);
+      ASSERT(mpz_sizeinbase(pub.n, 2) == 1000 + nprimes);
+      test_multi_key(&pub, &key);
+      test_multi_sexp(&pub, &key);
+    }
+
+  /* Random e */
+  ASSERT(rsa_multi_generate_keypair(&pub, &key, &lfib,
+				    (nettle_random_func *) knuth_lfib_random,
+				    NULL, NULL, 1536, 40, 3));
+  ASSERT(mpz_sizeinbase(pub.e, 2) == 40);
+  test_multi_key(&pub, &key);
+
+  ASSERT(!rsa_multi_generate_keypair(&pub, &key, &lfib,
+				     (nettle_random_func *) knuth_lfib_random,
+				     NULL, NULL, 1024, 0, RSA_MAX_PRIMES + 1));
+
+  rsa_public_key_clear(&pub);
+  rsa_multi_private_key_clear(&key);
+}
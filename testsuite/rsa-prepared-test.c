@@ -0,0 +1,93 @@
+#include "testutils.h"
+
+#include "knuth-lfib.h"
+
+static void
+test_prepared(const struct rsa_public_key *pub,
+	      const struct rsa_private_key *key)
+{
+  struct rsa_prepared_key prep;
+  struct rsa_prepared_key verify_only;
+  struct knuth_lfib_ctx lfib;
+  uint8_t digest_info[30];
+  mpz_t s, expected;
+  unsigned i;
+
+  mpz_init(s);
+  mpz_init(expected);
+  knuth_lfib_init(&lfib, 17);
+
+  ASSERT(rsa_prepared_key_init(&prep, pub, key));
+  ASSERT(rsa_prepared_key_init(&verify_only, pub, NULL));
+
+  /* Enough signatures to regenerate the blinding factors a few
+     times. */
+  for (i = 0; i < 3 * RSA_PREPARED_BLIND_UPDATES + 5; i++)
+    {
+      knuth_lfib_random(&lfib, sizeof(digest_info), digest_info);
+
+      ASSERT(rsa_pkcs1_sign(key, sizeof(digest_info), digest_info, expected));
+      ASSERT(rsa_prepared_pkcs1_sign_tr(&prep, &lfib,
+					(nettle_random_func *) knuth_lfib_random,
+					sizeof(digest_info), digest_info, s));
+      ASSERT(mpz_cmp(s, expected) == 0);
+
+      ASSERT(rsa_prepared_pkcs1_verify(&prep, sizeof(digest_info),
+				       digest_info, s));
+      ASSERT(rsa_prepared_pkcs1_verify(&verify_only, sizeof(digest_info),
+				       digest_info, s));
+
+      /* Bad signatures */
+      mpz_add_ui(s, s, 1);
+      ASSERT(!rsa_prepared_pkcs1_verify(&verify_only, sizeof(digest_info),
+					digest_info, s));
+      digest_info[i % sizeof(digest_info)] ^= 1;
+      ASSERT(!rsa_prepared_pkcs1_verify(&verify_only, sizeof(digest_info),
+					digest_info, expected));
+    }
+
+  /* Out of range */
+  ASSERT(!rsa_prepared_pkcs1_verify(&verify_only, sizeof(digest_info),
+				    digest_info, pub->n));
+  mpz_set_ui(s, 0);
+  ASSERT(!rsa_prepared_pkcs1_verify(&verify_only, sizeof(digest_info),
+				    digest_info, s));
+
+  /* Can't sign without a private key. */
+  ASSERT(!rsa_prepared_pkcs1_sign_tr(&verify_only, &lfib,
+				     (nettle_random_func *) knuth_lfib_random,
+				     sizeof(digest_info), digest_info, s));
+
+  rsa_prepared_key_clear(&prep);
+  rsa_prepared_key_clear(&verify_only);
+  mpz_clear(s);
+  mpz_clear(expected);
+}
+
+void
+test_main(void)
+{
+  struct rsa_public_key pub;
+  struct rsa_private_key key;
+  struct knuth_lfib_ctx lfib;
+
+  rsa_private_key_init(&key);
+  rsa_public_key_init(&pub);
+
+  test_rsa_set_key_1(&pub, &key);
+  test_prepared(&pub, &key);
+
+  test_rsa_set_key_2(&pub, &key);
+  test_prepared(&pub, &key);
+
+  /* Public exponent 3 */
+  knuth_lfib_init(&lfib, 11);
+  mpz_set_ui(pub.e, 3);
+  ASSERT(rsa_generate_keypair(&pub, &key, &lfib,
+			      (nettle_random_func *) knuth_lfib_random,
+			      NULL, NULL, 777, 0));
+  test_prepared(&pub, &key);
+
+  rsa_private_key_clear(&key);
+  rsa_public_key_clear(&pub);
+}
@@ -84,6 +84,8 @@ test_main(void)
   /* Additional test vector, from Daniel Kahn Gillmor */
   test_hash(&nettle_sha1, SDATA("38"),
 	    SHEX("5b384ce32d8cdef02bc3a139d4cac0a22bb029e8"));
+
+  test_hash_many(&nettle_sha1, sha1_digest_many);
 }
 
 /* These are intermediate values for the single sha1_compress call
@@ -102,6 +102,8 @@ test_main(void)
 		  "5678901234567890"),
 	    SHEX("f371bc4a311f2b00 9eef952dd83ca80e"
 		 "2b60026c8e935592 d0f9c308453c813e"));
+
+  test_hash_many(&nettle_sha256, sha256_digest_many);
 }
 
 /* These are intermediate values for the single sha1_compress call
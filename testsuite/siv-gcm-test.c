@@ -40,6 +40,7 @@
 #include "block-internal.h"
 #include "aes.h"
 #include "siv-gcm.h"
+#include "knuth-lfib.h"
 
 
 static const struct nettle_aead_message
@@ -102,6 +103,53 @@ test_polyval_internal (const struct tstring *key,
     }
 }
 
+/* Check _siv_ghash_set_key and _siv_ghash_update, which may have
+   optimized implementations, against hashing one byte reversed block
+   at a time with _ghash_update. */
+#define POLYVAL_BLOCKS 40
+
+static void
+test_polyval_blocks (void)
+{
+  struct knuth_lfib_ctx random;
+  struct gcm_key gcm_key, ref_key;
+  union nettle_block16 key, h;
+  union nettle_block16 state, ref;
+  uint8_t message[POLYVAL_BLOCKS * GCM_BLOCK_SIZE];
+  size_t blocks;
+
+  knuth_lfib_init (&random, 4711);
+  knuth_lfib_random (&random, sizeof(key), key.b);
+  knuth_lfib_random (&random, sizeof(message), message);
+
+  _siv_ghash_set_key (&gcm_key, &key);
+
+  block16_bswap (&h, &key);
+  block16_mulx_ghash (&h, &h);
+  _ghash_set_key (&ref_key, &h);
+
+  for (blocks = 0; blocks <= POLYVAL_BLOCKS; blocks++)
+    {
+      const uint8_t *end;
+      size_t i;
+
+      block16_zero (&ref);
+      for (i = 0; i < blocks; i++)
+	{
+	  union nettle_block16 b;
+	  unsigned j;
+	  for (j = 0; j < GCM_BLOCK_SIZE; j++)
+	    b.b[j] = message[i * GCM_BLOCK_SIZE + GCM_BLOCK_SIZE - 1 - j];
+	  _ghash_update (&ref_key, &ref, 1, b.b);
+	}
+
+      block16_zero (&state);
+      end = _siv_ghash_update (&gcm_key, &state, blocks, message);
+      ASSERT (end == message + blocks * GCM_BLOCK_SIZE);
+      ASSERT (MEMEQ (GCM_BLOCK_SIZE, state.b, ref.b));
+    }
+}
+
 void
 test_main(void)
 {
@@ -111,6 +159,8 @@ test_main(void)
 			      "d1a24ddd2721d006bbe45f20d3c9f362"),
 			 SHEX("f7a3b47b846119fae5b7866cf5e5b77e"));
 
+  test_polyval_blocks ();
+
   /* RFC8452, Appendix C.1.  */
   test_aead_message(&siv_gcm_aes128,
 		       SHEX("01000000000000000000000000000000"),
@@ -86,25 +86,32 @@ test_wots_sign (const struct tstring *public_seed, const struct tstring *secret_
 
 /* The xmss_leaf and xmss_node functions copied from slh-xmss.c */
 static void
-xmss_leaf (const struct slh_merkle_ctx_secret *ctx, unsigned idx, uint8_t *leaf)
+xmss_leaf (const struct slh_merkle_ctx_secret *ctx, unsigned idx,
+	   unsigned count, uint8_t *leaf)
 {
-  _wots_gen (ctx->pub.hash, ctx->pub.tree_ctx, ctx->secret_seed, idx, leaf, ctx->scratch_ctx);
-  mark_bytes_defined (SLH_DSA_128_SEED_SIZE, leaf);
+  for (; count > 0; count--, idx++, leaf += _SLH_DSA_128_SIZE)
+    {
+      _wots_gen (ctx->pub.hash, ctx->pub.tree_ctx, ctx->secret_seed, idx, leaf, ctx->scratch_ctx);
+      mark_bytes_defined (SLH_DSA_128_SEED_SIZE, leaf);
+    }
 }
 
 static void
 xmss_node (const struct slh_merkle_ctx_public *ctx, unsigned height, unsigned index,
-	   const uint8_t *left, const uint8_t *right, uint8_t *out)
+	   unsigned count, const uint8_t *children, uint8_t *out)
 {
-  struct slh_address_hash ah =
-    {
-      bswap32_if_le (SLH_XMSS_TREE),
-      0,
-      bswap32_if_le (height),
-      bswap32_if_le (index),
-    };
+  struct slh_address_hash ah[MERKLE_BATCH_SIZE];
+  unsigned i;
 
-  ctx->hash->node (ctx->tree_ctx, &ah, left, right, out);
+  ASSERT (count <= MERKLE_BATCH_SIZE);
+  for (i = 0; i < count; i++)
+    {
+      ah[i].type = bswap32_if_le (SLH_XMSS_TREE);
+      ah[i].keypair = 0;
+      ah[i].height_chain = bswap32_if_le (height);
+      ah[i].index_hash = bswap32_if_le (index + i);
+    }
+  ctx->hash->node_many (ctx->tree_ctx, count, ah, children, out);
 }
 
 static void
@@ -1300,6 +1300,114 @@ test_hash_large(const struct nettle_hash *hash,
   free(data);
 }
 
+/* Compares digest_many functions, like sha256_digest_many, to the
+   plain hash function, for messages of varying lengths and
+   alignment. */
+void
+test_hash_many(const struct nettle_hash *hash,
+	       test_digest_many_func *f)
+{
+  static const size_t counts[] = { 0, 1, 3, 7, 8, 9, 16, 17, 40, 100 };
+  void *ctx = xalloc(hash->context_size);
+  uint8_t *buffer = xalloc(hash->digest_size);
+  uint8_t *input = xalloc(420);
+  uint8_t *digest = xalloc(100 * hash->digest_size);
+  const uint8_t *data[100];
+  size_t length[100];
+  unsigned i, j;
+
+  for (i = 0; i < 420; i++)
+    input[i] = i * 0x45 + 3;
+
+  for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+      size_t n = counts[i];
+      for (j = 0; j < n; j++)
+	{
+	  /* Covers the padding cases around block boundaries, and
+	     some messages much longer than the others. */
+	  length[j] = (j * 37 + n * 11) % 140 + (j % 13 == 5) * 250;
+	  data[j] = input + (j * 7) % 16;
+	}
+      f (n, length, data, digest);
+
+      for (j = 0; j < n; j++)
+	{
+	  hash->init (ctx);
+	  hash->update (ctx, length[j], data[j]);
+	  hash->digest (ctx, buffer);
+	  if (!MEMEQ (hash->digest_size, buffer,
+		      digest + j * hash->digest_size))
+	    {
+	      fprintf (stderr, "%s digest_many failed: n = %u, message %u, length %u\nGot:\n",
+		       hash->name, (unsigned) n, j, (unsigned) length[j]);
+	      print_hex (hash->digest_size, digest + j * hash->digest_size);
+	      fprintf (stderr, "\nExpected:\n");
+	      print_hex (hash->digest_size, buffer);
+	      abort ();
+	    }
+	}
+    }
+  free (ctx);
+  free (buffer);
+  free (input);
+  free (digest);
+}
+
+void
+test_xof_many(const struct nettle_xof *xof,
+	      test_xof_many_func *f)
+{
+  static const size_t counts[] = { 0, 1, 2, 3, 4, 5, 8, 9, 17, 40 };
+  static const size_t output_lengths[] = { 1, 32, 136, 300 };
+  void *ctx = xalloc(xof->context_size);
+  uint8_t *buffer = xalloc(300);
+  uint8_t *input = xalloc(700);
+  uint8_t *output = xalloc(40 * 300);
+  const uint8_t *data[40];
+  size_t length[40];
+  unsigned i, j, k;
+
+  for (i = 0; i < 700; i++)
+    input[i] = i * 0x45 + 3;
+
+  for (k = 0; k < sizeof(output_lengths) / sizeof(output_lengths[0]); k++)
+    for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+      {
+	size_t output_length = output_lengths[k];
+	size_t n = counts[i];
+	for (j = 0; j < n; j++)
+	  {
+	    /* Covers the padding cases around block boundaries, and
+	       some messages much longer than the others. */
+	    length[j] = (j * 37 + n * 11) % 280 + (j % 13 == 5) * 400;
+	    data[j] = input + (j * 7) % 16;
+	  }
+	f (n, length, data, output_length, output);
+
+	for (j = 0; j < n; j++)
+	  {
+	    xof->init (ctx);
+	    xof->update (ctx, length[j], data[j]);
+	    xof->digest (ctx, output_length, buffer);
+	    if (!MEMEQ (output_length, buffer, output + j * output_length))
+	      {
+		fprintf (stderr, "%s many failed: n = %u, message %u, length %u, output length %u\nGot:\n",
+			 xof->name, (unsigned) n, j, (unsigned) length[j],
+			 (unsigned) output_length);
+		print_hex (output_length, output + j * output_length);
+		fprintf (stderr, "\nExpected:\n");
+		print_hex (output_length, buffer);
+		abort ();
+	      }
+	  }
+      }
+  free (ctx);
+  free (buffer);
+  free (input);
+  free (output);
+}
+
 void
 test_mac(const struct nettle_mac *mac,
 	 nettle_hash_update_func *set_key,
@@ -193,11 +193,28 @@ test_hash_large(const struct nettle_hash *hash,
 		uint8_t c,
 		const struct tstring *digest);
 
+typedef void
+test_digest_many_func(size_t n, const size_t *length,
+		      const uint8_t * const *data, uint8_t *digest);
+
+void
+test_hash_many(const struct nettle_hash *hash,
+	       test_digest_many_func *f);
+
 void
 test_xof (const struct nettle_xof *xof,
 	  const struct tstring *msg,
 	  const struct tstring *digest);
 
+typedef void
+test_xof_many_func(size_t n, const size_t *length,
+		   const uint8_t * const *data,
+		   size_t output_length, uint8_t *output);
+
+void
+test_xof_many(const struct nettle_xof *xof,
+	      test_xof_many_func *f);
+
 void
 test_mac(const struct nettle_mac *mac,
 	 nettle_hash_update_func *set_key,
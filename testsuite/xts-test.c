@@ -1,6 +1,7 @@
 #include "testutils.h"
 #include "aes.h"
 #include "xts.h"
+#include "memxor.h"
 #include "nettle-internal.h"
 
 static void
@@ -107,6 +108,170 @@ test_cipher_xts(const struct nettle_cipher *cipher,
   free(data2);
 }
 
+static void
+xts_ref_mulx(uint8_t *t)
+{
+  unsigned carry = t[XTS_BLOCK_SIZE - 1] >> 7;
+  unsigned i;
+  for (i = XTS_BLOCK_SIZE - 1; i > 0; i--)
+    t[i] = (t[i] << 1) | (t[i-1] >> 7);
+  t[0] = (t[0] << 1) ^ (135 * carry);
+}
+
+/* Straightforward one block at a time reference, without ciphertext
+   stealing, i.e., length must be a multiple of the block size. */
+static void
+xts_ref_crypt(const void *ctx, const void *twk_ctx,
+	      nettle_cipher_func *f, nettle_cipher_func *encf,
+	      const uint8_t *tweak, size_t length,
+	      uint8_t *dst, const uint8_t *src)
+{
+  uint8_t t[XTS_BLOCK_SIZE];
+  uint8_t b[XTS_BLOCK_SIZE];
+
+  encf(twk_ctx, XTS_BLOCK_SIZE, t, tweak);
+  for (; length > 0; length -= XTS_BLOCK_SIZE,
+	 src += XTS_BLOCK_SIZE, dst += XTS_BLOCK_SIZE)
+    {
+      memxor3(b, src, t, XTS_BLOCK_SIZE);
+      f(ctx, XTS_BLOCK_SIZE, b, b);
+      memxor3(dst, b, t, XTS_BLOCK_SIZE);
+      xts_ref_mulx(t);
+    }
+}
+
+static void
+test_xts_long(const struct nettle_cipher *cipher)
+{
+  void *twk_ctx = xalloc(cipher->context_size);
+  void *ctx = xalloc(cipher->context_size);
+  uint8_t key[2 * AES256_KEY_SIZE];
+  uint8_t tweak[XTS_BLOCK_SIZE];
+  size_t size = 80 * XTS_BLOCK_SIZE;
+  uint8_t *clear = xalloc(size);
+  uint8_t *ref = xalloc(size);
+  uint8_t *data = xalloc(size);
+  size_t length;
+  size_t i;
+
+  for (i = 0; i < sizeof(key); i++)
+    key[i] = i * 7 + 1;
+  for (i = 0; i < sizeof(tweak); i++)
+    tweak[i] = 0xa0 + i;
+  for (i = 0; i < size; i++)
+    clear[i] = i * 13 + (i >> 8);
+
+  cipher->set_encrypt_key(ctx, key);
+  cipher->set_encrypt_key(twk_ctx, key + cipher->key_size);
+
+  for (length = XTS_BLOCK_SIZE; length <= size; length += 7)
+    {
+      /* Complete blocks before the one used for stealing. */
+      size_t full = length % XTS_BLOCK_SIZE
+	? (length / XTS_BLOCK_SIZE - 1) * XTS_BLOCK_SIZE : length;
+
+      xts_ref_crypt(ctx, twk_ctx, cipher->encrypt, cipher->encrypt,
+		    tweak, full, ref, clear);
+      xts_encrypt_message(ctx, twk_ctx, cipher->encrypt,
+			  tweak, length, data, clear);
+      test_check_data("long encrypt", clear, data, ref, full);
+
+      cipher->set_decrypt_key(ctx, key);
+      xts_decrypt_message(ctx, twk_ctx, cipher->decrypt, cipher->encrypt,
+			  tweak, length, data, data);
+      test_check_data("long decrypt", clear, data, clear, length);
+      cipher->set_encrypt_key(ctx, key);
+    }
+
+  free(twk_ctx);
+  free(ctx);
+  free(clear);
+  free(ref);
+  free(data);
+}
+
+static void
+test_xts_sectors(const struct nettle_cipher *cipher, size_t sector_size)
+{
+  void *twk_ctx = xalloc(cipher->context_size);
+  void *ctx = xalloc(cipher->context_size);
+  uint8_t key[2 * AES256_KEY_SIZE];
+  uint8_t tweak[XTS_BLOCK_SIZE];
+  uint8_t t[XTS_BLOCK_SIZE];
+  size_t sectors = 40;
+  size_t length = sectors * sector_size;
+  uint8_t *clear = xalloc(length);
+  uint8_t *ref = xalloc(length);
+  uint8_t *data = xalloc(length);
+  size_t i;
+
+  for (i = 0; i < sizeof(key); i++)
+    key[i] = i * 5 + 3;
+  /* Low byte wraps around, to test carry propagation. */
+  memset(tweak, 0, sizeof(tweak));
+  tweak[0] = 0xf0;
+  tweak[1] = 0xff;
+  tweak[2] = 0x17;
+  for (i = 0; i < length; i++)
+    clear[i] = i * 11 + (i >> 9);
+
+  cipher->set_encrypt_key(ctx, key);
+  cipher->set_encrypt_key(twk_ctx, key + cipher->key_size);
+
+  memcpy(t, tweak, sizeof(t));
+  for (i = 0; i < sectors; i++)
+    {
+      unsigned j;
+      xts_encrypt_message(ctx, twk_ctx, cipher->encrypt, t, sector_size,
+			  ref + i * sector_size, clear + i * sector_size);
+      for (j = 0; j < XTS_BLOCK_SIZE && ++t[j] == 0; j++)
+	;
+    }
+
+  xts_encrypt_sectors(ctx, twk_ctx, cipher->encrypt, tweak,
+		      sector_size, length, data, clear);
+  test_check_data("sectors encrypt", clear, data, ref, length);
+
+  cipher->set_decrypt_key(ctx, key);
+  xts_decrypt_sectors(ctx, twk_ctx, cipher->decrypt, cipher->encrypt,
+		      tweak, sector_size, length, data, data);
+  test_check_data("sectors decrypt", ref, data, clear, length);
+
+  if (cipher == &nettle_aes128) {
+    struct xts_aes128_key xts_key;
+
+    xts_aes128_set_encrypt_key(&xts_key, key);
+    xts_aes128_encrypt_sectors(&xts_key, tweak, sector_size, length,
+                               data, clear);
+    test_check_data("sectors encrypt", clear, data, ref, length);
+
+    xts_aes128_set_decrypt_key(&xts_key, key);
+    xts_aes128_decrypt_sectors(&xts_key, tweak, sector_size, length,
+                               data, data);
+    test_check_data("sectors decrypt", ref, data, clear, length);
+  }
+
+  if (cipher == &nettle_aes256) {
+    struct xts_aes256_key xts_key;
+
+    xts_aes256_set_encrypt_key(&xts_key, key);
+    xts_aes256_encrypt_sectors(&xts_key, tweak, sector_size, length,
+                               data, clear);
+    test_check_data("sectors encrypt", clear, data, ref, length);
+
+    xts_aes256_set_decrypt_key(&xts_key, key);
+    xts_aes256_decrypt_sectors(&xts_key, tweak, sector_size, length,
+                               data, data);
+    test_check_data("sectors decrypt", ref, data, clear, length);
+  }
+
+  free(twk_ctx);
+  free(ctx);
+  free(clear);
+  free(ref);
+  free(data);
+}
+
 void
 test_main(void)
 {
@@ -170,4 +335,12 @@ test_main(void)
 		  SHEX("c73256870cc2f4dd57acc74b5456dbd7"
                        "76912a128bc1f77d72cdebbf270044b7"
                        "a43ceed29025e1e8be211fa3c3ed002d"));
+
+  test_xts_long(&nettle_aes128);
+  test_xts_long(&nettle_aes256);
+
+  test_xts_sectors(&nettle_aes128, 512);
+  test_xts_sectors(&nettle_aes256, 4096);
+  /* Sectors which are not a multiple of the block size */
+  test_xts_sectors(&nettle_aes128, 520);
 }
@@ -0,0 +1,69 @@
+C Macros for AES using the vaes instructions, shared by the 256-bit
+C (x86_64/vaes) and 512-bit (x86_64/avx512) implementations.
+
+C AES_ENCRYPT_X(rounds, keys, x)
+C Encrypts a single block in an xmm register, with subkeys read
+C directly from memory.
+define(`AES_ENCRYPT_X', `
+	vpxor	($2), $3, $3
+forloop(`aes_i', 1, eval($1 - 1), `
+	vaesenc	eval(16*aes_i)($2), $3, $3')
+	vaesenclast	eval(16*$1)($2), $3, $3')
+
+C AES_DECRYPT_X(rounds, keys, x)
+C Like AES_ENCRYPT_X, but the subkeys are used in the opposite
+C order, starting from the end of the array.
+define(`AES_DECRYPT_X', `
+	vpxor	eval(16*$1)($2), $3, $3
+forloop(`aes_i', eval($1 - 1), 1, `
+	vaesdec	eval(16*aes_i)($2), $3, $3')
+	vaesdeclast	($2), $3, $3')
+
+C AES_ENCRYPT_Y(rounds, keys, k, x1, x2, ...)
+C Encrypts two blocks in each of the ymm registers x1, x2, .... Each
+C subkey is broadcast into the ymm register k just before it is
+C needed, so that only one register is spent on the key schedule.
+define(`AES_ENCRYPT_Y', `
+	vbroadcasti128	($2), $3
+	OPN_YXX(vpxor, $3, shift(shift(shift($@))))
+forloop(`aes_i', 1, eval($1 - 1), `
+	vbroadcasti128	eval(16*aes_i)($2), $3
+	OPN_YXX(vaesenc, $3, shift(shift(shift($@))))')
+	vbroadcasti128	eval(16*$1)($2), $3
+	OPN_YXX(vaesenclast, $3, shift(shift(shift($@))))')
+
+C AES_DECRYPT_Y(rounds, keys, k, x1, x2, ...)
+define(`AES_DECRYPT_Y', `
+	vbroadcasti128	eval(16*$1)($2), $3
+	OPN_YXX(vpxor, $3, shift(shift(shift($@))))
+forloop(`aes_i', eval($1 - 1), 1, `
+	vbroadcasti128	eval(16*aes_i)($2), $3
+	OPN_YXX(vaesdec, $3, shift(shift(shift($@))))')
+	vbroadcasti128	($2), $3
+	OPN_YXX(vaesdeclast, $3, shift(shift(shift($@))))')
+
+C AES_LOAD_KEYS_Z(rounds, keys, reg)
+C Broadcasts all subkeys into the zmm registers reg(0), ...,
+C reg(rounds), where reg is the name of a macro mapping an index to a
+C register name.
+define(`AES_LOAD_KEYS_Z', `
+forloop(`aes_i', 0, $1, `
+	vbroadcasti32x4	eval(16*aes_i)($2), $3(aes_i)')')
+
+C AES_LOAD_DECRYPT_KEYS_Z(rounds, keys, reg)
+C Like AES_LOAD_KEYS_Z, but in opposite order, so that reg(0) is
+C the first subkey used for decryption.
+define(`AES_LOAD_DECRYPT_KEYS_Z', `
+forloop(`aes_i', 0, $1, `
+	vbroadcasti32x4	eval(16*($1 - aes_i))($2), $3(aes_i)')')
+
+C AES_CRYPT_R(op, oplast, rounds, reg, x1, x2, ...)
+C Applies all rounds to the registers x1, x2, ..., with subkeys
+C already in registers reg(0), ..., reg(rounds). Works for xmm, ymm
+C and zmm registers, as long as reg gives a register of the same
+C size.
+define(`AES_CRYPT_R', `
+	OPN_YXX(vpxord, $4(0), shift(shift(shift(shift($@)))))
+forloop(`aes_i', 1, eval($3 - 1), `
+	OPN_YXX($1, $4(aes_i), shift(shift(shift(shift($@)))))')
+	OPN_YXX($2, $4($3), shift(shift(shift(shift($@)))))')
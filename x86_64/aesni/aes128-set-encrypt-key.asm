@@ -0,0 +1,79 @@
+C x86_64/aesni/aes128-set-encrypt-key.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+C Input arguments
+define(`CTX',	`%rdi')
+define(`KEY',	`%rsi')
+
+define(`X', `%xmm0')
+define(`T', `%xmm1')
+define(`S', `%xmm2')
+
+C AES128_EXPAND(i, rcon)
+C Computes subkey i from subkey i-1 in X, and stores it.
+define(`AES128_EXPAND', `
+	aeskeygenassist	`$'$2, X, T
+	pshufd	`$'0xff, T, T
+	movdqa	X, S
+	pslldq	`$'4, S
+	pxor	S, X
+	pslldq	`$'4, S
+	pxor	S, X
+	pslldq	`$'4, S
+	pxor	S, X
+	pxor	T, X
+	movups	X, eval(16*$1)(CTX)')
+
+	.file "aes128-set-encrypt-key.asm"
+
+	C nettle_aes128_set_encrypt_key(struct aes128_ctx *ctx,
+	C                               const uint8_t *key)
+
+	.text
+	ALIGN(16)
+PROLOGUE(nettle_aes128_set_encrypt_key)
+	W64_ENTRY(2, 3)
+	movups	(KEY), X
+	movups	X, (CTX)
+	AES128_EXPAND(1, 0x01)
+	AES128_EXPAND(2, 0x02)
+	AES128_EXPAND(3, 0x04)
+	AES128_EXPAND(4, 0x08)
+	AES128_EXPAND(5, 0x10)
+	AES128_EXPAND(6, 0x20)
+	AES128_EXPAND(7, 0x40)
+	AES128_EXPAND(8, 0x80)
+	AES128_EXPAND(9, 0x1b)
+	AES128_EXPAND(10, 0x36)
+	W64_EXIT(2, 3)
+	ret
+EPILOGUE(nettle_aes128_set_encrypt_key)
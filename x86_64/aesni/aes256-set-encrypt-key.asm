@@ -0,0 +1,88 @@
+C x86_64/aesni/aes256-set-encrypt-key.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+C Input arguments
+define(`CTX',	`%rdi')
+define(`KEY',	`%rsi')
+
+define(`X0', `%xmm0')	C Even subkeys
+define(`X1', `%xmm1')	C Odd subkeys
+define(`T', `%xmm2')
+define(`S', `%xmm3')
+
+C AES256_EXPAND(i, x, y, rcon, shuffle)
+C Computes subkey i in register x, from subkeys i-2 in x and i-1 in
+C y, and stores it. For even i, shuffle is 0xff and rcon is the
+C round constant. For odd i, shuffle is 0xaa, selecting the
+C aeskeygenassist output without rotation, and rcon is zero.
+define(`AES256_EXPAND', `
+	aeskeygenassist	`$'$4, $3, T
+	pshufd	`$'$5, T, T
+	movdqa	$2, S
+	pslldq	`$'4, S
+	pxor	S, $2
+	pslldq	`$'4, S
+	pxor	S, $2
+	pslldq	`$'4, S
+	pxor	S, $2
+	pxor	T, $2
+	movups	$2, eval(16*$1)(CTX)')
+
+	.file "aes256-set-encrypt-key.asm"
+
+	C nettle_aes256_set_encrypt_key(struct aes256_ctx *ctx,
+	C                               const uint8_t *key)
+
+	.text
+	ALIGN(16)
+PROLOGUE(nettle_aes256_set_encrypt_key)
+	W64_ENTRY(2, 4)
+	movups	(KEY), X0
+	movups	16(KEY), X1
+	movups	X0, (CTX)
+	movups	X1, 16(CTX)
+	AES256_EXPAND(2, X0, X1, 0x01, 0xff)
+	AES256_EXPAND(3, X1, X0, 0, 0xaa)
+	AES256_EXPAND(4, X0, X1, 0x02, 0xff)
+	AES256_EXPAND(5, X1, X0, 0, 0xaa)
+	AES256_EXPAND(6, X0, X1, 0x04, 0xff)
+	AES256_EXPAND(7, X1, X0, 0, 0xaa)
+	AES256_EXPAND(8, X0, X1, 0x08, 0xff)
+	AES256_EXPAND(9, X1, X0, 0, 0xaa)
+	AES256_EXPAND(10, X0, X1, 0x10, 0xff)
+	AES256_EXPAND(11, X1, X0, 0, 0xaa)
+	AES256_EXPAND(12, X0, X1, 0x20, 0xff)
+	AES256_EXPAND(13, X1, X0, 0, 0xaa)
+	AES256_EXPAND(14, X0, X1, 0x40, 0xff)
+	W64_EXIT(2, 4)
+	ret
+EPILOGUE(nettle_aes256_set_encrypt_key)
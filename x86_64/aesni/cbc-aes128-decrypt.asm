@@ -0,0 +1,175 @@
+C x86_64/aesni/cbc-aes128-decrypt.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+C Input argument
+define(`CTX',	`%rdi')
+define(`IV',	`%rsi')
+define(`LENGTH',`%rdx')
+define(`DST',	`%rcx')
+define(`SRC',	`%r8')
+
+define(`X0', `%xmm0')
+define(`X1', `%xmm1')
+define(`X2', `%xmm2')
+define(`X3', `%xmm3')
+define(`X4', `%xmm4')
+define(`X5', `%xmm5')
+define(`X6', `%xmm6')
+define(`X7', `%xmm7')
+define(`K', `%xmm8')
+define(`Y', `%xmm9')	C Previous ciphertext block
+define(`T', `%xmm10')
+define(`NEXT', `%xmm11')	C Last ciphertext block of iteration
+
+	.file "cbc-aes128-decrypt.asm"
+
+	C nettle_cbc_aes128_decrypt(struct cbc_aes128_ctx *ctx,
+	C                           uint8_t *iv,
+	C                           size_t length, uint8_t *dst,
+	C                           const uint8_t *src);
+
+	C Decrypts 8 blocks in parallel. After decryption, the
+	C blocks are xored with the preceding ciphertext blocks
+	C and stored starting with the last one, so that in-place
+	C operation never overwrites ciphertext still needed.
+	.text
+	ALIGN(16)
+PROLOGUE(nettle_cbc_aes128_decrypt)
+	W64_ENTRY(5, 12)
+	shr	$4, LENGTH
+	test	LENGTH, LENGTH
+	jz	.Lend
+
+	movups	(IV), Y
+	cmp	$8, LENGTH
+	jc	.Lblock_loop
+
+.Lloop8:
+	movups	(SRC), X0
+	movups	16(SRC), X1
+	movups	32(SRC), X2
+	movups	48(SRC), X3
+	movups	64(SRC), X4
+	movups	80(SRC), X5
+	movups	96(SRC), X6
+	movups	112(SRC), X7
+	movaps	X7, NEXT
+
+	movups	160(CTX), K
+	pxor	K, X0
+	pxor	K, X1
+	pxor	K, X2
+	pxor	K, X3
+	pxor	K, X4
+	pxor	K, X5
+	pxor	K, X6
+	pxor	K, X7
+forloop(`i', 9, 1, `
+	movups	eval(16*i)(CTX), K
+	aesdec	K, X0
+	aesdec	K, X1
+	aesdec	K, X2
+	aesdec	K, X3
+	aesdec	K, X4
+	aesdec	K, X5
+	aesdec	K, X6
+	aesdec	K, X7')
+	movups	(CTX), K
+	aesdeclast K, X0
+	aesdeclast K, X1
+	aesdeclast K, X2
+	aesdeclast K, X3
+	aesdeclast K, X4
+	aesdeclast K, X5
+	aesdeclast K, X6
+	aesdeclast K, X7
+
+	movups	96(SRC), T
+	pxor	T, X7
+	movups	X7, 112(DST)
+	movups	80(SRC), T
+	pxor	T, X6
+	movups	X6, 96(DST)
+	movups	64(SRC), T
+	pxor	T, X5
+	movups	X5, 80(DST)
+	movups	48(SRC), T
+	pxor	T, X4
+	movups	X4, 64(DST)
+	movups	32(SRC), T
+	pxor	T, X3
+	movups	X3, 48(DST)
+	movups	16(SRC), T
+	pxor	T, X2
+	movups	X2, 32(DST)
+	movups	(SRC), T
+	pxor	T, X1
+	movups	X1, 16(DST)
+	pxor	Y, X0
+	movups	X0, (DST)
+	movaps	NEXT, Y
+
+	add	$128, SRC
+	add	$128, DST
+	sub	$8, LENGTH
+	cmp	$8, LENGTH
+	jnc	.Lloop8
+
+	test	LENGTH, LENGTH
+	jz	.Ldone
+
+.Lblock_loop:
+	movups	(SRC), X0
+	movaps	X0, NEXT
+	movups	160(CTX), K
+	pxor	K, X0
+forloop(`i', 9, 1, `
+	movups	eval(16*i)(CTX), K
+	aesdec	K, X0')
+	movups	(CTX), K
+	aesdeclast K, X0
+	pxor	Y, X0
+	movups	X0, (DST)
+	movaps	NEXT, Y
+
+	add	$16, SRC
+	add	$16, DST
+	dec	LENGTH
+	jnz	.Lblock_loop
+
+.Ldone:
+	movups	Y, (IV)
+
+.Lend:
+	W64_EXIT(5, 12)
+	ret
+EPILOGUE(nettle_cbc_aes128_decrypt)
@@ -0,0 +1,140 @@
+C x86_64/aesni/ccm-aes128-decrypt-n.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+C Input arguments
+define(`CTX',	`%rdi')
+define(`KEYS',	`%rsi')
+define(`N',	`%rdx')
+define(`DST',	`%rcx')
+define(`SRC',	`%r8')
+
+define(`TAG',	`%xmm0')
+define(`CTR',	`%xmm1')	C Counter, byte reversed
+define(`B',	`%xmm2')	C CTR block
+define(`M',	`%xmm3')	C Message block
+define(`BSWAP',	`%xmm4')
+C Subkeys are in %xmm5, ..., %xmm15
+define(`KEY', `%xmm`'eval($1 + 5)')
+
+C CCM_CTR_BLOCK
+C Copies the next counter block into B and increments the counter.
+define(`CCM_CTR_BLOCK', `
+	movdqa	CTR, B
+	pshufb	BSWAP, B
+	paddq	.Lone(%rip), CTR')
+
+C CCM_DECRYPT_BLOCK
+C Xors the keystream in B with the next ciphertext block, and
+C stores the plaintext, leaving it in M.
+define(`CCM_DECRYPT_BLOCK', `
+	movups	(SRC), M
+	pxor	B, M
+	movups	M, (DST)
+	add	`$'16, SRC
+	add	`$'16, DST')
+
+	.file "ccm-aes128-decrypt-n.asm"
+
+	C size_t _ccm_aes128_decrypt_n(struct ccm_ctx *ctx,
+	C                              const struct aes128_ctx *cipher,
+	C                              size_t n, uint8_t *dst,
+	C                              const uint8_t *src)
+
+	C The CBC-MAC needs the plaintext, so the CBC-MAC of each block
+	C is computed together with the CTR decryption of the next
+	C block. Updates ctr and tag of ctx, and returns n.
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_ccm_aes128_decrypt_n)
+	W64_ENTRY(5, 16)
+	mov	N, %rax
+	test	N, N
+	jz	.Lend
+
+	forloop(`i', 0, 10, `
+	movups	eval(16*i)(KEYS), KEY(i)')
+
+	movdqa	.Lbswap(%rip), BSWAP
+	C Offsets of the ctr and tag members of struct ccm_ctx are 0
+	C and 16.
+	movups	(CTX), CTR
+	pshufb	BSWAP, CTR
+	movups	16(CTX), TAG
+
+	CCM_CTR_BLOCK
+	pxor	KEY(0), B
+forloop(`r', 1, 9, `
+	aesenc	KEY(r), B')
+	aesenclast KEY(10), B
+	CCM_DECRYPT_BLOCK
+
+	dec	N
+	jz	.Lfinal
+
+.Lloop:
+	pxor	M, TAG
+	CCM_CTR_BLOCK
+
+	pxor	KEY(0), TAG
+	pxor	KEY(0), B
+forloop(`r', 1, 9, `
+	aesenc	KEY(r), TAG
+	aesenc	KEY(r), B')
+	aesenclast KEY(10), TAG
+	aesenclast KEY(10), B
+
+	CCM_DECRYPT_BLOCK
+	dec	N
+	jnz	.Lloop
+
+.Lfinal:
+	pxor	M, TAG
+	pxor	KEY(0), TAG
+forloop(`r', 1, 9, `
+	aesenc	KEY(r), TAG')
+	aesenclast KEY(10), TAG
+
+	pshufb	BSWAP, CTR
+	movups	CTR, (CTX)
+	movups	TAG, 16(CTX)
+
+.Lend:
+	W64_EXIT(5, 16)
+	ret
+EPILOGUE(_nettle_ccm_aes128_decrypt_n)
+
+	RODATA
+	ALIGN(16)
+.Lbswap:
+	.byte 15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0
+.Lone:
+	.quad 1,0
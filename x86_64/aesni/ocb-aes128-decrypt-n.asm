@@ -0,0 +1,158 @@
+C x86_64/aesni/ocb-aes128-decrypt-n.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+C Input arguments
+define(`CTX',	`%rdi')
+define(`KEYS',	`%rsi')
+define(`LTABLE',`%rdx')
+define(`N',	`%rcx')
+define(`DST',	`%r8')
+define(`SRC',	`%r9')
+
+define(`COUNT',	`%r10')
+define(`TMP',	`%r11')
+
+C Blocks are in %xmm0, ..., %xmm7
+define(`XREG', `%xmm$1')
+define(`K', `%xmm8')
+define(`O', `%xmm9')	C Current offset
+define(`CS', `%xmm10')	C Checksum
+define(`T', `%xmm11')
+
+C OCB_NEXT_OFFSET
+C Updates the offset for the next block, by xoring in L_i, where i
+C is the number of trailing zeros in the block index.
+define(`OCB_NEXT_OFFSET', `
+	add	`$'1, COUNT
+	bsf	COUNT, TMP
+	shl	`$'4, TMP
+	movups	(LTABLE, TMP), T
+	pxor	T, O')
+
+C OCB_LOAD(i)
+C Loads block i and xors in its offset, which is saved on the stack.
+define(`OCB_LOAD', `
+	OCB_NEXT_OFFSET
+	movups	O, eval(16*$1)(%rsp)
+	movups	eval(16*$1)(SRC), XREG($1)
+	pxor	O, XREG($1)')
+
+C OCB_STORE(i)
+C Xors in the offset, stores block i, and adds it to the checksum.
+define(`OCB_STORE', `
+	movups	eval(16*$1)(%rsp), T
+	pxor	T, XREG($1)
+	pxor	XREG($1), CS
+	movups	XREG($1), eval(16*$1)(DST)')
+
+	.file "ocb-aes128-decrypt-n.asm"
+
+	C size_t _ocb_aes128_decrypt_n(struct ocb_ctx *ctx,
+	C                              const struct aes128_ctx *cipher,
+	C                              const union nettle_block16 *L,
+	C                              size_t n, uint8_t *dst,
+	C                              const uint8_t *src)
+
+	C Processes 8 blocks per iteration, computing offsets, AES
+	C decryption and checksum in a single pass. Updates offset,
+	C checksum and message_count of ctx, and returns n.
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_ocb_aes128_decrypt_n)
+	W64_ENTRY(6, 12)
+	mov	N, %rax
+	test	N, N
+	jz	.Lend
+
+	C Space for 8 offsets
+	sub	$128, %rsp
+
+	C Offsets of the offset, checksum and message_count members
+	C of struct ocb_ctx are 16, 48 and 72.
+	mov	72(CTX), COUNT
+	movups	16(CTX), O
+	movups	48(CTX), CS
+
+	cmp	$8, N
+	jc	.Lblock_loop
+
+.Lloop8:
+	forloop(`i', 0, 7, `OCB_LOAD(i)')
+
+	movups	160(KEYS), K
+	forloop(`i', 0, 7, `
+	pxor	K, XREG(i)')
+forloop(`r', 9, 1, `
+	movups	eval(16*r)(KEYS), K
+	forloop(`i', 0, 7, `
+	aesdec	K, XREG(i)')')
+	movups	0(KEYS), K
+	forloop(`i', 0, 7, `
+	aesdeclast K, XREG(i)')
+
+	forloop(`i', 0, 7, `OCB_STORE(i)')
+
+	add	$128, SRC
+	add	$128, DST
+	sub	$8, N
+	cmp	$8, N
+	jnc	.Lloop8
+
+	test	N, N
+	jz	.Ldone
+
+.Lblock_loop:
+	OCB_LOAD(0)
+	movups	160(KEYS), K
+	pxor	K, XREG(0)
+forloop(`r', 9, 1, `
+	movups	eval(16*r)(KEYS), K
+	aesdec	K, XREG(0)')
+	movups	0(KEYS), K
+	aesdeclast K, XREG(0)
+	OCB_STORE(0)
+
+	add	$16, SRC
+	add	$16, DST
+	dec	N
+	jnz	.Lblock_loop
+
+.Ldone:
+	mov	COUNT, 72(CTX)
+	movups	O, 16(CTX)
+	movups	CS, 48(CTX)
+	add	$128, %rsp
+
+.Lend:
+	W64_EXIT(6, 12)
+	ret
+EPILOGUE(_nettle_ocb_aes128_decrypt_n)
@@ -0,0 +1,121 @@
+C x86_64/aesni_pclmul/gcm-aes-decrypt.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+
+include_src(`x86_64/aesni_pclmul/gcm-aes.m4')
+
+C Input arguments
+define(`CTX',	`%rdi')
+define(`ROUNDS',`%rsi')
+define(`LENGTH',`%rdx')
+define(`DST',	`%rcx')
+define(`SRC',	`%r8')
+
+define(`KEYS',	`%r9')
+define(`LAST',	`%r10')
+define(`COUNT',	`%r11')
+
+define(`X0', `%xmm0')
+define(`X1', `%xmm1')
+define(`X2', `%xmm2')
+define(`X3', `%xmm3')
+define(`X4', `%xmm4')
+define(`X5', `%xmm5')
+define(`X6', `%xmm6')
+define(`X7', `%xmm7')
+define(`K', `%xmm8')
+define(`CTR', `%xmm9')
+define(`BSWAP', `%xmm10')
+define(`R', `%xmm11')
+define(`F', `%xmm12')
+define(`T', `%xmm13')
+define(`M', `%xmm14')
+define(`HK', `%xmm15')
+
+	.file "gcm-aes-decrypt.asm"
+
+	C size_t _gcm_aes_decrypt(struct gcm_key *key, unsigned rounds,
+	C                         size_t size, uint8_t *dst,
+	C                         const uint8_t *src)
+
+	C Processes 8 blocks per iteration, and returns the number of
+	C bytes processed, a multiple of 128. The hashing of each group
+	C of ciphertext blocks is interleaved with the generation of
+	C the corresponding key stream.
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_gcm_aes_decrypt)
+	W64_ENTRY(5, 16)
+	and	$-128, LENGTH
+	jz	.Lnone
+
+	lea	GCM_CIPHER(CTX), KEYS
+	mov	XREG(ROUNDS), XREG(LAST)
+	shl	$4, LAST
+	add	KEYS, LAST
+	mov	LENGTH, COUNT
+	shr	$7, COUNT
+
+	movdqa	.Lbswap(%rip), BSWAP
+	movups	GCM_CTR(CTX), CTR
+	pshufb	BSWAP, CTR
+	movups	GCM_X(CTX), R
+	pshufb	BSWAP, R
+
+	ALIGN(16)
+.Loop:
+	GCM_AES_START
+	forloop(`i', 1, 8, `
+	GCM_AES_ROUND(i)
+	GCM_HASH_BLOCK(eval(i-1), SRC, 0)')
+	GCM_AES_ROUND(9)
+	GCM_HASH_REDUCE
+	GCM_AES_FINISH(.Lloop_last)
+	GCM_STORE
+	add	$128, SRC
+	add	$128, DST
+	dec	COUNT
+	jnz	.Loop
+
+	pshufb	BSWAP, CTR
+	movups	CTR, GCM_CTR(CTX)
+	pshufb	BSWAP, R
+	movups	R, GCM_X(CTX)
+
+.Lnone:
+	mov	LENGTH, %rax
+	W64_EXIT(5, 16)
+	ret
+EPILOGUE(_nettle_gcm_aes_decrypt)
+
+GCM_RODATA
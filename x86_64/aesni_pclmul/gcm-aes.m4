@@ -0,0 +1,132 @@
+C Macros shared by gcm-aes-encrypt.asm and gcm-aes-decrypt.asm. The
+C including file must define the registers X0, ..., X7, K, CTR,
+C BSWAP, R, F, T, M, HK, and the pointers CTX, KEYS and LAST.
+
+C Fields of struct gcm_aes*_ctx, GCM_CTR(CTX) etc.
+define(`GCM_CTR', `2064($1)')
+define(`GCM_X', `2080($1)')
+define(`GCM_CIPHER', `2112($1)')
+
+C GCM_AES_START
+C Sets up the next eight counter blocks in X0, ..., X7, and applies
+C the first subkey.
+define(`GCM_AES_START', `
+	movups	(KEYS), K
+	movdqa	CTR, X0
+	paddd	.Lone(%rip), CTR
+	movdqa	CTR, X1
+	paddd	.Lone(%rip), CTR
+	movdqa	CTR, X2
+	paddd	.Lone(%rip), CTR
+	movdqa	CTR, X3
+	paddd	.Lone(%rip), CTR
+	movdqa	CTR, X4
+	paddd	.Lone(%rip), CTR
+	movdqa	CTR, X5
+	paddd	.Lone(%rip), CTR
+	movdqa	CTR, X6
+	paddd	.Lone(%rip), CTR
+	movdqa	CTR, X7
+	paddd	.Lone(%rip), CTR
+	OPN_YX(pshufb, BSWAP, X0, X1, X2, X3, X4, X5, X6, X7)
+	OPN_YX(pxor, K, X0, X1, X2, X3, X4, X5, X6, X7)')
+
+C GCM_AES_ROUND(i)
+define(`GCM_AES_ROUND', `
+	movups	eval(16*$1)(KEYS), K
+	OPN_YX(aesenc, K, X0, X1, X2, X3, X4, X5, X6, X7)')
+
+C GCM_AES_FINISH(label)
+C Applies the remaining rounds, starting with round 10, and xors the
+C key stream with the input data at SRC. Uses T as temporary.
+define(`GCM_AES_FINISH', `
+	cmp	`$'10, XREG(ROUNDS)
+	je	$1
+	GCM_AES_ROUND(10)
+	GCM_AES_ROUND(11)
+	cmp	`$'12, XREG(ROUNDS)
+	je	$1
+	GCM_AES_ROUND(12)
+	GCM_AES_ROUND(13)
+$1:
+	movups	(LAST), K
+	OPN_YX(aesenclast, K, X0, X1, X2, X3, X4, X5, X6, X7)
+	movups	0(SRC), T
+	pxor	T, X0
+	movups	16(SRC), T
+	pxor	T, X1
+	movups	32(SRC), T
+	pxor	T, X2
+	movups	48(SRC), T
+	pxor	T, X3
+	movups	64(SRC), T
+	pxor	T, X4
+	movups	80(SRC), T
+	pxor	T, X5
+	movups	96(SRC), T
+	pxor	T, X6
+	movups	112(SRC), T
+	pxor	T, X7')
+
+C GCM_STORE
+define(`GCM_STORE', `
+	movups	X0, 0(DST)
+	movups	X1, 16(DST)
+	movups	X2, 32(DST)
+	movups	X3, 48(DST)
+	movups	X4, 64(DST)
+	movups	X5, 80(DST)
+	movups	X6, 96(DST)
+	movups	X7, 112(DST)')
+
+C GCM_HASH_BLOCK(i, ptr, offset)
+C Processes block i, read from offset(ptr), out of a group of eight, multiplying it by
+C H^{8-i}. For the first block, the hash state R is added in, and the
+C products initialize the accumulators R and F. The reduction is
+C postponed to GCM_HASH_REDUCE.
+define(`GCM_HASH_BLOCK', `
+	movups	eval(16*$1 + $3)($2), M
+	pshufb	BSWAP, M
+	movups	eval(32*(7-$1) + 16)(CTX), HK	C D^{8-i}
+ifelse($1, 0, `
+	pxor	R, M
+	movdqa	M, F
+	movdqa	M, R
+	pclmullqlqdq	HK, F	C D0 * M0
+	pclmullqhqdq	HK, R	C D1 * M0', `
+	movdqa	M, T
+	pclmullqlqdq	HK, T	C D0 * M0
+	pxor	T, F
+	movdqa	M, T
+	pclmullqhqdq	HK, T	C D1 * M0
+	pxor	T, R')
+	movups	eval(32*(7-$1))(CTX), HK	C H^{8-i}
+	movdqa	M, T
+	pclmulhqlqdq	HK, T	C H0 * M1
+	pxor	T, F
+	pclmulhqhqdq	HK, M	C H1 * M1
+	pxor	M, R')
+
+C GCM_HASH_REDUCE
+C Final reduction, R <-- R + x^{-64} F.
+define(`GCM_HASH_REDUCE', `
+	pshufd	`$'0x4e, F, T		C Swap halves of F
+	pxor	T, R
+	pclmullqhqdq	.Lpolynomial(%rip), F
+	pxor	F, R')
+
+C GCM_RODATA
+define(`GCM_RODATA', `
+	RODATA
+	C The GCM polynomial is x^{128} + x^7 + x^2 + x + 1,
+	C but in bit-reversed representation, that is
+	C P = x^{128}+ x^{127} + x^{126} + x^{121} + 1
+	C We will mainly use the middle part,
+	C P1 = (P + a + x^{128}) / x^64 = x^{563} + x^{62} + x^{57}
+	ALIGN(16)
+.Lpolynomial:
+	.byte 1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0xC2
+.Lbswap:
+	.byte 15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0
+.Lone:
+	.long 1,0,0,0')
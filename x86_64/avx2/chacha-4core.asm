@@ -0,0 +1,204 @@
+C x86_64/avx2/chacha-4core.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+define(`DST', `%rdi')
+define(`SRC', `%rsi')
+define(`ROUNDS', `%rdx')
+
+C Each ymm register holds one row of the state for two blocks, with
+C blocks 0 and 1 in A0-A3, and blocks 2 and 3 in B0-B3.
+define(`A0', `%ymm0')
+define(`A1', `%ymm1')
+define(`A2', `%ymm2')
+define(`A3', `%ymm3')
+define(`B0', `%ymm4')
+define(`B1', `%ymm5')
+define(`B2', `%ymm6')
+define(`B3', `%ymm7')
+define(`T', `%ymm8')
+define(`ROT16', `%ymm9')
+define(`ROT8', `%ymm10')
+define(`CTRA', `%ymm11')
+define(`CTRB', `%ymm12')
+define(`CARRY', `%ymm13')
+
+C ROTL(COUNT, REG), using T as temporary.
+define(`ROTL', `
+	vpsrld	`$'eval(32 - $1), $2, T
+	vpslld	`$'$1, $2, $2
+	vpor	T, $2, $2')
+
+C QROUND(a0, a1, a2, a3, b0, b1, b2, b3)
+C Applies the quarter round to all columns of two sets of rows.
+define(`QROUND', `
+	vpaddd	$2, $1, $1
+	vpaddd	$6, $5, $5
+	vpxor	$1, $4, $4
+	vpxor	$5, $8, $8
+	vpshufb	ROT16, $4, $4
+	vpshufb	ROT16, $8, $8
+
+	vpaddd	$4, $3, $3
+	vpaddd	$8, $7, $7
+	vpxor	$3, $2, $2
+	vpxor	$7, $6, $6
+	ROTL(12, $2)
+	ROTL(12, $6)
+
+	vpaddd	$2, $1, $1
+	vpaddd	$6, $5, $5
+	vpxor	$1, $4, $4
+	vpxor	$5, $8, $8
+	vpshufb	ROT8, $4, $4
+	vpshufb	ROT8, $8, $8
+
+	vpaddd	$4, $3, $3
+	vpaddd	$8, $7, $7
+	vpxor	$3, $2, $2
+	vpxor	$7, $6, $6
+	ROTL(7, $2)
+	ROTL(7, $6)')
+
+C COUNTER(row, cnts)
+C Adds the per-lane block numbers to the counter words of row,
+C propagating carry into the next word when enabled by CARRY. Uses
+C ROT8 as an additional temporary.
+define(`COUNTER', `
+	vmovdqa	$2, ROT8
+	vpaddd	ROT8, $1, $1
+	vpxor	.Lsign(%rip), $1, T
+	vpxor	.Lsign(%rip), ROT8, ROT8
+	vpcmpgtd	T, ROT8, T
+	vpslldq	`$'4, T, T
+	vpand	CARRY, T, T
+	vpsubd	T, $1, $1')
+
+C STORE(offset, r0, r1, r2, r3)
+C Stores the two blocks held in the given rows.
+define(`STORE', `
+	vperm2i128	`$'0x20, $3, $2, T
+	vmovdqu	T, $1(DST)
+	vperm2i128	`$'0x20, $5, $4, T
+	vmovdqu	T, eval($1 + 32)(DST)
+	vperm2i128	`$'0x31, $3, $2, T
+	vmovdqu	T, eval($1 + 64)(DST)
+	vperm2i128	`$'0x31, $5, $4, T
+	vmovdqu	T, eval($1 + 96)(DST)')
+
+	.file "chacha-4core.asm"
+
+	C _chacha_4core(uint32_t *dst, const uint32_t *src, unsigned rounds)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_chacha_4core)
+	W64_ENTRY(3, 14)
+	vpcmpeqd	CARRY, CARRY, CARRY	C Apply counter carries
+
+.Lshared_entry:
+	vbroadcasti128	48(SRC), CTRA
+	vmovdqa	CTRA, CTRB
+	COUNTER(CTRA, .Lcnts(%rip))
+	COUNTER(CTRB, .Lcnts+32(%rip))
+
+	vbroadcasti128	(SRC), A0
+	vbroadcasti128	16(SRC), A1
+	vbroadcasti128	32(SRC), A2
+	vmovdqa	CTRA, A3
+	vmovdqa	A0, B0
+	vmovdqa	A1, B1
+	vmovdqa	A2, B2
+	vmovdqa	CTRB, B3
+
+	vmovdqa	.Lrot16(%rip), ROT16
+	vmovdqa	.Lrot8(%rip), ROT8
+
+	shrl	$1, XREG(ROUNDS)
+
+	ALIGN(16)
+.Loop:
+	QROUND(A0, A1, A2, A3, B0, B1, B2, B3)
+	vpshufd	$0x39, A1, A1
+	vpshufd	$0x39, B1, B1
+	vpshufd	$0x4e, A2, A2
+	vpshufd	$0x4e, B2, B2
+	vpshufd	$0x93, A3, A3
+	vpshufd	$0x93, B3, B3
+
+	QROUND(A0, A1, A2, A3, B0, B1, B2, B3)
+	vpshufd	$0x93, A1, A1
+	vpshufd	$0x93, B1, B1
+	vpshufd	$0x4e, A2, A2
+	vpshufd	$0x4e, B2, B2
+	vpshufd	$0x39, A3, A3
+	vpshufd	$0x39, B3, B3
+
+	decl	XREG(ROUNDS)
+	jnz	.Loop
+
+	vbroadcasti128	(SRC), T
+	vpaddd	T, A0, A0
+	vpaddd	T, B0, B0
+	vbroadcasti128	16(SRC), T
+	vpaddd	T, A1, A1
+	vpaddd	T, B1, B1
+	vbroadcasti128	32(SRC), T
+	vpaddd	T, A2, A2
+	vpaddd	T, B2, B2
+	vpaddd	CTRA, A3, A3
+	vpaddd	CTRB, B3, B3
+
+	STORE(0, A0, A1, A2, A3)
+	STORE(128, B0, B1, B2, B3)
+
+	vzeroupper
+	W64_EXIT(3, 14)
+	ret
+EPILOGUE(_nettle_chacha_4core)
+
+	ALIGN(16)
+PROLOGUE(_nettle_chacha_4core32)
+	W64_ENTRY(3, 14)
+	vpxor	CARRY, CARRY, CARRY	C Ignore counter carries
+	jmp	.Lshared_entry
+EPILOGUE(_nettle_chacha_4core32)
+
+	RODATA
+	ALIGN(32)
+.Lcnts:	.long	0,0,0,0, 1,0,0,0, 2,0,0,0, 3,0,0,0
+.Lsign:	.long	0x80000000,0x80000000,0x80000000,0x80000000
+	.long	0x80000000,0x80000000,0x80000000,0x80000000
+.Lrot16:
+	.byte	2,3,0,1, 6,7,4,5, 10,11,8,9, 14,15,12,13
+	.byte	2,3,0,1, 6,7,4,5, 10,11,8,9, 14,15,12,13
+.Lrot8:
+	.byte	3,0,1,2, 7,4,5,6, 11,8,9,10, 15,12,13,14
+	.byte	3,0,1,2, 7,4,5,6, 11,8,9,10, 15,12,13,14
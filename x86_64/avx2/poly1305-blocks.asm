@@ -0,0 +1,362 @@
+C x86_64/avx2/poly1305-blocks.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "poly1305-blocks.asm"
+
+define(`CTX', `%rdi') C First argument to all functions
+define(`BLOCKS', `%rsi')
+define(`MP_PARAM', `%rdx')	C Moved to MP, to not collide with mul instruction.
+
+define(`MP', `%r8')		C May clobber, both with unix and windows conventions.
+define(`T0', `%rbx')
+define(`T1', `%rcx')
+define(`H0', `%rbp')
+define(`H1', `%r9')
+define(`H2', `%r10')
+define(`F0', `%r11')
+define(`F1', `%r12')
+
+C Used only by the vectorized code.
+define(`COUNT', `%rcx')
+define(`L0', `%rax')
+define(`L1', `%rdx')
+define(`L2', `%r9')
+define(`L3', `%r10')
+define(`L4', `%r11')
+
+C The vectorized code represents numbers using five limbs of 26
+C bits, each limb in a 64-bit element, with one ymm register per
+C limb, and four independent accumulators in the four elements.
+define(`A', `%ymm`'$1')		C Accumulator, %ymm0-%ymm4
+define(`AX', `%xmm`'$1')
+define(`D', `%ymm`'eval(5 + $1)')	C Products, %ymm5-%ymm9
+define(`T', `%ymm10')
+define(`TX', `%xmm10')
+define(`T2', `%ymm11')
+define(`MASK', `%ymm12')
+define(`ML', `%ymm13')
+define(`MLX', `%xmm13')
+define(`MH', `%ymm14')
+define(`MHX', `%xmm14')
+define(`HIBIT', `%ymm15')
+
+C Tables on the stack, each holding limbs r_0, ..., r_4 and 5 r_1,
+C ..., 5 r_4 of a multiplier, in 9 ymm words.
+define(`TABLE_P', 0)		C r, in all elements
+define(`TABLE_F', 288)		C r^4, r^2, r^3, r, one power per element
+define(`TABLE_R4', 576)		C r^4, in all elements
+define(`FRAME_SIZE', 864)
+
+C TR(table, j), TS(table, j)
+define(`TR', `eval($1 + 32*$2)(%rsp)')
+define(`TS', `eval($1 + 32*(4 + $2))(%rsp)')
+
+C STORE_TABLE(table)
+C Stores A(0), ..., A(4) and their multiples by 5.
+define(`STORE_TABLE', `
+	vmovdqa	A(0), TR($1, 0)
+forloop(`ti', 1, 4, `
+	vmovdqa	A(ti), TR($1, ti)
+	vpsllq	`$'2, A(ti), T
+	vpaddq	A(ti), T, T
+	vmovdqa	T, TS($1, ti)')')
+
+C MUL(table)
+C Multiplies A by the table, with unreduced products in D, using
+C d_k = sum_{i <= k} a_i r_{k-i} + sum_{i > k} a_i 5 r_{5+k-i}.
+define(`MUL', `
+forloop(`mk', 0, 4, `
+	vpmuludq	TR($1, mk), A(0), D(mk)')
+forloop(`mi', 1, 4, `forloop(`mk', 0, 4, `
+	vpmuludq	ifelse(eval(mi <= mk), 1,
+		`TR($1, eval(mk - mi))', `TS($1, eval(5 + mk - mi))'), A(mi), T
+	vpaddq	T, D(mk), D(mk)')')')
+
+C CARRY
+C Partially reduces the products in D, with the result in A. All
+C limbs except a_1 end up less than 2^26.
+define(`CARRY', `
+	vpsrlq	`$'26, D(0), T
+	vpand	MASK, D(0), A(0)
+	vpaddq	T, D(1), D(1)
+	vpsrlq	`$'26, D(1), T
+	vpand	MASK, D(1), A(1)
+	vpaddq	T, D(2), D(2)
+	vpsrlq	`$'26, D(2), T
+	vpand	MASK, D(2), A(2)
+	vpaddq	T, D(3), D(3)
+	vpsrlq	`$'26, D(3), T
+	vpand	MASK, D(3), A(3)
+	vpaddq	T, D(4), D(4)
+	vpsrlq	`$'26, D(4), T
+	vpand	MASK, D(4), A(4)
+	vpsllq	`$'2, T, T2
+	vpaddq	T, A(0), A(0)
+	vpaddq	T2, A(0), A(0)
+	vpsrlq	`$'26, A(0), T
+	vpand	MASK, A(0), A(0)
+	vpaddq	T, A(1), A(1)')
+
+C SPLIT(lo, hi, reg)
+C Splits the 128-bit numbers in lo and hi into limbs reg(0), ...,
+C reg(4). Clobbers lo.
+define(`SPLIT', `
+	vpand	MASK, $1, $3(0)
+	vpsrlq	`$'26, $1, $3(1)
+	vpand	MASK, $3(1), $3(1)
+	vpsrlq	`$'52, $1, $1
+	vpsllq	`$'12, $2, $3(2)
+	vpor	$1, $3(2), $3(2)
+	vpand	MASK, $3(2), $3(2)
+	vpsrlq	`$'14, $2, $3(3)
+	vpand	MASK, $3(3), $3(3)
+	vpsrlq	`$'40, $2, $3(4)')
+
+C HSUM(i, reg)
+C Adds together the four elements of A(i), result in reg.
+define(`HSUM', `
+	vextracti128	`$'1, A($1), TX
+	vpaddq	TX, AX($1), AX($1)
+	vpshufd	`$'0x4e, AX($1), TX
+	vpaddq	TX, AX($1), AX($1)
+	vmovq	AX($1), $2')
+
+C const uint8_t *
+C _nettle_poly1305_blocks (struct poly1305_ctx *ctx, size_t blocks, const uint8_t *m)
+
+	C Large inputs are processed four blocks at a time, using the
+	C powers r^2, r^3 and r^4, computed on each call. The
+	C remaining blocks are processed one at a time.
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_poly1305_blocks)
+	W64_ENTRY(3, 16)
+	mov	MP_PARAM, MP
+	cmp	$32, BLOCKS
+	jc	.Lscalar
+
+	push	%rbp
+	mov	%rsp, %rbp
+	sub	$FRAME_SIZE, %rsp
+	and	$-32, %rsp
+
+	vpbroadcastq	.Lmask26(%rip), MASK
+	vpbroadcastq	.Lhibit(%rip), HIBIT
+
+	vpbroadcastq	P1305_R0 (CTX), ML
+	vpbroadcastq	P1305_R1 (CTX), MH
+	SPLIT(ML, MH, `A')
+	STORE_TABLE(TABLE_P)
+	MUL(TABLE_P)
+	CARRY			C r^2 in all elements
+
+	C Multiply (r^2, r^2, r^2, r) by (r^2, 1, r, 1)
+	vpxor	T2, T2, T2
+	vpblendd	$0x30, TR(TABLE_P, 0), A(0), T
+	vpblendd	$0xcc, .Lone(%rip), T, T
+	vmovdqa	T, TR(TABLE_F, 0)
+forloop(`i', 1, 4, `
+	vpblendd	$0x30, TR(TABLE_P, i), A(i), T
+	vpblendd	$0xcc, T2, T, T
+	vmovdqa	T, TR(TABLE_F, i)
+	vpsllq	$2, T, D(0)
+	vpaddq	T, D(0), D(0)
+	vmovdqa	D(0), TS(TABLE_F, i)')
+forloop(`i', 0, 4, `
+	vpblendd	$0xc0, TR(TABLE_P, i), A(i), A(i)')
+	MUL(TABLE_F)
+	CARRY
+	STORE_TABLE(TABLE_F)
+forloop(`i', 0, 4, `
+	vpermq	$0, A(i), A(i)')
+	STORE_TABLE(TABLE_R4)
+
+	C Fold the high bits of h, and split it into limbs.
+	mov	P1305_H2 (CTX), T1
+	mov	T1, %rax
+	shr	$2, %rax
+	and	$3, T1
+	lea	(%rax, %rax, 4), %rax
+	add	P1305_H0 (CTX), %rax
+	mov	P1305_H1 (CTX), %rdx
+	adc	$0, %rdx
+	adc	$0, T1
+	vmovq	%rax, MLX
+	vmovq	%rdx, MHX
+	SPLIT(ML, MH, `A')
+	shl	$24, T1
+	vmovq	T1, TX
+	vpaddq	T, A(4), A(4)
+
+	mov	BLOCKS, COUNT
+	shr	$2, COUNT
+	and	$3, BLOCKS
+
+	C Message blocks are loaded with blocks 0 and 2 in the low
+	C half, and blocks 1 and 3 in the high half. Hence the order of
+	C the powers in TABLE_F.
+	ALIGN(16)
+.Lvloop:
+	vmovdqu	(MP), T
+	vmovdqu	32(MP), T2
+	vpunpcklqdq	T2, T, ML
+	vpunpckhqdq	T2, T, MH
+	add	$64, MP
+	SPLIT(ML, MH, `D')
+forloop(`i', 0, 4, `
+	vpaddq	D(i), A(i), A(i)')
+	vpaddq	HIBIT, A(4), A(4)
+	dec	COUNT
+	jz	.Lvdone
+	MUL(TABLE_R4)
+	CARRY
+	jmp	.Lvloop
+
+.Lvdone:
+	MUL(TABLE_F)
+	CARRY
+
+	HSUM(0, L0)
+	HSUM(1, L1)
+	HSUM(2, L2)
+	HSUM(3, L3)
+	HSUM(4, L4)
+	vzeroupper
+
+	C Convert to radix 2^64, as L0 + 2^26 L1 + 2^52 L2 + 2^78 L3
+	C + 2^104 L4, with the limbs less than 2^29.
+	shl	$26, L1
+	add	L1, L0
+	mov	L2, L1
+	shl	$52, L1
+	shr	$12, L2
+	add	L1, L0
+	adc	$0, L2
+	shl	$14, L3
+	add	L3, L2
+	mov	L4, L3
+	shl	$40, L3
+	shr	$24, L4
+	add	L3, L2
+	adc	$0, L4
+
+	mov	L0, P1305_H0 (CTX)
+	mov	L2, P1305_H1 (CTX)
+	mov	L4, P1305_H2 (CTX)
+
+	mov	%rbp, %rsp
+	pop	%rbp
+
+.Lscalar:
+	test	BLOCKS, BLOCKS
+	jz	.Lend
+
+	push 	%rbx
+	push 	%rbp
+	push	%r12
+	mov	P1305_H0 (CTX), H0
+	mov	P1305_H1 (CTX), H1
+	mov	P1305_H2 (CTX), H2
+	ALIGN(16)
+.Loop:
+	mov	(MP), T0
+	mov	8(MP), T1
+	add	$16, MP
+
+	add	H0, T0
+	adc	H1, T1
+	adc	$1, H2
+
+	mov	P1305_R1 (CTX), %rax
+	mul	T0			C R1*T0
+	mov	%rax, F0
+	mov	%rdx, F1
+
+	mov	T0, %rax		C Last use of T0 input
+	mov	P1305_R0 (CTX), T0
+	mul	T0			C R0*T0
+	mov	%rax, H0
+	mov	%rdx, H1
+
+	mov	T1, %rax
+	mul	T0			C R0*T1
+	add	%rax, F0
+	adc	%rdx, F1
+
+	mov	P1305_S1 (CTX), T0
+	mov	T1, %rax		C Last use of T1 input
+	mul	T0			C S1*T1
+	add	%rax, H0
+	adc	%rdx, H1
+
+	mov	H2, %rax
+	mul	T0			C S1*H2
+	add	%rax, F0
+	adc	%rdx, F1
+
+	mov	H2, T0
+	and	$3, H2
+
+	shr	$2, T0
+	mov	P1305_S0 (CTX), %rax
+	mul	T0			C S0*(H2 >> 2)
+	add	%rax, H0
+	adc	%rdx, H1
+
+	imul	P1305_R0 (CTX), H2	C R0*(H2 & 3)
+	add 	F0, H1
+	adc	F1, H2
+
+	dec	BLOCKS
+	jnz	.Loop
+
+	mov	H0, P1305_H0 (CTX)
+	mov	H1, P1305_H1 (CTX)
+	mov	H2, P1305_H2 (CTX)
+
+	pop	%r12
+	pop	%rbp
+	pop 	%rbx
+
+.Lend:
+	mov	MP, %rax
+	W64_EXIT(3, 16)
+	ret
+EPILOGUE(_nettle_poly1305_blocks)
+
+	RODATA
+	ALIGN(32)
+.Lone:	.quad	1,1,1,1
+.Lmask26:
+	.quad	0x3ffffff
+.Lhibit:
+	.quad	0x1000000
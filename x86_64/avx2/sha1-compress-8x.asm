@@ -0,0 +1,133 @@
+C x86_64/avx2/sha1-compress-8x.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "sha1-compress-8x.asm"
+
+include_src(`x86_64/sha-many.m4')
+
+define(`STATE', `%rdi')
+define(`INPUT', `%rsi')
+
+C Register holding state word i (a = 0, ..., e = 4) in round t.
+define(`SR', `%ymm`'eval((80 + $1 - $2) % 5)')
+define(`T1', `%ymm8')
+define(`T2', `%ymm9')
+define(`KT', `%ymm10')
+
+C Message schedule, word i of all blocks.
+define(`W', `eval(32*(($1) % 16))(%rsp)')
+
+C EXPAND(t), for t >= 16
+C W[t] = (W[t-3] ^ W[t-8] ^ W[t-14] ^ W[t-16]) <<< 1
+define(`EXPAND', `
+	vmovdqa	W(eval($1 + 13)), T1
+	vpxor	W(eval($1 + 8)), T1, T1
+	vpxor	W(eval($1 + 2)), T1, T1
+	vpxor	W($1), T1, T1
+	vpsrld	`$'31, T1, T2
+	vpslld	`$'1, T1, T1
+	vpor	T2, T1, T1
+	vmovdqa	T1, W($1)')
+
+C Round functions, F(b, c, d), leaving the result in T1.
+define(`F1', `
+	vpand	$2, $1, T1
+	vpandn	$3, $1, T2
+	vpxor	T2, T1, T1')
+define(`F2', `
+	vpxor	$2, $1, T1
+	vpxor	$3, T1, T1')
+define(`F3', `
+	vpor	$2, $1, T1
+	vpand	$3, T1, T1
+	vpand	$2, $1, T2
+	vpor	T2, T1, T1')
+
+C ROUND(a, b, c, d, e, t)
+C
+C e += (a <<< 5) + f(b, c, d) + K + W[t]
+C b <<<= 30
+define(`ROUND', `ifelse(eval($6 >= 16), 1, `EXPAND($6)')
+ifelse(eval($6 % 20), 0, `
+	vpbroadcastd	.LK+eval(4*($6 / 20))(%rip), KT')
+	vpslld	`$'5, $1, T1
+	vpsrld	`$'27, $1, T2
+	vpor	T2, T1, T1
+	vpaddd	T1, $5, $5
+	ifelse(eval($6 < 20), 1, `F1($2, $3, $4)',
+	       eval($6 >= 40 && $6 < 60), 1, `F3($2, $3, $4)',
+	       `F2($2, $3, $4)')
+	vpaddd	T1, $5, $5
+	vpaddd	W($6), KT, T1
+	vpaddd	T1, $5, $5
+	vpslld	`$'30, $2, T1
+	vpsrld	`$'2, $2, $2
+	vpor	T1, $2, $2')
+
+	C _sha1_compress_8x(uint32_t *state, const uint8_t * const *input)
+	C The state is word-major, with word i of all 8 lanes at
+	C state[8*i], ..., state[8*i + 7].
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_sha1_compress_8x)
+	W64_ENTRY(2, 16)
+	push	%rbp
+	mov	%rsp, %rbp
+	sub	$512, %rsp
+	and	$-32, %rsp
+
+	SHA_LOAD_8X(INPUT, .Lbswap(%rip), `W')
+
+forloop(`i', 0, 4, `
+	vmovdqu	eval(32*i)(STATE), %ymm`'i')
+
+forloop(`t', 0, 79, `
+	ROUND(SR(0, t), SR(1, t), SR(2, t), SR(3, t), SR(4, t), t)')
+
+forloop(`i', 0, 4, `
+	vpaddd	eval(32*i)(STATE), %ymm`'i, %ymm`'i
+	vmovdqu	%ymm`'i, eval(32*i)(STATE)')
+
+	vzeroupper
+	mov	%rbp, %rsp
+	pop	%rbp
+	W64_EXIT(2, 16)
+	ret
+EPILOGUE(_nettle_sha1_compress_8x)
+
+	RODATA
+	ALIGN(32)
+.Lbswap:
+	.byte	3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12
+	.byte	3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12
+.LK:
+	.long	0x5A827999,0x6ED9EBA1,0x8F1BBCDC,0xCA62C1D6
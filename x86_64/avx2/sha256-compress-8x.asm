@@ -0,0 +1,175 @@
+C x86_64/avx2/sha256-compress-8x.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "sha256-compress-8x.asm"
+
+include_src(`x86_64/sha-many.m4')
+
+define(`STATE', `%rdi')
+define(`INPUT', `%rsi')
+
+C Register holding state word i (a = 0, ..., h = 7) in round t.
+define(`SR', `%ymm`'eval((64 + $1 - $2) % 8)')
+define(`T1', `%ymm8')
+define(`T2', `%ymm9')
+define(`T3', `%ymm10')
+define(`T4', `%ymm11')
+
+C Message schedule, word i of all blocks.
+define(`W', `eval(32*(($1) % 16))(%rsp)')
+
+C EXPAND(t), for t >= 16
+C W[t] = s1(W[t-2]) + W[t-7] + s0(W[t-15]) + W[t-16]
+define(`EXPAND', `
+	vmovdqa	W(eval($1 + 1)), T3
+	vpsrld	`$'3, T3, T1
+	vpsrld	`$'7, T3, T2
+	vpxor	T2, T1, T1
+	vpslld	`$'14, T3, T2
+	vpxor	T2, T1, T1
+	vpsrld	`$'18, T3, T2
+	vpxor	T2, T1, T1
+	vpslld	`$'25, T3, T2
+	vpxor	T2, T1, T1
+	vpaddd	W($1), T1, T1
+	vpaddd	W(eval($1 + 9)), T1, T1
+	vmovdqa	W(eval($1 + 14)), T3
+	vpsrld	`$'10, T3, T4
+	vpsrld	`$'17, T3, T2
+	vpxor	T2, T4, T4
+	vpslld	`$'13, T3, T2
+	vpxor	T2, T4, T4
+	vpsrld	`$'19, T3, T2
+	vpxor	T2, T4, T4
+	vpslld	`$'15, T3, T2
+	vpxor	T2, T4, T4
+	vpaddd	T4, T1, T1
+	vmovdqa	T1, W($1)')
+
+C ROUND(a, b, c, d, e, f, g, h, t)
+C
+C h += S1(e) + Choice(e,f,g) + K[t] + W[t]
+C d += h
+C h += S0(a) + Majority(a,b,c)
+define(`ROUND', `ifelse(eval($9 >= 16), 1, `EXPAND($9)')
+	vpsrld	`$'6, $5, T1
+	vpslld	`$'26, $5, T2
+	vpxor	T2, T1, T1
+	vpsrld	`$'11, $5, T2
+	vpxor	T2, T1, T1
+	vpslld	`$'21, $5, T2
+	vpxor	T2, T1, T1
+	vpsrld	`$'25, $5, T2
+	vpxor	T2, T1, T1
+	vpslld	`$'7, $5, T2
+	vpxor	T2, T1, T1
+	vpaddd	T1, $8, $8
+	vpand	$6, $5, T1
+	vpandn	$7, $5, T2
+	vpxor	T2, T1, T1
+	vpaddd	T1, $8, $8
+	vpbroadcastd	.LK+eval(4*$9)(%rip), T1
+	vpaddd	W($9), T1, T1
+	vpaddd	T1, $8, $8
+	vpaddd	$8, $4, $4
+	vpsrld	`$'2, $1, T1
+	vpslld	`$'30, $1, T2
+	vpxor	T2, T1, T1
+	vpsrld	`$'13, $1, T2
+	vpxor	T2, T1, T1
+	vpslld	`$'19, $1, T2
+	vpxor	T2, T1, T1
+	vpsrld	`$'22, $1, T2
+	vpxor	T2, T1, T1
+	vpslld	`$'10, $1, T2
+	vpxor	T2, T1, T1
+	vpaddd	T1, $8, $8
+	vpor	$2, $1, T1
+	vpand	$3, T1, T1
+	vpand	$2, $1, T2
+	vpor	T2, T1, T1
+	vpaddd	T1, $8, $8')
+
+	C _sha256_compress_8x(uint32_t *state, const uint8_t * const *input)
+	C The state is word-major, with word i of all 8 lanes at
+	C state[8*i], ..., state[8*i + 7].
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_sha256_compress_8x)
+	W64_ENTRY(2, 16)
+	push	%rbp
+	mov	%rsp, %rbp
+	sub	$512, %rsp
+	and	$-32, %rsp
+
+	SHA_LOAD_8X(INPUT, .Lbswap(%rip), `W')
+
+forloop(`i', 0, 7, `
+	vmovdqu	eval(32*i)(STATE), %ymm`'i')
+
+forloop(`t', 0, 63, `
+	ROUND(SR(0, t), SR(1, t), SR(2, t), SR(3, t),
+	      SR(4, t), SR(5, t), SR(6, t), SR(7, t), t)')
+
+forloop(`i', 0, 7, `
+	vpaddd	eval(32*i)(STATE), %ymm`'i, %ymm`'i
+	vmovdqu	%ymm`'i, eval(32*i)(STATE)')
+
+	vzeroupper
+	mov	%rbp, %rsp
+	pop	%rbp
+	W64_EXIT(2, 16)
+	ret
+EPILOGUE(_nettle_sha256_compress_8x)
+
+	RODATA
+	ALIGN(32)
+.Lbswap:
+	.byte	3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12
+	.byte	3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12
+.LK:
+	.long	0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5
+	.long	0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5
+	.long	0xd807aa98,0x12835b01,0x243185be,0x550c7dc3
+	.long	0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174
+	.long	0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc
+	.long	0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da
+	.long	0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7
+	.long	0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967
+	.long	0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13
+	.long	0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85
+	.long	0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3
+	.long	0xd192e819,0xd6990624,0xf40e3585,0x106aa070
+	.long	0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5
+	.long	0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3
+	.long	0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208
+	.long	0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
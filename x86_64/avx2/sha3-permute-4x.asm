@@ -0,0 +1,104 @@
+C x86_64/avx2/sha3-permute-4x.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "sha3-permute-4x.asm"
+
+include_src(`x86_64/sha3-many.m4')
+
+define(`STATE', `%rdi')		C 25 words for each of 4 states, word-major
+
+C The state is kept in memory, and each round reads and writes each
+C lane once. Lane i after r rounds is stored in slot pi^-r(i), see
+C sha3-many.m4.
+define(`SLOT', `eval(32 * KECCAK_LANE($1, $2))(STATE)')
+
+C Column parities, and the D values of the theta step
+define(`CP', `%ymm`'$1')
+define(`D', `%ymm`'eval(5 + $1)')
+C One row, after the theta, rho and pi steps
+define(`B', `%ymm`'eval(10 + $1)')
+define(`T', `%ymm15')
+
+C ROTL(count, x, tmp)
+define(`ROTL', `ifelse($1, 0, , `
+	vpsllq	`$'$1, $2, $3
+	vpsrlq	`$'eval(64 - $1), $2, $2
+	vpor	$3, $2, $2')')
+
+C ROUND(r)
+C Expects the column parities in CP(0), ..., CP(4), and, except for
+C the last round, leaves the column parities of the output there.
+C The rows are processed one at a time, reading each lane once and
+C storing it back to the same slot. CP(1) is used as a temporary
+C for the iota step, before it is assigned.
+define(`ROUND', `
+forloop(`x', 0, 4, `
+	vpsrlq	`$'63, CP(eval((x + 1) % 5)), T
+	vpsllq	`$'1, CP(eval((x + 1) % 5)), D(x)
+	vpor	T, D(x), D(x)
+	vpxor	CP(eval((x + 4) % 5)), D(x), D(x)')
+forloop(`y', 0, 4, `
+forloop(`x', 0, 4, `
+	vpxor	SLOT($1, KECCAK_PI_INV(eval(x + 5*y))), D(eval(KECCAK_PI_INV(eval(x + 5*y)) % 5)), B(x)
+	ROTL(KECCAK_RHO(KECCAK_PI_INV(eval(x + 5*y))), B(x), T)')
+forloop(`x', 0, 4, `
+	vpandn	B(eval((x + 2) % 5)), B(eval((x + 1) % 5)), T
+	vpxor	B(x), T, T
+ifelse(eval(x + y), 0, `
+	vpbroadcastq	eval(8*$1)+.Lrc(%rip), CP(1)
+	vpxor	CP(1), T, T')
+	vmovdqu	T, SLOT(eval($1 + 1), eval(x + 5*y))
+ifelse($1, 23, , `
+	ifelse(y, 0, `vmovdqa	T, CP(x)', `vpxor	T, CP(x), CP(x)')')')')')
+
+	C _nettle_sha3_permute_4x(uint64_t *state)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_sha3_permute_4x)
+	W64_ENTRY(1, 16)
+forloop(`x', 0, 4, `
+	vmovdqu	SLOT(0, x), CP(x)
+	vpxor	SLOT(0, eval(x + 5)), CP(x), CP(x)
+	vpxor	SLOT(0, eval(x + 10)), CP(x), CP(x)
+	vpxor	SLOT(0, eval(x + 15)), CP(x), CP(x)
+	vpxor	SLOT(0, eval(x + 20)), CP(x), CP(x)')
+
+forloop(`r', 0, 23, `
+	ROUND(r)')
+
+	vzeroupper
+	W64_EXIT(1, 16)
+	ret
+EPILOGUE(_nettle_sha3_permute_4x)
+
+	RODATA
+	KECCAK_RC
@@ -0,0 +1,245 @@
+C x86_64/avx2/sha512-compress.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "sha512-compress.asm"
+define(`STATE', `%rdi')
+define(`INPUT', `%rsi')
+define(`K', `%rdx')
+define(`SA', `%rax')
+define(`SB', `%rbx')
+define(`SC', `%rcx')
+define(`SD', `%r8')
+define(`SE', `%r9')
+define(`SF', `%r10')
+define(`SG', `%r11')
+define(`SH', `%r12')
+define(`T0', `%r13')
+define(`T1', `%r14')
+define(`T2', `%r15')
+define(`COUNT', `%rbp')
+
+C Message words 2i, 2i+1, in %xmm<i>. The schedule is computed
+C with sse instructions, two words at a time, and W + K is stored
+C on the stack for use by the rounds.
+define(`X', `%xmm`'eval(($1) % 8)')
+define(`XT0', `%xmm8')
+define(`XT1', `%xmm9')
+define(`XT2', `%xmm10')
+define(`BSWAP', `%xmm11')
+define(`WK', `eval(8*(($1) % 16))(%rsp)')
+
+C EXPN(i)
+C Computes message words 16 + 2i and 17 + 2i, replacing X(i), and
+C stores W + K for those words. Uses
+C
+C s0(W) = W>>>1 ^ W>>>8 ^ W>>7
+C s1(W) = W>>>19 ^ W>>>61 ^ W>>6
+define(`EXPN', `
+	vpalignr	`$'8, X($1), X(eval($1 + 1)), XT0
+	vpsrlq	`$'1, XT0, XT1
+	vpsllq	`$'63, XT0, XT2
+	vpxor	XT2, XT1, XT1
+	vpsrlq	`$'8, XT0, XT2
+	vpxor	XT2, XT1, XT1
+	vpsllq	`$'56, XT0, XT2
+	vpxor	XT2, XT1, XT1
+	vpsrlq	`$'7, XT0, XT2
+	vpxor	XT2, XT1, XT1
+	vpaddq	XT1, X($1), X($1)
+	vpalignr	`$'8, X(eval($1 + 4)), X(eval($1 + 5)), XT0
+	vpaddq	XT0, X($1), X($1)
+	vpsrlq	`$'19, X(eval($1 + 7)), XT1
+	vpsllq	`$'45, X(eval($1 + 7)), XT2
+	vpxor	XT2, XT1, XT1
+	vpsrlq	`$'61, X(eval($1 + 7)), XT2
+	vpxor	XT2, XT1, XT1
+	vpsllq	`$'3, X(eval($1 + 7)), XT2
+	vpxor	XT2, XT1, XT1
+	vpsrlq	`$'6, X(eval($1 + 7)), XT2
+	vpxor	XT2, XT1, XT1
+	vpaddq	XT1, X($1), X($1)
+	vpaddq	eval(128 + 16*$1)(K), X($1), XT0
+	vmovdqu	XT0, WK(eval(2*$1))
+')
+
+C ROUND(A,B,C,D,E,F,G,H,i)
+C
+C H += S1(E) + Choice(E,F,G) + K + W
+C D += H
+C H += S0(A) + Majority(A,B,C)
+C
+C Where
+C
+C S1(E) = E>>>14 ^ E>>>18 ^ E>>>41
+C S0(A) = A>>>28 ^ A>>>34 ^ A>>>39
+C Choice (E, F, G) = (E&F) | (~E&G)
+C Majority (A,B,C) = (A & (B|C)) | (B&C)
+C
+C using the bmi2 rorx and andn instructions, which leave their
+C inputs unmodified. The order of the additions, and the form of
+C Majority, are chosen to shorten the dependency chains from E to
+C the next E, and from A to the next A.
+
+define(`ROUND', `
+	add	WK($9), $8
+	rorx	`$'14, $5, T0
+	rorx	`$'18, $5, T1
+	add	$8, $4
+	xor	T1, T0
+	rorx	`$'41, $5, T1
+	andn	$7, $5, T2
+	xor	T1, T0
+	mov	$6, T1
+	and	$5, T1
+	or	T1, T2
+	add	T2, $8
+	add	T2, $4
+	add	T0, $8
+	add	T0, $4
+
+	mov	$2, T1
+	or	$3, T1
+	mov	$2, T2
+	and	$3, T2
+	and	$1, T1
+	or	T2, T1
+	add	T1, $8
+	rorx	`$'28, $1, T0
+	rorx	`$'34, $1, T1
+	xor	T1, T0
+	rorx	`$'39, $1, T1
+	xor	T1, T0
+	add	T0, $8
+')
+
+C ROUND16(expand)
+C Sixteen rounds, optionally interleaved with computing the next
+C sixteen message words.
+define(`ROUND16', `
+	ROUND(SA,SB,SC,SD,SE,SF,SG,SH,0)
+	ROUND(SH,SA,SB,SC,SD,SE,SF,SG,1)
+	$1(0)
+	ROUND(SG,SH,SA,SB,SC,SD,SE,SF,2)
+	ROUND(SF,SG,SH,SA,SB,SC,SD,SE,3)
+	$1(1)
+	ROUND(SE,SF,SG,SH,SA,SB,SC,SD,4)
+	ROUND(SD,SE,SF,SG,SH,SA,SB,SC,5)
+	$1(2)
+	ROUND(SC,SD,SE,SF,SG,SH,SA,SB,6)
+	ROUND(SB,SC,SD,SE,SF,SG,SH,SA,7)
+	$1(3)
+	ROUND(SA,SB,SC,SD,SE,SF,SG,SH,8)
+	ROUND(SH,SA,SB,SC,SD,SE,SF,SG,9)
+	$1(4)
+	ROUND(SG,SH,SA,SB,SC,SD,SE,SF,10)
+	ROUND(SF,SG,SH,SA,SB,SC,SD,SE,11)
+	$1(5)
+	ROUND(SE,SF,SG,SH,SA,SB,SC,SD,12)
+	ROUND(SD,SE,SF,SG,SH,SA,SB,SC,13)
+	$1(6)
+	ROUND(SC,SD,SE,SF,SG,SH,SA,SB,14)
+	ROUND(SB,SC,SD,SE,SF,SG,SH,SA,15)
+	$1(7)
+')
+
+define(`NOEXPN', `')
+
+	C void
+	C _nettle_sha512_compress(uint64_t *state, const uint8_t *input, const uint64_t *k)
+
+	.text
+	ALIGN(16)
+
+PROLOGUE(_nettle_sha512_compress)
+	W64_ENTRY(3, 12)
+
+	sub	$184, %rsp
+	mov	%rbx, 128(%rsp)
+	mov	STATE, 136(%rsp)	C Save state, to free a register
+	mov	%rbp, 144(%rsp)
+	mov	%r12, 152(%rsp)
+	mov	%r13, 160(%rsp)
+	mov	%r14, 168(%rsp)
+	mov	%r15, 176(%rsp)
+
+	vmovdqa	.Lbswap(%rip), BSWAP
+forloop(`i', 0, 7, `
+	vmovdqu	eval(16*i)(INPUT), X(i)
+	vpshufb	BSWAP, X(i), X(i)
+	vpaddq	eval(16*i)(K), X(i), XT0
+	vmovdqu	XT0, WK(eval(2*i))')
+
+	mov	(STATE),   SA
+	mov	8(STATE),  SB
+	mov	16(STATE),  SC
+	mov	24(STATE), SD
+	mov	32(STATE), SE
+	mov	40(STATE), SF
+	mov	48(STATE), SG
+	mov	56(STATE), SH
+	mov	$4, COUNT
+	ALIGN(16)
+
+.Loop:
+	ROUND16(`EXPN')
+	add	$128, K
+	dec	COUNT
+	jnz	.Loop
+
+	ROUND16(`NOEXPN')
+
+	mov	136(%rsp), STATE
+	add	SA, (STATE)
+	add	SB, 8(STATE)
+	add	SC, 16(STATE)
+	add	SD, 24(STATE)
+	add	SE, 32(STATE)
+	add	SF, 40(STATE)
+	add	SG, 48(STATE)
+	add	SH, 56(STATE)
+
+	mov	128(%rsp), %rbx
+	mov	144(%rsp), %rbp
+	mov	152(%rsp), %r12
+	mov	160(%rsp), %r13
+	mov	168(%rsp), %r14
+	mov	176(%rsp), %r15
+
+	add	$184, %rsp
+	W64_EXIT(3, 12)
+	ret
+EPILOGUE(_nettle_sha512_compress)
+
+	RODATA
+	ALIGN(16)
+.Lbswap:
+	.byte	7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8
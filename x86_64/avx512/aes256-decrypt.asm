@@ -0,0 +1,160 @@
+C x86_64/avx512/aes256-decrypt.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+include_src(`x86_64/aes-vaes.m4')
+
+C Input argument
+define(`CTX',	`%rdi')
+define(`LENGTH',`%rsi')
+define(`DST',	`%rdx')
+define(`SRC',	`%rcx')
+
+define(`X0', `%zmm0')
+define(`X1', `%zmm1')
+define(`X2', `%zmm2')
+define(`X3', `%zmm3')
+define(`X4', `%zmm4')
+define(`X5', `%zmm5')
+define(`X6', `%zmm6')
+define(`X7', `%zmm7')
+define(`Y', `%ymm0')
+define(`X', `%xmm0')
+
+C Subkeys, broadcast to all four lanes, in %zmm16-%zmm30.
+define(`KEY', `%zmm`'eval(16 + $1)')
+define(`KEYY', `%ymm`'eval(16 + $1)')
+define(`KEYX', `%xmm`'eval(16 + $1)')
+
+	.file "aes256-decrypt.asm"
+
+	C nettle_aes256_decrypt(const struct aes256_ctx *ctx,
+	C                       size_t length, uint8_t *dst,
+	C                       const uint8_t *src);
+
+	C Processes 32 blocks per iteration, four blocks in each zmm
+	C register. Left-over blocks are handled first, one bit of
+	C the block count at a time.
+	.text
+	ALIGN(16)
+PROLOGUE(nettle_aes256_decrypt)
+	W64_ENTRY(4, 8)
+	shr	$4, LENGTH
+	test	LENGTH, LENGTH
+	jz	.Lend
+
+	AES_LOAD_DECRYPT_KEYS_Z(14, CTX, `KEY')
+
+	test	$1, LENGTH
+	jz	.Lx2
+	vmovdqu	(SRC), X
+	AES_CRYPT_R(vaesdec, vaesdeclast, 14, `KEYX', X)
+	vmovdqu	X, (DST)
+	add	$16, SRC
+	add	$16, DST
+
+.Lx2:
+	test	$2, LENGTH
+	jz	.Lx4
+	vmovdqu	(SRC), Y
+	AES_CRYPT_R(vaesdec, vaesdeclast, 14, `KEYY', Y)
+	vmovdqu	Y, (DST)
+	add	$32, SRC
+	add	$32, DST
+
+.Lx4:
+	test	$4, LENGTH
+	jz	.Lx8
+	vmovdqu64	(SRC), X0
+	AES_CRYPT_R(vaesdec, vaesdeclast, 14, `KEY', X0)
+	vmovdqu64	X0, (DST)
+	add	$64, SRC
+	add	$64, DST
+
+.Lx8:
+	test	$8, LENGTH
+	jz	.Lx16
+	vmovdqu64	(SRC), X0
+	vmovdqu64	64(SRC), X1
+	AES_CRYPT_R(vaesdec, vaesdeclast, 14, `KEY', X0, X1)
+	vmovdqu64	X0, (DST)
+	vmovdqu64	X1, 64(DST)
+	add	$128, SRC
+	add	$128, DST
+
+.Lx16:
+	test	$16, LENGTH
+	jz	.Lx32
+	vmovdqu64	(SRC), X0
+	vmovdqu64	64(SRC), X1
+	vmovdqu64	128(SRC), X2
+	vmovdqu64	192(SRC), X3
+	AES_CRYPT_R(vaesdec, vaesdeclast, 14, `KEY', X0, X1, X2, X3)
+	vmovdqu64	X0, (DST)
+	vmovdqu64	X1, 64(DST)
+	vmovdqu64	X2, 128(DST)
+	vmovdqu64	X3, 192(DST)
+	add	$256, SRC
+	add	$256, DST
+
+.Lx32:
+	shr	$5, LENGTH
+	jz	.Lend
+
+.Lblock_loop:
+	vmovdqu64	(SRC), X0
+	vmovdqu64	64(SRC), X1
+	vmovdqu64	128(SRC), X2
+	vmovdqu64	192(SRC), X3
+	vmovdqu64	256(SRC), X4
+	vmovdqu64	320(SRC), X5
+	vmovdqu64	384(SRC), X6
+	vmovdqu64	448(SRC), X7
+	AES_CRYPT_R(vaesdec, vaesdeclast, 14, `KEY',
+		    X0, X1, X2, X3, X4, X5, X6, X7)
+	vmovdqu64	X0, (DST)
+	vmovdqu64	X1, 64(DST)
+	vmovdqu64	X2, 128(DST)
+	vmovdqu64	X3, 192(DST)
+	vmovdqu64	X4, 256(DST)
+	vmovdqu64	X5, 320(DST)
+	vmovdqu64	X6, 384(DST)
+	vmovdqu64	X7, 448(DST)
+	add	$512, SRC
+	add	$512, DST
+	dec	LENGTH
+	jnz	.Lblock_loop
+
+.Lend:
+	vzeroupper
+	W64_EXIT(4, 8)
+	ret
+EPILOGUE(nettle_aes256_decrypt)
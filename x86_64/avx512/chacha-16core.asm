@@ -0,0 +1,158 @@
+C x86_64/avx512/chacha-16core.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+define(`DST', `%rdi')
+define(`SRC', `%rsi')
+define(`ROUNDS', `%rdx')
+
+C State word i, for all 16 blocks, in %zmm<i>, and the original
+C state words in %zmm16-%zmm31.
+define(`W', `%zmm`'$1')
+define(`O', `%zmm`'eval(16 + $1)')
+
+C Qa(s, i), ..., Qd(s, i) are the operands of quarter round i, for
+C the column round (s = 0) and the diagonal round (s = 1).
+define(`Qa', `W($2)')
+define(`Qb', `W(eval(4 + ($2 + $1) % 4))')
+define(`Qc', `W(eval(8 + ($2 + 2*$1) % 4))')
+define(`Qd', `W(eval(12 + ($2 + 3*$1) % 4))')
+
+C QSTEP(s, x, y, z, count)
+C One add-xor-rotate step of all four quarter rounds, with x += y,
+C z ^= x and z <<<= count.
+define(`QSTEP', `
+forloop(`qi', 0, 3, `
+	vpaddd	Q$3($1, qi), Q$2($1, qi), Q$2($1, qi)')
+forloop(`qi', 0, 3, `
+	vpxord	Q$2($1, qi), Q$4($1, qi), Q$4($1, qi)')
+forloop(`qi', 0, 3, `
+	vprold	`$'$5, Q$4($1, qi), Q$4($1, qi)')')
+
+C QROUND(s)
+define(`QROUND', `
+	QSTEP($1, a, b, d, 16)
+	QSTEP($1, c, d, b, 12)
+	QSTEP($1, a, b, d, 8)
+	QSTEP($1, c, d, b, 7)')
+
+C TRANSPOSE_WORDS(r0, r1, r2, r3, t0, t1, t2, t3)
+C Transposes the 4x4 matrix of words in each 128-bit lane.
+define(`TRANSPOSE_WORDS', `
+	vpunpckldq	$2, $1, $5
+	vpunpckhdq	$2, $1, $6
+	vpunpckldq	$4, $3, $7
+	vpunpckhdq	$4, $3, $8
+	vpunpcklqdq	$7, $5, $1
+	vpunpckhqdq	$7, $5, $2
+	vpunpcklqdq	$8, $6, $3
+	vpunpckhqdq	$8, $6, $4')
+
+C STORE_LANES(offset, r0, r1, r2, r3, t0, t1, t2, t3)
+C Transposes the 4x4 matrix of 128-bit lanes, and stores the rows
+C 256 bytes apart.
+define(`STORE_LANES', `
+	vshufi64x2	`$'0x44, $3, $2, $6
+	vshufi64x2	`$'0xee, $3, $2, $7
+	vshufi64x2	`$'0x44, $5, $4, $8
+	vshufi64x2	`$'0xee, $5, $4, $9
+	vshufi64x2	`$'0x88, $8, $6, $2
+	vshufi64x2	`$'0xdd, $8, $6, $3
+	vshufi64x2	`$'0x88, $9, $7, $4
+	vshufi64x2	`$'0xdd, $9, $7, $5
+	vmovdqu32	$2, $1(DST)
+	vmovdqu32	$3, eval($1 + 256)(DST)
+	vmovdqu32	$4, eval($1 + 512)(DST)
+	vmovdqu32	$5, eval($1 + 768)(DST)')
+
+	.file "chacha-16core.asm"
+
+	C _chacha_16core(uint32_t *dst, const uint32_t *src, unsigned rounds)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_chacha_16core)
+	W64_ENTRY(3, 16)
+	kxnorw	%k2, %k2, %k2	C Apply counter carries
+
+.Lshared_entry:
+forloop(`ci', 0, 15, `
+	vpbroadcastd	eval(4*ci)(SRC), O(ci)')
+
+	C Add block numbers to the counter, and propagate carries
+	C for lanes where the low word wrapped around.
+	vpaddd	.Lcnts(%rip), O(12), O(12)
+	vpcmpltud	.Lcnts(%rip), O(12), %k1{%k2}
+	vpaddd	.Lone(%rip){1to16}, O(13), O(13){%k1}
+
+forloop(`ci', 0, 15, `
+	vmovdqa32	O(ci), W(ci)')
+
+	shrl	$1, XREG(ROUNDS)
+
+	ALIGN(16)
+.Loop:
+	QROUND(0)
+	QROUND(1)
+
+	decl	XREG(ROUNDS)
+	jnz	.Loop
+
+forloop(`ci', 0, 15, `
+	vpaddd	O(ci), W(ci), W(ci)')
+
+	C After transposing words within lanes, register 4k + m holds
+	C words 4k, ..., 4k+3 of blocks m, m + 4, m + 8, m + 12.
+	TRANSPOSE_WORDS(W(0), W(1), W(2), W(3), O(0), O(1), O(2), O(3))
+	TRANSPOSE_WORDS(W(4), W(5), W(6), W(7), O(0), O(1), O(2), O(3))
+	TRANSPOSE_WORDS(W(8), W(9), W(10), W(11), O(0), O(1), O(2), O(3))
+	TRANSPOSE_WORDS(W(12), W(13), W(14), W(15), O(0), O(1), O(2), O(3))
+
+	STORE_LANES(0, W(0), W(4), W(8), W(12), O(0), O(1), O(2), O(3))
+	STORE_LANES(64, W(1), W(5), W(9), W(13), O(0), O(1), O(2), O(3))
+	STORE_LANES(128, W(2), W(6), W(10), W(14), O(0), O(1), O(2), O(3))
+	STORE_LANES(192, W(3), W(7), W(11), W(15), O(0), O(1), O(2), O(3))
+
+	vzeroupper
+	W64_EXIT(3, 16)
+	ret
+EPILOGUE(_nettle_chacha_16core)
+
+	ALIGN(16)
+PROLOGUE(_nettle_chacha_16core32)
+	W64_ENTRY(3, 16)
+	kxorw	%k2, %k2, %k2	C Ignore counter carries
+	jmp	.Lshared_entry
+EPILOGUE(_nettle_chacha_16core32)
+
+	RODATA
+	ALIGN(64)
+.Lcnts:	.long	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15
+.Lone:	.long	1
@@ -0,0 +1,103 @@
+C x86_64/avx512/sha1-compress-16x.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "sha1-compress-16x.asm"
+
+include_src(`x86_64/sha-many.m4')
+
+define(`STATE', `%rdi')
+define(`INPUT', `%rsi')
+
+C Register holding state word i (a = 0, ..., e = 4) in round t.
+define(`SR', `%zmm`'eval((80 + $1 - $2) % 5)')
+C Temporaries
+define(`T', `%zmm`'eval(8 + $1)')
+C Message schedule, word i of all blocks.
+define(`W', `%zmm`'eval(16 + ($1) % 16)')
+
+C EXPAND(t), for t >= 16
+C W[t] = (W[t-3] ^ W[t-8] ^ W[t-14] ^ W[t-16]) <<< 1
+define(`EXPAND', `
+	vpternlogd	`$'0x96, W(eval($1 + 13)), W(eval($1 + 8)), W($1)
+	vpxord	W(eval($1 + 2)), W($1), W($1)
+	vprold	`$'1, W($1), W($1)')
+
+C FN(t) is the vpternlogd immediate for the round function: Choice,
+C Parity or Majority.
+define(`FN', `ifelse(eval($1 < 20), 1, 0xca,
+		     eval($1 >= 40 && $1 < 60), 1, 0xe8, 0x96)')
+
+C ROUND(a, b, c, d, e, t)
+C
+C e += (a <<< 5) + f(b, c, d) + K + W[t]
+C b <<<= 30
+define(`ROUND', `ifelse(eval($6 >= 16), 1, `EXPAND($6)')
+	vprold	`$'5, $1, T(0)
+	vmovdqa32	$2, T(1)
+	vpternlogd	`$'FN($6), $4, $3, T(1)
+	vpaddd	.LK+eval(4*($6 / 20))(%rip){1to16}, W($6), T(2)
+	vpaddd	T(0), $5, $5
+	vpaddd	T(1), $5, $5
+	vpaddd	T(2), $5, $5
+	vprold	`$'30, $2, $2')
+
+	C _sha1_compress_16x(uint32_t *state, const uint8_t * const *input)
+	C The state is word-major, with word i of all 16 lanes at
+	C state[16*i], ..., state[16*i + 15].
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_sha1_compress_16x)
+	W64_ENTRY(2, 16)
+
+	SHA_LOAD_16X(INPUT, .Lbswap(%rip), `W', `T')
+
+forloop(`i', 0, 4, `
+	vmovdqu32	eval(64*i)(STATE), %zmm`'i')
+
+forloop(`t', 0, 79, `
+	ROUND(SR(0, t), SR(1, t), SR(2, t), SR(3, t), SR(4, t), t)')
+
+forloop(`i', 0, 4, `
+	vpaddd	eval(64*i)(STATE), %zmm`'i, %zmm`'i
+	vmovdqu32	%zmm`'i, eval(64*i)(STATE)')
+
+	vzeroupper
+	W64_EXIT(2, 16)
+	ret
+EPILOGUE(_nettle_sha1_compress_16x)
+
+	RODATA
+	ALIGN(16)
+.Lbswap:
+	.byte	3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12
+.LK:
+	.long	0x5A827999,0x6ED9EBA1,0x8F1BBCDC,0xCA62C1D6
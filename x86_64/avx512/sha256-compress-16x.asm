@@ -0,0 +1,134 @@
+C x86_64/avx512/sha256-compress-16x.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "sha256-compress-16x.asm"
+
+include_src(`x86_64/sha-many.m4')
+
+define(`STATE', `%rdi')
+define(`INPUT', `%rsi')
+
+C Register holding state word i (a = 0, ..., h = 7) in round t.
+define(`SR', `%zmm`'eval((64 + $1 - $2) % 8)')
+C Temporaries
+define(`T', `%zmm`'eval(8 + $1)')
+C Message schedule, word i of all blocks.
+define(`W', `%zmm`'eval(16 + ($1) % 16)')
+
+C EXPAND(t), for t >= 16
+C W[t] = s1(W[t-2]) + W[t-7] + s0(W[t-15]) + W[t-16]
+define(`EXPAND', `
+	vprord	`$'7, W(eval($1 + 1)), T(0)
+	vprord	`$'18, W(eval($1 + 1)), T(1)
+	vpsrld	`$'3, W(eval($1 + 1)), T(2)
+	vpternlogd	`$'0x96, T(2), T(1), T(0)
+	vpaddd	T(0), W($1), W($1)
+	vpaddd	W(eval($1 + 9)), W($1), W($1)
+	vprord	`$'17, W(eval($1 + 14)), T(0)
+	vprord	`$'19, W(eval($1 + 14)), T(1)
+	vpsrld	`$'10, W(eval($1 + 14)), T(2)
+	vpternlogd	`$'0x96, T(2), T(1), T(0)
+	vpaddd	T(0), W($1), W($1)')
+
+C ROUND(a, b, c, d, e, f, g, h, t)
+C
+C h += S1(e) + Choice(e,f,g) + K[t] + W[t]
+C d += h
+C h += S0(a) + Majority(a,b,c)
+define(`ROUND', `ifelse(eval($9 >= 16), 1, `EXPAND($9)')
+	vprord	`$'6, $5, T(0)
+	vprord	`$'11, $5, T(1)
+	vprord	`$'25, $5, T(2)
+	vpternlogd	`$'0x96, T(2), T(1), T(0)
+	vmovdqa32	$5, T(3)
+	vpternlogd	`$'0xca, $7, $6, T(3)
+	vpaddd	.LK+eval(4*$9)(%rip){1to16}, W($9), T(4)
+	vpaddd	T(0), $8, $8
+	vpaddd	T(3), $8, $8
+	vpaddd	T(4), $8, $8
+	vpaddd	$8, $4, $4
+	vprord	`$'2, $1, T(0)
+	vprord	`$'13, $1, T(1)
+	vprord	`$'22, $1, T(2)
+	vpternlogd	`$'0x96, T(2), T(1), T(0)
+	vmovdqa32	$1, T(3)
+	vpternlogd	`$'0xe8, $3, $2, T(3)
+	vpaddd	T(0), $8, $8
+	vpaddd	T(3), $8, $8')
+
+	C _sha256_compress_16x(uint32_t *state, const uint8_t * const *input)
+	C The state is word-major, with word i of all 16 lanes at
+	C state[16*i], ..., state[16*i + 15].
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_sha256_compress_16x)
+	W64_ENTRY(2, 16)
+
+	SHA_LOAD_16X(INPUT, .Lbswap(%rip), `W', `T')
+
+forloop(`i', 0, 7, `
+	vmovdqu32	eval(64*i)(STATE), %zmm`'i')
+
+forloop(`t', 0, 63, `
+	ROUND(SR(0, t), SR(1, t), SR(2, t), SR(3, t),
+	      SR(4, t), SR(5, t), SR(6, t), SR(7, t), t)')
+
+forloop(`i', 0, 7, `
+	vpaddd	eval(64*i)(STATE), %zmm`'i, %zmm`'i
+	vmovdqu32	%zmm`'i, eval(64*i)(STATE)')
+
+	vzeroupper
+	W64_EXIT(2, 16)
+	ret
+EPILOGUE(_nettle_sha256_compress_16x)
+
+	RODATA
+	ALIGN(16)
+.Lbswap:
+	.byte	3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12
+.LK:
+	.long	0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5
+	.long	0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5
+	.long	0xd807aa98,0x12835b01,0x243185be,0x550c7dc3
+	.long	0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174
+	.long	0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc
+	.long	0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da
+	.long	0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7
+	.long	0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967
+	.long	0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13
+	.long	0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85
+	.long	0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3
+	.long	0xd192e819,0xd6990624,0xf40e3585,0x106aa070
+	.long	0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5
+	.long	0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3
+	.long	0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208
+	.long	0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
@@ -0,0 +1,99 @@
+C x86_64/avx512/sha3-permute-8x.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "sha3-permute-8x.asm"
+
+define(`STATE', `%rdi')		C 25 words for each of 8 states, word-major
+
+include_src(`x86_64/sha3-many.m4')
+
+C Lane i of all 8 states is kept in %zmm<i>, renamed as described in
+C sha3-many.m4.
+define(`A', `%zmm`'$1')
+define(`CP', `%zmm`'eval(25 + $1)')	C Column parity
+define(`T0', `%zmm30')
+define(`T1', `%zmm31')
+
+C REG(r, i), register holding lane i at the start of round r.
+define(`REG', `A(KECCAK_LANE($1, $2))')
+
+C THETA(r)
+define(`THETA', `
+forloop(`x', 0, 4, `
+	vmovdqa64	REG($1, x), CP(x)
+	vpternlogq	`$'0x96, REG($1, eval(x + 10)), REG($1, eval(x + 5)), CP(x)
+	vpternlogq	`$'0x96, REG($1, eval(x + 20)), REG($1, eval(x + 15)), CP(x)')
+forloop(`x', 0, 4, `
+	vprolq	`$'1, CP(eval((x + 1) % 5)), T0
+forloop(`y', 0, 4, `
+	vpternlogq	`$'0x96, T0, CP(eval((x + 4) % 5)), REG($1, eval(x + 5*y))')')')
+
+C RHO_STEP(r)
+define(`RHO_STEP', `
+forloop(`i', 1, 24, `
+	vprolq	`$'KECCAK_RHO(i), REG($1, i), REG($1, i)')')
+
+C CHI(r), using the lanes after the pi step, i.e., as for round r + 1.
+C a ^= ~b & c is vpternlogq with immediate 0xd2.
+define(`CHI', `
+forloop(`y', 0, 4, `
+	vmovdqa64	REG(eval($1 + 1), eval(5*y)), T0
+	vmovdqa64	REG(eval($1 + 1), eval(5*y + 1)), T1
+forloop(`x', 0, 2, `
+	vpternlogq	`$'0xd2, REG(eval($1 + 1), eval(5*y + x + 2)), REG(eval($1 + 1), eval(5*y + x + 1)), REG(eval($1 + 1), eval(5*y + x))')
+	vpternlogq	`$'0xd2, T0, REG(eval($1 + 1), eval(5*y + 4)), REG(eval($1 + 1), eval(5*y + 3))
+	vpternlogq	`$'0xd2, T1, T0, REG(eval($1 + 1), eval(5*y + 4))')')
+
+	C _nettle_sha3_permute_8x(uint64_t *state)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_sha3_permute_8x)
+	W64_ENTRY(1, 16)
+forloop(`i', 0, 24, `
+	vmovdqu64	eval(64*i)(STATE), A(i)')
+
+forloop(`r', 0, 23, `
+	THETA(r)
+	RHO_STEP(r)
+	CHI(r)
+	vpxorq	eval(8*r)+.Lrc(%rip){1to8}, A(0), A(0)')
+
+forloop(`i', 0, 24, `
+	vmovdqu64	A(i), eval(64*i)(STATE)')
+
+	vzeroupper
+	W64_EXIT(1, 16)
+	ret
+EPILOGUE(_nettle_sha3_permute_8x)
+
+	RODATA
+	KECCAK_RC
@@ -0,0 +1,137 @@
+C x86_64/avx512_pclmul/gcm-aes-encrypt.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+include_src(`x86_64/aes-vaes.m4')
+include_src(`x86_64/avx512_pclmul/gcm-aes.m4')
+
+C Input arguments
+define(`CTX',	`%rdi')
+define(`ROUNDS',`%rsi')
+define(`LENGTH',`%rdx')
+define(`DST',	`%rcx')
+define(`SRC',	`%r8')
+
+define(`KEYS',	`%r9')
+define(`LAST',	`%r10')
+define(`COUNT',	`%r11')
+
+define(`X0', `%zmm0')
+define(`X1', `%zmm1')
+define(`X2', `%zmm2')
+define(`X3', `%zmm3')
+define(`CTR', `%zmm4')
+define(`CTRX', `%xmm4')
+define(`INC', `%zmm5')
+define(`BSWAP', `%zmm6')
+define(`BSWAPX', `%xmm6')
+define(`R', `%zmm7')
+define(`RX', `%xmm7')
+define(`F', `%zmm8')
+define(`FY', `%ymm8')
+define(`FX', `%xmm8')
+define(`G', `%zmm9')
+define(`GY', `%ymm9')
+define(`GX', `%xmm9')
+define(`M', `%zmm10')
+define(`T', `%zmm11')
+define(`TY', `%ymm11')
+define(`TX', `%xmm11')
+define(`T2', `%zmm12')
+define(`T2Y', `%ymm12')
+define(`T2X', `%xmm12')
+
+C Subkeys, broadcast to all four lanes, in %zmm16-%zmm29, and the
+C last subkey in %zmm31.
+define(`KEY', `%zmm`'eval(16 + $1)')
+define(`KLAST', `%zmm31')
+
+	.file "gcm-aes-encrypt.asm"
+
+	C size_t _gcm_aes_encrypt(struct gcm_key *key, unsigned rounds,
+	C                         size_t size, uint8_t *dst,
+	C                         const uint8_t *src)
+
+	C Processes 16 blocks per iteration, four blocks in each zmm
+	C register, and returns the number of bytes processed, a
+	C multiple of 256. The hashing of each group of ciphertext
+	C blocks is interleaved with the encryption of the next group.
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_gcm_aes_encrypt)
+	W64_ENTRY(5, 13)
+	and	$-256, LENGTH
+	jz	.Lnone
+
+	GCM_SETUP
+	mov	LENGTH, COUNT
+	shr	$8, COUNT
+
+	GCM_AES_START
+	forloop(`i', 1, 9, `GCM_AES_ROUND(i)')
+	GCM_AES_FINISH(.Lfirst_last)
+	GCM_STORE
+	add	$256, SRC
+	add	$256, DST
+	dec	COUNT
+	jz	.Lfinal
+
+	ALIGN(16)
+.Loop:
+	GCM_AES_START
+	forloop(`i', 1, 4, `
+	GCM_AES_ROUND(i)
+	GCM_HASH_Z(eval(i-1), DST, -256)')
+	GCM_AES_ROUND(5)
+	GCM_AES_ROUND(6)
+	GCM_HASH_REDUCE
+	forloop(`i', 7, 9, `GCM_AES_ROUND(i)')
+	GCM_AES_FINISH(.Lloop_last)
+	GCM_STORE
+	add	$256, SRC
+	add	$256, DST
+	dec	COUNT
+	jnz	.Loop
+
+.Lfinal:
+	forloop(`i', 0, 3, `GCM_HASH_Z(i, DST, -256)')
+	GCM_HASH_REDUCE
+	GCM_FINISH
+	vzeroupper
+
+.Lnone:
+	mov	LENGTH, %rax
+	W64_EXIT(5, 13)
+	ret
+EPILOGUE(_nettle_gcm_aes_encrypt)
+
+GCM_RODATA_Z
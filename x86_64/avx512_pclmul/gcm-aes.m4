@@ -0,0 +1,152 @@
+C Macros shared by gcm-aes-encrypt.asm and gcm-aes-decrypt.asm, for
+C the variant using vaes and vpclmulqdq on zmm registers. The
+C including file must define the registers used below, and the
+C pointers CTX and SRC.
+
+C Fields of struct gcm_aes*_ctx, GCM_CTR(CTX) etc.
+define(`GCM_CTR', `2064($1)')
+define(`GCM_X', `2080($1)')
+define(`GCM_CIPHER', `2112($1)')
+
+C Offsets of the powers H^16, ..., H^1 and D^16, ..., D^1 in
+C descending order, as stored by _ghash_set_key.
+define(`GCM_HPOW', `512')
+define(`GCM_DPOW', `768')
+
+C GCM_LOAD_KEYS(label)
+C Broadcasts the subkeys to KEY(0), ..., KEY(rounds - 1), and the
+C last subkey to KLAST, without reading beyond the key schedule.
+define(`GCM_LOAD_KEYS', `
+	AES_LOAD_KEYS_Z(10, KEYS, `KEY')
+	vbroadcasti32x4	(LAST), KLAST
+	cmp	`$'10, XREG(ROUNDS)
+	je	$1
+	vbroadcasti32x4	176(KEYS), KEY(11)
+	cmp	`$'12, XREG(ROUNDS)
+	je	$1
+	vbroadcasti32x4	192(KEYS), KEY(12)
+	vbroadcasti32x4	208(KEYS), KEY(13)
+$1:')
+
+C GCM_AES_START
+C Sets up the next 16 counter blocks in X0, ..., X3, and applies the
+C first subkey.
+define(`GCM_AES_START', `
+	vpshufb	BSWAP, CTR, X0
+	vpaddd	INC, CTR, CTR
+	vpshufb	BSWAP, CTR, X1
+	vpaddd	INC, CTR, CTR
+	vpshufb	BSWAP, CTR, X2
+	vpaddd	INC, CTR, CTR
+	vpshufb	BSWAP, CTR, X3
+	vpaddd	INC, CTR, CTR
+	OPN_YXX(vpxorq, KEY(0), X0, X1, X2, X3)')
+
+C GCM_AES_ROUND(i)
+define(`GCM_AES_ROUND', `
+	OPN_YXX(vaesenc, KEY($1), X0, X1, X2, X3)')
+
+C GCM_AES_FINISH(label)
+C Applies the remaining rounds, starting with round 10, and xors the
+C key stream with the input data at SRC.
+define(`GCM_AES_FINISH', `
+	cmp	`$'10, XREG(ROUNDS)
+	je	$1
+	GCM_AES_ROUND(10)
+	GCM_AES_ROUND(11)
+	cmp	`$'12, XREG(ROUNDS)
+	je	$1
+	GCM_AES_ROUND(12)
+	GCM_AES_ROUND(13)
+$1:
+	OPN_YXX(vaesenclast, KLAST, X0, X1, X2, X3)
+	vpxorq	(SRC), X0, X0
+	vpxorq	64(SRC), X1, X1
+	vpxorq	128(SRC), X2, X2
+	vpxorq	192(SRC), X3, X3')
+
+C GCM_STORE
+define(`GCM_STORE', `
+	vmovdqu64	X0, (DST)
+	vmovdqu64	X1, 64(DST)
+	vmovdqu64	X2, 128(DST)
+	vmovdqu64	X3, 192(DST)')
+
+C GCM_HASH_Z(j, ptr, offset)
+C Processes blocks 4j, ..., 4j+3, out of a group of 16, read from
+C offset(ptr). Block i is multiplied by H^{16-i}, using one lane per
+C block. The hash state R is added into the first block. The
+C products are accumulated lane-wise in F and G, to be combined and
+C reduced by GCM_HASH_REDUCE.
+define(`GCM_HASH_Z', `
+	vmovdqu64	eval(64*$1 + $3)($2), M
+	vpshufb	BSWAP, M, M
+ifelse($1, 0, `
+	vpxorq	R, M, M
+	vpclmulqdq	`$'0x00, eval(GCM_DPOW)(CTX), M, F	C D0 * M0
+	vpclmulqdq	`$'0x10, eval(GCM_DPOW)(CTX), M, G	C D1 * M0
+	vpclmulqdq	`$'0x01, eval(GCM_HPOW)(CTX), M, T	C H0 * M1
+	vpclmulqdq	`$'0x11, eval(GCM_HPOW)(CTX), M, T2	C H1 * M1
+	vpxorq	T, F, F
+	vpxorq	T2, G, G', `
+	vpclmulqdq	`$'0x00, eval(GCM_DPOW + 64*$1)(CTX), M, T
+	vpclmulqdq	`$'0x01, eval(GCM_HPOW + 64*$1)(CTX), M, T2
+	vpternlogq	`$'0x96, T, T2, F
+	vpclmulqdq	`$'0x10, eval(GCM_DPOW + 64*$1)(CTX), M, T
+	vpclmulqdq	`$'0x11, eval(GCM_HPOW + 64*$1)(CTX), M, T2
+	vpternlogq	`$'0x96, T, T2, G')')
+
+C GCM_HASH_REDUCE
+C Sums the lanes of F and G, and sets R <-- G + x^{-64} F. The upper
+C lanes of R are cleared.
+define(`GCM_HASH_REDUCE', `
+	vextracti64x4	`$'1, F, TY
+	vpxor	TY, FY, FY
+	vextracti64x4	`$'1, G, T2Y
+	vpxor	T2Y, GY, GY
+	vextracti128	`$'1, FY, TX
+	vpxor	TX, FX, FX
+	vextracti128	`$'1, GY, T2X
+	vpxor	T2X, GX, GX
+	vpshufd	`$'0x4e, FX, TX		C Swap halves of F
+	vpxor	TX, GX, GX
+	vpclmulqdq	`$'0x10, .Lpolynomial(%rip), FX, FX
+	vpxor	FX, GX, RX')
+
+C GCM_SETUP
+C Loads the subkeys, the counter, and the hash state.
+define(`GCM_SETUP', `
+	lea	GCM_CIPHER(CTX), KEYS
+	mov	XREG(ROUNDS), XREG(LAST)
+	shl	`$'4, LAST
+	add	KEYS, LAST
+	GCM_LOAD_KEYS(.Lkeys_done)
+
+	vbroadcasti32x4	.Lbswap(%rip), BSWAP
+	vbroadcasti32x4	.Lfour(%rip), INC
+	vbroadcasti32x4	GCM_CTR(CTX), CTR
+	vpshufb	BSWAP, CTR, CTR
+	vpaddd	.Lctr_init(%rip), CTR, CTR
+	vmovdqu	GCM_X(CTX), RX
+	vpshufb	BSWAPX, RX, RX')
+
+C GCM_FINISH
+C Stores the counter and the hash state.
+define(`GCM_FINISH', `
+	vpshufb	BSWAPX, CTRX, CTRX
+	vmovdqu	CTRX, GCM_CTR(CTX)
+	vpshufb	BSWAPX, RX, RX
+	vmovdqu	RX, GCM_X(CTX)')
+
+C GCM_RODATA_Z
+define(`GCM_RODATA_Z', `
+	RODATA
+	ALIGN(64)
+.Lctr_init:
+	.long 0,0,0,0, 1,0,0,0, 2,0,0,0, 3,0,0,0
+.Lpolynomial:
+	.byte 1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0xC2
+.Lbswap:
+	.byte 15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0
+.Lfour:
+	.long 4,0,0,0')
@@ -0,0 +1,171 @@
+C x86_64/chacha-2core.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+define(`DST', `%rdi')
+define(`SRC', `%rsi')
+define(`ROUNDS', `%rdx')
+
+define(`X0', `%xmm0')
+define(`X1', `%xmm1')
+define(`X2', `%xmm2')
+define(`X3', `%xmm3')
+define(`Y0', `%xmm4')
+define(`Y1', `%xmm5')
+define(`Y2', `%xmm6')
+define(`Y3', `%xmm7')
+define(`T0', `%xmm8')
+C Carry mask on entry, then the counter words of the second block.
+define(`T1', `%xmm9')
+
+C ROTL_BY_16(REG)
+define(`ROTL_BY_16', `
+	pshufhw	`$'0xb1, $1, $1
+	pshuflw	`$'0xb1, $1, $1')
+
+C ROTL(COUNT, REG), using T0 as temporary.
+define(`ROTL', `
+	movdqa	$2, T0
+	pslld	`$'$1, $2
+	psrld	`$'eval(32 - $1), T0
+	por	T0, $2')
+
+C QROUND(x0, x1, x2, x3)
+define(`QROUND', `
+	paddd	$2, $1
+	pxor	$1, $4
+	ROTL_BY_16($4)
+
+	paddd	$4, $3
+	pxor	$3, $2
+	ROTL(12, $2)
+
+	paddd	$2, $1
+	pxor	$1, $4
+	ROTL(8, $4)
+
+	paddd	$4, $3
+	pxor	$3, $2
+	ROTL(7, $2)')
+
+	.file "chacha-2core.asm"
+
+	C _chacha_2core(uint32_t *dst, const uint32_t *src, unsigned rounds)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_chacha_2core)
+	W64_ENTRY(3, 10)
+	pcmpeqd	T1, T1		C Apply counter carry
+
+.Lshared_entry:
+	movups	(SRC), X0
+	movups	16(SRC), X1
+	movups	32(SRC), X2
+	movups	48(SRC), X3
+
+	C The second block uses counter + 1, with carry into the next
+	C word if the low word wraps around.
+	movdqa	.Lone(%rip), T0
+	movdqa	X3, Y3
+	paddd	T0, Y3
+	pxor	T0, T0
+	pcmpeqd	Y3, T0
+	pand	.Lone(%rip), T0
+	pslldq	$4, T0
+	pand	T0, T1
+	paddd	T1, Y3
+	movdqa	Y3, T1
+
+	movdqa	X0, Y0
+	movdqa	X1, Y1
+	movdqa	X2, Y2
+
+	shrl	$1, XREG(ROUNDS)
+
+	ALIGN(16)
+.Loop:
+	QROUND(X0, X1, X2, X3)
+	QROUND(Y0, Y1, Y2, Y3)
+	pshufd	$0x39, X1, X1
+	pshufd	$0x4e, X2, X2
+	pshufd	$0x93, X3, X3
+	pshufd	$0x39, Y1, Y1
+	pshufd	$0x4e, Y2, Y2
+	pshufd	$0x93, Y3, Y3
+
+	QROUND(X0, X1, X2, X3)
+	QROUND(Y0, Y1, Y2, Y3)
+	pshufd	$0x93, X1, X1
+	pshufd	$0x4e, X2, X2
+	pshufd	$0x39, X3, X3
+	pshufd	$0x93, Y1, Y1
+	pshufd	$0x4e, Y2, Y2
+	pshufd	$0x39, Y3, Y3
+
+	decl	XREG(ROUNDS)
+	jnz	.Loop
+
+	movups	(SRC), T0
+	paddd	T0, X0
+	paddd	T0, Y0
+	movups	16(SRC), T0
+	paddd	T0, X1
+	paddd	T0, Y1
+	movups	32(SRC), T0
+	paddd	T0, X2
+	paddd	T0, Y2
+	movups	48(SRC), T0
+	paddd	T0, X3
+	paddd	T1, Y3
+
+	movups	X0, (DST)
+	movups	X1, 16(DST)
+	movups	X2, 32(DST)
+	movups	X3, 48(DST)
+	movups	Y0, 64(DST)
+	movups	Y1, 80(DST)
+	movups	Y2, 96(DST)
+	movups	Y3, 112(DST)
+
+	W64_EXIT(3, 10)
+	ret
+EPILOGUE(_nettle_chacha_2core)
+
+	ALIGN(16)
+PROLOGUE(_nettle_chacha_2core32)
+	W64_ENTRY(3, 10)
+	pxor	T1, T1		C Ignore counter carry
+	jmp	.Lshared_entry
+EPILOGUE(_nettle_chacha_2core32)
+
+	RODATA
+	ALIGN(16)
+.Lone:	.long	1,0,0,0
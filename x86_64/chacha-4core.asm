@@ -0,0 +1,237 @@
+C x86_64/chacha-4core.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+define(`DST', `%rdi')
+define(`SRC', `%rsi')
+define(`ROUNDS', `%rdx')
+
+C State word i, for all four blocks, in %xmm<i>, for i < 15. Word 15
+C lives in memory, and is swapped with word 12 when needed. The
+C stack frame also holds the original state words.
+define(`T', `%xmm15')
+define(`W15', `256(%rsp)')
+
+C ROTL_BY_16(REG)
+define(`ROTL_BY_16', `
+	pshufhw	`$'0xb1, $1, $1
+	pshuflw	`$'0xb1, $1, $1')
+
+C ROTL(COUNT, REG), using T as temporary.
+define(`ROTL', `
+	movdqa	$2, T
+	pslld	`$'$1, $2
+	psrld	`$'eval(32 - $1), T
+	por	T, $2')
+
+C QROUND(a, b, c, d)
+define(`QROUND', `
+	paddd	$2, $1
+	pxor	$1, $4
+	ROTL_BY_16($4)
+
+	paddd	$4, $3
+	pxor	$3, $2
+	ROTL(12, $2)
+
+	paddd	$2, $1
+	pxor	$1, $4
+	ROTL(8, $4)
+
+	paddd	$4, $3
+	pxor	$3, $2
+	ROTL(7, $2)')
+
+C SWAP_W15
+C Exchanges %xmm12 and the word in memory.
+define(`SWAP_W15', `
+	movdqa	%xmm12, T
+	movdqa	W15, %xmm12
+	movdqa	T, W15')
+
+C SPLAT(src, r0, r1, r2, r3)
+C Broadcasts each word of the src register, which must be r3.
+define(`SPLAT', `
+	pshufd	`$'0x00, $1, $2
+	pshufd	`$'0x55, $1, $3
+	pshufd	`$'0xaa, $1, $4
+	pshufd	`$'0xff, $1, $5')
+
+C TRANSPOSE(a, b, c, d)
+C Transposes a 4x4 matrix of words, using T as temporary. The rows
+C of the result end up in a, d, T, c.
+define(`TRANSPOSE', `
+	movdqa	$1, T
+	punpckldq	$2, $1	C a0 b0 a1 b1
+	punpckhdq	$2, T	C a2 b2 a3 b3
+	movdqa	$3, $2
+	punpckldq	$4, $3	C c0 d0 c1 d1
+	punpckhdq	$4, $2	C c2 d2 c3 d3
+	movdqa	$1, $4
+	punpcklqdq	$3, $1	C a0 b0 c0 d0
+	punpckhqdq	$3, $4	C a1 b1 c1 d1
+	movdqa	T, $3
+	punpcklqdq	$2, T	C a2 b2 c2 d2
+	punpckhqdq	$2, $3	C a3 b3 c3 d3')
+
+	.file "chacha-4core.asm"
+
+	C _chacha_4core(uint32_t *dst, const uint32_t *src, unsigned rounds)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_chacha_4core)
+	W64_ENTRY(3, 16)
+	pcmpeqd	%xmm0, %xmm0	C Apply counter carries
+
+.Lshared_entry:
+	push	%rbp
+	mov	%rsp, %rbp
+	sub	$272, %rsp
+	and	$-16, %rsp
+
+	C Counter words, with carry from the low word when enabled.
+	movups	48(SRC), T
+	pshufd	$0x00, T, %xmm12
+	movdqa	.Lcnts(%rip), %xmm2
+	paddd	%xmm2, %xmm12
+	movdqa	.Lsign(%rip), %xmm3
+	movdqa	%xmm12, %xmm1
+	pxor	%xmm3, %xmm1
+	pxor	%xmm3, %xmm2
+	pcmpgtd	%xmm1, %xmm2	C Unsigned compare, carry if result < increment
+	pand	%xmm0, %xmm2
+	pshufd	$0x55, T, %xmm13
+	psubd	%xmm2, %xmm13
+	pshufd	$0xaa, T, %xmm14
+	pshufd	$0xff, T, T
+	movdqa	T, 240(%rsp)
+	movdqa	T, W15
+
+	movups	(SRC), %xmm3
+	SPLAT(%xmm3, %xmm0, %xmm1, %xmm2, %xmm3)
+	movups	16(SRC), %xmm7
+	SPLAT(%xmm7, %xmm4, %xmm5, %xmm6, %xmm7)
+	movups	32(SRC), %xmm11
+	SPLAT(%xmm11, %xmm8, %xmm9, %xmm10, %xmm11)
+
+	movdqa	%xmm0, (%rsp)
+	movdqa	%xmm1, 16(%rsp)
+	movdqa	%xmm2, 32(%rsp)
+	movdqa	%xmm3, 48(%rsp)
+	movdqa	%xmm4, 64(%rsp)
+	movdqa	%xmm5, 80(%rsp)
+	movdqa	%xmm6, 96(%rsp)
+	movdqa	%xmm7, 112(%rsp)
+	movdqa	%xmm8, 128(%rsp)
+	movdqa	%xmm9, 144(%rsp)
+	movdqa	%xmm10, 160(%rsp)
+	movdqa	%xmm11, 176(%rsp)
+	movdqa	%xmm12, 192(%rsp)
+	movdqa	%xmm13, 208(%rsp)
+	movdqa	%xmm14, 224(%rsp)
+
+	shrl	$1, XREG(ROUNDS)
+
+	ALIGN(16)
+.Loop:
+	QROUND(%xmm0, %xmm4, %xmm8, %xmm12)
+	QROUND(%xmm1, %xmm5, %xmm9, %xmm13)
+	QROUND(%xmm2, %xmm6, %xmm10, %xmm14)
+	SWAP_W15
+	QROUND(%xmm3, %xmm7, %xmm11, %xmm12)
+
+	QROUND(%xmm0, %xmm5, %xmm10, %xmm12)
+	SWAP_W15
+	QROUND(%xmm1, %xmm6, %xmm11, %xmm12)
+	QROUND(%xmm2, %xmm7, %xmm8, %xmm13)
+	QROUND(%xmm3, %xmm4, %xmm9, %xmm14)
+
+	decl	XREG(ROUNDS)
+	jnz	.Loop
+
+	paddd	(%rsp), %xmm0
+	paddd	16(%rsp), %xmm1
+	paddd	32(%rsp), %xmm2
+	paddd	48(%rsp), %xmm3
+	TRANSPOSE(%xmm0, %xmm1, %xmm2, %xmm3)
+	movups	%xmm0, (DST)
+	movups	%xmm3, 64(DST)
+	movups	T, 128(DST)
+	movups	%xmm2, 192(DST)
+
+	paddd	64(%rsp), %xmm4
+	paddd	80(%rsp), %xmm5
+	paddd	96(%rsp), %xmm6
+	paddd	112(%rsp), %xmm7
+	TRANSPOSE(%xmm4, %xmm5, %xmm6, %xmm7)
+	movups	%xmm4, 16(DST)
+	movups	%xmm7, 80(DST)
+	movups	T, 144(DST)
+	movups	%xmm6, 208(DST)
+
+	paddd	128(%rsp), %xmm8
+	paddd	144(%rsp), %xmm9
+	paddd	160(%rsp), %xmm10
+	paddd	176(%rsp), %xmm11
+	TRANSPOSE(%xmm8, %xmm9, %xmm10, %xmm11)
+	movups	%xmm8, 32(DST)
+	movups	%xmm11, 96(DST)
+	movups	T, 160(DST)
+	movups	%xmm10, 224(DST)
+
+	movdqa	W15, %xmm3
+	paddd	192(%rsp), %xmm12
+	paddd	208(%rsp), %xmm13
+	paddd	224(%rsp), %xmm14
+	paddd	240(%rsp), %xmm3
+	TRANSPOSE(%xmm12, %xmm13, %xmm14, %xmm3)
+	movups	%xmm12, 48(DST)
+	movups	%xmm3, 112(DST)
+	movups	T, 176(DST)
+	movups	%xmm14, 240(DST)
+
+	mov	%rbp, %rsp
+	pop	%rbp
+	W64_EXIT(3, 16)
+	ret
+EPILOGUE(_nettle_chacha_4core)
+
+	ALIGN(16)
+PROLOGUE(_nettle_chacha_4core32)
+	W64_ENTRY(3, 16)
+	pxor	%xmm0, %xmm0	C Ignore counter carries
+	jmp	.Lshared_entry
+EPILOGUE(_nettle_chacha_4core32)
+
+	RODATA
+	ALIGN(16)
+.Lcnts:	.long	0,1,2,3
+.Lsign:	.long	0x80000000,0x80000000,0x80000000,0x80000000
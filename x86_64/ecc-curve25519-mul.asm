@@ -0,0 +1,87 @@
+C x86_64/ecc-curve25519-mul.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "ecc-curve25519-mul.asm"
+
+define(`RP', `%rsi')
+define(`AP', `%rdi')	C Overlaps unused modulo input
+define(`BP', `%rcx')
+define(`T', `%rcx')	C Overlaps BP, used after the product is done
+
+C R(i) gives the register for limb i of the product
+define(`R', `ifelse($1, 0, %r8, $1, 1, %r9, $1, 2, %r10, $1, 3, %r11,
+	$1, 4, %rbx, $1, 5, %rbp, $1, 6, %r12, $1, 7, %r13)')
+
+include_src(`x86_64/ecc-curve25519.m4')
+
+	C ecc_curve25519_mul (const struct ecc_modulo *m, mp_limb_t *rp,
+	C		      const mp_limb_t *ap, const mp_limb_t *bp,
+	C		      mp_limb_t *tp)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_ecc_curve25519_mul)
+	W64_ENTRY(5, 0)
+	push	%rbx
+	push	%rbp
+	push	%r12
+	push	%r13
+	mov	%rdx, AP
+
+	C Product scanning, accumulating column k in R(k), R(k+1)
+	C and R(k+2).
+	mov	(AP), %rax
+	mulq	(BP)
+	mov	%rax, R(0)
+	mov	%rdx, R(1)
+	xor	R(2), R(2)
+forloop(`k', 1, 5, `
+	xor	R(eval(k+2)), R(eval(k+2))
+forloop(`i', ifelse(eval(k < 4), 1, 0, eval(k-3)), ifelse(eval(k < 4), 1, k, 3), `
+	mov	eval(8*i)(AP), %rax
+	mulq	eval(8*(k-i))(BP)
+	add	%rax, R(k)
+	adc	%rdx, R(eval(k+1))
+	adc	$0, R(eval(k+2))')')
+	mov	24(AP), %rax
+	mulq	24(BP)
+	add	%rax, R(6)
+	adc	%rdx, R(7)
+
+	CURVE25519_REDUCE(RP, T)
+
+	pop	%r13
+	pop	%r12
+	pop	%rbp
+	pop	%rbx
+	W64_EXIT(5, 0)
+	ret
+EPILOGUE(_nettle_ecc_curve25519_mul)
@@ -0,0 +1,138 @@
+C x86_64/ecc-curve25519-sqr.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "ecc-curve25519-sqr.asm"
+
+define(`RP', `%rsi')
+define(`AP', `%rdi')	C Overlaps unused modulo input
+define(`T', `%rcx')	C Overlaps unused scratch input
+
+C R(i) gives the register for limb i of the product
+define(`R', `ifelse($1, 0, %r8, $1, 1, %r9, $1, 2, %r10, $1, 3, %r11,
+	$1, 4, %rbx, $1, 5, %rbp, $1, 6, %r12, $1, 7, %r13)')
+
+include_src(`x86_64/ecc-curve25519.m4')
+
+	C ecc_curve25519_sqr (const struct ecc_modulo *m, mp_limb_t *rp,
+	C		      const mp_limb_t *ap, mp_limb_t *tp)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_ecc_curve25519_sqr)
+	W64_ENTRY(4, 0)
+	push	%rbx
+	push	%rbp
+	push	%r12
+	push	%r13
+	mov	%rdx, AP
+
+	C Off-diagonal products, a_i a_j with i < j
+	mov	(AP), %rax
+	mulq	8(AP)
+	mov	%rax, R(1)
+	mov	%rdx, R(2)
+
+	mov	(AP), %rax
+	mulq	16(AP)
+	xor	R(3), R(3)
+	add	%rax, R(2)
+	adc	%rdx, R(3)
+
+	mov	(AP), %rax
+	mulq	24(AP)
+	xor	R(4), R(4)
+	xor	R(5), R(5)
+	add	%rax, R(3)
+	adc	%rdx, R(4)
+	mov	8(AP), %rax
+	mulq	16(AP)
+	add	%rax, R(3)
+	adc	%rdx, R(4)
+	adc	$0, R(5)
+
+	mov	8(AP), %rax
+	mulq	24(AP)
+	xor	R(6), R(6)
+	add	%rax, R(4)
+	adc	%rdx, R(5)
+	adc	$0, R(6)
+
+	mov	16(AP), %rax
+	mulq	24(AP)
+	xor	R(7), R(7)
+	add	%rax, R(5)
+	adc	%rdx, R(6)
+	adc	$0, R(7)
+
+	C Double
+	add	R(1), R(1)
+	adc	R(2), R(2)
+	adc	R(3), R(3)
+	adc	R(4), R(4)
+	adc	R(5), R(5)
+	adc	R(6), R(6)
+	adc	R(7), R(7)
+
+	C Add the squares a_i^2, carrying in T between them
+	mov	(AP), %rax
+	mul	%rax
+	mov	%rax, R(0)
+	mov	%rdx, T
+
+	mov	8(AP), %rax
+	mul	%rax
+	add	T, R(1)
+	adc	%rax, R(2)
+	adc	$0, %rdx
+	mov	%rdx, T
+
+	mov	16(AP), %rax
+	mul	%rax
+	add	T, R(3)
+	adc	%rax, R(4)
+	adc	$0, %rdx
+	mov	%rdx, T
+
+	mov	24(AP), %rax
+	mul	%rax
+	add	T, R(5)
+	adc	%rax, R(6)
+	adc	%rdx, R(7)
+
+	CURVE25519_REDUCE(RP, T)
+
+	pop	%r13
+	pop	%r12
+	pop	%rbp
+	pop	%rbx
+	W64_EXIT(4, 0)
+	ret
+EPILOGUE(_nettle_ecc_curve25519_sqr)
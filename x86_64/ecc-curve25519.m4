@@ -0,0 +1,55 @@
+C Macros shared by the curve25519 field multiplication and squaring,
+C x86_64/ecc-curve25519-mul.asm and x86_64/ecc-curve25519-sqr.asm.
+C Both keep the complete 8-limb product in registers, with R(i) giving
+C the register for limb i.
+
+C CURVE25519_REDUCE(rp, t)
+C Reduces the product in R(0), ..., R(7) modulo p = 2^255 - 19, and
+C stores the 4-limb result, less than 2^256, at rp. Clobbers %rax,
+C %rdx, t and R(4), ..., R(7).
+define(`CURVE25519_REDUCE', `
+	C Fold the high half, using 2^256 = 38 (mod p)
+	mov	`$'38, %eax
+	mul	R(4)
+	mov	%rax, R(4)
+	mov	%rdx, $2
+	mov	`$'38, %eax
+	mul	R(5)
+	add	$2, %rax
+	adc	`$'0, %rdx
+	mov	%rax, R(5)
+	mov	%rdx, $2
+	mov	`$'38, %eax
+	mul	R(6)
+	add	$2, %rax
+	adc	`$'0, %rdx
+	mov	%rax, R(6)
+	mov	%rdx, $2
+	mov	`$'38, %eax
+	mul	R(7)
+	add	$2, %rax
+	adc	`$'0, %rdx
+	mov	%rax, R(7)
+	mov	%rdx, $2
+
+	add	R(4), R(0)
+	adc	R(5), R(1)
+	adc	R(6), R(2)
+	adc	R(7), R(3)
+	adc	`$'0, $2
+
+	C Fold bit 255 and above, using 2^255 = 19 (mod p)
+	add	R(3), R(3)
+	adc	$2, $2
+	shr	R(3)		C Undo shift, clear high bit
+	imul	`$'19, $2
+
+	add	$2, R(0)
+	mov	R(0), ($1)
+	adc	`$'0, R(1)
+	mov	R(1), 8($1)
+	adc	`$'0, R(2)
+	mov	R(2), 16($1)
+	adc	`$'0, R(3)
+	mov	R(3), 24($1)
+')
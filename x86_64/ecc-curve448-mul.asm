@@ -0,0 +1,99 @@
+C x86_64/ecc-curve448-mul.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "ecc-curve448-mul.asm"
+
+define(`RP', `%rsi')
+define(`XP', `%rdx')
+define(`X0', `%rax')
+define(`X1', `%rbx')
+define(`X2', `%rcx')
+define(`X3', `%rbp')
+define(`X4', `%rdi')
+define(`X5', `%r8')
+define(`X6', `%r9')
+define(`X7', `%r10')
+define(`T0', `%r11')
+define(`T1', `%r12')
+define(`T2', `%r13')
+
+C Registers for the multiplication
+define(`AP', `%rdi')	C Overlaps unused modulo input
+define(`BP', `%rcx')
+define(`TP', `%r8')
+C ACC(k) gives the register for the low limb of column k
+define(`ACC', `ifelse(eval($1 % 3), 0, %r9, eval($1 % 3), 1, %r10, %r11)')
+
+include_src(`x86_64/ecc-curve448.m4')
+
+	C ecc_curve448_mul (const struct ecc_modulo *m, mp_limb_t *rp,
+	C		    const mp_limb_t *ap, const mp_limb_t *bp,
+	C		    mp_limb_t *tp)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_ecc_curve448_mul)
+	W64_ENTRY(5, 0)
+
+	push	%rbx
+	push	%rbp
+	push	%r12
+	push	%r13
+
+	mov	%rdx, AP
+
+	C Product scanning, accumulating column k in ACC(k),
+	C ACC(k+1) and ACC(k+2), and storing the 14-limb product at TP.
+	xor	ACC(0), ACC(0)
+	xor	ACC(1), ACC(1)
+	xor	ACC(2), ACC(2)
+forloop(`k', 0, 12, `
+forloop(`i', ifelse(eval(k < 7), 1, 0, eval(k-6)), ifelse(eval(k < 7), 1, k, 6), `
+	mov	eval(8*i)(AP), %rax
+	mulq	eval(8*(k-i))(BP)
+	add	%rax, ACC(k)
+	adc	%rdx, ACC(eval(k+1))
+	adc	$0, ACC(eval(k+2))')
+	mov	ACC(k), eval(8*k)(TP)
+	xor	ACC(k), ACC(k)')
+	mov	ACC(13), 104(TP)
+
+	mov	TP, XP
+	CURVE448_REDUCE
+
+	pop	%r13
+	pop	%r12
+	pop	%rbp
+	pop	%rbx
+
+	W64_EXIT(5, 0)
+	ret
+EPILOGUE(_nettle_ecc_curve448_mul)
@@ -0,0 +1,138 @@
+C x86_64/ecc-curve448-sqr.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "ecc-curve448-sqr.asm"
+
+define(`RP', `%rsi')
+define(`XP', `%rdx')
+define(`X0', `%rax')
+define(`X1', `%rbx')
+define(`X2', `%rcx')
+define(`X3', `%rbp')
+define(`X4', `%rdi')
+define(`X5', `%r8')
+define(`X6', `%r9')
+define(`X7', `%r10')
+define(`T0', `%r11')
+define(`T1', `%r12')
+define(`T2', `%r13')
+
+C Registers for the squaring
+define(`AP', `%rdi')	C Overlaps unused modulo input
+define(`TP', `%rcx')
+define(`C0', `%r11')
+define(`C1', `%rbx')
+define(`C2', `%rbp')
+C ACC(k) gives the register for the low limb of column k
+define(`ACC', `ifelse(eval($1 % 3), 0, %r8, eval($1 % 3), 1, %r9, %r10)')
+
+C SQR_COLUMN(k)
+C Adds column k of the square to ACC(k), ACC(k+1) and ACC(k+2).
+C The off-diagonal products a_i a_j, i < j, are summed in C0, C1, C2,
+C and doubled before the square a_{k/2}^2 is added, for even k.
+define(`SQR_COLUMN', `
+	xor	C0, C0
+	xor	C1, C1
+	xor	C2, C2
+forloop(`i', ifelse(eval($1 < 7), 1, 0, eval($1-6)), eval(($1-1)/2), `
+	mov	eval(8*i)(AP), %rax
+	mulq	eval(8*($1-i))(AP)
+	add	%rax, C0
+	adc	%rdx, C1
+	adc	`$'0, C2')
+	add	C0, C0
+	adc	C1, C1
+	adc	C2, C2
+ifelse(eval($1 % 2), 0, `
+	mov	eval(4*$1)(AP), %rax
+	mul	%rax
+	add	%rax, C0
+	adc	%rdx, C1
+	adc	`$'0, C2')
+	add	C0, ACC($1)
+	adc	C1, ACC(eval($1+1))
+	adc	C2, ACC(eval($1+2))
+')
+
+C SQR_DIAG(k)
+C Adds the square a_{k/2}^2, for the columns k = 0 and k = 12
+C which have no off-diagonal products.
+define(`SQR_DIAG', `
+	mov	eval(4*$1)(AP), %rax
+	mul	%rax
+	add	%rax, ACC($1)
+	adc	%rdx, ACC(eval($1+1))
+	adc	`$'0, ACC(eval($1+2))
+')
+
+include_src(`x86_64/ecc-curve448.m4')
+
+	C ecc_curve448_sqr (const struct ecc_modulo *m, mp_limb_t *rp,
+	C		    const mp_limb_t *ap, mp_limb_t *tp)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_ecc_curve448_sqr)
+	W64_ENTRY(4, 0)
+
+	push	%rbx
+	push	%rbp
+	push	%r12
+	push	%r13
+
+	mov	%rdx, AP
+
+	C Storing the 14-limb square at TP, one column at a time.
+	xor	ACC(0), ACC(0)
+	xor	ACC(1), ACC(1)
+	xor	ACC(2), ACC(2)
+	SQR_DIAG(0)
+	mov	ACC(0), (TP)
+	xor	ACC(0), ACC(0)
+forloop(`k', 1, 11, `
+	SQR_COLUMN(k)
+	mov	ACC(k), eval(8*k)(TP)
+	xor	ACC(k), ACC(k)')
+	SQR_DIAG(12)
+	mov	ACC(12), 96(TP)
+	mov	ACC(13), 104(TP)
+
+	mov	TP, XP
+	CURVE448_REDUCE
+
+	pop	%r13
+	pop	%r12
+	pop	%rbp
+	pop	%rbx
+
+	W64_EXIT(4, 0)
+	ret
+EPILOGUE(_nettle_ecc_curve448_sqr)
@@ -57,3 +57,16 @@ PROLOGUE(_nettle_cpuid)
 	ret
 EPILOGUE(_nettle_cpuid)
 
+	C uint64_t _nettle_xgetbv(uint32_t xcr)
+
+	C Must only be called if cpuid reports osxsave.
+	ALIGN(16)
+PROLOGUE(_nettle_xgetbv)
+	W64_ENTRY(1, 0)
+	movl	%edi, %ecx
+	xgetbv
+	shl	$32, %rdx
+	or	%rdx, %rax
+	W64_EXIT(1, 0)
+	ret
+EPILOGUE(_nettle_xgetbv)
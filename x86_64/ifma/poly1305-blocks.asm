@@ -0,0 +1,411 @@
+C x86_64/ifma/poly1305-blocks.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "poly1305-blocks.asm"
+
+define(`CTX', `%rdi') C First argument to all functions
+define(`BLOCKS', `%rsi')
+define(`MP_PARAM', `%rdx')	C Moved to MP, to not collide with mul instruction.
+
+define(`MP', `%r8')		C May clobber, both with unix and windows conventions.
+define(`T0', `%rbx')
+define(`T1', `%rcx')
+define(`H0', `%rbp')
+define(`H1', `%r9')
+define(`H2', `%r10')
+define(`F0', `%r11')
+define(`F1', `%r12')
+
+C Used only by the vectorized code.
+define(`COUNT', `%rcx')
+define(`L0', `%rax')
+define(`L1', `%rdx')
+define(`L2', `%r9')
+define(`L3', `%r10')
+
+C The vectorized code represents numbers using three limbs of 44,
+C 44 and 42 bits, each limb in a 64-bit element, with one zmm
+C register per limb, and eight independent accumulators in the
+C eight elements.
+define(`A', `%zmm`'$1')		C Accumulator, %zmm0-%zmm2
+define(`AY', `%ymm`'$1')
+define(`AX', `%xmm`'$1')
+define(`LO', `%zmm`'eval(3 + $1)')	C Low product halves, %zmm3-%zmm5
+define(`HI', `%zmm`'eval(6 + $1)')	C High product halves, %zmm6-%zmm8
+C Current multiplier, limbs r_0, r_1, r_2 and 20 r_1, 20 r_2.
+define(`R', `%zmm`'eval(9 + $1)')	C %zmm9-%zmm11
+define(`S', `%zmm`'eval(11 + $1)')	C %zmm12-%zmm13
+C Powers of r, first r, r^2 and r^4 in all elements. Later,
+C the multiplier for the final iteration, with r^8, r^4, r^7, r^3,
+C r^6, r^2, r^5, r, one power per element, in FR and FS.
+define(`V1', `%zmm`'eval(14 + $1)')	C %zmm14-%zmm16
+define(`V2', `%zmm`'eval(17 + $1)')	C %zmm17-%zmm19
+define(`V4', `%zmm`'eval(20 + $1)')	C %zmm20-%zmm22
+define(`FR', `%zmm`'eval(14 + $1)')	C %zmm14-%zmm16
+define(`FS', `%zmm`'eval(16 + $1)')	C %zmm17-%zmm18
+define(`MASK44', `%zmm23')
+define(`MASK42', `%zmm24')
+define(`HIBIT', `%zmm25')
+define(`T', `%zmm26')
+define(`TX', `%xmm26')
+define(`T2', `%zmm27')
+define(`ML', `%zmm28')
+define(`MLX', `%xmm28')
+define(`MH', `%zmm29')
+define(`MHX', `%xmm29')
+define(`ONE', `%zmm30')		C Limbs of the number one are ONE, ZERO, ZERO
+define(`ZERO', `%zmm31')
+
+C MUL(r, s)
+C Multiplies A by r(0), r(1), r(2), s(1), s(2), with the low and
+C high 52 bits of the products accumulated in LO and HI.
+define(`MUL', `
+	vpxorq	LO(0), LO(0), LO(0)
+	vpxorq	LO(1), LO(1), LO(1)
+	vpxorq	LO(2), LO(2), LO(2)
+	vpxorq	HI(0), HI(0), HI(0)
+	vpxorq	HI(1), HI(1), HI(1)
+	vpxorq	HI(2), HI(2), HI(2)
+	vpmadd52luq	$1(0), A(0), LO(0)
+	vpmadd52huq	$1(0), A(0), HI(0)
+	vpmadd52luq	$1(1), A(0), LO(1)
+	vpmadd52huq	$1(1), A(0), HI(1)
+	vpmadd52luq	$1(2), A(0), LO(2)
+	vpmadd52huq	$1(2), A(0), HI(2)
+	vpmadd52luq	$2(2), A(1), LO(0)
+	vpmadd52huq	$2(2), A(1), HI(0)
+	vpmadd52luq	$1(0), A(1), LO(1)
+	vpmadd52huq	$1(0), A(1), HI(1)
+	vpmadd52luq	$1(1), A(1), LO(2)
+	vpmadd52huq	$1(1), A(1), HI(2)
+	vpmadd52luq	$2(1), A(2), LO(0)
+	vpmadd52huq	$2(1), A(2), HI(0)
+	vpmadd52luq	$2(2), A(2), LO(1)
+	vpmadd52huq	$2(2), A(2), HI(1)
+	vpmadd52luq	$1(0), A(2), LO(2)
+	vpmadd52huq	$1(0), A(2), HI(2)')
+
+C CARRY
+C Partially reduces the products in LO and HI, with the result in
+C A. All limbs except a_1 end up less than 2^44 and 2^42,
+C respectively.
+define(`CARRY', `
+	vpsrlq	`$'44, LO(0), T
+	vpandq	MASK44, LO(0), A(0)
+	vpsllq	`$'8, HI(0), T2
+	vpaddq	T, LO(1), LO(1)
+	vpaddq	T2, LO(1), LO(1)
+	vpsrlq	`$'44, LO(1), T
+	vpandq	MASK44, LO(1), A(1)
+	vpsllq	`$'8, HI(1), T2
+	vpaddq	T, LO(2), LO(2)
+	vpaddq	T2, LO(2), LO(2)
+	vpsrlq	`$'42, LO(2), T
+	vpandq	MASK42, LO(2), A(2)
+	vpsllq	`$'10, HI(2), T2
+	vpaddq	T2, T, T
+	vpsllq	`$'2, T, T2
+	vpaddq	T, A(0), A(0)
+	vpaddq	T2, A(0), A(0)
+	vpsrlq	`$'44, A(0), T
+	vpandq	MASK44, A(0), A(0)
+	vpaddq	T, A(1), A(1)')
+
+C SPLIT(lo, hi, reg)
+C Splits the 128-bit numbers in lo and hi into limbs reg(0),
+C reg(1), reg(2). Clobbers lo.
+define(`SPLIT', `
+	vpandq	MASK44, $1, $3(0)
+	vpsrlq	`$'44, $1, $1
+	vpsllq	`$'20, $2, $3(1)
+	vporq	$1, $3(1), $3(1)
+	vpandq	MASK44, $3(1), $3(1)
+	vpsrlq	`$'24, $2, $3(2)')
+
+C SET_S(r, s)
+C Sets s(1), s(2) to 20 r(1), 20 r(2).
+define(`SET_S', `
+	vpsllq	`$'2, $1(1), T
+	vpaddq	$1(1), T, T
+	vpsllq	`$'2, T, $2(1)
+	vpsllq	`$'2, $1(2), T
+	vpaddq	$1(2), T, T
+	vpsllq	`$'2, T, $2(2)')
+
+C SET_R(v)
+C Sets R and S to v.
+define(`SET_R', `
+	vmovdqa64	$1(0), R(0)
+	vmovdqa64	$1(1), R(1)
+	vmovdqa64	$1(2), R(2)
+	SET_S(`R', `S')')
+
+C BLEND_R(v, mask)
+C Sets R and S to v in the elements selected by mask, and to one in
+C the other elements.
+define(`BLEND_R', `
+	mov	`$'$2, XREG(L0)
+	kmovw	XREG(L0), %k1
+	vpblendmq	$1(0), ONE, R(0){%k1}
+	vpblendmq	$1(1), ZERO, R(1){%k1}
+	vpblendmq	$1(2), ZERO, R(2){%k1}
+	SET_S(`R', `S')')
+
+C HSUM(i, reg)
+C Adds together the eight elements of A(i), result in reg. Uses
+C %zmm3 as temporary.
+define(`HSUM', `
+	vextracti64x4	`$'1, A($1), %ymm3
+	vpaddq	%ymm3, AY($1), AY($1)
+	vextracti128	`$'1, AY($1), %xmm3
+	vpaddq	%xmm3, AX($1), AX($1)
+	vpshufd	`$'0x4e, AX($1), %xmm3
+	vpaddq	%xmm3, AX($1), AX($1)
+	vmovq	AX($1), $2')
+
+C const uint8_t *
+C _nettle_poly1305_blocks (struct poly1305_ctx *ctx, size_t blocks, const uint8_t *m)
+
+	C Large inputs are processed eight blocks at a time, using the
+	C powers r^2, ..., r^8, computed on each call. The remaining
+	C blocks are processed one at a time.
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_poly1305_blocks)
+	W64_ENTRY(3, 16)
+	mov	MP_PARAM, MP
+	cmp	$32, BLOCKS
+	jc	.Lscalar
+
+	vpbroadcastq	.Lmask44(%rip), MASK44
+	vpsrlq	$2, MASK44, MASK42
+	vpbroadcastq	.Lhibit(%rip), HIBIT
+	vpbroadcastq	.Lone(%rip), ONE
+	vpxorq	ZERO, ZERO, ZERO
+
+	vpbroadcastq	P1305_R0 (CTX), ML
+	vpbroadcastq	P1305_R1 (CTX), MH
+	SPLIT(ML, MH, `V1')
+	SET_R(`V1')
+	vmovdqa64	V1(0), A(0)
+	vmovdqa64	V1(1), A(1)
+	vmovdqa64	V1(2), A(2)
+	MUL(`R', `S')
+	CARRY
+	vmovdqa64	A(0), V2(0)
+	vmovdqa64	A(1), V2(1)
+	vmovdqa64	A(2), V2(2)
+	SET_R(`V2')
+	MUL(`R', `S')
+	CARRY
+	vmovdqa64	A(0), V4(0)
+	vmovdqa64	A(1), V4(1)
+	vmovdqa64	A(2), V4(2)
+
+	C Compute the powers r^8, r^4, r^7, r^3, r^6, r^2, r^5, r,
+	C by multiplying together r, r^2, r^4 and r^4, each only in
+	C some of the elements.
+	mov	$0xcc, XREG(L0)
+	kmovw	XREG(L0), %k1
+	vpblendmq	V1(0), ONE, A(0){%k1}
+	vpblendmq	V1(1), ZERO, A(1){%k1}
+	vpblendmq	V1(2), ZERO, A(2){%k1}
+	BLEND_R(`V2', 0x3c)
+	MUL(`R', `S')
+	CARRY
+	BLEND_R(`V4', 0x57)
+	MUL(`R', `S')
+	CARRY
+	BLEND_R(`V4', 0x01)
+	MUL(`R', `S')
+	CARRY
+	vmovdqa64	A(0), FR(0)
+	vmovdqa64	A(1), FR(1)
+	vmovdqa64	A(2), FR(2)
+	SET_S(`FR', `FS')
+	vpbroadcastq	AX(0), R(0)
+	vpbroadcastq	AX(1), R(1)
+	vpbroadcastq	AX(2), R(2)
+	SET_S(`R', `S')
+
+	C Fold the high bits of h, and split it into limbs.
+	mov	P1305_H2 (CTX), T1
+	mov	T1, %rax
+	shr	$2, %rax
+	and	$3, T1
+	lea	(%rax, %rax, 4), %rax
+	add	P1305_H0 (CTX), %rax
+	mov	P1305_H1 (CTX), %rdx
+	adc	$0, %rdx
+	adc	$0, T1
+	vmovq	%rax, MLX
+	vmovq	%rdx, MHX
+	SPLIT(ML, MH, `A')
+	shl	$40, T1
+	vmovq	T1, TX
+	vpaddq	T, A(2), A(2)
+
+	mov	BLOCKS, COUNT
+	shr	$3, COUNT
+	and	$7, BLOCKS
+
+	C Message blocks are loaded with blocks 0-3 in the even
+	C elements, and blocks 4-7 in the odd elements. Hence the order
+	C of the powers in FR.
+	ALIGN(16)
+.Lvloop:
+	vmovdqu64	(MP), T
+	vmovdqu64	64(MP), T2
+	vpunpcklqdq	T2, T, ML
+	vpunpckhqdq	T2, T, MH
+	sub	$-128, MP
+	SPLIT(ML, MH, `LO')
+	vpaddq	LO(0), A(0), A(0)
+	vpaddq	LO(1), A(1), A(1)
+	vpaddq	LO(2), A(2), A(2)
+	vpaddq	HIBIT, A(2), A(2)
+	dec	COUNT
+	jz	.Lvdone
+	MUL(`R', `S')
+	CARRY
+	jmp	.Lvloop
+
+.Lvdone:
+	MUL(`FR', `FS')
+	CARRY
+
+	HSUM(0, L0)
+	HSUM(1, L1)
+	HSUM(2, L2)
+	vzeroupper
+
+	C Convert to radix 2^64, as L0 + 2^44 L1 + 2^88 L2, with the
+	C limbs less than 2^47.
+	mov	L1, L3
+	shl	$44, L3
+	shr	$20, L1
+	add	L3, L0
+	adc	$0, L1
+	mov	L2, L3
+	shl	$24, L3
+	shr	$40, L2
+	add	L3, L1
+	adc	$0, L2
+
+	mov	L0, P1305_H0 (CTX)
+	mov	L1, P1305_H1 (CTX)
+	mov	L2, P1305_H2 (CTX)
+
+.Lscalar:
+	test	BLOCKS, BLOCKS
+	jz	.Lend
+
+	push 	%rbx
+	push 	%rbp
+	push	%r12
+	mov	P1305_H0 (CTX), H0
+	mov	P1305_H1 (CTX), H1
+	mov	P1305_H2 (CTX), H2
+	ALIGN(16)
+.Loop:
+	mov	(MP), T0
+	mov	8(MP), T1
+	add	$16, MP
+
+	add	H0, T0
+	adc	H1, T1
+	adc	$1, H2
+
+	mov	P1305_R1 (CTX), %rax
+	mul	T0			C R1*T0
+	mov	%rax, F0
+	mov	%rdx, F1
+
+	mov	T0, %rax		C Last use of T0 input
+	mov	P1305_R0 (CTX), T0
+	mul	T0			C R0*T0
+	mov	%rax, H0
+	mov	%rdx, H1
+
+	mov	T1, %rax
+	mul	T0			C R0*T1
+	add	%rax, F0
+	adc	%rdx, F1
+
+	mov	P1305_S1 (CTX), T0
+	mov	T1, %rax		C Last use of T1 input
+	mul	T0			C S1*T1
+	add	%rax, H0
+	adc	%rdx, H1
+
+	mov	H2, %rax
+	mul	T0			C S1*H2
+	add	%rax, F0
+	adc	%rdx, F1
+
+	mov	H2, T0
+	and	$3, H2
+
+	shr	$2, T0
+	mov	P1305_S0 (CTX), %rax
+	mul	T0			C S0*(H2 >> 2)
+	add	%rax, H0
+	adc	%rdx, H1
+
+	imul	P1305_R0 (CTX), H2	C R0*(H2 & 3)
+	add 	F0, H1
+	adc	F1, H2
+
+	dec	BLOCKS
+	jnz	.Loop
+
+	mov	H0, P1305_H0 (CTX)
+	mov	H1, P1305_H1 (CTX)
+	mov	H2, P1305_H2 (CTX)
+
+	pop	%r12
+	pop	%rbp
+	pop 	%rbx
+
+.Lend:
+	mov	MP, %rax
+	W64_EXIT(3, 16)
+	ret
+EPILOGUE(_nettle_poly1305_blocks)
+
+	RODATA
+	ALIGN(8)
+.Lone:	.quad	1
+.Lmask44:
+	.quad	0xfffffffffff
+.Lhibit:
+	.quad	0x10000000000
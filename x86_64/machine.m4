@@ -165,3 +165,19 @@ define(`W64_EXIT', `
     pop	%rdi
   ')
 ')
+
+C Apply op y, x, x, for each x (AT&T operand order).
+C OPN_YXX(OP, Y, X1, X2, ...)
+define(`OPN_YXX',
+`$1	$2, $3, $3
+ifelse(eval($# > 3), 1,
+`OPN_YXX(`$1', `$2', shift(shift(shift($@))))dnl
+')')
+
+C Apply op y, x, for each x (AT&T operand order).
+C OPN_YX(OP, Y, X1, X2, ...)
+define(`OPN_YX',
+`$1	$2, $3
+ifelse(eval($# > 3), 1,
+`OPN_YX(`$1', `$2', shift(shift(shift($@))))dnl
+')')
@@ -3,6 +3,7 @@ C x86_64/ghash-set-key.asm
 ifelse(`
    Copyright (C) 2022 Niels Möller
    Copyright (C) 2023 Mamone Tarsha
+   Copyright (C) 2026 agent
 
    This file is part of GNU Nettle.
 
@@ -40,11 +41,22 @@ define(`BSWAP', `%xmm1')
 define(`H', `%xmm2')
 define(`D', `%xmm3')
 define(`T', `%xmm4')
-define(`R', `%xmm5')
+define(`X', `%xmm5')
 define(`M', `%xmm6')
 define(`F', `%xmm7')
 define(`MASK', `%xmm7')
 
+define(`PTR', `%rax')
+define(`RPTR', `%rdx')
+define(`COUNT', `%rcx')
+
+C The table holds powers H^k, for 1 <= k <= 16, and the corresponding
+C D^k = x^{-64} H^k. The first 512 bytes hold interleaved pairs, H^k
+C at offset 32(k-1) and D^k at offset 32(k-1) + 16. For the benefit
+C of code processing several blocks per register, powers are also
+C stored in descending order, H^16, ..., H^1 at offset 512 and D^16,
+C ..., D^1 at offset 768.
+
     C void _ghash_set_key (struct gcm_key *ctx, const union nettle_block16 *key)
 
 	.text
@@ -67,6 +79,7 @@ PROLOGUE(_nettle_ghash_set_key)
 	pand	P, T
 	pxor	T, H
 	movups	H, (CTX)
+	movups	H, 752(CTX)
 
 	C Set D = x^{-64} H = {H0, H1} + P1 H0
 	movdqa	H, T
@@ -74,28 +87,44 @@ PROLOGUE(_nettle_ghash_set_key)
 	pclmullqhqdq P, T
 	pxor	T, D
 	movups	D, 16(CTX)
-
-	movdqa		H, M
-	movdqa		H, F
-	movdqa		H, T
+	movups	D, 1008(CTX)
+
+	movdqa	H, X
+	lea	32(CTX), PTR
+	lea	736(CTX), RPTR
+	mov	$15, XREG(COUNT)
+
+.Loop:
+	C Set X = X H, i.e., the next power.
+	movdqa		X, M
+	movdqa		X, F
+	movdqa		X, T
 	pclmulhqlqdq	H, T	C H0 * M1
 	pclmulhqhqdq	H, M	C H1 * M1
 	pclmullqlqdq	D, F 	C D0 * M0
-	pclmullqhqdq	D, H	C D1 * M0
+	pclmullqhqdq	D, X	C D1 * M0
 	pxor		T, F
-	pxor		M, H
+	pxor		M, X
 
 	pshufd		$0x4e, F, T		C Swap halves of F
-	pxor		T, H
+	pxor		T, X
 	pclmullqhqdq	P, F
-	pxor		F, H
-	movups	H, 32(CTX)
-
-	C Set D2 = x^{-64} H^2 = {H0, H1} + P1 H0
-	pshufd	$0x4e, H, D	C Swap H0, H1
-	pclmullqhqdq P, H
-	pxor	H, D
-	movups	D, 48(CTX)
+	pxor		F, X
+	movups	X, (PTR)
+	movups	X, (RPTR)
+
+	C Set x^{-64} X = {X0, X1} + P1 X0
+	pshufd	$0x4e, X, T	C Swap X0, X1
+	movdqa	X, M
+	pclmullqhqdq P, M
+	pxor	M, T
+	movups	T, 16(PTR)
+	movups	T, 256(RPTR)
+
+	add	$32, PTR
+	sub	$16, RPTR
+	dec	XREG(COUNT)
+	jnz	.Loop
 
 	W64_EXIT(2, 8)
 	ret
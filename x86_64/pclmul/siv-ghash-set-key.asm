@@ -0,0 +1,108 @@
+C x86_64/pclmul/siv-ghash-set-key.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+C Common registers
+
+define(`CTX', `%rdi')
+define(`KEY', `%rsi')
+define(`P', `%xmm0')
+define(`H', `%xmm1')
+define(`D', `%xmm2')
+define(`T', `%xmm3')
+define(`X', `%xmm4')
+define(`M', `%xmm5')
+define(`F', `%xmm6')
+
+C Sets up only the part of the table used by _siv_ghash_update,
+C H at offset 0, D = x^{-64} H at offset 16, and H^2 and D^2 at
+C offsets 32 and 48.
+C
+C The C implementation reverses the bytes of the POLYVAL key,
+C multiplies by x using the GHASH bit order, and passes the result
+C to _ghash_set_key. That function reverses the bytes once more and
+C multiplies by x in the bit-reversed representation, which cancels
+C the first multiplication. Hence H is the POLYVAL key as is.
+
+    C void _siv_ghash_set_key (struct gcm_key *ctx, const union nettle_block16 *key)
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_siv_ghash_set_key)
+	W64_ENTRY(2, 7)
+	movdqa	.Lpolynomial(%rip), P
+	movups	(KEY), H
+	movups	H, (CTX)
+
+	C Set D = x^{-64} H = {H0, H1} + P1 H0
+	movdqa	H, T
+	pshufd	$0x4e, H, D	C Swap H0, H1
+	pclmullqhqdq P, T
+	pxor	T, D
+	movups	D, 16(CTX)
+
+	C Set X = H^2
+	movdqa		H, X
+	movdqa		H, M
+	movdqa		H, F
+	movdqa		H, T
+	pclmulhqlqdq	H, T	C H0 * M1
+	pclmulhqhqdq	H, M	C H1 * M1
+	pclmullqlqdq	D, F 	C D0 * M0
+	pclmullqhqdq	D, X	C D1 * M0
+	pxor		T, F
+	pxor		M, X
+
+	pshufd		$0x4e, F, T		C Swap halves of F
+	pxor		T, X
+	pclmullqhqdq	P, F
+	pxor		F, X
+	movups	X, 32(CTX)
+
+	C Set x^{-64} X = {X0, X1} + P1 X0
+	pshufd	$0x4e, X, T	C Swap X0, X1
+	pclmullqhqdq P, X
+	pxor	X, T
+	movups	T, 48(CTX)
+
+	W64_EXIT(2, 7)
+	ret
+EPILOGUE(_nettle_siv_ghash_set_key)
+
+	RODATA
+	C The GCM polynomial is x^{128} + x^7 + x^2 + x + 1,
+	C but in bit-reversed representation, that is
+	C P = x^{128}+ x^{127} + x^{126} + x^{121} + 1
+	C We will mainly use the middle part,
+	C P1 = (P + a + x^{128}) / x^64 = x^{563} + x^{62} + x^{57}
+	ALIGN(16)
+.Lpolynomial:
+	.byte 1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0xC2
@@ -0,0 +1,69 @@
+C Macros for loading message blocks for the multi-buffer sha1 and
+C sha256 compression functions, x86_64/avx2/sha*-compress-8x.asm and
+C x86_64/avx512/sha*-compress-16x.asm. The blocks of the different
+C messages are transposed, so that each vector register holds the
+C same big-endian word of all blocks.
+
+C SHA_LOAD_8X(input, bswap, w)
+C Loads one block from each of the 8 pointers at input, and stores
+C word i of all blocks in w(i), which must be a memory operand. Uses
+C %ymm0-%ymm15 and %rax.
+define(`SHA_LOAD_8X', `
+forloop(`sha_h', 0, 1, `
+forloop(`sha_i', 0, 7, `
+	mov	eval(8*sha_i)($1), %rax
+	vmovdqu	eval(32*sha_h)(%rax), %ymm`'sha_i')
+	vpunpckldq	%ymm1, %ymm0, %ymm8
+	vpunpckhdq	%ymm1, %ymm0, %ymm9
+	vpunpckldq	%ymm3, %ymm2, %ymm10
+	vpunpckhdq	%ymm3, %ymm2, %ymm11
+	vpunpckldq	%ymm5, %ymm4, %ymm12
+	vpunpckhdq	%ymm5, %ymm4, %ymm13
+	vpunpckldq	%ymm7, %ymm6, %ymm14
+	vpunpckhdq	%ymm7, %ymm6, %ymm15
+	vpunpcklqdq	%ymm10, %ymm8, %ymm0
+	vpunpckhqdq	%ymm10, %ymm8, %ymm1
+	vpunpcklqdq	%ymm11, %ymm9, %ymm2
+	vpunpckhqdq	%ymm11, %ymm9, %ymm3
+	vpunpcklqdq	%ymm14, %ymm12, %ymm4
+	vpunpckhqdq	%ymm14, %ymm12, %ymm5
+	vpunpcklqdq	%ymm15, %ymm13, %ymm6
+	vpunpckhqdq	%ymm15, %ymm13, %ymm7
+	vmovdqa	$2, %ymm8
+forloop(`sha_i', 0, 3, `
+	vperm2i128	`$'0x20, %ymm`'eval(sha_i + 4), %ymm`'sha_i, %ymm9
+	vperm2i128	`$'0x31, %ymm`'eval(sha_i + 4), %ymm`'sha_i, %ymm10
+	vpshufb	%ymm8, %ymm9, %ymm9
+	vpshufb	%ymm8, %ymm10, %ymm10
+	vmovdqa	%ymm9, $3(eval(8*sha_h + sha_i))
+	vmovdqa	%ymm10, $3(eval(8*sha_h + sha_i + 4))')')')
+
+C SHA_LOAD_16X(input, bswap, w, t)
+C Loads one block from each of the 16 pointers at input, leaving
+C word i of all blocks in the zmm register w(i). The registers t(0),
+C ..., t(3) are used as temporaries. Uses %rax.
+define(`SHA_LOAD_16X', `
+forloop(`sha_i', 0, 15, `
+	mov	eval(8*sha_i)($1), %rax
+	vmovdqu32	(%rax), $3(sha_i)')
+forloop(`sha_i', 0, 3, `
+	vpunpckldq	$3(eval(4*sha_i + 1)), $3(eval(4*sha_i)), $4(0)
+	vpunpckhdq	$3(eval(4*sha_i + 1)), $3(eval(4*sha_i)), $4(1)
+	vpunpckldq	$3(eval(4*sha_i + 3)), $3(eval(4*sha_i + 2)), $4(2)
+	vpunpckhdq	$3(eval(4*sha_i + 3)), $3(eval(4*sha_i + 2)), $4(3)
+	vpunpcklqdq	$4(2), $4(0), $3(eval(4*sha_i))
+	vpunpckhqdq	$4(2), $4(0), $3(eval(4*sha_i + 1))
+	vpunpcklqdq	$4(3), $4(1), $3(eval(4*sha_i + 2))
+	vpunpckhqdq	$4(3), $4(1), $3(eval(4*sha_i + 3))')
+forloop(`sha_i', 0, 3, `
+	vshufi64x2	`$'0x44, $3(eval(sha_i + 4)), $3(sha_i), $4(0)
+	vshufi64x2	`$'0xee, $3(eval(sha_i + 4)), $3(sha_i), $4(1)
+	vshufi64x2	`$'0x44, $3(eval(sha_i + 12)), $3(eval(sha_i + 8)), $4(2)
+	vshufi64x2	`$'0xee, $3(eval(sha_i + 12)), $3(eval(sha_i + 8)), $4(3)
+	vshufi64x2	`$'0x88, $4(2), $4(0), $3(sha_i)
+	vshufi64x2	`$'0xdd, $4(2), $4(0), $3(eval(sha_i + 4))
+	vshufi64x2	`$'0x88, $4(3), $4(1), $3(eval(sha_i + 8))
+	vshufi64x2	`$'0xdd, $4(3), $4(1), $3(eval(sha_i + 12))')
+	vbroadcasti32x4	$2, $4(0)
+forloop(`sha_i', 0, 15, `
+	vpshufb	$4(0), $3(sha_i), $3(sha_i)')')
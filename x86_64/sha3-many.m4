@@ -0,0 +1,45 @@
+C Macros for the multi-lane keccak permutations, shared by the avx2
+C and avx512 implementations.
+
+C The pi step moves lane i = x + 5y to position KECCAK_PI(i) =
+C y + 5 (2x + 3y). It is not done by moving data; instead, lanes are
+C renamed so that after r rounds, lane i is held in location
+C KECCAK_LANE(r, i) = pi^-r(i). Since the permutation pi has order
+C 24, all lanes are back in place after the last round.
+define(`KECCAK_PI', `eval($1 / 5 + 5 * ((2 * ($1 % 5) + 3 * ($1 / 5)) % 5))')
+define(`KECCAK_PIN', `ifelse($1, 0, $2, `KECCAK_PIN(decr($1), KECCAK_PI($2))')')
+define(`KECCAK_PI_INV', `KECCAK_PIN(23, $1)')
+define(`KECCAK_LANE', `KECCAK_PIN(eval((24 - ($1) % 24) % 24), $2)')
+
+C Rotation counts for the rho step, by lane.
+define(`KECCAK_RHO_0', 0)	define(`KECCAK_RHO_1', 1)
+define(`KECCAK_RHO_2', 62)	define(`KECCAK_RHO_3', 28)
+define(`KECCAK_RHO_4', 27)	define(`KECCAK_RHO_5', 36)
+define(`KECCAK_RHO_6', 44)	define(`KECCAK_RHO_7', 6)
+define(`KECCAK_RHO_8', 55)	define(`KECCAK_RHO_9', 20)
+define(`KECCAK_RHO_10', 3)	define(`KECCAK_RHO_11', 10)
+define(`KECCAK_RHO_12', 43)	define(`KECCAK_RHO_13', 25)
+define(`KECCAK_RHO_14', 39)	define(`KECCAK_RHO_15', 41)
+define(`KECCAK_RHO_16', 45)	define(`KECCAK_RHO_17', 15)
+define(`KECCAK_RHO_18', 21)	define(`KECCAK_RHO_19', 8)
+define(`KECCAK_RHO_20', 18)	define(`KECCAK_RHO_21', 2)
+define(`KECCAK_RHO_22', 61)	define(`KECCAK_RHO_23', 56)
+define(`KECCAK_RHO_24', 14)
+define(`KECCAK_RHO', `KECCAK_RHO_$1')
+
+C KECCAK_RC, table of round constants, labeled .Lrc.
+define(`KECCAK_RC', `
+	ALIGN(8)
+.Lrc:
+	.quad	0x0000000000000001, 0x0000000000008082
+	.quad	0x800000000000808A, 0x8000000080008000
+	.quad	0x000000000000808B, 0x0000000080000001
+	.quad	0x8000000080008081, 0x8000000000008009
+	.quad	0x000000000000008A, 0x0000000000000088
+	.quad	0x0000000080008009, 0x000000008000000A
+	.quad	0x000000008000808B, 0x800000000000008B
+	.quad	0x8000000000008089, 0x8000000000008003
+	.quad	0x8000000000008002, 0x8000000000000080
+	.quad	0x000000000000800A, 0x800000008000000A
+	.quad	0x8000000080008081, 0x8000000000008080
+	.quad	0x0000000080000001, 0x8000000080008008')
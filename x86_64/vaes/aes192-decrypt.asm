@@ -0,0 +1,143 @@
+C x86_64/vaes/aes192-decrypt.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+include_src(`x86_64/aes-vaes.m4')
+
+C Input argument
+define(`CTX',	`%rdi')
+define(`LENGTH',`%rsi')
+define(`DST',	`%rdx')
+define(`SRC',	`%rcx')
+
+define(`X0', `%ymm0')
+define(`X1', `%ymm1')
+define(`X2', `%ymm2')
+define(`X3', `%ymm3')
+define(`X4', `%ymm4')
+define(`X5', `%ymm5')
+define(`X6', `%ymm6')
+define(`X7', `%ymm7')
+define(`K', `%ymm8')
+define(`X', `%xmm0')
+
+	.file "aes192-decrypt.asm"
+
+	C nettle_aes192_decrypt(const struct aes192_ctx *ctx,
+	C                       size_t length, uint8_t *dst,
+	C                       const uint8_t *src);
+
+	C Processes 16 blocks per iteration, two blocks in each ymm
+	C register. Left-over blocks are handled first, one bit of
+	C the block count at a time.
+	.text
+	ALIGN(16)
+PROLOGUE(nettle_aes192_decrypt)
+	W64_ENTRY(4, 9)
+	shr	$4, LENGTH
+	test	LENGTH, LENGTH
+	jz	.Lend
+
+	test	$1, LENGTH
+	jz	.Lx2
+	vmovdqu	(SRC), X
+	AES_DECRYPT_X(12, CTX, X)
+	vmovdqu	X, (DST)
+	add	$16, SRC
+	add	$16, DST
+
+.Lx2:
+	test	$2, LENGTH
+	jz	.Lx4
+	vmovdqu	(SRC), X0
+	AES_DECRYPT_Y(12, CTX, K, X0)
+	vmovdqu	X0, (DST)
+	add	$32, SRC
+	add	$32, DST
+
+.Lx4:
+	test	$4, LENGTH
+	jz	.Lx8
+	vmovdqu	(SRC), X0
+	vmovdqu	32(SRC), X1
+	AES_DECRYPT_Y(12, CTX, K, X0, X1)
+	vmovdqu	X0, (DST)
+	vmovdqu	X1, 32(DST)
+	add	$64, SRC
+	add	$64, DST
+
+.Lx8:
+	test	$8, LENGTH
+	jz	.Lx16
+	vmovdqu	(SRC), X0
+	vmovdqu	32(SRC), X1
+	vmovdqu	64(SRC), X2
+	vmovdqu	96(SRC), X3
+	AES_DECRYPT_Y(12, CTX, K, X0, X1, X2, X3)
+	vmovdqu	X0, (DST)
+	vmovdqu	X1, 32(DST)
+	vmovdqu	X2, 64(DST)
+	vmovdqu	X3, 96(DST)
+	add	$128, SRC
+	add	$128, DST
+
+.Lx16:
+	shr	$4, LENGTH
+	jz	.Lend
+
+.Lblock_loop:
+	vmovdqu	(SRC), X0
+	vmovdqu	32(SRC), X1
+	vmovdqu	64(SRC), X2
+	vmovdqu	96(SRC), X3
+	vmovdqu	128(SRC), X4
+	vmovdqu	160(SRC), X5
+	vmovdqu	192(SRC), X6
+	vmovdqu	224(SRC), X7
+	AES_DECRYPT_Y(12, CTX, K, X0, X1, X2, X3, X4, X5, X6, X7)
+	vmovdqu	X0, (DST)
+	vmovdqu	X1, 32(DST)
+	vmovdqu	X2, 64(DST)
+	vmovdqu	X3, 96(DST)
+	vmovdqu	X4, 128(DST)
+	vmovdqu	X5, 160(DST)
+	vmovdqu	X6, 192(DST)
+	vmovdqu	X7, 224(DST)
+	add	$256, SRC
+	add	$256, DST
+	dec	LENGTH
+	jnz	.Lblock_loop
+
+.Lend:
+	vzeroupper
+	W64_EXIT(4, 9)
+	ret
+EPILOGUE(nettle_aes192_decrypt)
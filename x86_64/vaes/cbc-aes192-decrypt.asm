@@ -0,0 +1,141 @@
+C x86_64/vaes/cbc-aes192-decrypt.asm
+
+ifelse(`
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+include_src(`x86_64/aes-vaes.m4')
+
+C Input argument
+define(`CTX',	`%rdi')
+define(`IV',	`%rsi')
+define(`LENGTH',`%rdx')
+define(`DST',	`%rcx')
+define(`SRC',	`%r8')
+
+define(`X0', `%ymm0')
+define(`X1', `%ymm1')
+define(`X2', `%ymm2')
+define(`X3', `%ymm3')
+define(`X4', `%ymm4')
+define(`X5', `%ymm5')
+define(`X6', `%ymm6')
+define(`X7', `%ymm7')
+define(`K', `%ymm8')
+define(`Y', `%xmm9')	C Previous ciphertext block
+define(`YY', `%ymm9')
+define(`NEXT', `%xmm10')	C Last ciphertext block of iteration
+define(`T', `%ymm11')
+define(`X', `%xmm0')
+
+	.file "cbc-aes192-decrypt.asm"
+
+	C nettle_cbc_aes192_decrypt(struct cbc_aes192_ctx *ctx,
+	C                           uint8_t *iv,
+	C                           size_t length, uint8_t *dst,
+	C                           const uint8_t *src);
+
+	C Decrypts 16 blocks per iteration, two blocks in each ymm
+	C register. The preceding ciphertext blocks are xored in
+	C using unaligned loads at offset -16, storing the last
+	C register first, so that in-place operation works.
+	C Left-over blocks are done one at a time.
+	.text
+	ALIGN(16)
+PROLOGUE(nettle_cbc_aes192_decrypt)
+	W64_ENTRY(5, 12)
+	shr	$4, LENGTH
+	test	LENGTH, LENGTH
+	jz	.Lend
+
+	vmovdqu	(IV), Y
+	cmp	$16, LENGTH
+	jc	.Lblock_loop
+
+.Lloop16:
+	vmovdqu	(SRC), X0
+	vmovdqu	32(SRC), X1
+	vmovdqu	64(SRC), X2
+	vmovdqu	96(SRC), X3
+	vmovdqu	128(SRC), X4
+	vmovdqu	160(SRC), X5
+	vmovdqu	192(SRC), X6
+	vmovdqu	224(SRC), X7
+	vmovdqu	240(SRC), NEXT
+	AES_DECRYPT_Y(12, CTX, K, X0, X1, X2, X3, X4, X5, X6, X7)
+
+	vpxor	208(SRC), X7, X7
+	vmovdqu	X7, 224(DST)
+	vpxor	176(SRC), X6, X6
+	vmovdqu	X6, 192(DST)
+	vpxor	144(SRC), X5, X5
+	vmovdqu	X5, 160(DST)
+	vpxor	112(SRC), X4, X4
+	vmovdqu	X4, 128(DST)
+	vpxor	80(SRC), X3, X3
+	vmovdqu	X3, 96(DST)
+	vpxor	48(SRC), X2, X2
+	vmovdqu	X2, 64(DST)
+	vpxor	16(SRC), X1, X1
+	vmovdqu	X1, 32(DST)
+	vinserti128 $1, (SRC), YY, T
+	vpxor	T, X0, X0
+	vmovdqu	X0, (DST)
+	vmovdqa	NEXT, Y
+
+	add	$256, SRC
+	add	$256, DST
+	sub	$16, LENGTH
+	cmp	$16, LENGTH
+	jnc	.Lloop16
+
+	test	LENGTH, LENGTH
+	jz	.Ldone
+
+.Lblock_loop:
+	vmovdqu	(SRC), X
+	vmovdqa	X, NEXT
+	AES_DECRYPT_X(12, CTX, X)
+	vpxor	Y, X, X
+	vmovdqu	X, (DST)
+	vmovdqa	NEXT, Y
+
+	add	$16, SRC
+	add	$16, DST
+	dec	LENGTH
+	jnz	.Lblock_loop
+
+.Ldone:
+	vmovdqu	Y, (IV)
+
+.Lend:
+	vzeroupper
+	W64_EXIT(5, 12)
+	ret
+EPILOGUE(nettle_cbc_aes192_decrypt)
@@ -57,34 +57,57 @@ check_length(size_t length, uint8_t *dst)
     memset(dst, '\0', length);
 }
 
-/* works also for inplace encryption/decryption */
+/* Number of blocks processed per call to the cipher function. */
+#define XTS_BUFFER_BLOCKS 32
 
-void
-xts_encrypt_message(const void *enc_ctx, const void *twk_ctx,
-	            nettle_cipher_func *encf,
-	            const uint8_t *tweak, size_t length,
-	            uint8_t *dst, const uint8_t *src)
+/* Processes complete blocks, starting with the tweak T, which is
+   updated for the following block. The tweaks for up to
+   XTS_BUFFER_BLOCKS blocks are computed up front, so that the cipher
+   function gets many blocks at a time. */
+static void
+xts_crypt_blocks(const void *ctx, nettle_cipher_func *f,
+		 union nettle_block16 *T, size_t blocks,
+		 uint8_t *dst, const uint8_t *src)
 {
-  union nettle_block16 T;
-  union nettle_block16 P;
+  union nettle_block16 buffer[XTS_BUFFER_BLOCKS];
 
-  check_length(length, dst);
+  while (blocks > 0)
+    {
+      size_t n = blocks < XTS_BUFFER_BLOCKS ? blocks : XTS_BUFFER_BLOCKS;
+      size_t i;
 
-  encf(twk_ctx, XTS_BLOCK_SIZE, T.b, tweak);
+      buffer[0] = *T;
+      for (i = 1; i < n; i++)
+	block16_mulx_le(&buffer[i], &buffer[i-1]);
+      block16_mulx_le(T, &buffer[n-1]);
 
-  /* the zeroth power of alpha is the initial ciphertext value itself, so we
-   * skip shifting and do it at the end of each block operation instead */
-  for (;length >= 2 * XTS_BLOCK_SIZE || length == XTS_BLOCK_SIZE;
-       length -= XTS_BLOCK_SIZE, src += XTS_BLOCK_SIZE, dst += XTS_BLOCK_SIZE)
-    {
-      memxor3(P.b, src, T.b, XTS_BLOCK_SIZE);	/* P -> PP */
-      encf(enc_ctx, XTS_BLOCK_SIZE, dst, P.b);  /* CC */
-      memxor(dst, T.b, XTS_BLOCK_SIZE);	        /* CC -> C */
+      memxor3(dst, src, buffer[0].b, n * XTS_BLOCK_SIZE);
+      f(ctx, n * XTS_BLOCK_SIZE, dst, dst);
+      memxor(dst, buffer[0].b, n * XTS_BLOCK_SIZE);
 
-      /* shift T for next block if any */
-      if (length > XTS_BLOCK_SIZE)
-          block16_mulx_le(&T, &T);
+      blocks -= n;
+      src += n * XTS_BLOCK_SIZE;
+      dst += n * XTS_BLOCK_SIZE;
     }
+}
+
+/* Encrypts a message with the encrypted tweak T, which is clobbered.
+   Works also for inplace encryption. */
+static void
+xts_encrypt_tweaked(const void *enc_ctx, nettle_cipher_func *encf,
+		    union nettle_block16 *T, size_t length,
+		    uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 P;
+  size_t blocks;
+
+  /* the last complete block is processed together with a partial
+   * block, if any, using ciphertext stealing */
+  blocks = length / XTS_BLOCK_SIZE - (length % XTS_BLOCK_SIZE != 0);
+  xts_crypt_blocks(enc_ctx, encf, T, blocks, dst, src);
+  length -= blocks * XTS_BLOCK_SIZE;
+  src += blocks * XTS_BLOCK_SIZE;
+  dst += blocks * XTS_BLOCK_SIZE;
 
   /* if the last block is partial, handle via stealing */
   if (length)
@@ -92,23 +115,23 @@ xts_encrypt_message(const void *enc_ctx, const void *twk_ctx,
       /* S Holds the real C(n-1) (Whole last block to steal from) */
       union nettle_block16 S;
 
-      memxor3(P.b, src, T.b, XTS_BLOCK_SIZE);	/* P -> PP */
+      memxor3(P.b, src, T->b, XTS_BLOCK_SIZE);	/* P -> PP */
       encf(enc_ctx, XTS_BLOCK_SIZE, S.b, P.b);  /* CC */
-      memxor(S.b, T.b, XTS_BLOCK_SIZE);	        /* CC -> S */
+      memxor(S.b, T->b, XTS_BLOCK_SIZE);	/* CC -> S */
 
       /* shift T for next block */
-      block16_mulx_le(&T, &T);
+      block16_mulx_le(T, T);
 
       length -= XTS_BLOCK_SIZE;
       src += XTS_BLOCK_SIZE;
 
-      memxor3(P.b, src, T.b, length);           /* P |.. */
+      memxor3(P.b, src, T->b, length);          /* P |.. */
       /* steal ciphertext to complete block */
-      memxor3(P.b + length, S.b + length, T.b + length,
+      memxor3(P.b + length, S.b + length, T->b + length,
               XTS_BLOCK_SIZE - length);         /* ..| S_2 -> PP */
 
       encf(enc_ctx, XTS_BLOCK_SIZE, dst, P.b);  /* CC */
-      memxor(dst, T.b, XTS_BLOCK_SIZE);         /* CC -> C(n-1) */
+      memxor(dst, T->b, XTS_BLOCK_SIZE);        /* CC -> C(n-1) */
 
       /* Do this after we read src so inplace operations do not break */
       dst += XTS_BLOCK_SIZE;
@@ -116,30 +139,21 @@ xts_encrypt_message(const void *enc_ctx, const void *twk_ctx,
     }
 }
 
-void
-xts_decrypt_message(const void *dec_ctx, const void *twk_ctx,
-	            nettle_cipher_func *decf, nettle_cipher_func *encf,
-	            const uint8_t *tweak, size_t length,
-	            uint8_t *dst, const uint8_t *src)
+/* Decrypts a message with the encrypted tweak T, which is clobbered.
+   Works also for inplace decryption. */
+static void
+xts_decrypt_tweaked(const void *dec_ctx, nettle_cipher_func *decf,
+		    union nettle_block16 *T, size_t length,
+		    uint8_t *dst, const uint8_t *src)
 {
-  union nettle_block16 T;
   union nettle_block16 C;
+  size_t blocks;
 
-  check_length(length, dst);
-
-  encf(twk_ctx, XTS_BLOCK_SIZE, T.b, tweak);
-
-  for (;length >= 2 * XTS_BLOCK_SIZE || length == XTS_BLOCK_SIZE;
-       length -= XTS_BLOCK_SIZE, src += XTS_BLOCK_SIZE, dst += XTS_BLOCK_SIZE)
-    {
-      memxor3(C.b, src, T.b, XTS_BLOCK_SIZE);	/* c -> CC */
-      decf(dec_ctx, XTS_BLOCK_SIZE, dst, C.b);  /* PP */
-      memxor(dst, T.b, XTS_BLOCK_SIZE);	        /* PP -> P */
-
-      /* shift T for next block if any */
-      if (length > XTS_BLOCK_SIZE)
-          block16_mulx_le(&T, &T);
-    }
+  blocks = length / XTS_BLOCK_SIZE - (length % XTS_BLOCK_SIZE != 0);
+  xts_crypt_blocks(dec_ctx, decf, T, blocks, dst, src);
+  length -= blocks * XTS_BLOCK_SIZE;
+  src += blocks * XTS_BLOCK_SIZE;
+  dst += blocks * XTS_BLOCK_SIZE;
 
   /* if the last block is partial, handle via stealing */
   if (length)
@@ -149,7 +163,7 @@ xts_decrypt_message(const void *dec_ctx, const void *twk_ctx,
       union nettle_block16 S;
 
       /* we need the last T(n) and save the T(n-1) for later */
-      block16_mulx_le(&T1, &T);
+      block16_mulx_le(&T1, T);
 
       memxor3(C.b, src, T1.b, XTS_BLOCK_SIZE);	/* C -> CC */
       decf(dec_ctx, XTS_BLOCK_SIZE, S.b, C.b);  /* PP */
@@ -160,14 +174,117 @@ xts_decrypt_message(const void *dec_ctx, const void *twk_ctx,
       src += XTS_BLOCK_SIZE;
 
       /* Prepare C, P holds the real P(n) */
-      memxor3(C.b, src, T.b, length);	        /* C_1 |.. */
-      memxor3(C.b + length, S.b + length, T.b + length,
+      memxor3(C.b, src, T->b, length);	        /* C_1 |.. */
+      memxor3(C.b + length, S.b + length, T->b + length,
               XTS_BLOCK_SIZE - length);         /* ..| S_2 -> CC */
       decf(dec_ctx, XTS_BLOCK_SIZE, dst, C.b);  /* PP */
-      memxor(dst, T.b, XTS_BLOCK_SIZE);	        /* PP -> P(n-1) */
+      memxor(dst, T->b, XTS_BLOCK_SIZE);	/* PP -> P(n-1) */
 
       /* Do this after we read src so inplace operations do not break */
       dst += XTS_BLOCK_SIZE;
       memcpy(dst, S.b, length);                 /* S_1 -> P(n) */
     }
 }
+
+/* works also for inplace encryption/decryption */
+
+void
+xts_encrypt_message(const void *enc_ctx, const void *twk_ctx,
+	            nettle_cipher_func *encf,
+	            const uint8_t *tweak, size_t length,
+	            uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 T;
+
+  check_length(length, dst);
+
+  encf(twk_ctx, XTS_BLOCK_SIZE, T.b, tweak);
+  xts_encrypt_tweaked(enc_ctx, encf, &T, length, dst, src);
+}
+
+void
+xts_decrypt_message(const void *dec_ctx, const void *twk_ctx,
+	            nettle_cipher_func *decf, nettle_cipher_func *encf,
+	            const uint8_t *tweak, size_t length,
+	            uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 T;
+
+  check_length(length, dst);
+
+  encf(twk_ctx, XTS_BLOCK_SIZE, T.b, tweak);
+  xts_decrypt_tweaked(dec_ctx, decf, &T, length, dst, src);
+}
+
+/* Sets up to XTS_BUFFER_BLOCKS consecutive sector tweaks, starting
+   with N, interpreted as a little-endian number, and encrypts them
+   all with a single call to encf. Updates N, and returns the number
+   of tweaks. */
+static size_t
+xts_sector_tweaks(const void *twk_ctx, nettle_cipher_func *encf,
+		  union nettle_block16 *N, size_t sectors,
+		  union nettle_block16 *T)
+{
+  size_t n = sectors < XTS_BUFFER_BLOCKS ? sectors : XTS_BUFFER_BLOCKS;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      unsigned j;
+      T[i] = *N;
+      for (j = 0; j < XTS_BLOCK_SIZE && ++N->b[j] == 0; j++)
+	;
+    }
+  encf(twk_ctx, n * XTS_BLOCK_SIZE, T[0].b, T[0].b);
+  return n;
+}
+
+void
+xts_encrypt_sectors(const void *enc_ctx, const void *twk_ctx,
+		    nettle_cipher_func *encf,
+		    const uint8_t *tweak, size_t sector_size,
+		    size_t length, uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 T[XTS_BUFFER_BLOCKS];
+  union nettle_block16 N;
+  size_t sectors;
+
+  assert(sector_size >= XTS_BLOCK_SIZE);
+  assert(length % sector_size == 0);
+
+  memcpy(N.b, tweak, XTS_BLOCK_SIZE);
+  for (sectors = length / sector_size; sectors > 0; )
+    {
+      size_t n = xts_sector_tweaks(twk_ctx, encf, &N, sectors, T);
+      size_t i;
+
+      for (i = 0; i < n; i++, src += sector_size, dst += sector_size)
+	xts_encrypt_tweaked(enc_ctx, encf, &T[i], sector_size, dst, src);
+      sectors -= n;
+    }
+}
+
+void
+xts_decrypt_sectors(const void *dec_ctx, const void *twk_ctx,
+		    nettle_cipher_func *decf, nettle_cipher_func *encf,
+		    const uint8_t *tweak, size_t sector_size,
+		    size_t length, uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 T[XTS_BUFFER_BLOCKS];
+  union nettle_block16 N;
+  size_t sectors;
+
+  assert(sector_size >= XTS_BLOCK_SIZE);
+  assert(length % sector_size == 0);
+
+  memcpy(N.b, tweak, XTS_BLOCK_SIZE);
+  for (sectors = length / sector_size; sectors > 0; )
+    {
+      size_t n = xts_sector_tweaks(twk_ctx, encf, &N, sectors, T);
+      size_t i;
+
+      for (i = 0; i < n; i++, src += sector_size, dst += sector_size)
+	xts_decrypt_tweaked(dec_ctx, decf, &T[i], sector_size, dst, src);
+      sectors -= n;
+    }
+}
@@ -46,14 +46,20 @@ extern "C" {
 /* Name mangling */
 #define xts_encrypt_message nettle_xts_encrypt_message
 #define xts_decrypt_message nettle_xts_decrypt_message
+#define xts_encrypt_sectors nettle_xts_encrypt_sectors
+#define xts_decrypt_sectors nettle_xts_decrypt_sectors
 #define xts_aes128_set_encrypt_key nettle_xts_aes128_set_encrypt_key
 #define xts_aes128_set_decrypt_key nettle_xts_aes128_set_decrypt_key
 #define xts_aes128_encrypt_message nettle_xts_aes128_encrypt_message
 #define xts_aes128_decrypt_message nettle_xts_aes128_decrypt_message
+#define xts_aes128_encrypt_sectors nettle_xts_aes128_encrypt_sectors
+#define xts_aes128_decrypt_sectors nettle_xts_aes128_decrypt_sectors
 #define xts_aes256_set_encrypt_key nettle_xts_aes256_set_encrypt_key
 #define xts_aes256_set_decrypt_key nettle_xts_aes256_set_decrypt_key
 #define xts_aes256_encrypt_message nettle_xts_aes256_encrypt_message
 #define xts_aes256_decrypt_message nettle_xts_aes256_decrypt_message
+#define xts_aes256_encrypt_sectors nettle_xts_aes256_encrypt_sectors
+#define xts_aes256_decrypt_sectors nettle_xts_aes256_decrypt_sectors
 
 #define XTS_BLOCK_SIZE 16
 
@@ -68,6 +74,21 @@ xts_decrypt_message(const void *dec_ctx, const void *twk_ctx,
                     const uint8_t *tweak, size_t length,
                     uint8_t *dst, const uint8_t *src);
 
+/* Processes length / sector_size consecutive sectors, each one a
+   separate XTS message. The tweak for the first sector is given, and
+   incremented, as a 128-bit little-endian number, for each following
+   sector. */
+void
+xts_encrypt_sectors(const void *enc_ctx, const void *twk_ctx,
+                    nettle_cipher_func *encf,
+                    const uint8_t *tweak, size_t sector_size,
+                    size_t length, uint8_t *dst, const uint8_t *src);
+void
+xts_decrypt_sectors(const void *dec_ctx, const void *twk_ctx,
+                    nettle_cipher_func *decf, nettle_cipher_func *encf,
+                    const uint8_t *tweak, size_t sector_size,
+                    size_t length, uint8_t *dst, const uint8_t *src);
+
 /* XTS Mode with AES-128 */
 struct xts_aes128_key {
     struct aes128_ctx cipher;
@@ -92,6 +113,16 @@ xts_aes128_decrypt_message(const struct xts_aes128_key *xts_key,
                            const uint8_t *tweak, size_t length,
                            uint8_t *dst, const uint8_t *src);
 
+void
+xts_aes128_encrypt_sectors(const struct xts_aes128_key *xts_key,
+                           const uint8_t *tweak, size_t sector_size,
+                           size_t length, uint8_t *dst, const uint8_t *src);
+
+void
+xts_aes128_decrypt_sectors(const struct xts_aes128_key *xts_key,
+                           const uint8_t *tweak, size_t sector_size,
+                           size_t length, uint8_t *dst, const uint8_t *src);
+
 /* XTS Mode with AES-256 */
 struct xts_aes256_key {
     struct aes256_ctx cipher;
@@ -116,6 +147,16 @@ xts_aes256_decrypt_message(const struct xts_aes256_key *xts_key,
                            const uint8_t *tweak, size_t length,
                            uint8_t *dst, const uint8_t *src);
 
+void
+xts_aes256_encrypt_sectors(const struct xts_aes256_key *xts_key,
+                           const uint8_t *tweak, size_t sector_size,
+                           size_t length, uint8_t *dst, const uint8_t *src);
+
+void
+xts_aes256_decrypt_sectors(const struct xts_aes256_key *xts_key,
+                           const uint8_t *tweak, size_t sector_size,
+                           size_t length, uint8_t *dst, const uint8_t *src);
+
 #ifdef __cplusplus
 }
 #endif